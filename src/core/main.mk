@@ -35,6 +35,8 @@ endif
 # Rules
 #===============================================================================
 BUILD_TARGET_LIST :=
+# Benchmarks to run by "make bench" (projects/bench)
+BENCH_TARGET_LIST :=
 # File list to delete
 BUILD_FILES_TO_CLEAN :=
 
@@ -50,6 +52,7 @@ help:
 	@echo "   Commands:"
 	@echo "       $(ANSI_YELLOW)help$(ANSI_RESET): show this page"
 	@echo "       $(ANSI_YELLOW)release$(ANSI_RESET): make project to release"
+	@echo "       $(ANSI_YELLOW)bench$(ANSI_RESET): make project with benchmarks, and run the benchmarks"
 	@echo ""
 
 # clean할 때 target이 삭제될 수 있도록 함
@@ -68,6 +71,14 @@ build_target_list: $(BUILD_TARGET_LIST)
 	@$(TARGET_COUNTER)
 	@echo $(CURRENT_PROGRESS)"$(CONFIG_COMPLETE_COLOR)Completed.$(ANSI_RESET)"$(INCREASE_COUNT)
 
+.PHONY: bench
+bench: all
+	@for target in $(BENCH_TARGET_LIST); \
+	do \
+		echo "$(CONFIG_BUILDING_COLOR)Running benchmark$(ANSI_RESET) $$target..."; \
+		$$target || exit 1; \
+	done
+
 .PHONY: directories_to_prepare
 directories_to_prepare:
 	@$(TARGET_COUNTER)
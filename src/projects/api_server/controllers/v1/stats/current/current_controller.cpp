@@ -18,8 +18,54 @@ namespace api
 		{
 			void CurrentController::PrepareHandlers()
 			{
+				RegisterGet(R"(\/memoryPool)", &CurrentController::OnGetMemoryPool);
+				RegisterGet(R"(\/admissionWebhooks)", &CurrentController::OnGetAdmissionWebhooks);
+				RegisterGet(R"(\/executors)", &CurrentController::OnGetExecutors);
+				RegisterGet(R"(\/httpServers)", &CurrentController::OnGetHttpServers);
+
 				CreateSubController<VHostsController>(R"(\/vhosts)");
 			};
+
+			ApiResponse CurrentController::OnGetMemoryPool(const std::shared_ptr<http::svr::HttpConnection> &client)
+			{
+				auto monitoring = mon::Monitoring::GetInstance();
+				Json::Value response;
+
+				response["buffer"] = conv::JsonFromMemoryPoolStats(monitoring->GetBufferPoolStats());
+
+				return response;
+			}
+
+			ApiResponse CurrentController::OnGetAdmissionWebhooks(const std::shared_ptr<http::svr::HttpConnection> &client)
+			{
+				return conv::JsonFromAdmissionWebhooksStats(AdmissionWebhooksCache::GetStats());
+			}
+
+			ApiResponse CurrentController::OnGetExecutors(const std::shared_ptr<http::svr::HttpConnection> &client)
+			{
+				auto monitoring = mon::Monitoring::GetInstance();
+				Json::Value response = Json::arrayValue;
+
+				for (const auto &executor : monitoring->GetExecutorList())
+				{
+					response.append(conv::JsonFromExecutorStats(executor));
+				}
+
+				return response;
+			}
+
+			ApiResponse CurrentController::OnGetHttpServers(const std::shared_ptr<http::svr::HttpConnection> &client)
+			{
+				auto monitoring = mon::Monitoring::GetInstance();
+				Json::Value response = Json::arrayValue;
+
+				for (const auto &metrics : monitoring->GetHttpServerMetricsList())
+				{
+					response.append(conv::JsonFromHttpServerMetrics(metrics));
+				}
+
+				return response;
+			}
 		}  // namespace stats
 	}	   // namespace v1
 }  // namespace api
@@ -20,6 +20,12 @@ namespace api
 			{
 			public:
 				void PrepareHandlers() override;
+
+			protected:
+				ApiResponse OnGetMemoryPool(const std::shared_ptr<http::svr::HttpConnection> &client);
+				ApiResponse OnGetAdmissionWebhooks(const std::shared_ptr<http::svr::HttpConnection> &client);
+				ApiResponse OnGetExecutors(const std::shared_ptr<http::svr::HttpConnection> &client);
+				ApiResponse OnGetHttpServers(const std::shared_ptr<http::svr::HttpConnection> &client);
 			};
 		}  // namespace stats
 	}	   // namespace v1
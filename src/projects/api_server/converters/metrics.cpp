@@ -8,6 +8,7 @@
 //==============================================================================
 #include "application.h"
 #include "common.h"
+#include "metrics.h"
 
 namespace api
 {
@@ -47,6 +48,91 @@ namespace api
 			SetTimeInterval(value, "requestTimeToOrigin", metrics->GetOriginRequestTimeMSec());
 			SetTimeInterval(value, "responseTimeFromOrigin", metrics->GetOriginResponseTimeMSec());
 
+			// Bandwidth of the WebRTC viewers estimated by transport-cc (bps)
+			auto bandwidth_estimate = metrics->GetEstimatedBandwidthSummary();
+			Json::Value bandwidth_estimate_value;
+
+			SetInt(bandwidth_estimate_value, "sessionCount", bandwidth_estimate.session_count);
+			SetInt64(bandwidth_estimate_value, "min", bandwidth_estimate.min);
+			SetInt64(bandwidth_estimate_value, "avg", bandwidth_estimate.avg);
+			SetInt64(bandwidth_estimate_value, "max", bandwidth_estimate.max);
+
+			value["webrtcBandwidthEstimate"] = bandwidth_estimate_value;
+
+			return value;
+		}
+
+		Json::Value JsonFromMemoryPoolStats(const ov::MemoryPool::Stats &stats)
+		{
+			Json::Value value;
+
+			SetInt64(value, "hitCount", stats.hit_count);
+			SetInt64(value, "missCount", stats.miss_count);
+			SetInt64(value, "residentBytes", stats.resident_bytes);
+
+			return value;
+		}
+
+		Json::Value JsonFromExecutorStats(const std::shared_ptr<ov::WorkStealingExecutor> &executor)
+		{
+			Json::Value value;
+			Json::Value &threads = value["threads"];
+
+			SetString(value, "name", executor->GetName(), Optional::False);
+			SetInt64(value, "threadCount", executor->GetThreadCount());
+			SetInt64(value, "pendingCount", executor->GetPendingCount());
+
+			threads = Json::arrayValue;
+
+			for (const auto &statistics : executor->GetStatistics())
+			{
+				Json::Value thread;
+
+				SetInt64(thread, "index", statistics.index);
+				SetFloat(thread, "utilization", statistics.GetUtilization());
+				SetInt64(thread, "executedCount", statistics.executed_count);
+				SetInt64(thread, "stolenCount", statistics.stolen_count);
+				SetInt64(thread, "queuedCount", statistics.queued_count);
+				SetTimeInterval(thread, "busyTime", statistics.busy_time_usec / 1000);
+				SetTimeInterval(thread, "elapsedTime", statistics.elapsed_time_usec / 1000);
+
+				threads.append(thread);
+			}
+
+			return value;
+		}
+
+		Json::Value JsonFromHttpServerMetrics(const std::shared_ptr<const mon::HttpServerMetrics> &metrics)
+		{
+			Json::Value value;
+
+			SetString(value, "name", metrics->GetServerName(), Optional::False);
+			SetString(value, "address", metrics->GetAddress(), Optional::False);
+			SetBool(value, "tls", metrics->IsTls());
+			SetInt64(value, "connectionCount", metrics->GetConnectionCount());
+			SetInt64(value, "requestCount", metrics->GetRequestCount());
+			SetFloat(value, "requestsPerConnection", metrics->GetRequestsPerConnection());
+
+			if (metrics->IsTls())
+			{
+				SetInt64(value, "kernelTlsConnectionCount", metrics->GetKernelTlsConnectionCount());
+				SetInt64(value, "userspaceTlsConnectionCount", metrics->GetUserspaceTlsConnectionCount());
+			}
+
+			return value;
+		}
+
+		Json::Value JsonFromAdmissionWebhooksStats(const AdmissionWebhooksCache::Stats &stats)
+		{
+			Json::Value value;
+
+			SetInt64(value, "queryCount", stats.query_count);
+			SetInt64(value, "hitCount", stats.hit_count);
+			SetInt64(value, "missCount", stats.miss_count);
+			SetInt64(value, "coalescedCount", stats.coalesced_count);
+			SetInt64(value, "avgLatency", (stats.query_count > 0) ? (stats.total_latency_msec / stats.query_count) : 0);
+			SetInt64(value, "maxLatency", stats.max_latency_msec);
+
 			return value;
 		}
 	}  // namespace conv
@@ -8,6 +8,7 @@
 //==============================================================================
 #pragma once
 
+#include <modules/access_control/admission_webhooks/admission_webhooks_cache.h>
 #include <monitoring/monitoring.h>
 
 namespace api
@@ -16,5 +17,9 @@ namespace api
 	{
 		Json::Value JsonFromMetrics(const std::shared_ptr<const mon::CommonMetrics> &metrics);
 		Json::Value JsonFromStreamMetrics(const std::shared_ptr<const mon::StreamMetrics> &metrics);
+		Json::Value JsonFromMemoryPoolStats(const ov::MemoryPool::Stats &stats);
+		Json::Value JsonFromExecutorStats(const std::shared_ptr<ov::WorkStealingExecutor> &executor);
+		Json::Value JsonFromHttpServerMetrics(const std::shared_ptr<const mon::HttpServerMetrics> &metrics);
+		Json::Value JsonFromAdmissionWebhooksStats(const AdmissionWebhooksCache::Stats &stats);
 	}  // namespace conv
 };	   // namespace api
\ No newline at end of file
@@ -45,6 +45,7 @@ namespace info
 		_created_time = stream._created_time;
 		_app_info = stream._app_info;
 		_origin_stream = stream._origin_stream;
+		_origin_stream_uuid = stream._origin_stream_uuid;
 
 		for (auto &track : stream._tracks)
 		{
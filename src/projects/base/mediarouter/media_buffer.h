@@ -264,7 +264,7 @@ public:
 
 	void ClearBuffer(int32_t plane = 0)
 	{
-		auto plane_data = AllocPlainData(plane);
+		auto plane_data = AllocWritablePlainData(plane);
 
 		if (plane_data != nullptr)
 		{
@@ -274,7 +274,7 @@ public:
 
 	void SetBuffer(const uint8_t *data, int32_t data_size, int32_t plane = 0)
 	{
-		auto plane_data = AllocPlainData(plane);
+		auto plane_data = AllocWritablePlainData(plane);
 
 		if (plane_data != nullptr && data_size != 0)
 		{
@@ -285,7 +285,7 @@ public:
 
 	void AppendBuffer(const uint8_t *data, int32_t data_size, int32_t plane = 0)
 	{
-		auto plane_data = AllocPlainData(plane);
+		auto plane_data = AllocWritablePlainData(plane);
 
 		if (plane_data != nullptr && data_size != 0)
 		{
@@ -307,7 +307,7 @@ public:
 
 	uint8_t *GetWritableBuffer(int32_t plane = 0)
 	{
-		auto plane_data = AllocPlainData(plane);
+		auto plane_data = AllocWritablePlainData(plane);
 
 		if (plane_data != nullptr)
 		{
@@ -329,10 +329,32 @@ public:
 		return 0;
 	}
 
+	// Makes the plane refer to the memory owned by the native frame without copying (See SetNativeFrame())
+	void SetBufferReference(const uint8_t *data, int32_t data_size, int32_t plane = 0)
+	{
+		SetPlainData(std::make_shared<ov::Data>(data, data_size, true), plane);
+	}
+
+	// Sets the native frame (ex: AVFrame of the transcoder) that owns the memory of the planes.
+	// The native frame is released when all the MediaFrames that refer to it are released.
+	void SetNativeFrame(std::shared_ptr<void> native_frame)
+	{
+		_native_frame = std::move(native_frame);
+		_is_native_frame_modified = false;
+	}
+
+	// Returns nullptr if there is no native frame, or the planes are modified after the native frame is set
+	// (In this case, the planes must be copied from GetBuffer())
+	template <typename T>
+	T *GetNativeFrame() const
+	{
+		return _is_native_frame_modified ? nullptr : static_cast<T *>(_native_frame.get());
+	}
+
 	// Preallocate memory only
 	void Reserve(uint32_t capacity, int32_t plane = 0)
 	{
-		auto plane_data = AllocPlainData(plane);
+		auto plane_data = AllocWritablePlainData(plane);
 
 		if (plane_data != nullptr)
 		{
@@ -344,7 +366,7 @@ public:
 	// Pre-work Resize due to Append Buffer's performance problem, then get a pointer with GetBuffer and set the data.
 	void Resize(uint32_t capacity, int32_t plane = 0)
 	{
-		auto plane_data = AllocPlainData(plane);
+		auto plane_data = AllocWritablePlainData(plane);
 
 		if (plane_data != nullptr)
 		{
@@ -570,6 +592,9 @@ public:
 					frame->SetPlainData(GetPlainData(i)->Clone(), i);
 				}
 			}
+
+			frame->_native_frame = _native_frame;
+			frame->_is_native_frame_modified = _is_native_frame_modified;
 		}
 		else if (_media_type == cmn::MediaType::Audio)
 		{
@@ -586,6 +611,9 @@ public:
 			{
 				frame->SetPlainData(GetPlainData(i)->Clone(), i);
 			}
+
+			frame->_native_frame = _native_frame;
+			frame->_is_native_frame_modified = _is_native_frame_modified;
 		}
 		else
 		{
@@ -629,6 +657,14 @@ private:
 		return item->second;
 	}
 
+	// Called before the plane is modified, so the native frame is no longer the same as the planes
+	std::shared_ptr<ov::Data> AllocWritablePlainData(int32_t plane)
+	{
+		_is_native_frame_modified = true;
+
+		return AllocPlainData(plane);
+	}
+
 	// Data plane, Data
 	std::map<int32_t, std::shared_ptr<ov::Data>> _data_buffer;
 	cmn::MediaType _media_type = cmn::MediaType::Unknown;
@@ -649,4 +685,8 @@ private:
 	int32_t _sample_rate = 0;
 
 	int32_t _flags = 0;	 // Key, non-Key
+
+	// The native frame that owns the memory of the planes (The planes refer to it)
+	std::shared_ptr<void> _native_frame;
+	bool _is_native_frame_modified = false;
 };
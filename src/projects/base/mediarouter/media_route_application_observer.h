@@ -35,6 +35,21 @@ public:
 	virtual bool OnSendFrame(const std::shared_ptr<info::Stream> &info,
 								const std::shared_ptr<MediaPacket> &packet) = 0;
 
+	// Delivery a batch of encoded video/audio frames of a stream (in decoding order)
+	// Override this to handle the batch at once (ex: look up the stream only once)
+	virtual bool OnSendFrames(const std::shared_ptr<info::Stream> &info,
+							  const std::vector<std::shared_ptr<MediaPacket>> &packets)
+	{
+		bool result = true;
+
+		for (const auto &packet : packets)
+		{
+			result = OnSendFrame(info, packet) && result;
+		}
+
+		return result;
+	}
+
 	virtual ObserverType GetObserverType()
 	{
 		return ObserverType::Publisher;
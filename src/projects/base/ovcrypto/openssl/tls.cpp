@@ -8,8 +8,14 @@
 //==============================================================================
 #include "tls.h"
 
+#include <openssl/kdf.h>
+
 #include <utility>
 
+#if IS_LINUX
+#	include <linux/tls.h>
+#endif	// IS_LINUX
+
 #include "./openssl_manager.h"
 
 #define OV_LOG_TAG "OpenSSL"
@@ -664,6 +670,129 @@ namespace ov
 		return true;
 	}
 
+	void Tls::PrepareKernelTls()
+	{
+		OV_ASSERT2(_ssl != nullptr);
+
+		// Records written by OpenSSL after the keys are handed to the kernel cannot be sent
+		::SSL_set_options(_ssl, SSL_OP_NO_RENEGOTIATION);
+	}
+
+#if IS_LINUX
+	template <typename Tcrypto_info>
+	static std::shared_ptr<const Data> MakeKernelTlsCryptoInfo(uint16_t cipher_type, const uint8_t *key, const uint8_t *salt)
+	{
+		Tcrypto_info crypto_info{};
+
+		crypto_info.info.version = TLS_1_2_VERSION;
+		crypto_info.info.cipher_type = cipher_type;
+
+		::memcpy(crypto_info.key, key, sizeof(crypto_info.key));
+		::memcpy(crypto_info.salt, salt, sizeof(crypto_info.salt));
+
+		// The server has sent only one record (Finished, sequence number: 0) using these keys,
+		// so the next record will use 1 as sequence number and explicit nonce (same as OpenSSL)
+		crypto_info.rec_seq[sizeof(crypto_info.rec_seq) - 1] = 1;
+		::memcpy(crypto_info.iv, crypto_info.rec_seq, sizeof(crypto_info.iv));
+
+		auto data = std::make_shared<Data>(&crypto_info, sizeof(crypto_info));
+
+		::OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+
+		return data;
+	}
+#endif	// IS_LINUX
+
+	std::shared_ptr<const Data> Tls::GetKernelTlsTxInfo() const
+	{
+#if IS_LINUX
+		OV_ASSERT2(_ssl != nullptr);
+
+		if (::SSL_version(_ssl) != TLS1_2_VERSION)
+		{
+			return nullptr;
+		}
+
+		auto cipher = ::SSL_get_current_cipher(_ssl);
+		auto session = ::SSL_get_session(_ssl);
+
+		if ((cipher == nullptr) || (session == nullptr))
+		{
+			return nullptr;
+		}
+
+		size_t key_length = 0;
+
+		switch (::SSL_CIPHER_get_cipher_nid(cipher))
+		{
+			case NID_aes_128_gcm:
+				key_length = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+				break;
+
+			case NID_aes_256_gcm:
+				key_length = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+				break;
+
+			default:
+				// Other ciphers (ex: AES128-SHA) are encrypted in userspace
+				return nullptr;
+		}
+
+		// RFC 5246 - 6.3. Key Calculation
+		//
+		// key_block = PRF(SecurityParameters.master_secret, "key expansion", SecurityParameters.server_random + SecurityParameters.client_random);
+		//
+		// AEAD ciphers have no MAC keys, so the key block is:
+		// [client_write_key][server_write_key][client_write_IV (salt)][server_write_IV (salt)]
+		uint8_t master_key[SSL_MAX_MASTER_KEY_LENGTH];
+		size_t master_key_length = ::SSL_SESSION_get_master_key(session, master_key, sizeof(master_key));
+
+		uint8_t seed[SSL3_RANDOM_SIZE * 2];
+		::SSL_get_server_random(_ssl, seed, SSL3_RANDOM_SIZE);
+		::SSL_get_client_random(_ssl, seed + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+
+		constexpr const char KEY_EXPANSION_LABEL[] = "key expansion";
+		// TLS_CIPHER_AES_GCM_*_SALT_SIZE is 4 for both of AES-128-GCM and AES-256-GCM
+		constexpr size_t salt_length = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+
+		uint8_t key_block[(TLS_CIPHER_AES_GCM_256_KEY_SIZE + salt_length) * 2];
+		size_t key_block_length = (key_length + salt_length) * 2;
+
+		TlsUniquePtr<EVP_PKEY_CTX, void, ::EVP_PKEY_CTX_free> context(::EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, nullptr));
+
+		bool result =
+			(context != nullptr) &&
+			(::EVP_PKEY_derive_init(context) == 1) &&
+			(::EVP_PKEY_CTX_set_tls1_prf_md(context, ::SSL_CIPHER_get_handshake_digest(cipher)) == 1) &&
+			(::EVP_PKEY_CTX_set1_tls1_prf_secret(context, master_key, static_cast<int>(master_key_length)) == 1) &&
+			(::EVP_PKEY_CTX_add1_tls1_prf_seed(context, reinterpret_cast<const unsigned char *>(KEY_EXPANSION_LABEL), static_cast<int>(sizeof(KEY_EXPANSION_LABEL) - 1)) == 1) &&
+			(::EVP_PKEY_CTX_add1_tls1_prf_seed(context, seed, static_cast<int>(sizeof(seed))) == 1) &&
+			(::EVP_PKEY_derive(context, key_block, &key_block_length) == 1);
+
+		::OPENSSL_cleanse(master_key, sizeof(master_key));
+
+		if (result == false)
+		{
+			logtw("Could not derive the key block for kTLS: %s", ov::OpensslError::CreateErrorFromOpenssl()->ToString().CStr());
+			::OPENSSL_cleanse(key_block, sizeof(key_block));
+			return nullptr;
+		}
+
+		const uint8_t *server_key = key_block + key_length;
+		const uint8_t *server_salt = key_block + (key_length * 2) + salt_length;
+
+		auto crypto_info = (key_length == TLS_CIPHER_AES_GCM_128_KEY_SIZE)
+							   ? MakeKernelTlsCryptoInfo<tls12_crypto_info_aes_gcm_128>(TLS_CIPHER_AES_GCM_128, server_key, server_salt)
+							   : MakeKernelTlsCryptoInfo<tls12_crypto_info_aes_gcm_256>(TLS_CIPHER_AES_GCM_256, server_key, server_salt);
+
+		::OPENSSL_cleanse(key_block, sizeof(key_block));
+
+		return crypto_info;
+#else	// IS_LINUX
+		return nullptr;
+#endif	// IS_LINUX
+	}
+
 	unsigned long Tls::GetSelectedSrtpProfileId()
 	{
 		OV_ASSERT2(_ssl != nullptr);
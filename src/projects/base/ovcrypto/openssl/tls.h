@@ -152,6 +152,17 @@ namespace ov
 		std::shared_ptr<Certificate> GetPeerCertificate() const;
 		bool ExportKeyingMaterial(unsigned long crypto_suite, const ov::String &label, std::shared_ptr<ov::Data> &server_key, std::shared_ptr<ov::Data> &client_key);
 
+		// Disables the features which make OpenSSL write records after the handshake (ex: renegotiation).
+		// Must be called before the handshake if the TX keys will be handed to the kernel
+		void PrepareKernelTls();
+
+		// Returns tls12_crypto_info_* of <linux/tls.h> which contains the TX keys of the established session.
+		// Returns nullptr if the kernel cannot encrypt the session (only TLS 1.2 + AES-GCM is supported).
+		//
+		// NOTE: This must be called right after the handshake is completed,
+		//       before any application data is written using Write().
+		std::shared_ptr<const Data> GetKernelTlsTxInfo() const;
+
 		// APIs related to SRTP
 		unsigned long GetSelectedSrtpProfileId();
 
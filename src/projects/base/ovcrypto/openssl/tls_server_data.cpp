@@ -65,6 +65,43 @@ namespace ov
 		_tls.Uninitialize();
 	}
 
+	void TlsServerData::SetKernelTlsCallback(KernelTlsCallback kernel_tls_callback)
+	{
+		if ((_state != State::WaitingForAccept) || (_method != Method::Tls))
+		{
+			OV_ASSERT2(false);
+			return;
+		}
+
+		_kernel_tls_callback = kernel_tls_callback;
+
+		if (_kernel_tls_callback != nullptr)
+		{
+			_tls.PrepareKernelTls();
+		}
+	}
+
+	void TlsServerData::EnableKernelTls()
+	{
+		if (_kernel_tls_callback == nullptr)
+		{
+			return;
+		}
+
+		auto crypto_info = _tls.GetKernelTlsTxInfo();
+
+		if (crypto_info == nullptr)
+		{
+			logtd("The negotiated cipher cannot be offloaded to the kernel");
+		}
+		else
+		{
+			_kernel_tls_enabled = _kernel_tls_callback(crypto_info);
+		}
+
+		_kernel_tls_callback = nullptr;
+	}
+
 	bool TlsServerData::Decrypt(const std::shared_ptr<const Data> &cipher_data, std::shared_ptr<const Data> *plain_data)
 	{
 		if (_state == State::Invalid)
@@ -105,6 +142,7 @@ namespace ov
 					case SSL_ERROR_NONE:
 						logtd("Accepted");
 						_state = State::Accepted;
+						EnableKernelTls();
 						break;
 
 					case SSL_ERROR_WANT_READ:
@@ -145,6 +183,13 @@ namespace ov
 			return false;
 		}
 
+		if (_kernel_tls_enabled)
+		{
+			// The kernel encrypts the data
+			*cipher_data = plain_data;
+			return true;
+		}
+
 		logtd("Trying to encrypt the data for TLS\n%s", plain_data->Dump(32).CStr());
 
 		size_t written_bytes = 0;
@@ -191,6 +236,11 @@ namespace ov
 			OV_ASSERT2(false);
 			return -1LL;
 		}
+		else if (_kernel_tls_enabled)
+		{
+			// The record cannot be sent because the kernel owns the sequence number of the TX keys (ex: close_notify alert)
+			logtd("Dropping %zu bytes written by TLS module after kTLS is enabled", length);
+		}
 		else
 		{
 			if (_plain_data == nullptr)
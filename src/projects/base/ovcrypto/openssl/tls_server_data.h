@@ -17,6 +17,8 @@ namespace ov
 	{
 	public:
 		using WriteCallback = std::function<ssize_t(const void *data, int64_t length)>;
+		// Hands crypto_info (tls12_crypto_info_* of <linux/tls.h>) to the kernel, returns false if the kernel cannot encrypt the data
+		using KernelTlsCallback = std::function<bool(const std::shared_ptr<const Data> &crypto_info)>;
 
 		enum class Method
 		{
@@ -54,6 +56,16 @@ namespace ov
 			_write_callback = write_callback;
 		}
 
+		// This callback is called when the TLS negotiation is completed to offload the encryption to the kernel.
+		// If the callback succeeds, Encrypt() returns the plain data as it is.
+		// Must be set before the negotiation is started
+		void SetKernelTlsCallback(KernelTlsCallback kernel_tls_callback);
+
+		bool IsKernelTlsEnabled() const
+		{
+			return _kernel_tls_enabled;
+		}
+
 		// plain_data can be null even if successful (It indicates accepting a new client)
 		bool Decrypt(const std::shared_ptr<const Data> &cipher_data, std::shared_ptr<const Data> *plain_data);
 		// cipher_data can be null even if successful (It indicates accepting a new client)
@@ -73,6 +85,8 @@ namespace ov
 
 		long OnTlsCtrl(ov::Tls *tls, int cmd, long num, void *arg);
 
+		void EnableKernelTls();
+
 		State _state = State::Invalid;
 		Method _method;
 
@@ -80,6 +94,9 @@ namespace ov
 		std::mutex _data_mutex;
 		WriteCallback _write_callback;
 
+		KernelTlsCallback _kernel_tls_callback;
+		bool _kernel_tls_enabled = false;
+
 		std::shared_ptr<Data> _cipher_data;
 		std::shared_ptr<Data> _plain_data;
 	};
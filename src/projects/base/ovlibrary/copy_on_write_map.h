@@ -0,0 +1,234 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "./epoch.h"
+
+namespace ov
+{
+	// A map for read-mostly tables which are looked up on hot paths (ex: for every packet).
+	//
+	// - Readers load the current snapshot of a shard in a read-side section of ov::Epoch and look up the snapshot,
+	//   so they never take a lock, never wait for a writer, and never write a shared reference count
+	// - Writers copy the snapshot of a shard, modify the copy, publish it, and retire the old snapshot to ov::Epoch
+	// - A snapshot is deleted when all the readers which could see it have left their sections
+	//
+	// Keys are distributed over shard_count shards by ShardHash, so a writer copies only a part of the table.
+	template <typename Tkey, typename Tvalue, typename ShardHash = std::hash<Tkey>, size_t shard_count = 64>
+	class CopyOnWriteMap
+	{
+	public:
+		using Map = std::map<Tkey, Tvalue>;
+
+		CopyOnWriteMap()
+		{
+			for (auto &shard : _shards)
+			{
+				shard.snapshot = new Map();
+			}
+		}
+
+		~CopyOnWriteMap()
+		{
+			// There is no reader when the map is destroyed
+			for (auto &shard : _shards)
+			{
+				delete shard.snapshot.load();
+			}
+		}
+
+		CopyOnWriteMap(const CopyOnWriteMap &) = delete;
+		CopyOnWriteMap &operator=(const CopyOnWriteMap &) = delete;
+
+		bool Find(const Tkey &key, Tvalue *value = nullptr) const
+		{
+			Epoch::ReadGuard guard;
+
+			auto snapshot = GetShard(key).snapshot.load(std::memory_order_acquire);
+			auto item = snapshot->find(key);
+
+			if (item == snapshot->end())
+			{
+				return false;
+			}
+
+			if (value != nullptr)
+			{
+				*value = item->second;
+			}
+
+			return true;
+		}
+
+		// Returns false if the key already exists (the value is not changed)
+		bool Insert(const Tkey &key, const Tvalue &value)
+		{
+			return Update(key, [&](Map &map) -> bool {
+				return map.emplace(key, value).second;
+			});
+		}
+
+		void Set(const Tkey &key, const Tvalue &value)
+		{
+			Update(key, [&](Map &map) -> bool {
+				map[key] = value;
+				return true;
+			});
+		}
+
+		// Returns false if the key is not found
+		bool Remove(const Tkey &key, Tvalue *removed_value = nullptr)
+		{
+			return Update(key, [&](Map &map) -> bool {
+				auto item = map.find(key);
+
+				if (item == map.end())
+				{
+					return false;
+				}
+
+				if (removed_value != nullptr)
+				{
+					*removed_value = std::move(item->second);
+				}
+
+				map.erase(item);
+				return true;
+			});
+		}
+
+		// Removes the items for which predicate returns true, and returns the number of removed items
+		size_t RemoveIf(const std::function<bool(const Tkey &key, const Tvalue &value)> &predicate)
+		{
+			size_t removed_count = 0;
+
+			for (auto &shard : _shards)
+			{
+				std::lock_guard<std::mutex> lock_guard(shard.mutex);
+
+				auto snapshot = shard.snapshot.load(std::memory_order_relaxed);
+				std::unique_ptr<Map> new_map;
+
+				for (auto &item : *snapshot)
+				{
+					if (predicate(item.first, item.second))
+					{
+						if (new_map == nullptr)
+						{
+							new_map = std::make_unique<Map>(*snapshot);
+						}
+
+						new_map->erase(item.first);
+						removed_count++;
+					}
+				}
+
+				if (new_map != nullptr)
+				{
+					Publish(shard, new_map.release());
+				}
+			}
+
+			return removed_count;
+		}
+
+		// The callback is called with the snapshots, so it may not see the items changed while iterating
+		void ForEach(const std::function<void(const Tkey &key, const Tvalue &value)> &callback) const
+		{
+			for (auto &shard : _shards)
+			{
+				Epoch::ReadGuard guard;
+
+				for (auto &item : *(shard.snapshot.load(std::memory_order_acquire)))
+				{
+					callback(item.first, item.second);
+				}
+			}
+		}
+
+		size_t GetCount() const
+		{
+			size_t count = 0;
+
+			for (auto &shard : _shards)
+			{
+				Epoch::ReadGuard guard;
+
+				count += shard.snapshot.load(std::memory_order_acquire)->size();
+			}
+
+			return count;
+		}
+
+		void Clear()
+		{
+			for (auto &shard : _shards)
+			{
+				std::lock_guard<std::mutex> lock_guard(shard.mutex);
+
+				Publish(shard, new Map());
+			}
+		}
+
+	protected:
+		struct Shard
+		{
+			// Serializes the writers
+			std::mutex mutex;
+			std::atomic<const Map *> snapshot{nullptr};
+		};
+
+		Shard &GetShard(const Tkey &key)
+		{
+			return _shards[ShardHash()(key) % shard_count];
+		}
+
+		const Shard &GetShard(const Tkey &key) const
+		{
+			return _shards[ShardHash()(key) % shard_count];
+		}
+
+		// Must be called while the mutex of the shard is held
+		void Publish(Shard &shard, const Map *new_map)
+		{
+			// seq_cst: pairs with ov::Epoch::Enter() of the readers
+			auto old_map = shard.snapshot.exchange(new_map);
+
+			Epoch::Retire(old_map);
+		}
+
+		// updater returns true if the map is modified
+		bool Update(const Tkey &key, const std::function<bool(Map &map)> &updater)
+		{
+			auto &shard = GetShard(key);
+
+			std::lock_guard<std::mutex> lock_guard(shard.mutex);
+
+			auto new_map = std::make_unique<Map>(*(shard.snapshot.load(std::memory_order_relaxed)));
+
+			if (updater(*new_map) == false)
+			{
+				return false;
+			}
+
+			Publish(shard, new_map.release());
+
+			return true;
+		}
+
+		std::array<Shard, shard_count> _shards;
+	};
+}  // namespace ov
@@ -0,0 +1,347 @@
+#include "crc.h"
+
+#include <array>
+
+#if defined(__x86_64__) || defined(__i386__)
+#	include <immintrin.h>
+#	define OV_CRC_X86
+#endif
+
+// Below this size, the setup of PCLMULQDQ folding costs more than slicing-by-8
+#define OV_CRC_PCLMUL_MIN_LENGTH	64
+
+namespace ov
+{
+	// tables[0] is the byte-wise table, and tables[k][n] is the CRC of the byte n followed by k zero bytes (slicing-by-8)
+	using CrcTables = std::array<std::array<uint32_t, 256>, 8>;
+
+	// LSB first
+	static constexpr CrcTables MakeReflectedTables(uint32_t reversed_polynomial)
+	{
+		CrcTables tables {};
+
+		for (uint32_t n = 0; n < 256; n++)
+		{
+			uint32_t c = n;
+
+			for (int k = 0; k < 8; k++)
+			{
+				c = (c & 1) ? (reversed_polynomial ^ (c >> 1)) : (c >> 1);
+			}
+
+			tables[0][n] = c;
+		}
+
+		for (size_t k = 1; k < tables.size(); k++)
+		{
+			for (uint32_t n = 0; n < 256; n++)
+			{
+				tables[k][n] = (tables[k - 1][n] >> 8) ^ tables[0][tables[k - 1][n] & 0xFF];
+			}
+		}
+
+		return tables;
+	}
+
+	// MSB first
+	static constexpr CrcTables MakeTables(uint32_t polynomial)
+	{
+		CrcTables tables {};
+
+		for (uint32_t n = 0; n < 256; n++)
+		{
+			uint32_t c = n << 24;
+
+			for (int k = 0; k < 8; k++)
+			{
+				c = (c & 0x80000000) ? ((c << 1) ^ polynomial) : (c << 1);
+			}
+
+			tables[0][n] = c;
+		}
+
+		for (size_t k = 1; k < tables.size(); k++)
+		{
+			for (uint32_t n = 0; n < 256; n++)
+			{
+				tables[k][n] = (tables[k - 1][n] << 8) ^ tables[0][tables[k - 1][n] >> 24];
+			}
+		}
+
+		return tables;
+	}
+
+	static constexpr CrcTables kCrc32Tables = MakeReflectedTables(0xEDB88320);
+	static constexpr CrcTables kCrc32Mpeg2Tables = MakeTables(0x04C11DB7);
+
+	// crc is not inverted
+	static uint32_t UpdateCrc32Bytewise(uint32_t crc, const uint8_t *buf, size_t len)
+	{
+		const auto &t = kCrc32Tables;
+
+		while (len-- > 0)
+		{
+			crc = (crc >> 8) ^ t[0][(crc ^ *buf++) & 0xFF];
+		}
+
+		return crc;
+	}
+
+	// crc is not inverted
+	static uint32_t UpdateCrc32(uint32_t crc, const uint8_t *buf, size_t len)
+	{
+		const auto &t = kCrc32Tables;
+
+		while (len >= 8)
+		{
+			uint32_t first = crc ^ (static_cast<uint32_t>(buf[0]) | (static_cast<uint32_t>(buf[1]) << 8) |
+									(static_cast<uint32_t>(buf[2]) << 16) | (static_cast<uint32_t>(buf[3]) << 24));
+
+			crc = t[7][first & 0xFF] ^ t[6][(first >> 8) & 0xFF] ^ t[5][(first >> 16) & 0xFF] ^ t[4][first >> 24] ^
+				  t[3][buf[4]] ^ t[2][buf[5]] ^ t[1][buf[6]] ^ t[0][buf[7]];
+
+			buf += 8;
+			len -= 8;
+		}
+
+		return UpdateCrc32Bytewise(crc, buf, len);
+	}
+
+#if defined(OV_CRC_X86)
+	// Folds the buffer with carry-less multiplication and reduces it by Barrett reduction:
+	// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (V. Gopal, E. Ozturk, et al., Intel, 2009)
+	//
+	// len must be a multiple of 16 and at least 64, crc is not inverted
+	__attribute__((target("sse4.1,pclmul")))
+	static uint32_t UpdateCrc32Pclmul(uint32_t crc, const uint8_t *buf, size_t len)
+	{
+		// Constants of the bit-reflected domain (x^(4*128+32) mod P, x^(4*128-32) mod P, ...) and the polynomial for Barrett reduction
+		alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+		alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+		alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+		alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+		__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+		x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x00));
+		x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x10));
+		x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x20));
+		x4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x30));
+
+		x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+
+		x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k1k2));
+
+		buf += 64;
+		len -= 64;
+
+		// Fold 4 blocks of 16 bytes in parallel
+		while (len >= 64)
+		{
+			x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+			x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+			x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+			x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+			x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+			x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+			x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+			x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+			y5 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x00));
+			y6 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x10));
+			y7 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x20));
+			y8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x30));
+
+			x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+			x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+			x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+			x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+
+			buf += 64;
+			len -= 64;
+		}
+
+		// Fold into 128 bits
+		x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k3k4));
+
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+		// Fold the remaining blocks of 16 bytes
+		while (len >= 16)
+		{
+			x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf));
+
+			x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+			x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+			x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+			buf += 16;
+			len -= 16;
+		}
+
+		// Fold 128 bits into 64 bits
+		x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+		x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+		x1 = _mm_srli_si128(x1, 8);
+		x1 = _mm_xor_si128(x1, x2);
+
+		x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(k5k0));
+
+		x2 = _mm_srli_si128(x1, 4);
+		x1 = _mm_and_si128(x1, x3);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_xor_si128(x1, x2);
+
+		// Barrett reduction into 32 bits
+		x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(poly));
+
+		x2 = _mm_and_si128(x1, x3);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+		x2 = _mm_and_si128(x2, x3);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+		x1 = _mm_xor_si128(x1, x2);
+
+		return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+	}
+
+	static bool IsPclmulSupported()
+	{
+		static const bool is_supported = []() -> bool {
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+		}();
+
+		return is_supported;
+	}
+#endif	// OV_CRC_X86
+
+	static uint32_t UpdateCrc32Mpeg2Bytewise(uint32_t crc, const uint8_t *buf, size_t len)
+	{
+		const auto &t = kCrc32Mpeg2Tables;
+
+		while (len-- > 0)
+		{
+			crc = (crc << 8) ^ t[0][((crc >> 24) ^ *buf++) & 0xFF];
+		}
+
+		return crc;
+	}
+
+	static uint32_t UpdateCrc32Mpeg2(uint32_t crc, const uint8_t *buf, size_t len)
+	{
+		const auto &t = kCrc32Mpeg2Tables;
+
+		while (len >= 8)
+		{
+			uint32_t first = crc ^ ((static_cast<uint32_t>(buf[0]) << 24) | (static_cast<uint32_t>(buf[1]) << 16) |
+									(static_cast<uint32_t>(buf[2]) << 8) | static_cast<uint32_t>(buf[3]));
+
+			crc = t[7][first >> 24] ^ t[6][(first >> 16) & 0xFF] ^ t[5][(first >> 8) & 0xFF] ^ t[4][first & 0xFF] ^
+				  t[3][buf[4]] ^ t[2][buf[5]] ^ t[1][buf[6]] ^ t[0][buf[7]];
+
+			buf += 8;
+			len -= 8;
+		}
+
+		return UpdateCrc32Mpeg2Bytewise(crc, buf, len);
+	}
+
+	uint32_t CRC::Crc32(uint32_t crc, const uint8_t *buf, size_t len)
+	{
+#if defined(OV_CRC_X86)
+		if (IsPclmulSupported())
+		{
+			return Crc32(Kernel::Pclmul, crc, buf, len);
+		}
+#endif	// OV_CRC_X86
+
+		return Crc32(Kernel::SlicingBy8, crc, buf, len);
+	}
+
+	uint32_t CRC::Crc32Mpeg2(const uint8_t *buf, size_t len, uint32_t crc)
+	{
+		return UpdateCrc32Mpeg2(crc, buf, len);
+	}
+
+	const char *CRC::GetCrc32KernelName()
+	{
+#if defined(OV_CRC_X86)
+		if (IsPclmulSupported())
+		{
+			return "pclmul";
+		}
+#endif	// OV_CRC_X86
+
+		return "slicing-by-8";
+	}
+
+	bool CRC::IsKernelSupported(Kernel kernel, bool is_mpeg2)
+	{
+		switch (kernel)
+		{
+			case Kernel::Bytewise:
+			case Kernel::SlicingBy8:
+				return true;
+
+			case Kernel::Pclmul:
+#if defined(OV_CRC_X86)
+				return (is_mpeg2 == false) && IsPclmulSupported();
+#else	// OV_CRC_X86
+				return false;
+#endif	// OV_CRC_X86
+		}
+
+		return false;
+	}
+
+	uint32_t CRC::Crc32(Kernel kernel, uint32_t crc, const uint8_t *buf, size_t len)
+	{
+		crc = ~crc;
+
+		switch (kernel)
+		{
+			case Kernel::Bytewise:
+				return ~UpdateCrc32Bytewise(crc, buf, len);
+
+			case Kernel::SlicingBy8:
+				break;
+
+			case Kernel::Pclmul:
+#if defined(OV_CRC_X86)
+				if ((len >= OV_CRC_PCLMUL_MIN_LENGTH) && IsPclmulSupported())
+				{
+					size_t folded_length = len & ~static_cast<size_t>(15);
+
+					crc = UpdateCrc32Pclmul(crc, buf, folded_length);
+
+					buf += folded_length;
+					len -= folded_length;
+				}
+#endif	// OV_CRC_X86
+				break;
+		}
+
+		return ~UpdateCrc32(crc, buf, len);
+	}
+
+	uint32_t CRC::Crc32Mpeg2(Kernel kernel, const uint8_t *buf, size_t len, uint32_t crc)
+	{
+		if (kernel == Kernel::Bytewise)
+		{
+			return UpdateCrc32Mpeg2Bytewise(crc, buf, len);
+		}
+
+		return UpdateCrc32Mpeg2(crc, buf, len);
+	}
+}  // namespace ov
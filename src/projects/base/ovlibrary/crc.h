@@ -1,57 +1,39 @@
 #pragma once
 
-// This code is referenced from https://rosettacode.org/wiki/CRC-32#C
-
-#include "base/common_types.h"
+#include <cstddef>
+#include <cstdint>
 
 namespace ov
 {
+	// The tables are built at compile time, so the functions are thread-safe.
+	// The buffer is processed 8 bytes at a time (slicing-by-8), and Crc32() uses PCLMULQDQ if the CPU supports it.
 	class CRC
 	{
 	public:
-		static uint32_t Crc32(uint32_t crc, const uint8_t *buf, size_t len)
+		enum class Kernel
 		{
-			static uint32_t table[256];
-			static int have_table = 0;
-			uint32_t rem;
-			uint8_t octet;
-			int i, j;
-			const uint8_t *p, *q;
-		
-			/* This check is not thread safe; there is no mutex. */
-			if (have_table == 0) 
-			{
-				/* Calculate CRC table. */
-				for (i = 0; i < 256; i++) 
-				{
-					rem = i;  /* remainder from polynomial division */
-					for (j = 0; j < 8; j++) 
-					{
-						if (rem & 1) 
-						{
-							rem >>= 1;
-							rem ^= 0x04C11DB7;
-						} 
-						else
-						{
-							rem >>= 1;
-						}
-					}
+			// Byte-wise table
+			Bytewise,
+			SlicingBy8,
+			// PCLMULQDQ folding for 64 bytes or more, slicing-by-8 for the rest (CRC-32 only)
+			Pclmul
+		};
+
+		// CRC-32 (IEEE 802.3, zlib, STUN FINGERPRINT): reflected, polynomial 0x04C11DB7, initial 0xFFFFFFFF, final XOR 0xFFFFFFFF
+		// crc: The result of the previous call to continue, or 0
+		static uint32_t Crc32(uint32_t crc, const uint8_t *buf, size_t len);
+
+		// CRC-32/MPEG-2 (MPEG-TS PSI): not reflected, polynomial 0x04C11DB7, initial 0xFFFFFFFF, no final XOR
+		// crc: The result of the previous call to continue, or 0xFFFFFFFF
+		static uint32_t Crc32Mpeg2(const uint8_t *buf, size_t len, uint32_t crc = 0xFFFFFFFF);
 
-					table[i] = rem;
-				}
-				have_table = 1;
-			}
-		
-			crc = ~crc;
-			q = buf + len;
-			for (p = buf; p < q; p++) 
-			{
-				octet = *p;  /* Cast to unsigned octet. */
-				crc = (crc >> 8) ^ table[(crc & 0xff) ^ octet];
-			}
+		// Name of the implementation which Crc32() uses (ex: "pclmul")
+		static const char *GetCrc32KernelName();
 
-			return ~crc;
-		}
+		// Same as above, with the given kernel (to verify and compare the kernels, see bench/crc)
+		// Returns false if the kernel is not supported by the CPU or by the CRC
+		static bool IsKernelSupported(Kernel kernel, bool is_mpeg2);
+		static uint32_t Crc32(Kernel kernel, uint32_t crc, const uint8_t *buf, size_t len);
+		static uint32_t Crc32Mpeg2(Kernel kernel, const uint8_t *buf, size_t len, uint32_t crc = 0xFFFFFFFF);
 	};
-}
\ No newline at end of file
+}
@@ -25,6 +25,12 @@ namespace ov
 		Reserve(capacity);
 	}
 
+	Data::Data(size_t capacity, bool use_pool)
+		: _use_pool(use_pool)
+	{
+		Reserve(capacity);
+	}
+
 	Data::Data(const void *data, size_t length, bool reference_only)
 	{
 		if (data == nullptr)
@@ -50,9 +56,10 @@ namespace ov
 	Data::Data(const Data &data)
 	{
 		_reference_data = data._reference_data;
+		_use_pool = data._use_pool;
 		if (data._allocated_data != nullptr)
 		{
-			_allocated_data = std::make_shared<std::vector<uint8_t>>();
+			_allocated_data = AllocateBuffer(data._length);
 			Append(&data);
 		}
 		_offset = data._offset;
@@ -65,6 +72,19 @@ namespace ov
 		std::swap(_allocated_data, data._allocated_data);
 		std::swap(_offset, data._offset);
 		std::swap(_length, data._length);
+		std::swap(_use_pool, data._use_pool);
+	}
+
+	std::shared_ptr<Data> Data::CreatePooled(const void *data, size_t length)
+	{
+		auto instance = std::make_shared<Data>(length, true);
+
+		if ((data != nullptr) && (length > 0))
+		{
+			instance->Append(data, length);
+		}
+
+		return instance;
 	}
 
 	std::shared_ptr<Data> Data::Clone() const
@@ -114,6 +134,7 @@ namespace ov
 
 		instance->_offset = new_offset;
 		instance->_length = length;
+		instance->_use_pool = _use_pool;
 
 		return instance;
 	}
@@ -156,6 +177,7 @@ namespace ov
 		_allocated_data = data._allocated_data;
 		_offset = data._offset;
 		_length = data._length;
+		_use_pool = data._use_pool;
 
 		return *this;
 	}
@@ -257,8 +279,8 @@ namespace ov
 		// Reset the offset
 		_offset = 0L;
 
-		_allocated_data = std::make_shared<std::vector<uint8_t>>(begin, end);
-		_allocated_data->reserve(old_data->capacity() - old_offset);
+		_allocated_data = AllocateBuffer(old_data->capacity() - old_offset);
+		_allocated_data->assign(begin, end);
 
 		return (_allocated_data != nullptr);
 	}
@@ -276,7 +298,7 @@ namespace ov
 		}
 		else
 		{
-			_allocated_data = std::make_shared<std::vector<uint8_t>>();
+			_allocated_data = AllocateBuffer(capacity);
 		}
 
 		_allocated_data->reserve(capacity);
@@ -284,11 +306,25 @@ namespace ov
 		return true;
 	}
 
+	std::shared_ptr<std::vector<uint8_t>> Data::AllocateBuffer(size_t capacity) const
+	{
+		if (_use_pool)
+		{
+			return MemoryPool::AllocateBuffer(capacity);
+		}
+
+		auto buffer = std::make_shared<std::vector<uint8_t>>();
+		buffer->reserve(capacity);
+
+		return buffer;
+	}
+
 	bool Data::Clear() noexcept
 	{
 		// Reallocate the buffer (this method is faster than Detach() & clear());
+		// The pooled buffer has the same capacity since the data is likely to be filled again as much as before
 		_reference_data = nullptr;
-		_allocated_data = std::make_shared<std::vector<uint8_t>>();
+		_allocated_data = _use_pool ? MemoryPool::AllocateBuffer(GetCapacity()) : std::make_shared<std::vector<uint8_t>>();
 		_offset = 0;
 		_length = 0;
 
@@ -11,6 +11,7 @@
 #include "./string.h"
 #include "./assert.h"
 #include "./memory_utilities.h"
+#include "./memory_pool.h"
 #include "./data.h"
 
 #include <memory>
@@ -30,6 +31,17 @@ namespace ov
 		/// @param capacity
 		explicit Data(size_t capacity);
 
+		/// Constructs a instance with the capacity (preallocated)
+		///
+		/// @param capacity
+		/// @param use_pool a flag to determine whether to take the memory from ov::MemoryPool or not
+		///
+		/// @remarks
+		/// If use_pool is true, the buffer (including the buffer which is allocated again by copy-on-write or Clear()) is taken from ov::MemoryPool,
+		/// and returned to it when it is released. Use this for the large data which is created/released per frame (ex: video frames),
+		/// the small buffers are allocated from the heap even if use_pool is true.
+		Data(size_t capacity, bool use_pool);
+
 		/// Constructs a instance from another data
 		///
 		/// @param data data to copy/reference
@@ -47,6 +59,14 @@ namespace ov
 		// Move constructor
 		Data(Data &&data) noexcept;
 
+		/// Create a new data which copies data, the memory of it is taken from ov::MemoryPool
+		///
+		/// @param data data to copy
+		/// @param length length of data
+		///
+		/// @return the data which has the pooled buffer
+		static std::shared_ptr<Data> CreatePooled(const void *data, size_t length);
+
 		/// Create a new data from this instance. The newly created data is managed by copy-on-write method
 		///
 		/// @return
@@ -148,6 +168,15 @@ namespace ov
 			return (_allocated_data != nullptr) ? _allocated_data->capacity() : 0;
 		}
 
+		/// Whether the memory is shared with other instances (ex: created by Clone()/Subdata()).
+		/// If true, the memory will be copied when the data is modified.
+		///
+		/// @return true if the memory is shared
+		inline bool IsBufferShared() const noexcept
+		{
+			return (_reference_data != nullptr) || ((_allocated_data != nullptr) && (_allocated_data.use_count() > 1));
+		}
+
 		/// 버퍼에 있는 데이터 모두 삭제
 		///
 		/// @return 성공적으로 삭제되었는지 여부
@@ -212,6 +241,9 @@ namespace ov
 		/// @return true on success, false on failure
 		bool Detach();
 
+		/// Allocate a new buffer for _allocated_data (from ov::MemoryPool if _use_pool is true)
+		std::shared_ptr<std::vector<uint8_t>> AllocateBuffer(size_t capacity) const;
+
 		const void *_reference_data = nullptr;
 
 		// Allocated data. If this data is subdata, _current_data and _data can be different.
@@ -226,6 +258,9 @@ namespace ov
 		// else
 		//     <length of _reference_data>
 		size_t _length = 0;
+
+		// Whether the buffer is taken from ov::MemoryPool
+		bool _use_pool = false;
 	};
 
 	template<typename T>
@@ -0,0 +1,216 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./epoch.h"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace ov
+{
+	namespace
+	{
+		// A slot is owned by one thread at a time, and is placed in its own cache line
+		struct alignas(64) ReaderSlot
+		{
+			// The global epoch when the thread entered the read-side section (0: not in the section)
+			std::atomic<uint64_t> epoch{0};
+			std::atomic<bool> in_use{false};
+
+			// Not changed after the slot is added to the list
+			ReaderSlot *next = nullptr;
+		};
+
+		struct RetiredItem
+		{
+			// The global epoch when the object was retired
+			uint64_t epoch;
+			std::function<void()> deleter;
+		};
+
+		struct RetiredList
+		{
+			std::mutex mutex;
+			std::vector<RetiredItem> item_list;
+		};
+
+		std::atomic<uint64_t> global_epoch{1};
+
+		// The slots are never deleted (a writer may be scanning them), and are reused by the new threads
+		std::atomic<ReaderSlot *> slot_list{nullptr};
+
+		// Never deleted, so the objects can be retired while the static objects are destroyed
+		RetiredList *GetRetiredList()
+		{
+			static auto retired_list = new RetiredList();
+
+			return retired_list;
+		}
+
+		ReaderSlot *AcquireSlot()
+		{
+			for (auto slot = slot_list.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+			{
+				bool expected = false;
+
+				if ((slot->in_use.load(std::memory_order_relaxed) == false) &&
+					slot->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+				{
+					return slot;
+				}
+			}
+
+			auto slot = new ReaderSlot();
+			slot->in_use = true;
+
+			auto head = slot_list.load(std::memory_order_relaxed);
+
+			do
+			{
+				slot->next = head;
+			} while (slot_list.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed) == false);
+
+			return slot;
+		}
+
+		struct ThreadContext
+		{
+			ReaderSlot *slot = nullptr;
+			int depth = 0;
+
+			~ThreadContext()
+			{
+				if (slot != nullptr)
+				{
+					slot->epoch.store(0, std::memory_order_release);
+					slot->in_use.store(false, std::memory_order_release);
+					slot = nullptr;
+				}
+			}
+		};
+
+		thread_local ThreadContext thread_context;
+	}  // namespace
+
+	void Epoch::Enter()
+	{
+		auto &context = thread_context;
+
+		if (context.depth++ > 0)
+		{
+			return;
+		}
+
+		if (context.slot == nullptr)
+		{
+			context.slot = AcquireSlot();
+		}
+
+		// seq_cst: Either the writer which retires an object sees this epoch (and keeps the object),
+		// or this reader loads the data published before the object was retired
+		context.slot->epoch.store(global_epoch.load(), std::memory_order_seq_cst);
+	}
+
+	void Epoch::Leave()
+	{
+		auto &context = thread_context;
+
+		if (--context.depth > 0)
+		{
+			return;
+		}
+
+		// release: The reads in the section happen before the object is deleted
+		context.slot->epoch.store(0, std::memory_order_release);
+	}
+
+	void Epoch::Retire(std::function<void()> deleter)
+	{
+		auto retired_list = GetRetiredList();
+
+		{
+			std::lock_guard<std::mutex> lock_guard(retired_list->mutex);
+
+			// The readers which entered with this epoch (or before) may still see the object
+			auto epoch = global_epoch.fetch_add(1);
+
+			retired_list->item_list.push_back({epoch, std::move(deleter)});
+		}
+
+		Reclaim();
+	}
+
+	size_t Epoch::Reclaim()
+	{
+		auto retired_list = GetRetiredList();
+		std::vector<RetiredItem> reclaimed_list;
+
+		{
+			// The slots are scanned while the lock is held, so every item in the list was retired before the scan
+			std::lock_guard<std::mutex> lock_guard(retired_list->mutex);
+
+			if (retired_list->item_list.empty())
+			{
+				return 0;
+			}
+
+			auto min_epoch = std::numeric_limits<uint64_t>::max();
+
+			for (auto slot = slot_list.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+			{
+				auto epoch = slot->epoch.load(std::memory_order_seq_cst);
+
+				if ((epoch != 0) && (epoch < min_epoch))
+				{
+					min_epoch = epoch;
+				}
+			}
+
+			auto &item_list = retired_list->item_list;
+			auto remaining = item_list.begin();
+
+			for (auto item = item_list.begin(); item != item_list.end(); ++item)
+			{
+				if (item->epoch < min_epoch)
+				{
+					reclaimed_list.push_back(std::move(*item));
+				}
+				else
+				{
+					if (remaining != item)
+					{
+						*remaining = std::move(*item);
+					}
+
+					++remaining;
+				}
+			}
+
+			item_list.erase(remaining, item_list.end());
+		}
+
+		// The deleters may retire other objects
+		for (auto &item : reclaimed_list)
+		{
+			item.deleter();
+		}
+
+		return reclaimed_list.size();
+	}
+
+	size_t Epoch::GetRetiredCount()
+	{
+		auto retired_list = GetRetiredList();
+		std::lock_guard<std::mutex> lock_guard(retired_list->mutex);
+
+		return retired_list->item_list.size();
+	}
+}  // namespace ov
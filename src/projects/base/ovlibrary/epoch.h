@@ -0,0 +1,75 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <functional>
+
+namespace ov
+{
+	// Epoch-based reclamation (a userspace RCU) for the read-mostly data which is replaced by the writers
+	//
+	// - A reader enters a read-side section (Epoch::ReadGuard), loads the pointer of the current data and uses it
+	//   until it leaves the section. Entering/leaving only stores the global epoch into a slot owned by the calling thread,
+	//   so the readers never take a lock, and never write a cache line shared with other threads
+	// - A writer publishes the new data (with a seq_cst store/exchange), and passes the old data to Retire().
+	//   The old data is deleted when all the readers which could see it have left their sections.
+	//   (It is deleted by the next Retire()/Reclaim() if a reader is still using it)
+	//
+	// Usage:
+	//   [Reader]                                  [Writer]
+	//   {                                         auto old_data = data.exchange(new_data);
+	//       ov::Epoch::ReadGuard guard;           ov::Epoch::Retire(old_data);
+	//       auto current = data.load();
+	//       (use current)
+	//   }
+	class Epoch
+	{
+	public:
+		class ReadGuard
+		{
+		public:
+			ReadGuard()
+			{
+				Epoch::Enter();
+			}
+
+			~ReadGuard()
+			{
+				Epoch::Leave();
+			}
+
+			ReadGuard(const ReadGuard &) = delete;
+			ReadGuard &operator=(const ReadGuard &) = delete;
+		};
+
+		// Read-side sections can be nested
+		static void Enter();
+		static void Leave();
+
+		// Deletes the object when no reader can see it
+		template <typename T>
+		static void Retire(const T *object)
+		{
+			if (object != nullptr)
+			{
+				Retire(std::function<void()>([object]() {
+					delete object;
+				}));
+			}
+		}
+
+		static void Retire(std::function<void()> deleter);
+
+		// Calls the deleters of the retired objects which no reader can see, and returns the number of them
+		static size_t Reclaim();
+
+		// Number of the retired objects which are not deleted yet
+		static size_t GetRetiredCount();
+	};
+}  // namespace ov
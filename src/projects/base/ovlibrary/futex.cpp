@@ -0,0 +1,127 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./futex.h"
+
+#if IS_LINUX
+#	include <linux/futex.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+
+#	include <cerrno>
+#	include <climits>
+#	include <ctime>
+#endif	// IS_LINUX
+
+#include <chrono>
+
+namespace ov
+{
+#if IS_LINUX
+	static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "std::atomic<uint32_t> cannot be used as a futex word");
+
+	static inline uint32_t *GetFutexWord(std::atomic<uint32_t> *value)
+	{
+		return reinterpret_cast<uint32_t *>(value);
+	}
+#endif	// IS_LINUX
+
+	void Futex::Signal()
+	{
+		Signal(true);
+	}
+
+	void Futex::SignalOne()
+	{
+		Signal(false);
+	}
+
+	void Futex::Signal(bool wake_all)
+	{
+		_value.fetch_add(1, std::memory_order_release);
+
+#if IS_LINUX
+		::syscall(SYS_futex, GetFutexWord(&_value), FUTEX_WAKE_PRIVATE, wake_all ? INT_MAX : 1, nullptr, nullptr, 0);
+#else	// IS_LINUX
+		{
+			// Prevents the waiter from missing the notification between the check and the wait
+			std::lock_guard<std::mutex> lock_guard(_mutex);
+		}
+
+		if (wake_all)
+		{
+			_condition.notify_all();
+		}
+		else
+		{
+			_condition.notify_one();
+		}
+#endif	// IS_LINUX
+	}
+
+	bool Futex::Wait(uint32_t expected, int timeout)
+	{
+#if IS_LINUX
+		struct timespec timeout_spec;
+		struct timespec *timeout_ptr = nullptr;
+
+		if (timeout != Infinite)
+		{
+			timeout_spec.tv_sec = timeout / 1000;
+			timeout_spec.tv_nsec = (timeout % 1000) * 1000000L;
+			timeout_ptr = &timeout_spec;
+		}
+
+		while (true)
+		{
+			auto result = ::syscall(SYS_futex, GetFutexWord(&_value), FUTEX_WAIT_PRIVATE, expected, timeout_ptr, nullptr, 0);
+
+			if (result == 0)
+			{
+				// Woken up (It may be a spurious wakeup, the caller must check the condition again)
+				return true;
+			}
+
+			switch (errno)
+			{
+				case EAGAIN:
+					// The value has been already changed
+					return true;
+
+				case ETIMEDOUT:
+					return false;
+
+				case EINTR:
+					if (timeout_ptr != nullptr)
+					{
+						// The remaining time is not tracked, let the caller check the condition again
+						return true;
+					}
+					break;
+
+				default:
+					return true;
+			}
+		}
+#else	// IS_LINUX
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		auto predicate = [this, expected]() -> bool {
+			return _value.load(std::memory_order_acquire) != expected;
+		};
+
+		if (timeout == Infinite)
+		{
+			_condition.wait(lock, predicate);
+			return true;
+		}
+
+		return _condition.wait_for(lock, std::chrono::milliseconds(timeout), predicate);
+#endif	// IS_LINUX
+	}
+}  // namespace ov
@@ -0,0 +1,55 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "./ovdata_structure.h"
+#include "./platform.h"
+
+namespace ov
+{
+	// A 32-bit counter which threads can sleep on until it is changed by Signal()
+	// (futex(2) on Linux, std::condition_variable on other platforms)
+	//
+	// Usage:
+	//   [Waiter]                                  [Signaller]
+	//   auto value = futex.GetValue();
+	//   if (condition is not met)                 (make the condition met)
+	//       futex.Wait(value);                    futex.Signal();
+	class Futex
+	{
+	public:
+		uint32_t GetValue() const
+		{
+			return _value.load(std::memory_order_acquire);
+		}
+
+		// Increases the value and wakes up all waiting threads
+		void Signal();
+		// Increases the value and wakes up one of the waiting threads
+		void SignalOne();
+
+		// Sleeps while the value is equal to expected
+		// Timeout in milliseconds, returns false if timed out
+		bool Wait(uint32_t expected, int timeout = Infinite);
+
+	protected:
+		void Signal(bool wake_all);
+
+		std::atomic<uint32_t> _value{0};
+
+#if !IS_LINUX
+		std::mutex _mutex;
+		std::condition_variable _condition;
+#endif	// !IS_LINUX
+	};
+}  // namespace ov
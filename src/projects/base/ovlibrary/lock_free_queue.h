@@ -0,0 +1,476 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+
+#include "./dump_utilities.h"
+#include "./futex.h"
+#include "./log.h"
+#include "./ovdata_structure.h"
+#include "./string.h"
+
+// Default number of slots in the ring (must be a power of two)
+#define OV_LOCK_FREE_QUEUE_DEFAULT_CAPACITY 1024
+
+#define OV_LOCK_FREE_QUEUE_CACHE_LINE_SIZE 64
+
+namespace ov
+{
+	// A bounded lock-free ring queue which has the same interface as ov::Queue
+	//
+	// - Only one thread can call Dequeue()/Clear() at the same time (single consumer)
+	// - If multi_producer is false, only one thread can call Enqueue() at the same time
+	// - The consumer is woken up only when the queue becomes non-empty while it is sleeping,
+	//   so a producer does not make a syscall for every item
+	// - When the ring is full, the items are kept in an overflow list (protected by a mutex) and
+	//   are not lost. The order of the items enqueued by the same producer is preserved.
+	template <typename T, bool multi_producer>
+	class LockFreeQueue
+	{
+	public:
+		LockFreeQueue()
+			: LockFreeQueue(nullptr)
+		{
+		}
+
+		LockFreeQueue(const char *alias, size_t threshold = 0, int log_interval_in_msec = 5000, size_t capacity = OV_LOCK_FREE_QUEUE_DEFAULT_CAPACITY)
+			: _threshold(threshold),
+			  _log_interval(log_interval_in_msec)
+		{
+			_capacity = 2;
+			while (_capacity < capacity)
+			{
+				_capacity <<= 1;
+			}
+			_mask = _capacity - 1;
+
+			_slots = std::make_unique<Slot[]>(_capacity);
+			for (size_t index = 0; index < _capacity; index++)
+			{
+				_slots[index].sequence.store(index, std::memory_order_relaxed);
+			}
+
+			SetAlias(alias);
+
+			auto shared_lock = std::shared_lock(_name_mutex);
+			logd("ov.Queue", "[%p] %s is created with threshold: %zu, interval: %d, capacity: %zu", this, _queue_name.CStr(), threshold, log_interval_in_msec, _capacity);
+		}
+
+		~LockFreeQueue()
+		{
+			auto shared_lock = std::shared_lock(_name_mutex);
+			logd("ov.Queue", "[%p] %s is destroyed", this, _queue_name.CStr());
+		}
+
+		String GetAlias() const
+		{
+			auto shared_lock = std::shared_lock(_name_mutex);
+			return _queue_name;
+		}
+
+		void SetAlias(const char *alias)
+		{
+			auto lock_guard = std::lock_guard(_name_mutex);
+
+			if ((alias != nullptr) && (alias[0] != '\0'))
+			{
+				_queue_name = alias;
+			}
+			else
+			{
+				_queue_name.Format("%s<%s>", multi_producer ? "MpscQueue" : "SpscQueue", Demangle(typeid(T).name()).CStr());
+			}
+
+			logd("ov.Queue", "[%p] The alias is changed to %s", this, _queue_name.CStr());
+		}
+
+		void SetThreshold(size_t threshold)
+		{
+			_threshold = threshold;
+			logd("ov.Queue", "[%p] The threshold is changed to %zu", this, threshold);
+		}
+
+		size_t GetCapacity() const
+		{
+			return _capacity;
+		}
+
+		// Returns true if the queue was empty before the item is enqueued
+		bool Enqueue(const T &item)
+		{
+			T copied_item = item;
+			return Enqueue(std::move(copied_item));
+		}
+
+		// Returns true if the queue was empty before the item is enqueued
+		bool Enqueue(T &&item)
+		{
+			// Increase the size first so that the consumer never sees an item which is not counted
+			// (seq_cst: pairs with the consumer which sets _waiting and then checks _size)
+			auto previous_size = _size.fetch_add(1);
+
+			// If there are items in the overflow list, new items must follow them to keep the order
+			if ((_overflow_count.load(std::memory_order_acquire) > 0) || (Push(item) == false))
+			{
+				PushToOverflowList(std::move(item));
+			}
+
+			CheckThreshold(previous_size + 1);
+
+			if (previous_size == 0)
+			{
+				if (_waiting.load())
+				{
+					_futex.Signal();
+				}
+
+				return true;
+			}
+
+			return false;
+		}
+
+		// Enqueues the item only if there is a free slot in the ring (the item is not moved if it fails)
+		// Returns false if the ring is full
+		bool TryEnqueue(T &&item)
+		{
+			if (_overflow_count.load(std::memory_order_acquire) > 0)
+			{
+				return false;
+			}
+
+			auto previous_size = _size.fetch_add(1);
+
+			if (Push(item) == false)
+			{
+				_size.fetch_sub(1);
+				return false;
+			}
+
+			CheckThreshold(previous_size + 1);
+
+			if ((previous_size == 0) && _waiting.load())
+			{
+				_futex.Signal();
+			}
+
+			return true;
+		}
+
+		// Timeout in milliseconds
+		std::optional<T> Dequeue(int timeout = Infinite)
+		{
+			// The clock is read only when the queue is empty
+			uint64_t expire = 0ULL;
+
+			while (_stop.load(std::memory_order_acquire) == false)
+			{
+				auto item = TryDequeue();
+
+				if (item.has_value())
+				{
+					return item;
+				}
+
+				if ((timeout != Infinite) && (expire == 0ULL))
+				{
+					expire = GetNowMSec() + timeout;
+				}
+
+				if (_size.load(std::memory_order_acquire) > 0)
+				{
+					// A producer has counted the item but has not finished writing it yet
+					std::this_thread::yield();
+					continue;
+				}
+
+				int wait_timeout = Infinite;
+
+				if (timeout != Infinite)
+				{
+					auto now = GetNowMSec();
+
+					if (now >= expire)
+					{
+						// timed out
+						break;
+					}
+
+					wait_timeout = static_cast<int>(expire - now);
+				}
+
+				auto futex_value = _futex.GetValue();
+
+				_waiting.store(true);
+
+				if ((_size.load() == 0) && (_stop.load() == false))
+				{
+					_futex.Wait(futex_value, wait_timeout);
+				}
+
+				_waiting.store(false);
+			}
+
+			return {};
+		}
+
+		// Dequeues an item without waiting (consumer only)
+		std::optional<T> TryDequeue()
+		{
+			std::optional<T> item;
+
+			if (_overflow_pending_list.empty() == false)
+			{
+				// The items in the overflow list were enqueued before the items in the ring
+				item = std::move(_overflow_pending_list.front());
+				_overflow_pending_list.pop_front();
+			}
+			else if (Pop(item) == false)
+			{
+				if (_overflow_count.load(std::memory_order_acquire) == 0)
+				{
+					return {};
+				}
+
+				// Pop() also fails when a producer has claimed the head slot but has not finished writing it.
+				// That producer may have pushed its next item to the overflow list, so the overflow list
+				// can be consumed only after all claimed slots are consumed.
+				// (The claim of the slot is visible here, because the producer pushes to the overflow list after it)
+				if (_tail.load(std::memory_order_acquire) != _head)
+				{
+					return {};
+				}
+
+				{
+					auto lock_guard = std::lock_guard(_overflow_mutex);
+
+					_overflow_pending_list.swap(_overflow_list);
+					_overflow_count.store(0, std::memory_order_release);
+				}
+
+				if (_overflow_pending_list.empty())
+				{
+					return {};
+				}
+
+				item = std::move(_overflow_pending_list.front());
+				_overflow_pending_list.pop_front();
+			}
+
+			_size.fetch_sub(1);
+
+			return item;
+		}
+
+		bool IsEmpty() const
+		{
+			return (Size() == 0);
+		}
+
+		// Removes all items (consumer only - call it after the consumer thread is finished)
+		void Clear()
+		{
+			while (TryDequeue().has_value())
+			{
+			}
+		}
+
+		size_t Size() const
+		{
+			return _size.load(std::memory_order_acquire);
+		}
+
+		bool IsStopped() const
+		{
+			return _stop.load(std::memory_order_acquire);
+		}
+
+		void Stop()
+		{
+			_stop.store(true);
+			_futex.Signal();
+		}
+
+	protected:
+		struct Slot
+		{
+			std::atomic<size_t> sequence{0};
+			std::optional<T> item;
+		};
+
+		// Writes the item into the ring (the item is moved only if it succeeds)
+		bool Push(T &item)
+		{
+			Slot *slot = nullptr;
+			size_t position = _tail.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				slot = &(_slots[position & _mask]);
+
+				auto sequence = slot->sequence.load(std::memory_order_acquire);
+				auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+				if (difference == 0)
+				{
+					if constexpr (multi_producer)
+					{
+						if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						{
+							break;
+						}
+
+						// position is updated by compare_exchange_weak()
+					}
+					else
+					{
+						_tail.store(position + 1, std::memory_order_relaxed);
+						break;
+					}
+				}
+				else if (difference < 0)
+				{
+					// The ring is full
+					return false;
+				}
+				else
+				{
+					// Another producer took the slot
+					position = _tail.load(std::memory_order_relaxed);
+				}
+			}
+
+			slot->item = std::move(item);
+			slot->sequence.store(position + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		bool Pop(std::optional<T> &item)
+		{
+			auto &slot = _slots[_head & _mask];
+			auto sequence = slot.sequence.load(std::memory_order_acquire);
+
+			if (sequence != (_head + 1))
+			{
+				// The ring is empty, or the producer has not finished writing yet
+				return false;
+			}
+
+			item = std::move(slot.item);
+			slot.item.reset();
+			slot.sequence.store(_head + _capacity, std::memory_order_release);
+
+			_head++;
+
+			return true;
+		}
+
+		void PushToOverflowList(T &&item)
+		{
+			size_t overflow_count;
+
+			{
+				auto lock_guard = std::lock_guard(_overflow_mutex);
+
+				_overflow_list.push_back(std::move(item));
+				overflow_count = _overflow_list.size();
+				_overflow_count.store(overflow_count, std::memory_order_release);
+			}
+
+			// The clock is not read for every item that overflows
+			if (((overflow_count & _mask) == 1) && IsLogRequired(_last_overflow_log_time))
+			{
+				auto shared_lock = std::shared_lock(_name_mutex);
+				// Small rings overflow on bursts by design, the threshold warning reports a real backlog
+				logd("ov.Queue", "[%p] %s ring is full, the items are kept in the overflow list: capacity: %zu, overflow: %zu", this, _queue_name.CStr(), _capacity, overflow_count);
+			}
+		}
+
+		inline void CheckThreshold(size_t size)
+		{
+			auto peak = _peak.load(std::memory_order_relaxed);
+			while ((peak < size) && (_peak.compare_exchange_weak(peak, size, std::memory_order_relaxed) == false))
+			{
+			}
+
+			auto threshold = _threshold.load(std::memory_order_relaxed);
+
+			if ((threshold > 0) && (size >= threshold) && IsLogRequired(_last_log_time))
+			{
+				auto shared_lock = std::shared_lock(_name_mutex);
+				logw("ov.Queue", "[%p] %s size has exceeded the threshold: queue: %zu, threshold: %zu, peak: %zu", this, _queue_name.CStr(), size, threshold, _peak.load(std::memory_order_relaxed));
+			}
+		}
+
+		static inline uint64_t GetNowMSec()
+		{
+			return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		// Only one of the threads which call this at the same time gets true
+		inline bool IsLogRequired(std::atomic<uint64_t> &last_log_time)
+		{
+			auto now = GetNowMSec();
+			auto last = last_log_time.load(std::memory_order_relaxed);
+
+			return ((now - last) >= static_cast<uint64_t>(_log_interval)) &&
+				   last_log_time.compare_exchange_strong(last, now, std::memory_order_relaxed);
+		}
+
+	private:
+		// Ring
+		std::unique_ptr<Slot[]> _slots;
+		size_t _capacity = 0;
+		size_t _mask = 0;
+
+		// Written by the producers
+		alignas(OV_LOCK_FREE_QUEUE_CACHE_LINE_SIZE) std::atomic<size_t> _tail{0};
+		// Written by the consumer
+		alignas(OV_LOCK_FREE_QUEUE_CACHE_LINE_SIZE) size_t _head = 0;
+		// Items which are moved from _overflow_list (accessed by the consumer only)
+		std::deque<T> _overflow_pending_list;
+
+		alignas(OV_LOCK_FREE_QUEUE_CACHE_LINE_SIZE) std::atomic<size_t> _size{0};
+		std::atomic<bool> _waiting{false};
+		std::atomic<bool> _stop{false};
+		Futex _futex;
+
+		// Overflow
+		std::mutex _overflow_mutex;
+		std::deque<T> _overflow_list;
+		std::atomic<size_t> _overflow_count{0};
+
+		// Logging
+		mutable std::shared_mutex _name_mutex;
+		String _queue_name;
+
+		std::atomic<size_t> _threshold{0};
+		std::atomic<size_t> _peak{0};
+		int _log_interval = 0;
+		std::atomic<uint64_t> _last_log_time{0};
+		std::atomic<uint64_t> _last_overflow_log_time{0};
+	};
+
+	// Single producer, single consumer
+	template <typename T>
+	using SpscQueue = LockFreeQueue<T, false>;
+
+	// Multiple producers, single consumer
+	template <typename T>
+	using MpscQueue = LockFreeQueue<T, true>;
+}  // namespace ov
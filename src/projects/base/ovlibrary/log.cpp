@@ -55,6 +55,11 @@ void ov_log_set_path(const char *log_path)
     g_log_internal.SetLogPath(log_path);
 }
 
+void ov_log_flush()
+{
+	g_log_internal.Flush();
+}
+
 void ov_stat_log_internal(StatLogType type, OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, ...)
 {
 	va_list arg_list;
@@ -125,6 +125,8 @@ bool ov_log_get_enabled(const char *tag, OVLogLevel level);
 
 void ov_log_internal(OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, ...);
 void ov_log_set_path(const char *log_path);
+// Writes the queued logs in the calling thread (ex: before the process is terminated by a signal)
+void ov_log_flush();
 
 void ov_stat_log_internal(StatLogType type, OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, ...);
 void ov_stat_log_set_path(StatLogType type, const char *log_path);
@@ -0,0 +1,320 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./log_async_writer.h"
+
+#include <pthread.h>
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <thread>
+
+#include "./log_write.h"
+
+// Number of logs that can be queued (the logs are dropped if the queue is full)
+#define OV_LOG_QUEUE_CAPACITY 16384
+// Number of slots of the queue which only the error/critical logs can use
+#define OV_LOG_QUEUE_PRIORITY_RESERVE 1024
+// The writer thread wakes up at this interval even if there is no log
+#define OV_LOG_WRITER_IDLE_TIMEOUT 500
+// Maximum time to wait for a producer which has counted a log but has not finished writing it
+// (the producer may not exist in the child process after fork())
+#define OV_LOG_DRAIN_WAIT_TIMEOUT 100
+
+namespace ov
+{
+	// Prevents the logs from being written after the instance is destroyed (static destruction order)
+	static std::atomic<bool> writer_released{false};
+
+	AsyncLogWriter *AsyncLogWriter::GetInstance()
+	{
+		if (writer_released.load(std::memory_order_acquire))
+		{
+			return nullptr;
+		}
+
+		static AsyncLogWriter instance;
+
+		return &instance;
+	}
+
+	AsyncLogWriter::AsyncLogWriter()
+	{
+		::pthread_atfork(PrepareFork, ParentAfterFork, ChildAfterFork);
+	}
+
+	AsyncLogWriter::~AsyncLogWriter()
+	{
+		writer_released = true;
+
+		_stop = true;
+		_futex.Signal();
+
+		while (_thread_running.load())
+		{
+			auto value = _thread_exit_futex.GetValue();
+
+			if (_thread_running.load() == false)
+			{
+				break;
+			}
+
+			_thread_exit_futex.Wait(value, 100);
+		}
+
+		Flush();
+
+		delete _queue.exchange(nullptr);
+	}
+
+	// Holds the locks during fork() so the child process doesn't inherit the locked mutexes
+	void AsyncLogWriter::PrepareFork()
+	{
+		auto writer = GetInstance();
+
+		if (writer != nullptr)
+		{
+			writer->_drain_mutex.lock();
+		}
+	}
+
+	void AsyncLogWriter::ParentAfterFork()
+	{
+		auto writer = GetInstance();
+
+		if (writer != nullptr)
+		{
+			writer->_drain_mutex.unlock();
+		}
+	}
+
+	void AsyncLogWriter::ChildAfterFork()
+	{
+		auto writer = GetInstance();
+
+		if (writer != nullptr)
+		{
+			writer->_drain_mutex.unlock();
+
+			// The writer thread doesn't exist in the child process, it will be started again by the next Write()
+			writer->_thread_running = false;
+			writer->_thread_started = false;
+		}
+	}
+
+	bool AsyncLogWriter::StartThread()
+	{
+		if (_thread_started.exchange(true))
+		{
+			return true;
+		}
+
+		try
+		{
+			_thread_running = true;
+
+			std::thread thread(&AsyncLogWriter::WriterThread, this);
+			::pthread_setname_np(thread.native_handle(), "LogWriter");
+			thread.detach();
+		}
+		catch (const std::system_error &e)
+		{
+			_thread_running = false;
+			_thread_started = false;
+
+			return false;
+		}
+
+		return true;
+	}
+
+	bool AsyncLogWriter::Write(Entry &&entry, bool is_priority)
+	{
+		if (_stop.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		std::call_once(_queue_once, [this]() {
+			_queue = new MpscQueue<Entry>("Log queue", 0, 5000, OV_LOG_QUEUE_CAPACITY);
+		});
+
+		if (StartThread() == false)
+		{
+			return false;
+		}
+
+		auto queue = _queue.load(std::memory_order_acquire);
+
+		// The other logs leave the reserved room for the error/critical logs
+		// (Size() may be slightly stale, so the reserve is approximate, but the capacity is not)
+		bool has_room = is_priority || (queue->Size() < (OV_LOG_QUEUE_CAPACITY - OV_LOG_QUEUE_PRIORITY_RESERVE));
+
+		if ((has_room == false) || (queue->TryEnqueue(std::move(entry)) == false))
+		{
+			// Never block the calling thread, drop the log instead
+			_dropped_count.fetch_add(1, std::memory_order_relaxed);
+
+			if (is_priority)
+			{
+				_dropped_priority_count.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			_dropped_log_file = entry.log_file;
+
+			// Treat as written
+			return true;
+		}
+
+		// seq_cst: pairs with the writer thread which sets _waiting and then checks _pending_count
+		if ((_pending_count.fetch_add(1) == 0) && _waiting.load())
+		{
+			_futex.Signal();
+		}
+
+		return true;
+	}
+
+	void AsyncLogWriter::Flush()
+	{
+		std::lock_guard<std::mutex> lock_guard(_drain_mutex);
+
+		DrainQueue(true);
+	}
+
+	void AsyncLogWriter::WriteEntry(const Entry &entry)
+	{
+		if (entry.color_prefix != nullptr)
+		{
+			auto output = entry.use_stderr ? stderr : stdout;
+
+			::fprintf(output, "%s%s%s\n", entry.color_prefix, entry.message.CStr(), (entry.color_suffix != nullptr) ? entry.color_suffix : "");
+			::fflush(output);
+		}
+
+		if (entry.log_file != nullptr)
+		{
+			entry.log_file->Write(entry.message.CStr());
+		}
+	}
+
+	size_t AsyncLogWriter::DrainQueue(bool wait_for_queued)
+	{
+		auto queue = _queue.load(std::memory_order_acquire);
+
+		if (queue == nullptr)
+		{
+			return 0;
+		}
+
+		// The logs are dequeued in the order of the slots claimed by the producers,
+		// so the logs queued before this call are within the first `remaining_count` logs
+		size_t remaining_count = queue->Size();
+		size_t count = 0;
+		std::chrono::steady_clock::time_point wait_start;
+		bool is_waiting = false;
+
+		while (remaining_count > 0)
+		{
+			auto entry = queue->TryDequeue();
+
+			if (entry.has_value() == false)
+			{
+				if ((wait_for_queued == false) || queue->IsEmpty())
+				{
+					break;
+				}
+
+				// A producer has counted the log but has not finished writing it yet
+				auto now = std::chrono::steady_clock::now();
+
+				if (is_waiting == false)
+				{
+					wait_start = now;
+					is_waiting = true;
+				}
+				else if ((now - wait_start) >= std::chrono::milliseconds(OV_LOG_DRAIN_WAIT_TIMEOUT))
+				{
+					break;
+				}
+
+				std::this_thread::yield();
+				continue;
+			}
+
+			is_waiting = false;
+
+			WriteEntry(entry.value());
+
+			_pending_count.fetch_sub(1);
+			remaining_count--;
+			count++;
+		}
+
+		ReportDroppedCount();
+
+		return count;
+	}
+
+	void AsyncLogWriter::ReportDroppedCount()
+	{
+		auto dropped_count = _dropped_count.load(std::memory_order_relaxed);
+		auto dropped_priority_count = _dropped_priority_count.load(std::memory_order_relaxed);
+
+		if (dropped_count == _reported_dropped_count)
+		{
+			return;
+		}
+
+		Entry entry;
+
+		entry.log_file = _dropped_log_file.load();
+		entry.color_prefix = "";
+		entry.use_stderr = true;
+		entry.message.Format("[LogWriter] %" PRIu64 " logs (error/critical: %" PRIu64 ") were dropped because the log queue was full (total: %" PRIu64 ")",
+							 dropped_count - _reported_dropped_count, dropped_priority_count - _reported_dropped_priority_count, dropped_count);
+
+		WriteEntry(entry);
+
+		_reported_dropped_count = dropped_count;
+		_reported_dropped_priority_count = dropped_priority_count;
+	}
+
+	void AsyncLogWriter::WriterThread()
+	{
+		while (_stop.load() == false)
+		{
+			size_t count;
+
+			{
+				std::lock_guard<std::mutex> lock_guard(_drain_mutex);
+				count = DrainQueue(false);
+			}
+
+			if (count > 0)
+			{
+				continue;
+			}
+
+			auto futex_value = _futex.GetValue();
+
+			_waiting = true;
+
+			if ((_pending_count.load() == 0) && (_stop.load() == false))
+			{
+				_futex.Wait(futex_value, OV_LOG_WRITER_IDLE_TIMEOUT);
+			}
+
+			_waiting = false;
+		}
+
+		_thread_running = false;
+		_thread_exit_futex.Signal();
+	}
+}  // namespace ov
@@ -0,0 +1,112 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "./futex.h"
+#include "./lock_free_queue.h"
+#include "./string.h"
+
+namespace ov
+{
+	class LogWrite;
+
+	// Writes the logs to the console/files in a background thread, so the threads which write logs are never blocked by I/O.
+	//
+	// - All threads queue the logs into one lock-free MPSC queue, so the logs are written in the order they are queued
+	// - A part of the queue is reserved for the error/critical logs, so a flood of other logs cannot take all the room
+	// - If there is no room, the log is dropped and counted (GetDroppedCount()). The calling thread never waits.
+	class AsyncLogWriter
+	{
+	public:
+		struct Entry
+		{
+			// nullptr if the log is not written to a file
+			LogWrite *log_file = nullptr;
+
+			// nullptr if the log is not written to the console
+			const char *color_prefix = nullptr;
+			const char *color_suffix = nullptr;
+			bool use_stderr = false;
+
+			String message;
+		};
+
+		// Returns nullptr if the writer is already released (while the process is terminating)
+		static AsyncLogWriter *GetInstance();
+
+		~AsyncLogWriter();
+
+		// Returns false if the log is not queued (the caller must write it by itself using WriteEntry())
+		//
+		// If is_priority is true, the log can use the room reserved for the error/critical logs.
+		// If there is no room, the log is dropped (and true is returned).
+		bool Write(Entry &&entry, bool is_priority);
+
+		// Writes the logs queued before this call in the calling thread
+		void Flush();
+
+		uint64_t GetDroppedCount() const
+		{
+			return _dropped_count.load(std::memory_order_relaxed);
+		}
+
+		// Number of the error/critical logs dropped (included in GetDroppedCount())
+		uint64_t GetDroppedPriorityCount() const
+		{
+			return _dropped_priority_count.load(std::memory_order_relaxed);
+		}
+
+		static void WriteEntry(const Entry &entry);
+
+	protected:
+		AsyncLogWriter();
+
+		bool StartThread();
+		void WriterThread();
+
+		// Must be called while _drain_mutex is held
+		//
+		// If wait_for_queued is true, waits for the producers which have counted their logs but have not finished writing them,
+		// so that all the logs queued before this call are written
+		size_t DrainQueue(bool wait_for_queued);
+		void ReportDroppedCount();
+
+		static void PrepareFork();
+		static void ParentAfterFork();
+		static void ChildAfterFork();
+
+	private:
+		// Created by the first Write() (not in the constructor, because the queue writes logs while it is created)
+		std::once_flag _queue_once;
+		std::atomic<MpscQueue<Entry> *> _queue{nullptr};
+
+		// Held by the thread which consumes the queue (the writer thread or Flush())
+		std::mutex _drain_mutex;
+
+		std::atomic<bool> _thread_started{false};
+		std::atomic<bool> _thread_running{false};
+		std::atomic<bool> _stop{false};
+
+		std::atomic<size_t> _pending_count{0};
+		std::atomic<bool> _waiting{false};
+		Futex _futex;
+		// Used to wait for the writer thread to finish (the thread is detached)
+		Futex _thread_exit_futex;
+
+		std::atomic<uint64_t> _dropped_count{0};
+		std::atomic<uint64_t> _dropped_priority_count{0};
+		uint64_t _reported_dropped_count = 0;
+		uint64_t _reported_dropped_priority_count = 0;
+		std::atomic<LogWrite *> _dropped_log_file{nullptr};
+	};
+}  // namespace ov
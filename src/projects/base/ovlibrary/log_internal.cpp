@@ -9,7 +9,9 @@
 #include "log_internal.h"
 
 #include <thread>
+#include <unordered_map>
 
+#include "log_async_writer.h"
 #include "platform.h"
 
 #define OV_LOG_COLOR_RESET "\x1B[0m"
@@ -52,17 +54,65 @@
 
 namespace ov
 {
+	// Result of IsEnabled() cached by each thread
+	struct LogTagCache
+	{
+		struct Item
+		{
+			// Most tags are string literals, but a tag can also be a temporary string,
+			// so the pointer is only used to find the item, and the tag is compared to confirm it
+			std::string tag;
+			OVLogLevel level;
+			bool is_enabled;
+		};
+
+		uint64_t generation = 0;
+
+		// key: pointer of the tag (a lookup does not allocate a string)
+		std::unordered_map<const char *, Item> map;
+	};
+
+	// key: LogInternal instance
+	static thread_local std::unordered_map<const LogInternal *, LogTagCache> log_tag_cache;
+
+	// The date/time part of the log is formatted only once per second
+	struct LogTimeCache
+	{
+		std::time_t time = -1;
+		// "[yyyy-mm-dd hh:mm:ss" (DEBUG: "[mm-dd hh:mm:ss")
+		char prefix[32]{};
+	};
+
+	static thread_local LogTimeCache log_time_cache;
+
+	// true while the calling thread is queueing a log to the writer (the logs written at this time are written synchronously)
+	static thread_local bool log_writer_entered = false;
+
 	LogInternal::LogInternal(std::string log_file_name) noexcept
 		: _level(OVLogLevelDebug),
-		  _log_file(log_file_name)
+		  _log_file(log_file_name),
+		  _enable_generation(1)
 	{
 	}
 
 	LogInternal::~LogInternal()
 	{
+		// Write the queued logs before _log_file is released
+		Flush();
+
 		_released = true;
 	}
 
+	void LogInternal::Flush()
+	{
+		auto writer = AsyncLogWriter::GetInstance();
+
+		if (writer != nullptr)
+		{
+			writer->Flush();
+		}
+	}
+
 	void LogInternal::SetLogLevel(OVLogLevel level)
 	{
 		_level = level;
@@ -79,6 +129,8 @@ namespace ov
 
 		_enable_map.clear();
 		_enable_list.clear();
+
+		_enable_generation++;
 	}
 
 	bool LogInternal::IsEnabled(const char *tag, OVLogLevel level)
@@ -88,8 +140,48 @@ namespace ov
 			return false;
 		}
 
-		std::lock_guard<std::mutex> lock(_mutex);
+		auto &cache = log_tag_cache[this];
+		auto generation = _enable_generation.load(std::memory_order_acquire);
 
+		if (cache.generation != generation)
+		{
+			// SetEnable() or ResetEnable() is called
+			cache.map.clear();
+			cache.generation = generation;
+		}
+
+		auto cached_item = cache.map.find(tag);
+
+		if ((cached_item == cache.map.end()) || (cached_item->second.tag != tag))
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			auto item = FindEnableItem(tag);
+
+			if (item == nullptr)
+			{
+				return false;
+			}
+
+			cached_item = cache.map.insert_or_assign(tag, LogTagCache::Item{tag, item->level, item->is_enabled}).first;
+		}
+
+		auto tag_level = cached_item->second.level;
+		auto is_enabled = cached_item->second.is_enabled;
+
+		if (level >= tag_level)
+		{
+			// Returns whether the log level for the tag is activated
+			return is_enabled;
+		}
+
+		// Levels below level behave as opposed to being activated
+		return (is_enabled == false);
+	}
+
+	// Must be called while _mutex is held
+	const LogInternal::EnableItem *LogInternal::FindEnableItem(const char *tag)
+	{
 		auto item = _enable_map.find(tag);
 
 		if (item == _enable_map.cend())
@@ -122,18 +214,11 @@ namespace ov
 			{
 				// Item must be added
 				OV_ASSERT2(false);
-				return false;
+				return nullptr;
 			}
 		}
 
-		if (level >= item->second.level)
-		{
-			// Returns whether the log level for the tag is activated
-			return item->second.is_enabled;
-		}
-
-		// Levels below level behave as opposed to being activated
-		return (item->second.is_enabled == false);
+		return &(item->second);
 	}
 
 	bool LogInternal::SetEnable(const char *tag_regex, OVLogLevel level, bool is_enabled)
@@ -170,6 +255,10 @@ namespace ov
 				item->is_enabled = is_enabled;
 			}
 
+			// Invalidate the cache of the threads
+			// (Increased after the list is changed, so the threads that read a new generation always see the new list)
+			_enable_generation++;
+
 			return true;
 		}
 		catch (const std::regex_error &e)
@@ -227,16 +316,9 @@ namespace ov
 			OV_LOG_COLOR_RESET,
 			OV_LOG_COLOR_RESET};
 
-		// Obtain current time in milliseconds
-		auto current = std::chrono::system_clock::now();
-		auto mseconds = std::chrono::duration_cast<std::chrono::milliseconds>(current.time_since_epoch()).count() % 1000;
-
-		// Obtain current hours/minutes/seconds
-		std::time_t time = std::time(nullptr);
-		std::tm local_time{};
-		::localtime_r(&time, &local_time);
-
-		ov::String log;
+		AsyncLogWriter::Entry entry;
+		// Format the log directly into the entry to avoid copying
+		auto &log = entry.message;
 
 #if OV_LOG_SHOW_FILE_NAME
 		ov::String fileName = file;
@@ -276,23 +358,37 @@ namespace ov
 			auto tid = ov::Platform::GetThreadId();
 			auto name = ov::Platform::GetThreadName();
 
-			// log format
-			//  [<date> <time>] <tag> <log level> <thread id> | <message>
-			log.Format(
-				""
-				// color
-				"%s"
+			// Obtain current time in milliseconds
+			auto current = std::chrono::system_clock::now();
+			auto mseconds = std::chrono::duration_cast<std::chrono::milliseconds>(current.time_since_epoch()).count() % 1000;
+			std::time_t time = std::chrono::system_clock::to_time_t(current);
+
+			if (log_time_cache.time != time)
+			{
+				// Obtain current hours/minutes/seconds (localtime_r() is called only once per second)
+				std::tm local_time{};
+				::localtime_r(&time, &local_time);
+
+				::snprintf(log_time_cache.prefix, sizeof(log_time_cache.prefix),
 #if DEBUG
-				// In DEBUG mode, the year is not displayed
-				"["
+						   // In DEBUG mode, the year is not displayed
+						   "[%02d-%02d %02d:%02d:%02d",
+						   local_time.tm_mon + 1, local_time.tm_mday,
 #else	// DEBUG
-
-				// date,
-				"[%04d-"
+						   "[%04d-%02d-%02d %02d:%02d:%02d",
+						   1900 + local_time.tm_year, local_time.tm_mon + 1, local_time.tm_mday,
 #endif	// DEBUG
+						   local_time.tm_hour, local_time.tm_min, local_time.tm_sec);
 
-				// time ([mm-dd hh:mm:ss.sss])
-				"%02d-%02d %02d:%02d:%02d.%03d]"
+				log_time_cache.time = time;
+			}
+
+			// log format
+			//  [<date> <time>] <tag> <log level> <thread id> | <message>
+			log.Format(
+				""
+				// date/time ([yyyy-mm-dd hh:mm:ss.sss])
+				"%s.%03d]"
 
 				// <log level>
 				" %s"
@@ -311,13 +407,7 @@ namespace ov
 				"%s() | "
 #endif	// OV_LOG_SHOW_FUNCTION_NAME
 				,
-				"",
-#if DEBUG
-				local_time.tm_mon + 1, local_time.tm_mday,
-#else	// DEBUG
-				1900 + local_time.tm_year, local_time.tm_mon + 1, local_time.tm_mday,
-#endif	// DEBUG
-				local_time.tm_hour, local_time.tm_min, local_time.tm_sec, mseconds,
+				log_time_cache.prefix, static_cast<int>(mseconds),
 				log_level[level],
 				name,
 				tid,
@@ -336,21 +426,34 @@ namespace ov
 
 		// Append messages
 		log.AppendVFormat(format, arg_list);
+
+		entry.log_file = &_log_file;
+
 		if (show_format)
 		{
-			if (level < OVLogLevelWarning)
-			{
-				fprintf(stdout, "%s%s%s\n", color_prefix[level], log.CStr(), color_suffix[level]);
-				fflush(stdout);
-			}
-			else
-			{
-				fprintf(stderr, "%s%s%s\n", color_prefix[level], log.CStr(), color_suffix[level]);
-				fflush(stderr);
-			}
+			entry.color_prefix = color_prefix[level];
+			entry.color_suffix = color_suffix[level];
+			entry.use_stderr = (level >= OVLogLevelWarning);
+		}
+
+		auto writer = AsyncLogWriter::GetInstance();
+
+		// The logs written while queueing a log (ex: creating the queue) are written synchronously
+		if ((writer == nullptr) || log_writer_entered)
+		{
+			AsyncLogWriter::WriteEntry(entry);
+			return;
 		}
 
-		_log_file.Write(log.CStr());
+		log_writer_entered = true;
+		// Error/critical logs can use the room reserved for them
+		bool queued = writer->Write(std::move(entry), level >= OVLogLevelError);
+		log_writer_entered = false;
+
+		if (queued == false)
+		{
+			AsyncLogWriter::WriteEntry(entry);
+		}
 	}
 
 	void LogInternal::SetLogPath(const char *log_path)
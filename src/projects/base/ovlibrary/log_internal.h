@@ -12,6 +12,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <ctime>
@@ -66,6 +67,9 @@ namespace ov
 
 		void SetLogPath(const char *log_path);
 
+		// Writes all the logs queued in the background writer
+		void Flush();
+
 	protected:
 		// This variable is used to avoid the problem of referencing incorrect heap if the log is written after LogInternal instance is released.
 		// This situation occurs when the LogInternal instance declared static is disabled just before the OME is terminated and then logs are written by another module.
@@ -85,11 +89,18 @@ namespace ov
 			ov::String regex_string;
 		};
 
+		// Must be called while _mutex is held
+		const EnableItem *FindEnableItem(const char *tag);
+
 		std::vector<EnableItem> _enable_list;
 
 		// This map used for cache (It reduces regex matching cost)
 		// key: tag
 		// value: is_enabled
 		std::map<ov::String, EnableItem> _enable_map;
+
+		// Each thread also caches the result of IsEnabled() without locking _mutex,
+		// and the cache is invalidated when this value is changed by SetEnable()/ResetEnable()
+		std::atomic<uint64_t> _enable_generation;
 	};
 }  // namespace ov
\ No newline at end of file
@@ -0,0 +1,480 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "memory_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+
+// Buffers of ov::Data (4 KB ~ 1 MB)
+// The smaller buffers (RTP packets, audio frames, ...) are allocated from the heap, because malloc is faster than the pool for them
+#define OV_MEMORY_POOL_MIN_BUFFER_SIZE (4 * 1024)
+#define OV_MEMORY_POOL_MAX_BUFFER_SIZE (1024 * 1024)
+// Max bytes of the free buffers kept by the cache of a thread (divided equally among the size classes)
+#define OV_MEMORY_POOL_THREAD_CACHE_BYTES (2 * 1024 * 1024)
+// Max bytes of the free buffers kept by the global cache (high-water mark of all size classes)
+#define OV_MEMORY_POOL_GLOBAL_CACHE_BYTES (16 * 1024 * 1024)
+
+#define OV_MEMORY_POOL_MAX_CLASS_COUNT 16
+
+namespace ov
+{
+	namespace
+	{
+		struct FreeItem
+		{
+			std::vector<uint8_t> *buffer;
+			size_t bytes;
+		};
+
+		struct ThreadCache
+		{
+			std::array<std::vector<FreeItem>, OV_MEMORY_POOL_MAX_CLASS_COUNT> free_lists;
+
+			// Written only by the owner thread, and read by GetStats()
+			std::atomic<uint64_t> hit_count{0};
+			std::atomic<uint64_t> miss_count{0};
+			std::atomic<int64_t> resident_bytes{0};
+		};
+
+		// Only the owner thread writes the counter, so it doesn't need an atomic read-modify-write
+		template <typename T>
+		inline void AddToCounter(std::atomic<T> &counter, T value)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		class SizeClassPool;
+
+		// Becomes true when the cache of this thread is destroyed (the thread is exiting)
+		thread_local bool tls_thread_cache_destroyed = false;
+		// Trivial thread_local doesn't need the guard of the initialization, so it is faster than ThreadCacheHolder
+		thread_local ThreadCache *tls_thread_cache = nullptr;
+
+		struct ThreadCacheHolder
+		{
+			~ThreadCacheHolder();
+
+			SizeClassPool *pool = nullptr;
+			ThreadCache *cache = nullptr;
+		};
+
+		class SizeClassPool
+		{
+		public:
+			SizeClassPool(size_t min_size, size_t max_size, size_t thread_cache_bytes, size_t global_cache_bytes)
+				: _min_size(min_size),
+				  _max_size(max_size),
+				  _min_size_log2(Log2Floor(min_size)),
+				  _global_cache_bytes(global_cache_bytes)
+			{
+				for (size_t class_size = min_size; (class_size <= max_size) && (_class_count < OV_MEMORY_POOL_MAX_CLASS_COUNT); class_size <<= 1)
+				{
+					_class_count++;
+				}
+
+				// The large classes may not be kept by the thread cache (0), then they are exchanged through the global cache directly
+				for (size_t class_index = 0; class_index < _class_count; class_index++)
+				{
+					_thread_cache_limits[class_index] = (thread_cache_bytes / _class_count) / GetClassSize(class_index);
+				}
+			}
+
+			size_t GetClassSize(size_t class_index) const
+			{
+				return _min_size << class_index;
+			}
+
+			// The smallest class which can serve size bytes
+			bool GetClassIndexToAllocate(size_t size, size_t *class_index) const
+			{
+				if ((size < _min_size) || (size > _max_size))
+				{
+					return false;
+				}
+
+				*class_index = Log2Ceil(size) - _min_size_log2;
+				return true;
+			}
+
+			// The largest class which the memory of size bytes can serve
+			bool GetClassIndexToFree(size_t size, size_t *class_index) const
+			{
+				if ((size < _min_size) || (size > _max_size))
+				{
+					return false;
+				}
+
+				*class_index = Log2Floor(size) - _min_size_log2;
+				return true;
+			}
+
+			// Returns nullptr if the pool is empty, then the caller allocates from the heap
+			std::vector<uint8_t> *Pop(size_t class_index)
+			{
+				auto cache = GetThreadCache();
+
+				if (cache != nullptr)
+				{
+					auto &free_list = cache->free_lists[class_index];
+
+					if (free_list.empty())
+					{
+						Refill(class_index, cache);
+					}
+
+					if (free_list.empty() == false)
+					{
+						auto item = free_list.back();
+						free_list.pop_back();
+
+						AddToCounter<int64_t>(cache->resident_bytes, -static_cast<int64_t>(item.bytes));
+						AddToCounter<uint64_t>(cache->hit_count, 1);
+
+						return item.buffer;
+					}
+
+					AddToCounter<uint64_t>(cache->miss_count, 1);
+					return nullptr;
+				}
+
+				// The thread is exiting
+				auto &global_list = _global_lists[class_index];
+				std::lock_guard<std::mutex> lock_guard(global_list.mutex);
+
+				if (global_list.items.empty() == false)
+				{
+					auto item = global_list.items.back();
+					global_list.items.pop_back();
+
+					_global_resident_bytes -= item.bytes;
+					_retired_hit_count++;
+
+					return item.buffer;
+				}
+
+				_retired_miss_count++;
+				return nullptr;
+			}
+
+			// If the pool is full, the buffer is deleted
+			void Push(size_t class_index, std::vector<uint8_t> *buffer)
+			{
+				auto cache = GetThreadCache();
+				size_t bytes = buffer->capacity();
+
+				if (cache != nullptr)
+				{
+					auto &free_list = cache->free_lists[class_index];
+
+					free_list.push_back({buffer, bytes});
+					AddToCounter<int64_t>(cache->resident_bytes, static_cast<int64_t>(bytes));
+
+					auto limit = _thread_cache_limits[class_index];
+
+					if (free_list.size() > limit)
+					{
+						// Give a half to the other threads
+						Flush(class_index, cache, free_list.size() - (limit / 2));
+					}
+
+					return;
+				}
+
+				// The thread is exiting
+				{
+					auto &global_list = _global_lists[class_index];
+					std::lock_guard<std::mutex> lock_guard(global_list.mutex);
+
+					if (HasGlobalRoom(bytes))
+					{
+						global_list.items.push_back({buffer, bytes});
+						_global_resident_bytes += bytes;
+
+						return;
+					}
+				}
+
+				delete buffer;
+			}
+
+			// For the memory which is not pooled (too small or too large)
+			void CountMiss()
+			{
+				auto cache = GetThreadCache();
+
+				if (cache != nullptr)
+				{
+					AddToCounter<uint64_t>(cache->miss_count, 1);
+				}
+				else
+				{
+					_retired_miss_count++;
+				}
+			}
+
+			MemoryPool::Stats GetStats()
+			{
+				MemoryPool::Stats stats;
+				int64_t resident_bytes = _global_resident_bytes;
+
+				stats.hit_count = _retired_hit_count;
+				stats.miss_count = _retired_miss_count;
+
+				std::lock_guard<std::mutex> lock_guard(_thread_caches_mutex);
+
+				for (auto cache : _thread_caches)
+				{
+					stats.hit_count += cache->hit_count.load(std::memory_order_relaxed);
+					stats.miss_count += cache->miss_count.load(std::memory_order_relaxed);
+					resident_bytes += cache->resident_bytes.load(std::memory_order_relaxed);
+				}
+
+				stats.resident_bytes = static_cast<uint64_t>(std::max<int64_t>(resident_bytes, 0));
+
+				return stats;
+			}
+
+			// Called when the thread is exiting
+			void ReleaseThreadCache(ThreadCache *cache)
+			{
+				for (size_t class_index = 0; class_index < _class_count; class_index++)
+				{
+					Flush(class_index, cache, cache->free_lists[class_index].size());
+				}
+
+				{
+					std::lock_guard<std::mutex> lock_guard(_thread_caches_mutex);
+
+					_thread_caches.erase(cache);
+
+					_retired_hit_count += cache->hit_count;
+					_retired_miss_count += cache->miss_count;
+				}
+
+				delete cache;
+			}
+
+		protected:
+			static size_t Log2Floor(size_t value)
+			{
+				return (sizeof(unsigned long long) * 8 - 1) - __builtin_clzll(value);
+			}
+
+			static size_t Log2Ceil(size_t value)
+			{
+				return Log2Floor(value - 1) + 1;
+			}
+
+			ThreadCache *GetThreadCache()
+			{
+				auto cache = tls_thread_cache;
+
+				if ((cache != nullptr) || tls_thread_cache_destroyed)
+				{
+					return cache;
+				}
+
+				return CreateThreadCache();
+			}
+
+			ThreadCache *CreateThreadCache()
+			{
+				// Releases the cache when the thread exits
+				thread_local ThreadCacheHolder holder;
+
+				if (holder.cache == nullptr)
+				{
+					holder.cache = new ThreadCache();
+					holder.pool = this;
+					tls_thread_cache = holder.cache;
+
+					for (size_t class_index = 0; class_index < _class_count; class_index++)
+					{
+						holder.cache->free_lists[class_index].reserve(_thread_cache_limits[class_index] + 1);
+					}
+
+					std::lock_guard<std::mutex> lock_guard(_thread_caches_mutex);
+					_thread_caches.insert(holder.cache);
+				}
+
+				return holder.cache;
+			}
+
+			// Every size class shares the high-water mark of the global cache (the lock of the size class must be held)
+			bool HasGlobalRoom(size_t bytes) const
+			{
+				return (_global_resident_bytes.load(std::memory_order_relaxed) + static_cast<int64_t>(bytes)) <= static_cast<int64_t>(_global_cache_bytes);
+			}
+
+			// Take a half of the limit from the global cache
+			void Refill(size_t class_index, ThreadCache *cache)
+			{
+				auto &free_list = cache->free_lists[class_index];
+				auto &global_list = _global_lists[class_index];
+				size_t count = std::max<size_t>(1, _thread_cache_limits[class_index] / 2);
+				size_t bytes = 0;
+
+				{
+					std::lock_guard<std::mutex> lock_guard(global_list.mutex);
+
+					while ((count > 0) && (global_list.items.empty() == false))
+					{
+						auto &item = global_list.items.back();
+
+						bytes += item.bytes;
+						free_list.push_back(item);
+						global_list.items.pop_back();
+
+						count--;
+					}
+
+					_global_resident_bytes -= bytes;
+				}
+
+				AddToCounter<int64_t>(cache->resident_bytes, static_cast<int64_t>(bytes));
+			}
+
+			// Move count items to the global cache, and delete the items which exceed the high-water mark of the global cache
+			void Flush(size_t class_index, ThreadCache *cache, size_t count)
+			{
+				auto &free_list = cache->free_lists[class_index];
+				auto &global_list = _global_lists[class_index];
+				size_t bytes = 0;
+
+				count = std::min(count, free_list.size());
+
+				{
+					std::lock_guard<std::mutex> lock_guard(global_list.mutex);
+
+					while ((count > 0) && HasGlobalRoom(free_list.back().bytes))
+					{
+						auto &item = free_list.back();
+
+						bytes += item.bytes;
+						_global_resident_bytes += item.bytes;
+						global_list.items.push_back(item);
+						free_list.pop_back();
+
+						count--;
+					}
+				}
+
+				while (count > 0)
+				{
+					auto &item = free_list.back();
+
+					bytes += item.bytes;
+					delete item.buffer;
+					free_list.pop_back();
+
+					count--;
+				}
+
+				AddToCounter<int64_t>(cache->resident_bytes, -static_cast<int64_t>(bytes));
+			}
+
+			struct GlobalList
+			{
+				std::mutex mutex;
+				std::vector<FreeItem> items;
+			};
+
+			size_t _min_size;
+			size_t _max_size;
+			size_t _min_size_log2;
+			size_t _global_cache_bytes;
+
+			size_t _class_count = 0;
+			std::array<size_t, OV_MEMORY_POOL_MAX_CLASS_COUNT> _thread_cache_limits{};
+
+			std::array<GlobalList, OV_MEMORY_POOL_MAX_CLASS_COUNT> _global_lists;
+			std::atomic<int64_t> _global_resident_bytes{0};
+
+			std::mutex _thread_caches_mutex;
+			std::unordered_set<ThreadCache *> _thread_caches;
+
+			// Counters of the threads which are exited
+			std::atomic<uint64_t> _retired_hit_count{0};
+			std::atomic<uint64_t> _retired_miss_count{0};
+		};
+
+		ThreadCacheHolder::~ThreadCacheHolder()
+		{
+			// The buffers which are released after this are returned to the global cache
+			tls_thread_cache_destroyed = true;
+			tls_thread_cache = nullptr;
+
+			if (cache != nullptr)
+			{
+				pool->ReleaseThreadCache(cache);
+			}
+		}
+
+		// The pool is never deleted, because the buffers can be released while the static objects are destroyed
+		SizeClassPool &GetBufferPool()
+		{
+			static auto pool = new SizeClassPool(OV_MEMORY_POOL_MIN_BUFFER_SIZE, OV_MEMORY_POOL_MAX_BUFFER_SIZE,
+												 OV_MEMORY_POOL_THREAD_CACHE_BYTES, OV_MEMORY_POOL_GLOBAL_CACHE_BYTES);
+			return *pool;
+		}
+
+		void ReleaseBuffer(std::vector<uint8_t> *buffer)
+		{
+			auto &pool = GetBufferPool();
+			size_t class_index;
+
+			// clear() keeps the capacity
+			buffer->clear();
+
+			if (pool.GetClassIndexToFree(buffer->capacity(), &class_index))
+			{
+				pool.Push(class_index, buffer);
+			}
+			else
+			{
+				delete buffer;
+			}
+		}
+	}  // namespace
+
+	std::shared_ptr<std::vector<uint8_t>> MemoryPool::AllocateBuffer(size_t capacity)
+	{
+		auto &pool = GetBufferPool();
+		size_t class_index;
+
+		if (pool.GetClassIndexToAllocate(capacity, &class_index) == false)
+		{
+			pool.CountMiss();
+
+			// Same as the buffer which is not pooled (a control block with the deleter costs an allocation more)
+			auto buffer = std::make_shared<std::vector<uint8_t>>();
+			buffer->reserve(capacity);
+
+			return buffer;
+		}
+
+		auto buffer = pool.Pop(class_index);
+
+		if (buffer == nullptr)
+		{
+			buffer = new std::vector<uint8_t>();
+			buffer->reserve(pool.GetClassSize(class_index));
+		}
+
+		return std::shared_ptr<std::vector<uint8_t>>(buffer, ReleaseBuffer);
+	}
+
+	MemoryPool::Stats MemoryPool::GetBufferStats()
+	{
+		return GetBufferPool().GetStats();
+	}
+}  // namespace ov
@@ -0,0 +1,49 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ov
+{
+	// Size-classed memory pool for the large buffers of ov::Data which are created/released per frame (ex: video frames)
+	//
+	// Free buffers are kept per size class (power of 2) in the cache of each thread first, and then in the global cache.
+	// When the cache of a thread is empty, it takes a batch from the global cache, and when the cache is full,
+	// it gives a half to the global cache. So the threads which allocate (ingest) and the threads which release (publishers)
+	// exchange the buffers without taking a lock per allocation.
+	//
+	// Small buffers are not pooled, because malloc is faster than the pool for them. The bytes kept by the cache of
+	// a thread and by the global cache are limited, and the buffers which exceed the limits are returned to the heap.
+	class MemoryPool
+	{
+	public:
+		struct Stats
+		{
+			// Number of the allocations served from the pool
+			uint64_t hit_count = 0;
+			// Number of the allocations which are made from the heap (the pool is empty, or the size is not pooled)
+			uint64_t miss_count = 0;
+			// Bytes of the free memory kept by the pool (including the caches of the threads)
+			uint64_t resident_bytes = 0;
+		};
+
+		/// Get a buffer of ov::Data which has at least capacity bytes of capacity
+		///
+		/// @param capacity Capacity to reserve
+		///
+		/// @return std::vector which is empty. It keeps its capacity and returns to the pool when it is released.
+		static std::shared_ptr<std::vector<uint8_t>> AllocateBuffer(size_t capacity);
+
+		static Stats GetBufferStats();
+	};
+}  // namespace ov
@@ -15,12 +15,16 @@
 #include "./byte_stream.h"
 #include "./clock.h"
 #include "./converter.h"
+#include "./copy_on_write_map.h"
 #include "./data.h"
 #include "./delay_queue.h"
 #include "./dump_utilities.h"
 #include "./enable_shared_from_this.h"
+#include "./epoch.h"
 #include "./error.h"
+#include "./futex.h"
 #include "./json.h"
+#include "./lock_free_queue.h"
 #include "./log.h"
 #include "./memory_utilities.h"
 #include "./ovdata_structure.h"
@@ -31,6 +35,7 @@
 #include "./random.h"
 #include "./regex.h"
 #include "./semaphore.h"
+#include "./serial_executor.h"
 #include "./singleton.h"
 #include "./stack_trace.h"
 #include "./stop_watch.h"
@@ -38,4 +43,5 @@
 #include "./time.h"
 #include "./type.h"
 #include "./unique.h"
-#include "./url.h"
\ No newline at end of file
+#include "./url.h"
+#include "./work_stealing_executor.h"
\ No newline at end of file
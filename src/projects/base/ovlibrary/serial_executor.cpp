@@ -0,0 +1,130 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./serial_executor.h"
+
+#include "./log.h"
+#include "./ovlibrary_private.h"
+
+// Maximum number of tasks executed in a turn (the rest are executed after the tasks of other executors)
+#define SERIAL_EXECUTOR_MAX_TASKS_PER_TURN 64
+// There is a serial executor per stream (and per stream worker), so the ring is kept small.
+// A burst larger than the ring goes to the overflow list of the queue.
+#define SERIAL_EXECUTOR_QUEUE_CAPACITY 64
+
+namespace ov
+{
+	std::shared_ptr<SerialExecutor> SerialExecutor::Create(const std::shared_ptr<WorkStealingExecutor> &executor, const char *alias)
+	{
+		if (executor == nullptr)
+		{
+			return nullptr;
+		}
+
+		return std::make_shared<SerialExecutor>(executor, alias);
+	}
+
+	SerialExecutor::SerialExecutor(const std::shared_ptr<WorkStealingExecutor> &executor, const char *alias)
+		: _executor(executor),
+		  _task_queue((alias != nullptr) ? String::FormatString("%s - Serial executor", alias).CStr() : nullptr, 500, 5000, SERIAL_EXECUTOR_QUEUE_CAPACITY)
+	{
+	}
+
+	bool SerialExecutor::Post(Task task)
+	{
+		if (IsStopped())
+		{
+			return false;
+		}
+
+		_task_queue.Enqueue(std::move(task));
+
+		// seq_cst: pairs with Drain() which clears _scheduled and then checks the queue
+		if (_scheduled.exchange(true) == false)
+		{
+			return Schedule();
+		}
+
+		return true;
+	}
+
+	bool SerialExecutor::Schedule()
+	{
+		auto self = GetSharedPtr();
+
+		if (_executor->Post([self]() { self->Drain(); }))
+		{
+			return true;
+		}
+
+		logtw("[%p] Could not post the task to the executor (the executor is stopped)", this);
+		_scheduled.store(false);
+
+		return false;
+	}
+
+	void SerialExecutor::Stop()
+	{
+		_stopped.store(true);
+
+		if (_running_thread_id.load() == std::this_thread::get_id())
+		{
+			// Called in a task, the remaining tasks are discarded by Drain()
+			return;
+		}
+
+		// Wait for Drain() to finish, and then discard the remaining tasks (only one thread can pop the queue at a time)
+		std::lock_guard<std::mutex> lock_guard(_execution_mutex);
+		_task_queue.Clear();
+	}
+
+	void SerialExecutor::Drain()
+	{
+		{
+			std::lock_guard<std::mutex> lock_guard(_execution_mutex);
+
+			_running_thread_id.store(std::this_thread::get_id());
+
+			size_t count = 0;
+
+			while (count < SERIAL_EXECUTOR_MAX_TASKS_PER_TURN)
+			{
+				auto task = _task_queue.TryDequeue();
+
+				if (task.has_value() == false)
+				{
+					if (_task_queue.IsEmpty())
+					{
+						break;
+					}
+
+					// A producer has not finished enqueuing yet
+					std::this_thread::yield();
+					continue;
+				}
+
+				count++;
+
+				if (IsStopped() == false)
+				{
+					(task.value())();
+				}
+			}
+
+			_running_thread_id.store(std::thread::id());
+		}
+
+		_scheduled.store(false);
+
+		// If a task was posted after the queue became empty (or the turn ended), schedule again
+		if ((_task_queue.IsEmpty() == false) && (_scheduled.exchange(true) == false))
+		{
+			Schedule();
+		}
+	}
+}  // namespace ov
@@ -0,0 +1,69 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "./enable_shared_from_this.h"
+#include "./lock_free_queue.h"
+#include "./work_stealing_executor.h"
+
+namespace ov
+{
+	// Runs the posted tasks on a WorkStealingExecutor one by one, in the order in which they were posted.
+	// (Used to keep the order of the tasks of a stream while the streams are processed in parallel)
+	//
+	// Usage:
+	//   auto serial_executor = SerialExecutor::Create(WorkStealingExecutor::GetSharedInstance(), "stream");
+	//   serial_executor->Post([]() { ... });
+	class SerialExecutor : public EnableSharedFromThis<SerialExecutor>
+	{
+	public:
+		using Task = WorkStealingExecutor::Task;
+
+		static std::shared_ptr<SerialExecutor> Create(const std::shared_ptr<WorkStealingExecutor> &executor, const char *alias = nullptr);
+
+		SerialExecutor(const std::shared_ptr<WorkStealingExecutor> &executor, const char *alias);
+
+		bool Post(Task task);
+
+		// Prevents the pending tasks from being executed, and waits for the running task to finish
+		// (If it is called in a task of this executor, it doesn't wait)
+		void Stop();
+
+		bool IsStopped() const
+		{
+			return _stopped.load(std::memory_order_acquire);
+		}
+
+		size_t GetPendingCount() const
+		{
+			return _task_queue.Size();
+		}
+
+	protected:
+		bool Schedule();
+		void Drain();
+
+	private:
+		std::shared_ptr<WorkStealingExecutor> _executor;
+
+		MpscQueue<Task> _task_queue;
+
+		// true while a Drain() is posted to the executor (or is running)
+		std::atomic<bool> _scheduled{false};
+		std::atomic<bool> _stopped{false};
+
+		// Held while Drain() is running, so the tasks are never executed concurrently after Stop() returns
+		std::mutex _execution_mutex;
+		std::atomic<std::thread::id> _running_thread_id;
+	};
+}  // namespace ov
@@ -0,0 +1,346 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./work_stealing_executor.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "./log.h"
+#include "./ovlibrary_private.h"
+
+// An idle thread wakes up at this interval to check whether there are tasks to steal
+#define WORK_STEALING_EXECUTOR_IDLE_TIMEOUT 100
+// The threads of the blocking instance mostly wait for I/O, so there are more threads than CPUs
+#define WORK_STEALING_EXECUTOR_BLOCKING_THREADS_PER_CPU 2
+#define WORK_STEALING_EXECUTOR_MIN_BLOCKING_THREAD_COUNT 4
+
+namespace ov
+{
+	struct WorkStealingExecutorContext
+	{
+		const WorkStealingExecutor *executor = nullptr;
+		size_t worker_index = 0;
+	};
+
+	static thread_local WorkStealingExecutorContext executor_context;
+
+	namespace
+	{
+		std::mutex instance_mutex;
+		std::shared_ptr<WorkStealingExecutor> shared_instance;
+		std::shared_ptr<WorkStealingExecutor> blocking_instance;
+
+		std::shared_ptr<WorkStealingExecutor> GetInstance(std::shared_ptr<WorkStealingExecutor> &instance, const char *name, size_t thread_count)
+		{
+			std::lock_guard<std::mutex> lock_guard(instance_mutex);
+
+			if (instance == nullptr)
+			{
+				instance = std::make_shared<WorkStealingExecutor>(name, thread_count);
+				instance->Start();
+			}
+
+			return instance;
+		}
+
+		size_t GetCpuCount()
+		{
+			auto cpu_count = ::sysconf(_SC_NPROCESSORS_ONLN);
+
+			return (cpu_count > 0) ? cpu_count : 1;
+		}
+	}  // namespace
+
+	std::shared_ptr<WorkStealingExecutor> WorkStealingExecutor::GetSharedInstance()
+	{
+		return GetInstance(shared_instance, "SharedExecutor", GetCpuCount());
+	}
+
+	std::shared_ptr<WorkStealingExecutor> WorkStealingExecutor::GetBlockingInstance()
+	{
+		return GetInstance(blocking_instance, "BlockingExecutor",
+						   std::max(GetCpuCount() * WORK_STEALING_EXECUTOR_BLOCKING_THREADS_PER_CPU, static_cast<size_t>(WORK_STEALING_EXECUTOR_MIN_BLOCKING_THREAD_COUNT)));
+	}
+
+	std::vector<std::shared_ptr<WorkStealingExecutor>> WorkStealingExecutor::GetInstanceList()
+	{
+		std::vector<std::shared_ptr<WorkStealingExecutor>> instance_list;
+		std::lock_guard<std::mutex> lock_guard(instance_mutex);
+
+		for (auto &instance : {shared_instance, blocking_instance})
+		{
+			if (instance != nullptr)
+			{
+				instance_list.push_back(instance);
+			}
+		}
+
+		return instance_list;
+	}
+
+	WorkStealingExecutor::WorkStealingExecutor(const char *name, size_t thread_count)
+		: _name(name),
+		  _thread_count(std::max(thread_count, static_cast<size_t>(1)))
+	{
+	}
+
+	WorkStealingExecutor::~WorkStealingExecutor()
+	{
+		Stop();
+	}
+
+	bool WorkStealingExecutor::Start()
+	{
+		if (_stop.exchange(false) == false)
+		{
+			logtw("[%s] The executor is already started", _name.CStr());
+			return false;
+		}
+
+		_worker_list.clear();
+
+		for (size_t index = 0; index < _thread_count; index++)
+		{
+			auto worker = std::make_unique<Worker>();
+
+			worker->index = index;
+			_worker_list.push_back(std::move(worker));
+		}
+
+		// Create the threads after all workers are created, because a thread may steal the tasks from other workers
+		for (auto &worker : _worker_list)
+		{
+			worker->start_time = std::chrono::steady_clock::now();
+			worker->thread = std::thread(&WorkStealingExecutor::WorkerThread, this, worker.get());
+
+			auto thread_name = String::FormatString("%s#%zu", _name.CStr(), worker->index);
+			::pthread_setname_np(worker->thread.native_handle(), thread_name.Left(15).CStr());
+		}
+
+		logti("[%s] The executor is started with %zu threads", _name.CStr(), _thread_count);
+
+		return true;
+	}
+
+	void WorkStealingExecutor::Stop()
+	{
+		if (_stop.exchange(true))
+		{
+			return;
+		}
+
+		_futex.Signal();
+
+		for (auto &worker : _worker_list)
+		{
+			if (worker->thread.joinable())
+			{
+				worker->thread.join();
+			}
+		}
+
+		for (auto &worker : _worker_list)
+		{
+			std::lock_guard<std::mutex> lock_guard(worker->mutex);
+			worker->task_list.clear();
+		}
+
+		_pending_count = 0;
+
+		logti("[%s] The executor is stopped", _name.CStr());
+	}
+
+	bool WorkStealingExecutor::IsExecutorThread() const
+	{
+		return (executor_context.executor == this);
+	}
+
+	bool WorkStealingExecutor::Post(Task task)
+	{
+		if (_stop.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		auto worker_index = IsExecutorThread() ? executor_context.worker_index : (_next_worker_index.fetch_add(1, std::memory_order_relaxed) % _thread_count);
+		auto &worker = _worker_list[worker_index];
+
+		// Count the task before it is pushed, so the count never goes below zero
+		// (seq_cst: pairs with the idle thread which increases _idle_count and then checks _pending_count)
+		_pending_count.fetch_add(1);
+
+		{
+			std::lock_guard<std::mutex> lock_guard(worker->mutex);
+			worker->task_list.push_back(std::move(task));
+		}
+
+		if (_idle_count.load() > 0)
+		{
+			_futex.SignalOne();
+		}
+
+		return true;
+	}
+
+	bool WorkStealingExecutor::PopTask(Worker *worker, Task &task)
+	{
+		std::lock_guard<std::mutex> lock_guard(worker->mutex);
+
+		if (worker->task_list.empty())
+		{
+			return false;
+		}
+
+		task = std::move(worker->task_list.front());
+		worker->task_list.pop_front();
+
+		return true;
+	}
+
+	bool WorkStealingExecutor::StealTask(Worker *thief, Task &task)
+	{
+		std::vector<Task> stolen_list;
+
+		for (size_t offset = 1; offset < _thread_count; offset++)
+		{
+			auto &victim = _worker_list[(thief->index + offset) % _thread_count];
+
+			std::lock_guard<std::mutex> lock_guard(victim->mutex);
+			auto count = victim->task_list.size();
+
+			if (count == 0)
+			{
+				continue;
+			}
+
+			// Steal the newer half of the tasks (the victim keeps processing the older ones)
+			auto steal_count = (count + 1) / 2;
+			auto begin = victim->task_list.end() - steal_count;
+
+			stolen_list.assign(std::make_move_iterator(begin), std::make_move_iterator(victim->task_list.end()));
+			victim->task_list.erase(begin, victim->task_list.end());
+
+			break;
+		}
+
+		if (stolen_list.empty())
+		{
+			return false;
+		}
+
+		thief->stolen_count.fetch_add(stolen_list.size(), std::memory_order_relaxed);
+
+		task = std::move(stolen_list.front());
+
+		if (stolen_list.size() > 1)
+		{
+			std::lock_guard<std::mutex> lock_guard(thief->mutex);
+
+			for (auto item = stolen_list.begin() + 1; item != stolen_list.end(); ++item)
+			{
+				thief->task_list.push_back(std::move(*item));
+			}
+		}
+
+		return true;
+	}
+
+	void WorkStealingExecutor::ExecuteTask(Worker *worker, Task &task)
+	{
+		_pending_count.fetch_sub(1, std::memory_order_relaxed);
+
+		auto start = std::chrono::steady_clock::now();
+
+		task();
+		// Release the resources captured by the task before measuring
+		task = nullptr;
+
+		auto busy_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+		worker->busy_time_usec.fetch_add(busy_time, std::memory_order_relaxed);
+		worker->executed_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void WorkStealingExecutor::WorkerThread(Worker *worker)
+	{
+		executor_context.executor = this;
+		executor_context.worker_index = worker->index;
+
+		Task task;
+
+		while (_stop.load(std::memory_order_acquire) == false)
+		{
+			if (PopTask(worker, task) || StealTask(worker, task))
+			{
+				ExecuteTask(worker, task);
+				continue;
+			}
+
+			auto futex_value = _futex.GetValue();
+
+			_idle_count.fetch_add(1);
+
+			if ((_pending_count.load() == 0) && (_stop.load() == false))
+			{
+				_futex.Wait(futex_value, WORK_STEALING_EXECUTOR_IDLE_TIMEOUT);
+			}
+
+			_idle_count.fetch_sub(1);
+		}
+
+		executor_context.executor = nullptr;
+	}
+
+	std::vector<WorkStealingExecutor::ThreadStatistics> WorkStealingExecutor::GetStatistics() const
+	{
+		std::vector<ThreadStatistics> statistics_list;
+		auto now = std::chrono::steady_clock::now();
+
+		for (auto &worker : _worker_list)
+		{
+			ThreadStatistics statistics;
+
+			statistics.index = worker->index;
+			statistics.executed_count = worker->executed_count.load(std::memory_order_relaxed);
+			statistics.stolen_count = worker->stolen_count.load(std::memory_order_relaxed);
+			statistics.busy_time_usec = worker->busy_time_usec.load(std::memory_order_relaxed);
+			statistics.elapsed_time_usec = std::chrono::duration_cast<std::chrono::microseconds>(now - worker->start_time).count();
+
+			{
+				std::lock_guard<std::mutex> lock_guard(worker->mutex);
+				statistics.queued_count = worker->task_list.size();
+			}
+
+			statistics_list.push_back(statistics);
+		}
+
+		return statistics_list;
+	}
+
+	String WorkStealingExecutor::ToString() const
+	{
+		String description;
+
+		description.AppendFormat("<WorkStealingExecutor: %p, %s, threads: %zu, pending: %zu", this, _name.CStr(), _thread_count, _pending_count.load());
+
+		for (auto &statistics : GetStatistics())
+		{
+			description.AppendFormat(
+				"\n\t#%zu: utilization: %.1f%%, executed: %" PRIu64 ", stolen: %" PRIu64 ", queued: %zu",
+				statistics.index, statistics.GetUtilization() * 100.0, statistics.executed_count, statistics.stolen_count, statistics.queued_count);
+		}
+
+		description.Append(">");
+
+		return description;
+	}
+}  // namespace ov
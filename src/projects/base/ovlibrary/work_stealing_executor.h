@@ -0,0 +1,141 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "./futex.h"
+#include "./string.h"
+
+namespace ov
+{
+	// A thread pool which has a task deque for each thread.
+	//
+	// - A task posted from a thread of the executor is pushed to the deque of that thread,
+	//   and a task posted from other threads is distributed to the deques in round-robin
+	// - An idle thread steals the half of the tasks from the deque of another thread,
+	//   so a few heavy producers cannot saturate one thread while the others sleep
+	// - The tasks are executed in arbitrary order/thread. Use SerialExecutor to keep the order.
+	class WorkStealingExecutor
+	{
+	public:
+		using Task = std::function<void()>;
+
+		struct ThreadStatistics
+		{
+			size_t index = 0;
+
+			// Number of tasks executed by the thread
+			uint64_t executed_count = 0;
+			// Number of tasks stolen from other threads
+			uint64_t stolen_count = 0;
+			// Number of tasks waiting in the deque of the thread
+			size_t queued_count = 0;
+
+			// Time spent in executing tasks
+			uint64_t busy_time_usec = 0;
+			// Time since the thread is started
+			uint64_t elapsed_time_usec = 0;
+
+			// 0.0 ~ 1.0
+			double GetUtilization() const
+			{
+				return (elapsed_time_usec > 0) ? (static_cast<double>(busy_time_usec) / static_cast<double>(elapsed_time_usec)) : 0.0;
+			}
+		};
+
+		// The executor shared by the modules (mediarouter, publishers, ...)
+		// It is started with the number of online CPUs at the first call.
+		static std::shared_ptr<WorkStealingExecutor> GetSharedInstance();
+
+		// The executor for the tasks which can block on I/O (such as writing files, or sending to a remote server),
+		// so they cannot stall the tasks of the shared instance.
+		// It is started with twice the number of online CPUs (at least 4 threads) at the first call.
+		static std::shared_ptr<WorkStealingExecutor> GetBlockingInstance();
+
+		// Returns the instances started so far (for monitoring)
+		static std::vector<std::shared_ptr<WorkStealingExecutor>> GetInstanceList();
+
+		WorkStealingExecutor(const char *name, size_t thread_count);
+		~WorkStealingExecutor();
+
+		bool Start();
+		void Stop();
+
+		bool Post(Task task);
+
+		const String &GetName() const
+		{
+			return _name;
+		}
+
+		size_t GetThreadCount() const
+		{
+			return _thread_count;
+		}
+
+		// Number of tasks waiting in all deques
+		size_t GetPendingCount() const
+		{
+			return _pending_count.load(std::memory_order_relaxed);
+		}
+
+		// Returns true if the calling thread is one of the threads of this executor
+		bool IsExecutorThread() const;
+
+		std::vector<ThreadStatistics> GetStatistics() const;
+
+		String ToString() const;
+
+	protected:
+		struct Worker
+		{
+			size_t index = 0;
+
+			mutable std::mutex mutex;
+			std::deque<Task> task_list;
+
+			std::thread thread;
+			std::chrono::steady_clock::time_point start_time;
+
+			std::atomic<uint64_t> executed_count{0};
+			std::atomic<uint64_t> stolen_count{0};
+			std::atomic<uint64_t> busy_time_usec{0};
+		};
+
+		void WorkerThread(Worker *worker);
+
+		bool PopTask(Worker *worker, Task &task);
+		bool StealTask(Worker *thief, Task &task);
+		void ExecuteTask(Worker *worker, Task &task);
+
+	private:
+		String _name;
+		size_t _thread_count = 0;
+
+		std::vector<std::unique_ptr<Worker>> _worker_list;
+
+		std::atomic<bool> _stop{true};
+
+		// Index of the deque for the task posted from other threads
+		std::atomic<size_t> _next_worker_index{0};
+
+		// Number of tasks in all deques
+		std::atomic<size_t> _pending_count{0};
+		// Number of threads which are sleeping (or are going to sleep)
+		std::atomic<size_t> _idle_count{0};
+		Futex _futex;
+	};
+}  // namespace ov
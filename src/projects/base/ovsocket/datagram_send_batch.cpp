@@ -0,0 +1,116 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "datagram_send_batch.h"
+
+#include "datagram_socket.h"
+#include "socket_private.h"
+
+#undef OV_LOG_TAG
+#define OV_LOG_TAG "Socket.Datagram"
+
+// If the number of datagrams collected for a socket exceeds this value, they are flushed immediately
+#define DATAGRAM_SEND_BATCH_MAX_ITEMS 1024
+
+namespace ov
+{
+	struct DatagramSendBatchContext
+	{
+		struct Entry
+		{
+			std::shared_ptr<DatagramSocket> socket;
+			std::vector<DatagramSendBatch::Item> items;
+		};
+
+		int depth = 0;
+
+		// Sockets are flushed in the order in which they were first used
+		std::vector<Entry> entry_list;
+	};
+
+	static thread_local DatagramSendBatchContext batch_context;
+
+	void DatagramSendBatch::Begin()
+	{
+		batch_context.depth++;
+	}
+
+	void DatagramSendBatch::End()
+	{
+		if (batch_context.depth <= 0)
+		{
+			OV_ASSERT(batch_context.depth > 0, "DatagramSendBatch::End() is called without Begin()");
+			return;
+		}
+
+		batch_context.depth--;
+
+		if (batch_context.depth == 0)
+		{
+			Flush();
+		}
+	}
+
+	bool DatagramSendBatch::IsActive()
+	{
+		return (batch_context.depth > 0);
+	}
+
+	bool DatagramSendBatch::Append(const std::shared_ptr<Socket> &socket, const SocketAddress &address, const std::shared_ptr<const Data> &data)
+	{
+		if ((batch_context.depth == 0) || (socket == nullptr) || (socket->GetType() != SocketType::Udp))
+		{
+			return false;
+		}
+
+		auto datagram_socket = std::static_pointer_cast<DatagramSocket>(socket);
+
+		DatagramSendBatchContext::Entry *entry = nullptr;
+
+		for (auto &item : batch_context.entry_list)
+		{
+			if (item.socket == datagram_socket)
+			{
+				entry = &item;
+				break;
+			}
+		}
+
+		if (entry == nullptr)
+		{
+			entry = &(batch_context.entry_list.emplace_back());
+			entry->socket = datagram_socket;
+		}
+
+		// The caller may reuse the data after SendTo() returns, so keep a copy-on-write instance
+		entry->items.emplace_back(address, data->Clone());
+
+		if (entry->items.size() >= DATAGRAM_SEND_BATCH_MAX_ITEMS)
+		{
+			entry->socket->SendBatch(entry->items);
+			entry->items.clear();
+		}
+
+		return true;
+	}
+
+	void DatagramSendBatch::Flush()
+	{
+		// Move the list to prevent re-entrance problems (ex: SendTo() is called in the callback)
+		auto entry_list = std::move(batch_context.entry_list);
+		batch_context.entry_list.clear();
+
+		for (auto &entry : entry_list)
+		{
+			if (entry.items.empty() == false)
+			{
+				entry.socket->SendBatch(entry.items);
+			}
+		}
+	}
+}  // namespace ov
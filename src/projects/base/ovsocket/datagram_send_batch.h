@@ -0,0 +1,79 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "socket_address.h"
+
+namespace ov
+{
+	class Socket;
+	class DatagramSocket;
+
+	// Collects the datagrams sent by the calling thread between Begin() and End(),
+	// and flushes them to the kernel with as few syscalls as possible (sendmmsg/UDP GSO).
+	//
+	// Only the sockets that enabled the send batching (DatagramSocket::SetSendBatching())
+	// are collected, other sockets send the datagram immediately.
+	//
+	// Usage:
+	//   DatagramSendBatch::Begin();
+	//   socket->SendTo(address, data1);
+	//   socket->SendTo(address, data2);
+	//   DatagramSendBatch::End(); // <-- data1 and data2 are sent here
+	class DatagramSendBatch
+	{
+	public:
+		struct Item
+		{
+			Item(const SocketAddress &address, const std::shared_ptr<const Data> &data)
+				: address(address),
+				  data(data)
+			{
+			}
+
+			SocketAddress address;
+			std::shared_ptr<const Data> data;
+		};
+
+		// Starts collecting the datagrams of the calling thread
+		// Nested calls are allowed, and the datagrams are flushed when the outermost End() is called
+		static void Begin();
+		// Flushes the collected datagrams
+		static void End();
+
+		static bool IsActive();
+
+		// Returns true if the datagram is collected (This API is called by Socket::SendTo())
+		static bool Append(const std::shared_ptr<Socket> &socket, const SocketAddress &address, const std::shared_ptr<const Data> &data);
+
+	protected:
+		static void Flush();
+	};
+
+	// Calls DatagramSendBatch::Begin()/End() within the scope
+	class DatagramSendBatchScope
+	{
+	public:
+		DatagramSendBatchScope()
+		{
+			DatagramSendBatch::Begin();
+		}
+
+		~DatagramSendBatchScope()
+		{
+			DatagramSendBatch::End();
+		}
+
+		DatagramSendBatchScope(const DatagramSendBatchScope &) = delete;
+		DatagramSendBatchScope &operator=(const DatagramSendBatchScope &) = delete;
+	};
+}  // namespace ov
@@ -9,9 +9,25 @@
 
 #include "datagram_socket.h"
 
+#include <netinet/udp.h>
+
 #include "client_socket.h"
 #include "socket_private.h"
 
+#ifndef UDP_SEGMENT
+// Available since Linux 4.18
+#	define UDP_SEGMENT 103
+#endif	// UDP_SEGMENT
+
+// Max number of messages per sendmmsg() call
+#define DATAGRAM_SEND_BATCH_MAX_MESSAGES 64
+// Max number of segments per GSO message (UDP_MAX_SEGMENTS of the kernel)
+#define DATAGRAM_GSO_MAX_SEGMENTS 64
+// Max payload size per GSO message
+#define DATAGRAM_GSO_MAX_BYTES 65000
+// Interval to print the statistics of send batching
+#define DATAGRAM_SEND_BATCH_STATS_INTERVAL (60 * 1000)
+
 #undef OV_LOG_TAG
 #define OV_LOG_TAG "Socket.Datagram"
 
@@ -31,20 +47,30 @@ namespace ov
 	}
 
 	bool DatagramSocket::Prepare(const SocketAddress &address, DatagramCallback datagram_callback)
+	{
+		return Prepare(address, std::move(datagram_callback), nullptr);
+	}
+
+	bool DatagramSocket::Prepare(const SocketAddress &address, DatagramCallback datagram_callback, DatagramBatchCallback batch_callback)
 	{
 		CHECK_STATE(== SocketState::Created, false);
 
+		// Callbacks must be set before the socket is added to epoll
+		_datagram_callback = std::move(datagram_callback);
+		_datagram_batch_callback = std::move(batch_callback);
+
 		if (
 			(
 				MakeNonBlocking(GetSharedPtrAs<ov::SocketAsyncInterface>()) &&
 				SetSockOpt<int>(SO_REUSEADDR, 1) &&
 				Bind(address)))
 		{
-			_datagram_callback = std::move(datagram_callback);
-
 			return true;
 		}
 
+		_datagram_callback = nullptr;
+		_datagram_batch_callback = nullptr;
+
 		Close();
 
 		return false;
@@ -63,10 +89,402 @@ namespace ov
 		return false;
 	}
 
+	bool DatagramSocket::SetSendBatching(bool enabled)
+	{
+		CHECK_STATE2(== SocketState::Created, == SocketState::Bound, false);
+
+		if (enabled == false)
+		{
+			_send_batching = false;
+			_gso_enabled = false;
+
+			return true;
+		}
+
+		// Check whether the kernel supports UDP GSO (Setting the segment size to 0 does not affect anything)
+		int segment_size = 0;
+		_gso_enabled = (::setsockopt(GetNativeHandle(), SOL_UDP, UDP_SEGMENT, &segment_size, sizeof(segment_size)) == 0);
+		_send_batching = true;
+
+		logad("Send batching is enabled (GSO: %s)", _gso_enabled ? "supported" : "not supported");
+
+		return true;
+	}
+
+	DatagramSendBatchStats DatagramSocket::GetSendBatchStats() const
+	{
+		DatagramSendBatchStats stats;
+
+		stats.syscall_count = _batch_syscall_count;
+		stats.packet_count = _batch_packet_count;
+		stats.gso_packet_count = _batch_gso_packet_count;
+
+		return stats;
+	}
+
+	void DatagramSocket::UpdateSendBatchStats(int syscall_count, int packet_count, int gso_packet_count)
+	{
+		_batch_syscall_count += syscall_count;
+		_batch_packet_count += packet_count;
+		_batch_gso_packet_count += gso_packet_count;
+
+		auto now = ov::Clock::NowMSec();
+		int64_t last_log_time = _last_stats_log_time;
+
+		if (((now - last_log_time) >= DATAGRAM_SEND_BATCH_STATS_INTERVAL) &&
+			_last_stats_log_time.compare_exchange_strong(last_log_time, now))
+		{
+			auto stats = GetSendBatchStats();
+
+			logai("Send batch stats: %" PRIu64 " packets / %" PRIu64 " syscalls (%.2f packets/syscall), GSO packets: %" PRIu64,
+				  stats.packet_count, stats.syscall_count, stats.GetPacketsPerSyscall(), stats.gso_packet_count);
+		}
+	}
+
+	bool DatagramSocket::SendBatch(const std::vector<DatagramSendBatch::Item> &items)
+	{
+		switch (GetState())
+		{
+			case SocketState::Created:
+			case SocketState::Bound:
+				break;
+
+			default:
+				return false;
+		}
+
+		// Scratch buffers are reused per thread because several threads may send through the same socket
+		static thread_local std::vector<mmsghdr> messages;
+		static thread_local std::vector<iovec> iovecs;
+		static thread_local std::vector<uint8_t> control_buffers;
+		// Index of the first item of each message
+		static thread_local std::vector<size_t> first_item_indices;
+
+		constexpr size_t control_length = CMSG_SPACE(sizeof(uint16_t));
+
+		messages.resize(DATAGRAM_SEND_BATCH_MAX_MESSAGES);
+		iovecs.resize(DATAGRAM_SEND_BATCH_MAX_MESSAGES * DATAGRAM_GSO_MAX_SEGMENTS);
+		control_buffers.resize(DATAGRAM_SEND_BATCH_MAX_MESSAGES * control_length);
+		first_item_indices.resize(DATAGRAM_SEND_BATCH_MAX_MESSAGES + 1);
+
+		// Send the datagrams that were queued earlier to keep the order
+		if (_dispatch_queue.empty() == false)
+		{
+			if (DispatchEvents() == DispatchResult::Error)
+			{
+				return false;
+			}
+		}
+
+		size_t item_index = 0;
+		const size_t item_count = items.size();
+
+		while ((item_index < item_count) && (_force_stop == false))
+		{
+			if (_dispatch_queue.empty() == false)
+			{
+				// The socket buffer is full - the remaining items will be sent by SocketPoolWorker
+				break;
+			}
+
+			// Build messages
+			size_t message_count = 0;
+			size_t iovec_index = 0;
+			int gso_packet_count = 0;
+			bool gso_enabled = _gso_enabled;
+
+			while ((item_index < item_count) && (message_count < DATAGRAM_SEND_BATCH_MAX_MESSAGES))
+			{
+				auto &first_item = items[item_index];
+				auto segment_size = first_item.data->GetLength();
+				auto &message = messages[message_count];
+				auto first_iovec = &(iovecs[iovec_index]);
+				size_t segment_count = 0;
+				size_t total_bytes = 0;
+
+				first_item_indices[message_count] = item_index;
+
+				::memset(&message, 0, sizeof(message));
+
+				// Merge datagrams that have the same destination and the same size (the last one may be smaller)
+				while (item_index < item_count)
+				{
+					auto &item = items[item_index];
+					auto length = item.data->GetLength();
+
+					if (segment_count > 0)
+					{
+						if ((gso_enabled == false) ||
+							(segment_count >= DATAGRAM_GSO_MAX_SEGMENTS) ||
+							(length > segment_size) ||
+							((total_bytes + length) > DATAGRAM_GSO_MAX_BYTES) ||
+							((item.address == first_item.address) == false))
+						{
+							break;
+						}
+					}
+
+					auto &vec = iovecs[iovec_index++];
+					vec.iov_base = const_cast<void *>(item.data->GetData());
+					vec.iov_len = length;
+
+					segment_count++;
+					total_bytes += length;
+					item_index++;
+
+					if (length < segment_size)
+					{
+						// Only the last segment can be smaller than the segment size
+						break;
+					}
+				}
+
+				message.msg_hdr.msg_name = const_cast<sockaddr *>(first_item.address.Address());
+				message.msg_hdr.msg_namelen = first_item.address.AddressLength();
+				message.msg_hdr.msg_iov = first_iovec;
+				message.msg_hdr.msg_iovlen = segment_count;
+
+				if (segment_count > 1)
+				{
+					auto control = &(control_buffers[message_count * control_length]);
+					::memset(control, 0, control_length);
+
+					message.msg_hdr.msg_control = control;
+					message.msg_hdr.msg_controllen = control_length;
+
+					auto cmsg = CMSG_FIRSTHDR(&(message.msg_hdr));
+					cmsg->cmsg_level = SOL_UDP;
+					cmsg->cmsg_type = UDP_SEGMENT;
+					cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+					*(reinterpret_cast<uint16_t *>(CMSG_DATA(cmsg))) = static_cast<uint16_t>(segment_size);
+
+					gso_packet_count += segment_count;
+				}
+
+				message_count++;
+			}
+
+			first_item_indices[message_count] = item_index;
+
+			int sent_count = ::sendmmsg(GetNativeHandle(), messages.data(), message_count, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+			if (sent_count < 0)
+			{
+				auto error = Error::CreateErrorFromErrno();
+
+				// Rewind to the first item of this round
+				item_index = first_item_indices[0];
+
+				switch (error->GetCode())
+				{
+					case EAGAIN:
+						// Socket buffer is full - the remaining items will be sent later
+						break;
+
+					case EIO:
+						[[fallthrough]];
+					case EINVAL:
+						if (gso_enabled && (gso_packet_count > 0))
+						{
+							// The NIC/route does not support GSO - send the datagrams one by one from now on
+							logaw("Could not send datagrams using GSO, GSO is disabled: %s", error->ToString().CStr());
+							_gso_enabled = false;
+							continue;
+						}
+						[[fallthrough]];
+
+					default:
+						logaw("Could not send datagrams: %s", error->ToString().CStr());
+						return false;
+				}
+
+				break;
+			}
+
+			if (sent_count == 0)
+			{
+				item_index = first_item_indices[0];
+				break;
+			}
+
+			// Count only the datagrams which are actually sent
+			int sent_gso_packet_count = 0;
+			auto sent_item_count = first_item_indices[sent_count] - first_item_indices[0];
+
+			for (int index = 0; index < sent_count; index++)
+			{
+				auto segment_count = first_item_indices[index + 1] - first_item_indices[index];
+				sent_gso_packet_count += (segment_count > 1) ? segment_count : 0;
+			}
+
+			UpdateSendBatchStats(1, sent_item_count, sent_gso_packet_count);
+
+			// If sendmmsg() sent only some of the messages, retry from the first unsent message
+			item_index = first_item_indices[sent_count];
+		}
+
+		// Items that could not be sent are sent by SocketPoolWorker when the socket becomes writable
+		for (; item_index < item_count; item_index++)
+		{
+			auto &item = items[item_index];
+
+			if (AppendCommand({item.address, item.data}) == false)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	DatagramRecvBatchStats DatagramSocket::GetRecvBatchStats() const
+	{
+		DatagramRecvBatchStats stats;
+
+		stats.syscall_count = _recv_syscall_count;
+		stats.packet_count = _recv_packet_count;
+
+		for (int index = 0; index < DatagramRecvBatchStats::BucketCount; index++)
+		{
+			stats.buckets[index] = _recv_batch_buckets[index];
+		}
+
+		return stats;
+	}
+
+	String DatagramRecvBatchStats::ToString() const
+	{
+		return String::FormatString(
+			"%" PRIu64 " packets / %" PRIu64 " syscalls, [1]: %" PRIu64 ", [2-3]: %" PRIu64 ", [4-7]: %" PRIu64 ", [8-15]: %" PRIu64 ", [16-31]: %" PRIu64 ", [32-]: %" PRIu64,
+			packet_count, syscall_count,
+			buckets[0], buckets[1], buckets[2], buckets[3], buckets[4], buckets[5]);
+	}
+
+	void DatagramSocket::UpdateRecvBatchStats(int packet_count)
+	{
+		_recv_syscall_count++;
+		_recv_packet_count += packet_count;
+		_recv_batch_buckets[DatagramRecvBatchStats::GetBucketIndex(packet_count)]++;
+	}
+
+	void DatagramSocket::DispatchDatagrams(const std::vector<DatagramPacket> &packets)
+	{
+		if (_datagram_batch_callback != nullptr)
+		{
+			_datagram_batch_callback(GetSharedPtrAs<DatagramSocket>(), packets);
+		}
+		else if (_datagram_callback != nullptr)
+		{
+			auto self = GetSharedPtrAs<DatagramSocket>();
+
+			for (auto &packet : packets)
+			{
+				_datagram_callback(self, packet.address, packet.data);
+			}
+		}
+	}
+
 	void DatagramSocket::OnReadable()
 	{
 		logtp("Trying to read UDP packets...");
 
+		ReadDatagramsInBatch();
+	}
+
+	void DatagramSocket::ReadDatagramsInBatch()
+	{
+#if !IS_MACOS
+		mmsghdr messages[UdpRecvBatchCount];
+		iovec iovecs[UdpRecvBatchCount];
+		sockaddr_storage addresses[UdpRecvBatchCount];
+
+		if (_recv_buffers.empty())
+		{
+			_recv_buffers.resize(UdpRecvBatchCount);
+			_recv_packets.reserve(UdpRecvBatchCount);
+		}
+
+		while (GetState() != SocketState::Closed)
+		{
+			for (int index = 0; index < UdpRecvBatchCount; index++)
+			{
+				auto &buffer = _recv_buffers[index];
+
+				// If the buffer is still held by an observer, allocate a new one
+				if ((buffer == nullptr) || (buffer.use_count() > 1))
+				{
+					buffer = std::make_shared<Data>(UdpBufferSize);
+				}
+
+				buffer->SetLength(UdpBufferSize);
+
+				iovecs[index].iov_base = buffer->GetWritableData();
+				iovecs[index].iov_len = buffer->GetLength();
+
+				auto &header = messages[index].msg_hdr;
+				::memset(&header, 0, sizeof(header));
+				header.msg_name = &(addresses[index]);
+				header.msg_namelen = sizeof(addresses[index]);
+				header.msg_iov = &(iovecs[index]);
+				header.msg_iovlen = 1;
+
+				messages[index].msg_len = 0;
+			}
+
+			int count = ::recvmmsg(GetNativeHandle(), messages, UdpRecvBatchCount, MSG_DONTWAIT, nullptr);
+
+			if (count < 0)
+			{
+				auto error = Error::CreateErrorFromErrno();
+
+				if (error->GetCode() == EAGAIN)
+				{
+					// Try later
+					break;
+				}
+				else if (error->GetCode() == EINTR)
+				{
+					continue;
+				}
+
+				logae("An error occurred while read data: %s", error->ToString().CStr());
+				CloseWithState(SocketState::Error);
+				break;
+			}
+
+			if (count == 0)
+			{
+				break;
+			}
+
+			UpdateRecvBatchStats(count);
+
+			for (int index = 0; index < count; index++)
+			{
+				auto &buffer = _recv_buffers[index];
+
+				buffer->SetLength(messages[index].msg_len);
+				_recv_packets.emplace_back(SocketAddress(addresses[index]), buffer);
+			}
+
+			DispatchDatagrams(_recv_packets);
+
+			// Release the references so that the buffers can be reused in the next round
+			_recv_packets.clear();
+
+			if (count < UdpRecvBatchCount)
+			{
+				// The socket buffer is drained
+				break;
+			}
+		}
+#else	// !IS_MACOS
+		ReadDatagrams();
+#endif	// !IS_MACOS
+	}
+
+	void DatagramSocket::ReadDatagrams()
+	{
 		auto data = std::make_shared<ov::Data>(UdpBufferSize);
 
 		while (true)
@@ -83,10 +501,7 @@ namespace ov
 				}
 				else
 				{
-					if (_datagram_callback != nullptr)
-					{
-						_datagram_callback(GetSharedPtrAs<DatagramSocket>(), remote, data->Clone());
-					}
+					DispatchDatagrams({{remote, data->Clone()}});
 				}
 			}
 			else
@@ -99,6 +514,20 @@ namespace ov
 
 	String DatagramSocket::ToString() const
 	{
-		return Socket::ToString("DatagramSocket");
+		auto description = Socket::ToString("DatagramSocket");
+
+		description.AppendFormat(" (recv batch: %s)", GetRecvBatchStats().ToString().CStr());
+
+		if (_send_batching)
+		{
+			auto stats = GetSendBatchStats();
+
+			description.AppendFormat(
+				" (send batch: %" PRIu64 " packets / %" PRIu64 " syscalls, gso: %s/%" PRIu64 ")",
+				stats.packet_count, stats.syscall_count,
+				_gso_enabled ? "on" : "off", stats.gso_packet_count);
+		}
+
+		return description;
 	}
 }  // namespace ov
\ No newline at end of file
@@ -8,13 +8,75 @@
 //==============================================================================
 #pragma once
 
+#include "datagram_send_batch.h"
 #include "socket.h"
 #include "socket_datastructure.h"
 
 namespace ov
 {
+	struct DatagramPacket
+	{
+		DatagramPacket(const SocketAddress &address, const std::shared_ptr<Data> &data)
+			: address(address),
+			  data(data)
+		{
+		}
+
+		SocketAddress address;
+		std::shared_ptr<Data> data;
+	};
+
+	// Called with the datagrams received by one recvmmsg() call
+	typedef std::function<void(const std::shared_ptr<ov::DatagramSocket> &client, const std::vector<DatagramPacket> &packets)> DatagramBatchCallback;
+
+	struct DatagramRecvBatchStats
+	{
+		// Histogram of the number of datagrams received per recvmmsg() call
+		// [0]: 1, [1]: 2~3, [2]: 4~7, [3]: 8~15, [4]: 16~31, [5]: 32~
+		static constexpr int BucketCount = 6;
+
+		static int GetBucketIndex(int batch_size)
+		{
+			int index = 0;
+
+			while ((batch_size > 1) && (index < (BucketCount - 1)))
+			{
+				batch_size >>= 1;
+				index++;
+			}
+
+			return index;
+		}
+
+		// Number of recvmmsg() calls that returned at least one datagram
+		uint64_t syscall_count = 0;
+		// Number of datagrams received
+		uint64_t packet_count = 0;
+		uint64_t buckets[BucketCount]{};
+
+		String ToString() const;
+	};
+
+	struct DatagramSendBatchStats
+	{
+		// Number of sendmmsg() calls
+		uint64_t syscall_count = 0;
+		// Number of datagrams sent by sendmmsg()
+		uint64_t packet_count = 0;
+		// Number of datagrams that are segmented by the kernel (UDP GSO)
+		uint64_t gso_packet_count = 0;
+
+		double GetPacketsPerSyscall() const
+		{
+			return (syscall_count == 0) ? 0.0 : static_cast<double>(packet_count) / static_cast<double>(syscall_count);
+		}
+	};
+
 	class DatagramSocket : public Socket, public SocketAsyncInterface
 	{
+	protected:
+		friend class DatagramSendBatch;
+
 	public:
 		DatagramSocket(PrivateToken token, const std::shared_ptr<SocketPoolWorker> &worker)
 			: Socket(token, worker)
@@ -27,6 +89,24 @@ namespace ov
 		bool Prepare(int port, DatagramCallback datagram_callback);
 		// address에 해당하는 주소로 bind
 		bool Prepare(const SocketAddress &address, DatagramCallback datagram_callback);
+		// If batch_callback is specified, the datagrams received at once are delivered to batch_callback instead of datagram_callback
+		bool Prepare(const SocketAddress &address, DatagramCallback datagram_callback, DatagramBatchCallback batch_callback);
+
+		// Collects the datagrams sent within DatagramSendBatch::Begin()/End() and send them using sendmmsg()
+		// If the kernel supports UDP GSO, datagrams with the same destination are merged into one message
+		bool SetSendBatching(bool enabled);
+		bool IsSendBatchingEnabled() const
+		{
+			return _send_batching;
+		}
+
+		bool IsGsoEnabled() const
+		{
+			return _gso_enabled;
+		}
+
+		DatagramSendBatchStats GetSendBatchStats() const;
+		DatagramRecvBatchStats GetRecvBatchStats() const;
 
 		using Socket::Close;
 		using Socket::Connect;
@@ -59,6 +139,36 @@ namespace ov
 			OV_ASSERT2(false);
 		}
 
+		// Called by DatagramSendBatch
+		bool SendBatch(const std::vector<DatagramSendBatch::Item> &items);
+
+		void UpdateSendBatchStats(int syscall_count, int packet_count, int gso_packet_count);
+		void UpdateRecvBatchStats(int packet_count);
+
+		// Reads datagrams one by one using recvfrom() (used when recvmmsg() is not available)
+		void ReadDatagrams();
+		// Reads up to UdpRecvBatchCount datagrams per recvmmsg() call
+		void ReadDatagramsInBatch();
+
+		void DispatchDatagrams(const std::vector<DatagramPacket> &packets);
+
 		DatagramCallback _datagram_callback = nullptr;
+		DatagramBatchCallback _datagram_batch_callback = nullptr;
+
+		// Receive buffers - only accessed in the thread of SocketPoolWorker
+		// A buffer is reused if no one holds it after the callback returns
+		std::vector<std::shared_ptr<Data>> _recv_buffers;
+		std::vector<DatagramPacket> _recv_packets;
+
+		std::atomic<uint64_t> _recv_syscall_count{0};
+		std::atomic<uint64_t> _recv_packet_count{0};
+		std::atomic<uint64_t> _recv_batch_buckets[DatagramRecvBatchStats::BucketCount]{};
+
+		std::atomic<bool> _gso_enabled{false};
+
+		std::atomic<uint64_t> _batch_syscall_count{0};
+		std::atomic<uint64_t> _batch_packet_count{0};
+		std::atomic<uint64_t> _batch_gso_packet_count{0};
+		std::atomic<int64_t> _last_stats_log_time{0};
 	};
 }  // namespace ov
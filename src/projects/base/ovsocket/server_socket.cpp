@@ -92,7 +92,9 @@ namespace ov
 
 			logad("Trying to allocate a socket for client: %s", address.ToString().CStr());
 
-			auto client = _pool->AllocSocket<ClientSocket>(GetSharedPtrAs<ServerSocket>(), client_socket, address);
+			auto client = _keep_clients_on_worker
+							  ? _pool->AllocSocketOnWorker<ClientSocket>(GetSocketPoolWorker(), GetSharedPtrAs<ServerSocket>(), client_socket, address)
+							  : _pool->AllocSocket<ClientSocket>(GetSharedPtrAs<ServerSocket>(), client_socket, address);
 
 			if (client != nullptr)
 			{
@@ -48,6 +48,13 @@ namespace ov
 
 		std::shared_ptr<ClientSocket> Accept();
 
+		// If enabled, accepted clients are allocated on the worker that owns this server socket
+		// instead of the least loaded worker of the pool (Used by SO_REUSEPORT shards)
+		void SetKeepClientsOnWorker(bool enabled)
+		{
+			_keep_clients_on_worker = enabled;
+		}
+
 		String ToString() const override;
 
 	protected:
@@ -89,6 +96,7 @@ namespace ov
 		}
 
 		std::shared_ptr<SocketPool> _pool;
+		bool _keep_clients_on_worker = false;
 
 		std::mutex _client_list_mutex;
 		std::unordered_map<const void *, std::shared_ptr<ClientSocket>> _client_list;
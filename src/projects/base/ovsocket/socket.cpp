@@ -14,10 +14,25 @@
 #include <sys/ioctl.h>
 #include <unistd.h>
 
+#if !IS_MACOS
+#	include <linux/filter.h>
+#	include <linux/tls.h>
+#	include <net/ethernet.h>
+#	include <netinet/tcp.h>
+
+#	ifndef SOL_TLS
+#		define SOL_TLS 282
+#	endif	// SOL_TLS
+#	ifndef TCP_ULP
+#		define TCP_ULP 31
+#	endif	// TCP_ULP
+#endif	// !IS_MACOS
+
 #include <algorithm>
 #include <atomic>
 #include <chrono>
 
+#include "datagram_send_batch.h"
 #include "epoll_wrapper.h"
 #include "socket_pool/socket_pool.h"
 #include "socket_private.h"
@@ -724,6 +739,141 @@ namespace ov
 		return true;
 	}
 
+	bool Socket::SetReusePort(bool enabled)
+	{
+		if (GetType() == SocketType::Srt)
+		{
+			logae("SO_REUSEPORT is not supported for SRT socket");
+			return false;
+		}
+
+		return SetSockOpt<int>(SO_REUSEPORT, enabled ? 1 : 0);
+	}
+
+	bool Socket::AttachReusePortSteering(int group_size)
+	{
+		CHECK_STATE2(== SocketState::Bound, == SocketState::Listening, false);
+
+#if IS_MACOS
+		logaw("SO_ATTACH_REUSEPORT_CBPF is not supported on this platform");
+		return false;
+#else	// IS_MACOS
+		if (group_size <= 0)
+		{
+			logae("Invalid group size: %d", group_size);
+			return false;
+		}
+
+		// When the program is executed, the transport header has already been pulled from the packet data,
+		// so BPF_ABS loads from offset 0 read the payload (and a TCP SYN has no payload at all).
+		// The ports are loaded relative to the network header (SKF_NET_OFF) instead.
+		//
+		// hash = [source port][destination port] ^ source_ip
+		// index = (((hash ^ (hash >> 16)) * golden_ratio) >> 16) % group_size
+		//
+		// (The upper half is folded into the lower half before multiplying, otherwise the source port barely
+		// affects the result - Linux assigns even ephemeral ports to the TCP connections)
+		//
+		// For IPv6, the extension headers are not considered (the transport header is expected at +40),
+		// and the last 4 bytes of the source address are used.
+		// (The destination address is the same for all sockets in the group)
+		struct sock_filter code[] = {
+			// A = skb->protocol
+			BPF_STMT(BPF_LD | BPF_H | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_PROTOCOL)),
+			// if (A != ETHERTYPE_IP) goto ipv6
+			BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ETHERTYPE_IP, 0, 6),
+
+			// X = (IPv4 header length) = 4 * (network_header[0] & 0x0F)
+			BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, static_cast<uint32_t>(SKF_NET_OFF)),
+			// A = *(uint32_t *)(network_header + X) - ports
+			BPF_STMT(BPF_LD | BPF_W | BPF_IND, static_cast<uint32_t>(SKF_NET_OFF)),
+			// X = A
+			BPF_STMT(BPF_MISC | BPF_TAX, 0),
+			// A = source IP
+			BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_NET_OFF + 12)),
+			// A ^= X
+			BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+			// goto hash
+			BPF_JUMP(BPF_JMP | BPF_JA, 5, 0, 0),
+
+			// ipv6: X = (IPv6 header length)
+			BPF_STMT(BPF_LDX | BPF_W | BPF_IMM, 40),
+			// A = *(uint32_t *)(network_header + X) - ports
+			BPF_STMT(BPF_LD | BPF_W | BPF_IND, static_cast<uint32_t>(SKF_NET_OFF)),
+			// X = A
+			BPF_STMT(BPF_MISC | BPF_TAX, 0),
+			// A = the last 4 bytes of the source address
+			BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_NET_OFF + 20)),
+			// A ^= X
+			BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+
+			// hash: A ^= (A >> 16)
+			BPF_STMT(BPF_MISC | BPF_TAX, 0),
+			BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 16),
+			BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+			BPF_STMT(BPF_ALU | BPF_MUL | BPF_K, 0x9E3779B1),
+			BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 16),
+			BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, static_cast<uint32_t>(group_size)),
+			// return A
+			BPF_STMT(BPF_RET | BPF_A, 0)};
+
+		struct sock_fprog program = {
+			.len = static_cast<unsigned short>(OV_COUNTOF(code)),
+			.filter = code};
+
+		if (SetSockOpt(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) == false)
+		{
+			logaw("Could not attach the steering program, the kernel's default hash will be used");
+			return false;
+		}
+
+		logad("Steering program is attached (group size: %d)", group_size);
+
+		return true;
+#endif	// IS_MACOS
+	}
+
+	bool Socket::EnableKernelTlsTx(const void *crypto_info, size_t length)
+	{
+		CHECK_STATE(== SocketState::Connected, false);
+
+#if IS_MACOS
+		return false;
+#else	// IS_MACOS
+		if (GetType() != SocketType::Tcp)
+		{
+			return false;
+		}
+
+		std::lock_guard lock_guard(_dispatch_queue_lock);
+
+		if (HasCommand())
+		{
+			// Records encrypted in userspace are still waiting to be sent, so the kernel cannot take over the sequence
+			logad("Could not enable kTLS: %zu commands are waiting to be sent", _dispatch_queue.size());
+			return false;
+		}
+
+		if (::setsockopt(GetNativeHandle(), SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0)
+		{
+			// ENOENT: The tls module is not loaded
+			logad("Could not attach the tls ULP: %s", Error::CreateErrorFromErrno()->ToString().CStr());
+			return false;
+		}
+
+		// If TLS_TX fails, the socket works as a plain TCP socket even though the tls ULP is attached
+		if (::setsockopt(GetNativeHandle(), SOL_TLS, TLS_TX, crypto_info, static_cast<socklen_t>(length)) != 0)
+		{
+			logad("Could not set the TX key for kTLS: %s", Error::CreateErrorFromErrno()->ToString().CStr());
+			return false;
+		}
+
+		logad("kTLS TX is enabled");
+
+		return true;
+#endif	// IS_MACOS
+	}
+
 	bool Socket::SetSockOpt(int option, const void *value, socklen_t value_length)
 	{
 		return SetSockOpt(SOL_SOCKET, option, value, value_length);
@@ -1352,6 +1502,12 @@ namespace ov
 				{
 					CHECK_STATE2(== SocketState::Created, == SocketState::Bound, false);
 
+					if (_send_batching && DatagramSendBatch::Append(GetSharedPtr(), address, data))
+					{
+						// The data will be sent when DatagramSendBatch::End() is called
+						return true;
+					}
+
 					// We don't have to be accurate here, because we'll acquire lock of _dispatch_queue_lock in DispatchEvents()
 					if (_dispatch_queue.empty() == false)
 					{
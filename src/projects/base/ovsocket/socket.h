@@ -109,6 +109,19 @@ namespace ov
 
 		bool SetRecvTimeout(const timeval &tv);
 
+		// Allow multiple sockets to bind to the same address (must be called before Bind())
+		bool SetReusePort(bool enabled);
+		// Attach a classic BPF program to the SO_REUSEPORT group of this socket that selects
+		// a socket by hashing the remote address/port, so that a 4-tuple always lands on the same socket.
+		// This socket must be already bound, and group_size must be the number of sockets in the group.
+		bool AttachReusePortSteering(int group_size);
+
+		// Hands the TX keys of an established TLS session to the kernel (kTLS), so that the data passed to Send() is encrypted by the kernel.
+		// crypto_info must be one of tls12_crypto_info_* in <linux/tls.h>.
+		// Returns false if kTLS is not available (ex: the tls module is not loaded) or data is waiting to be sent,
+		// in this case, the caller must keep encrypting the data in userspace.
+		bool EnableKernelTlsTx(const void *crypto_info, size_t length);
+
 		std::shared_ptr<SocketAddress> GetLocalAddress() const;
 		std::shared_ptr<SocketAddress> GetRemoteAddress() const;
 
@@ -465,6 +478,9 @@ namespace ov
 
 		volatile bool _force_stop = false;
 
+		// Used by DatagramSocket - if true, SendTo() collects the datagram into DatagramSendBatch if available
+		std::atomic<bool> _send_batching{false};
+
 		ov::String _stream_id;	// only available for SRT socket
 	};
 }  // namespace ov
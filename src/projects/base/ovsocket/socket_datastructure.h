@@ -47,6 +47,8 @@ namespace ov
 
 	const ssize_t TcpBufferSize = 4096;
 	const ssize_t UdpBufferSize = 4096;
+	// Max number of datagrams read per recvmmsg() call
+	constexpr const int UdpRecvBatchCount = 32;
 
 	enum class SocketConnectionState : int8_t
 	{
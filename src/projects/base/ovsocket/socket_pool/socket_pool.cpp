@@ -102,6 +102,28 @@ namespace ov
 		return _initialized;
 	}
 
+	bool SocketPool::PinWorkersToCpus()
+	{
+		auto cpu_count = static_cast<int>(::sysconf(_SC_NPROCESSORS_ONLN));
+
+		if (cpu_count <= 0)
+		{
+			logaw("Could not obtain the number of CPUs");
+			return false;
+		}
+
+		std::lock_guard lock_guard(_worker_list_mutex);
+
+		bool result = true;
+
+		for (auto &worker : _worker_list)
+		{
+			result &= worker->SetCpuAffinity(_next_cpu_index++ % cpu_count);
+		}
+
+		return result;
+	}
+
 	bool SocketPool::UninitializeInternal()
 	{
 		for (auto worker : _worker_list)
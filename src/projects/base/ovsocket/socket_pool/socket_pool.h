@@ -110,6 +110,47 @@ namespace ov
 			return nullptr;
 		}
 
+		// Allocate a socket on the specified worker instead of the least loaded worker
+		// (Used to keep the sockets of a SO_REUSEPORT shard on the same worker)
+		template <typename Tsocket = ov::Socket, typename... Targuments>
+		std::shared_ptr<Tsocket> AllocSocketOnWorker(const std::shared_ptr<SocketPoolWorker> &worker, Targuments... args)
+		{
+			if (worker == nullptr)
+			{
+				return nullptr;
+			}
+
+			worker->IncreaseSocketCount();
+
+			auto socket = worker->AllocSocket<Tsocket>(args...);
+
+			if (socket == nullptr)
+			{
+				// Rollback
+				worker->DecreaseSocketCount();
+			}
+
+			return socket;
+		}
+
+		std::shared_ptr<SocketPoolWorker> GetWorker(int index) const
+		{
+			std::lock_guard lock_guard(_worker_list_mutex);
+
+			if ((index < 0) || (index >= static_cast<int>(_worker_list.size())))
+			{
+				return nullptr;
+			}
+
+			return _worker_list[index];
+		}
+
+		// Pin each worker to a different CPU
+		//
+		// CPUs are assigned in a round-robin manner across all socket pools,
+		// so that the workers of several pinned pools are spread over the cores
+		bool PinWorkersToCpus();
+
 		bool ReleaseSocket(const std::shared_ptr<Socket> &socket)
 		{
 			return socket->GetSocketPoolWorker()->ReleaseSocket(socket);
@@ -147,6 +188,9 @@ namespace ov
 
 		bool _initialized = false;
 
+		// The next CPU to be assigned by PinWorkersToCpus()
+		inline static std::atomic<int> _next_cpu_index{0};
+
 		mutable std::mutex _worker_list_mutex;
 		std::vector<std::shared_ptr<SocketPoolWorker>> _worker_list;
 	};
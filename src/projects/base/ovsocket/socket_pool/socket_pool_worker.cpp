@@ -64,6 +64,37 @@ namespace ov
 		return true;
 	}
 
+	bool SocketPoolWorker::SetCpuAffinity(int cpu_index)
+	{
+		if (_epoll_thread.joinable() == false)
+		{
+			logae("Epoll thread is not running");
+			return false;
+		}
+
+#if IS_MACOS
+		logaw("CPU affinity is not supported on this platform");
+		return false;
+#else	// IS_MACOS
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		CPU_SET(cpu_index, &cpu_set);
+
+		auto result = ::pthread_setaffinity_np(_epoll_thread.native_handle(), sizeof(cpu_set), &cpu_set);
+
+		if (result != 0)
+		{
+			logaw("Could not pin the worker to CPU #%d: %s (%d)", cpu_index, ::strerror(result), result);
+			return false;
+		}
+
+		logad("Worker is pinned to CPU #%d", cpu_index);
+		_cpu_index = cpu_index;
+
+		return true;
+#endif	// IS_MACOS
+	}
+
 	bool SocketPoolWorker::Uninitialize()
 	{
 		if (GetNativeHandle() == InvalidSocket)
@@ -794,8 +825,8 @@ namespace ov
 		String description;
 
 		description.AppendFormat(
-			"<SocketPoolWorker: %p, socket_map: %zu, insert queue: %zu, delete queue: %zu, connection queue: %zu>",
-			this, _socket_map.size(),
+			"<SocketPoolWorker: %p, cpu: %d, socket_map: %zu, insert queue: %zu, delete queue: %zu, connection queue: %zu>",
+			this, _cpu_index, _socket_map.size(),
 			_sockets_to_insert.Size(), _sockets_to_delete.Size(),
 			_connection_timed_out_queue.size());
 
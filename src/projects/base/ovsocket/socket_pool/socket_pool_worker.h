@@ -33,6 +33,13 @@ namespace ov
 
 		int GetNativeHandle() const;
 
+		// Pin the epoll thread to the CPU
+		bool SetCpuAffinity(int cpu_index);
+		int GetCpuAffinity() const
+		{
+			return _cpu_index;
+		}
+
 		template <typename Tsocket = ov::Socket, typename... Targuments>
 		std::shared_ptr<Tsocket> AllocSocket(Targuments... args)
 		{
@@ -123,6 +130,8 @@ namespace ov
 		// Common variables
 		std::thread _epoll_thread;
 		bool _stop_epoll_thread = true;
+		// -1 == Not pinned
+		int _cpu_index = -1;
 		std::vector<epoll_event> _epoll_events;
 		int _last_epoll_event_count = 0;
 
@@ -5,141 +5,6 @@
 
 namespace pub
 {
-	ApplicationWorker::ApplicationWorker(uint32_t worker_id, ov::String worker_name)
-		: _stream_data_queue(nullptr, 500),
-		_incoming_packet_queue(nullptr, 500)
-	{
-		_worker_id = worker_id;
-		_worker_name = worker_name;
-		_stop_thread_flag = false;
-	}
-
-	bool ApplicationWorker::Start()
-	{
-		_stop_thread_flag = false;
-		_worker_thread = std::thread(&ApplicationWorker::WorkerThread, this);
-		pthread_setname_np(_worker_thread.native_handle(), "AppWorker");
-
-		ov::String queue_name;
-
-		queue_name.Format("%s - Stream Data Queue", _worker_name.CStr());
-		_stream_data_queue.SetAlias(queue_name.CStr());
-
-		queue_name.Format("%s - Incoming Packet Queue", _worker_name.CStr());
-		_incoming_packet_queue.SetAlias(queue_name.CStr());
-
-		logti("%s ApplicationWorker has been created", _worker_name.CStr());
-
-		return true;
-	}
-
-	bool ApplicationWorker::Stop()
-	{
-		if(_stop_thread_flag == true)
-		{
-			return true;
-		}
-
-		_stream_data_queue.Clear();
-		_incoming_packet_queue.Clear();
-
-		_stop_thread_flag = true;
-
-		_queue_event.Notify();
-
-		if (_worker_thread.joinable())
-		{
-			_worker_thread.join();
-		}
-
-		return true;
-	}
-
-	bool ApplicationWorker::PushMediaPacket(const std::shared_ptr<Stream> &stream, const std::shared_ptr<MediaPacket> &media_packet)
-	{
-		auto data = std::make_shared<ApplicationWorker::StreamData>(stream, media_packet);
-		_stream_data_queue.Enqueue(std::move(data));
-
-		_queue_event.Notify();
-
-		return true;
-	}
-
-	bool ApplicationWorker::PushNetworkPacket(const std::shared_ptr<Session> &session, const std::shared_ptr<const ov::Data> &data)
-	{
-		auto packet = std::make_shared<ApplicationWorker::IncomingPacket>(session, data);
-		_incoming_packet_queue.Enqueue(std::move(packet));
-
-		_queue_event.Notify();
-
-		return true;
-	}
-
-	std::shared_ptr<ApplicationWorker::StreamData> ApplicationWorker::PopStreamData()
-	{
-		if (_stream_data_queue.IsEmpty())
-		{
-			return nullptr;
-		}
-
-		auto data = _stream_data_queue.Dequeue(0);
-		if(data.has_value())
-		{
-			return data.value();
-		}
-
-		return nullptr;
-	}
-
-	std::shared_ptr<ApplicationWorker::IncomingPacket> ApplicationWorker::PopIncomingPacket()
-	{
-		if (_incoming_packet_queue.IsEmpty())
-		{
-			return nullptr;
-		}
-
-		auto data = _incoming_packet_queue.Dequeue(0);
-		if(data.has_value())
-		{
-			return data.value();
-		}
-		
-		return nullptr;
-	}
-
-	void ApplicationWorker::WorkerThread()
-	{
-		while (!_stop_thread_flag)
-		{
-			_queue_event.Wait();
-
-			// Check media data is available
-			auto stream_data = PopStreamData();
-			if ((stream_data != nullptr) && (stream_data->_stream != nullptr) && (stream_data->_media_packet != nullptr))
-			{
-				if(stream_data->_media_packet->GetMediaType() == cmn::MediaType::Video)
-				{
-					stream_data->_stream->SendVideoFrame(stream_data->_media_packet);
-				}
-				else if(stream_data->_media_packet->GetMediaType() == cmn::MediaType::Audio)
-				{
-					stream_data->_stream->SendAudioFrame(stream_data->_media_packet);
-				}
-				else
-				{
-					// Nothing can do
-				}
-			}
-
-			// Check incoming packet is available
-			std::shared_ptr<IncomingPacket> packet = PopIncomingPacket();
-			if (packet)
-			{
-				packet->_session->OnPacketReceived(packet->_session, packet->_data);
-			}
-		}
-	}
-
 	Application::Application(const std::shared_ptr<Publisher> &publisher, const info::Application &application_info)
 		: info::Application(application_info)
 	{
@@ -168,33 +33,6 @@ namespace pub
 
 	bool Application::Start()
 	{
-		_application_worker_count = GetConfig().GetStreamLoadBalancingThreadCount();
-		if(_application_worker_count < MIN_APPLICATION_WORKER_COUNT)
-		{
-			_application_worker_count = MIN_APPLICATION_WORKER_COUNT;
-		}
-		if(_application_worker_count > MAX_APPLICATION_WORKER_COUNT)
-		{
-			_application_worker_count = MIN_APPLICATION_WORKER_COUNT;
-		}
-		
-		std::lock_guard<std::shared_mutex> worker_lock(_application_worker_lock);
-
-		for(uint32_t i = 0; i < _application_worker_count; i++)
-		{
-			auto worker_name = ov::String::FormatString("%s/%s/%d", GetApplicationTypeName(), GetName().CStr(), i);
-			auto app_worker = std::make_shared<ApplicationWorker>(i, worker_name.CStr());
-			if (app_worker->Start() == false)
-			{
-				logte("Cannot create ApplicationWorker (%s)", worker_name.CStr());
-				Stop();
-
-				return false;
-			}
-
-			_application_workers.push_back(app_worker);
-		}
-
 		logti("%s has created [%s] application", GetApplicationTypeName(), GetName().CStr());
 
 		return true;
@@ -202,15 +40,6 @@ namespace pub
 
 	bool Application::Stop()
 	{
-		std::unique_lock<std::shared_mutex> worker_lock(_application_worker_lock);
-		for(const auto &worker : _application_workers)
-		{
-			worker->Stop();
-		}
-
-		_application_workers.clear();
-		worker_lock.unlock();
-
 		// release remaining streams
 		DeleteAllStreams();
 
@@ -303,41 +132,86 @@ namespace pub
 		return true;
 	}
 
-	std::shared_ptr<ApplicationWorker> Application::GetWorkerByStreamID(info::stream_id_t stream_id)
+	void Application::SendFrame(const std::shared_ptr<Stream> &stream, const std::shared_ptr<MediaPacket> &media_packet)
 	{
-		if(_application_worker_count == 0)
+		if(media_packet->GetMediaType() == cmn::MediaType::Video)
 		{
-			return nullptr;
+			stream->SendVideoFrame(media_packet);
+		}
+		else if(media_packet->GetMediaType() == cmn::MediaType::Audio)
+		{
+			stream->SendAudioFrame(media_packet);
+		}
+		else
+		{
+			// Nothing can do
 		}
-
-		std::shared_lock<std::shared_mutex> worker_lock(_application_worker_lock);
-		return _application_workers[stream_id % _application_worker_count];
 	}
 
 	bool Application::OnSendFrame(const std::shared_ptr<info::Stream> &stream,
 									   const std::shared_ptr<MediaPacket> &media_packet)
 	{
-		auto application_worker = GetWorkerByStreamID(stream->GetId());
-		if(application_worker == nullptr)
+		auto publisher_stream = GetStream(stream->GetId());
+		if((publisher_stream == nullptr) || (media_packet == nullptr))
 		{
 			return false;
 		}
 
-		return application_worker->PushMediaPacket(GetStream(stream->GetId()), media_packet);
+		// The stream owns the serial executor, so keep a weak reference to avoid a circular reference
+		std::weak_ptr<Stream> stream_ref = publisher_stream;
+
+		return publisher_stream->GetSerialExecutor()->Post([stream_ref, media_packet]() {
+			auto stream = stream_ref.lock();
+			if(stream != nullptr)
+			{
+				SendFrame(stream, media_packet);
+			}
+		});
+	}
+
+	bool Application::OnSendFrames(const std::shared_ptr<info::Stream> &stream,
+								   const std::vector<std::shared_ptr<MediaPacket>> &media_packets)
+	{
+		// Look up the stream once for the whole batch
+		auto publisher_stream = GetStream(stream->GetId());
+		if(publisher_stream == nullptr)
+		{
+			return false;
+		}
+
+		std::weak_ptr<Stream> stream_ref = publisher_stream;
+
+		return publisher_stream->GetSerialExecutor()->Post([stream_ref, media_packets]() {
+			auto stream = stream_ref.lock();
+			if(stream == nullptr)
+			{
+				return;
+			}
+
+			for (const auto &media_packet : media_packets)
+			{
+				if(media_packet != nullptr)
+				{
+					SendFrame(stream, media_packet);
+				}
+			}
+		});
 	}
-	
 
 	bool Application::PushIncomingPacket(const std::shared_ptr<info::Session> &session_info,
 										 const std::shared_ptr<const ov::Data> &data)
 	{
-		auto stream_id = session_info->GetStream().GetId();
-		auto application_worker = GetWorkerByStreamID(stream_id);
-		if(application_worker == nullptr)
+		auto stream = GetStream(session_info->GetStream().GetId());
+		if(stream == nullptr)
 		{
 			return false;
 		}
 
-		return application_worker->PushNetworkPacket(std::static_pointer_cast<Session>(session_info), data);
+		auto session = std::static_pointer_cast<Session>(session_info);
+
+		return stream->GetSerialExecutor()->Post([session, data]() {
+			session->OnPacketReceived(session, data);
+		});
 	}
 
 	uint32_t Application::GetStreamCount()
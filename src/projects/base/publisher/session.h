@@ -28,6 +28,9 @@ namespace pub
 		virtual bool Stop();
 		
 		virtual bool SendOutgoingData(const std::any &packet) = 0;
+		// Called by the stream worker after it has delivered a batch of packets with SendOutgoingData()
+		// (ex: sends the packets which are held by the pacer of the session)
+		virtual void FlushOutgoingData() {}
 		virtual void OnPacketReceived(const std::shared_ptr<info::Session> &session_info, const std::shared_ptr<const ov::Data> &data) = 0;
 
 		enum class SessionState : int8_t
@@ -2,10 +2,16 @@
 #include "application.h"
 #include "publisher_private.h"
 
+#include <base/ovsocket/datagram_send_batch.h>
+
+// There is a worker per session partition of each stream, so the ring is kept small
+// (A burst larger than the ring, such as the packets of a large keyframe, goes to the overflow list of the queue)
+#define STREAM_WORKER_QUEUE_CAPACITY 256
+
 namespace pub
 {
 	StreamWorker::StreamWorker(const std::shared_ptr<Stream> &parent_stream)
-		: _packet_queue(nullptr, 500)
+		: _packet_queue(nullptr, 500, 5000, STREAM_WORKER_QUEUE_CAPACITY)
 	{
 		_stop_thread_flag = true;
 		_parent = parent_stream;
@@ -27,10 +33,14 @@ namespace pub
 
 		queue_name.Format("%s/%s/%s StreamWorker Queue", _parent->GetApplicationTypeName(), _parent->GetApplicationName(), _parent->GetName().CStr());
 		_packet_queue.SetAlias(queue_name.CStr());
-		
+
+		_serial_executor = ov::SerialExecutor::Create(_parent->GetExecutor(), queue_name.CStr());
+		if (_serial_executor == nullptr)
+		{
+			return false;
+		}
+
 		_stop_thread_flag = false;
-		_worker_thread = std::thread(&StreamWorker::WorkerThread, this);
-		pthread_setname_np(_worker_thread.native_handle(), "StreamWorker");
 
 		return true;
 	}
@@ -43,13 +53,12 @@ namespace pub
 		}
 
 		_stop_thread_flag = true;
-		// Generate Event
+
+		// Wait for DrainPackets() to finish
+		_serial_executor->Stop();
+
 		_packet_queue.Stop();
-		_queue_event.Notify();
-		if(_worker_thread.joinable())
-		{
-			_worker_thread.join();
-		}
+		_packet_queue.Clear();
 
 		std::lock_guard<std::shared_mutex> lock(_session_map_mutex);
 		for (auto const &x : _sessions)
@@ -100,6 +109,12 @@ namespace pub
 		return true;
 	}
 
+	bool StreamWorker::DetachSession(session_id_t id)
+	{
+		std::lock_guard<std::shared_mutex> lock(_session_map_mutex);
+		return _sessions.erase(id) > 0;
+	}
+
 	std::shared_ptr<Session> StreamWorker::GetSession(session_id_t id)
 	{
 		std::shared_lock<std::shared_mutex> lock(_session_map_mutex);
@@ -114,40 +129,55 @@ namespace pub
 
 	void StreamWorker::SendPacket(const std::any &packet)
 	{
-		_packet_queue.Enqueue(packet);
-		_queue_event.Notify();
-	}
+		if (_stop_thread_flag)
+		{
+			return;
+		}
 
-	std::any StreamWorker::PopStreamPacket()
-	{
-		if (_packet_queue.IsEmpty())
+		if (_packet_queue.Enqueue(packet))
 		{
-			return nullptr;
+			std::weak_ptr<StreamWorker> worker_ref = GetSharedPtr();
+
+			_serial_executor->Post([worker_ref]() {
+				auto worker = worker_ref.lock();
+
+				if (worker != nullptr)
+				{
+					worker->DrainPackets();
+				}
+			});
 		}
+	}
 
-		auto data = _packet_queue.Dequeue();
+	std::any StreamWorker::PopStreamPacket()
+	{
+		auto data = _packet_queue.TryDequeue();
 		if(data.has_value())
 		{
 			return data.value();
 		}
 
-		return nullptr;
+		return {};
 	}
 
-	void StreamWorker::WorkerThread()
+	void StreamWorker::DrainPackets()
 	{
 		std::shared_lock<std::shared_mutex> session_lock(_session_map_mutex, std::defer_lock);
 
-		while (!_stop_thread_flag)
-		{
-			_queue_event.Wait();
+		// Drain all the packets queued so far (usually the packets of a frame),
+		// so that the datagrams of the sessions are flushed together with sendmmsg()
+		ov::DatagramSendBatchScope send_batch;
 
+		while ((!_stop_thread_flag) && (_packet_queue.IsEmpty() == false))
+		{
 			auto packet = PopStreamPacket();
 			if (!packet.has_value())
 			{
+				// A producer has not finished enqueuing yet
+				std::this_thread::yield();
 				continue;
 			}
-			
+
 			session_lock.lock();
 			for (auto const &x : _sessions)
 			{
@@ -156,6 +186,18 @@ namespace pub
 			}
 			session_lock.unlock();
 		}
+
+		if (_stop_thread_flag)
+		{
+			return;
+		}
+
+		// The sessions which hold the packets (ex: paced by the bandwidth of the viewer) send them on this worker too
+		session_lock.lock();
+		for (auto const &x : _sessions)
+		{
+			x.second->FlushOutgoingData();
+		}
 	}
 
 	Stream::Stream(const std::shared_ptr<Application> application, const info::Stream &info)
@@ -164,6 +206,13 @@ namespace pub
 		_application = application;
 		_last_issued_session_id = 100;
 		_state = State::CREATED;
+
+		// The streams which can block on I/O must not stall the streams on the shared executor
+		_executor = application->IsBlockingIo() ? ov::WorkStealingExecutor::GetBlockingInstance() : ov::WorkStealingExecutor::GetSharedInstance();
+
+		_serial_executor = ov::SerialExecutor::Create(
+			_executor,
+			ov::String::FormatString("%s/%s - Publisher stream", GetApplicationName(), GetName().CStr()).CStr());
 	}
 
 	Stream::~Stream()
@@ -230,6 +279,9 @@ namespace pub
 
 	bool Stream::Stop()
 	{
+		// Wait for the frame being sent, and discard the pending frames
+		_serial_executor->Stop();
+
 		std::unique_lock<std::shared_mutex> worker_lock(_stream_worker_lock);
 
 		if (_state != State::STARTED)
@@ -239,6 +291,20 @@ namespace pub
 
 		_state = State::STOPPED;
 
+		// The attached sessions are owned by other streams, so they must not be stopped with this stream
+		{
+			std::lock_guard<std::shared_mutex> attached_session_lock(_attached_session_map_mutex);
+			for (const auto &x : _attached_sessions)
+			{
+				auto worker = GetWorkerBySessionID(x.first);
+				if (worker != nullptr)
+				{
+					worker->DetachSession(x.first);
+				}
+			}
+			_attached_sessions.clear();
+		}
+
 		for(const auto &worker : _stream_workers)
 		{
 			worker->Stop();
@@ -342,6 +408,44 @@ namespace pub
 		return _sessions.size();
 	}
 
+	bool Stream::AttachSession(const std::shared_ptr<Session> &session)
+	{
+		if (_state != State::STARTED)
+		{
+			return false;
+		}
+
+		std::lock_guard<std::shared_mutex> attached_session_lock(_attached_session_map_mutex);
+		_attached_sessions[session->GetId()] = session;
+
+		if (_worker_count > 0)
+		{
+			return GetWorkerBySessionID(session->GetId())->AddSession(session);
+		}
+
+		return true;
+	}
+
+	bool Stream::DetachSession(session_id_t id)
+	{
+		std::lock_guard<std::shared_mutex> attached_session_lock(_attached_session_map_mutex);
+		if (_attached_sessions.erase(id) == 0)
+		{
+			return false;
+		}
+
+		if (_worker_count > 0)
+		{
+			auto worker = GetWorkerBySessionID(id);
+			if (worker != nullptr)
+			{
+				worker->DetachSession(id);
+			}
+		}
+
+		return true;
+	}
+
 	bool Stream::BroadcastPacket(const std::any &packet)
 	{
 		if(_worker_count > 0)
@@ -360,6 +464,13 @@ namespace pub
 				auto session = std::static_pointer_cast<Session>(x.second);
 				session->SendOutgoingData(packet);
 			}
+			session_lock.unlock();
+
+			std::shared_lock<std::shared_mutex> attached_session_lock(_attached_session_map_mutex);
+			for (auto const &x : _attached_sessions)
+			{
+				x.second->SendOutgoingData(packet);
+			}
 		}
 	
 		return true;
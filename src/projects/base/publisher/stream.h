@@ -10,7 +10,9 @@
 
 namespace pub
 {
-	class StreamWorker
+	// Delivers the packets to a group of sessions of the stream.
+	// The packets are processed on the shared work-stealing executor, in order.
+	class StreamWorker : public ov::EnableSharedFromThis<StreamWorker>
 	{
 	public:
 		StreamWorker(const std::shared_ptr<Stream> &parent_stream);
@@ -21,22 +23,25 @@ namespace pub
 
 		bool AddSession(std::shared_ptr<Session> session);
 		bool RemoveSession(session_id_t id);
+		// Removes the session without stopping it (The session is owned by another stream)
+		bool DetachSession(session_id_t id);
 		std::shared_ptr<Session> GetSession(session_id_t id);
 
 		void SendPacket(const std::any &packet);
 
 	private:
-		void WorkerThread();
+		// Sends all packets queued so far to the sessions
+		void DrainPackets();
 
 		std::map<session_id_t, std::shared_ptr<Session>> _sessions;
 		std::shared_mutex _session_map_mutex;
-		ov::Semaphore _queue_event;
 
 		std::any PopStreamPacket();
-		ov::Queue<std::any> _packet_queue;
+		// DrainPackets() is posted only when the queue becomes non-empty
+		ov::MpscQueue<std::any> _packet_queue;
+		std::shared_ptr<ov::SerialExecutor> _serial_executor;
 
-		bool _stop_thread_flag;
-		std::thread _worker_thread;
+		std::atomic<bool> _stop_thread_flag;
 
 		std::shared_ptr<Stream> _parent;
 	};
@@ -62,6 +67,12 @@ namespace pub
 		const std::map<session_id_t, std::shared_ptr<Session>> GetAllSessions();
 		uint32_t GetSessionCount();
 
+		// Delivers the packets of this stream to a session of another stream as well.
+		// The session is not owned by this stream: it is neither stopped nor counted by this stream.
+		// (ex: A WebRTC session moves between the renditions of the same input stream)
+		bool AttachSession(const std::shared_ptr<Session> &session);
+		bool DetachSession(session_id_t id);
+
 		// A child call this function to delivery packet to all sessions
 		bool BroadcastPacket(const std::any &packet);
 
@@ -76,6 +87,18 @@ namespace pub
 
 		bool CreateStreamWorker(uint32_t worker_count);
 
+		// The frames of the stream are processed on this executor, in order
+		const std::shared_ptr<ov::SerialExecutor> &GetSerialExecutor() const
+		{
+			return _serial_executor;
+		}
+
+		// The executor which runs the serial executors of the stream and its workers
+		const std::shared_ptr<ov::WorkStealingExecutor> &GetExecutor() const
+		{
+			return _executor;
+		}
+
 		uint32_t IssueUniqueSessionId();
 
 		std::shared_ptr<Application> GetApplication();
@@ -95,11 +118,17 @@ namespace pub
 		std::map<session_id_t, std::shared_ptr<Session>> _sessions;
 		std::shared_mutex _session_map_mutex;
 
+		// Sessions of other streams which receive the packets of this stream
+		std::map<session_id_t, std::shared_ptr<Session>> _attached_sessions;
+		std::shared_mutex _attached_session_map_mutex;
+
 		uint32_t _worker_count;
 		
 		std::shared_mutex _stream_worker_lock;
 		std::vector<std::shared_ptr<StreamWorker>>	_stream_workers;
 		std::shared_ptr<Application> _application;
+		std::shared_ptr<ov::WorkStealingExecutor> _executor;
+		std::shared_ptr<ov::SerialExecutor> _serial_executor;
 
 		session_id_t _last_issued_session_id;
 
@@ -0,0 +1,6 @@
+LOCAL_PATH := $(call get_local_path)
+
+# The benchmarks are built only by "make bench"
+ifneq ($(filter bench,$(MAKECMDGOALS)),)
+include $(BUILD_SUB_AMS)
+endif
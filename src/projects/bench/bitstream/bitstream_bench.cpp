@@ -0,0 +1,301 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+//
+// Measures the throughput of the Annex-B scanning of NalUnitScanner and the converters which use it
+//
+// Usage: bench_bitstream [<bitstream size in KB>] [<iteration count>]
+//
+// - byte loop: compares every byte with the start code, like the converters did before NalUnitScanner
+// - FindAnnexBStartCode: splits the bitstream with the kernel selected for the CPU (see "kernel:")
+// - RemoveEmulationPrevention/InsertEmulationPrevention: converts between RBSP and the payload of the NAL unit
+// - ConvertAnnexbToAvcc: H264Converter, which splits the bitstream with FindAnnexBStartCode
+// - ConvertAvccToAnnexb (escape): H264Converter with the NAL units which were not escaped by the encoder
+//
+// The bitstream is made of random NAL units which are escaped by InsertEmulationPrevention(), so the bench also checks that
+// both scanners find the same start codes, and that the escaping is reversed by RemoveEmulationPrevention().
+//
+#include <modules/bitstream/h264/h264_converter.h>
+#include <modules/bitstream/nalu/nal_unit_scanner.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+	struct Result
+	{
+		double seconds = 0.0;
+		bool valid = false;
+	};
+
+	// Random RBSP with many zero bytes, so the escaping is exercised as well
+	std::vector<uint8_t> MakeRbsp(std::mt19937 &random, size_t length)
+	{
+		std::vector<uint8_t> rbsp(length);
+
+		for (auto &value : rbsp)
+		{
+			auto number = random();
+			value = ((number & 0x0F) == 0) ? 0x00 : static_cast<uint8_t>(number >> 8);
+		}
+
+		return rbsp;
+	}
+
+	// The offsets of the start codes (00 00 01) found by checking every byte
+	std::vector<size_t> SplitByByteLoop(const uint8_t *bitstream, size_t length)
+	{
+		std::vector<size_t> offset_list;
+
+		for (size_t offset = 0; offset + 3 <= length; offset++)
+		{
+			if ((bitstream[offset] == 0x00) && (bitstream[offset + 1] == 0x00) && (bitstream[offset + 2] == 0x01))
+			{
+				offset_list.push_back(offset);
+				offset += 2;
+			}
+		}
+
+		return offset_list;
+	}
+
+	std::vector<size_t> SplitByScanner(const uint8_t *bitstream, size_t length)
+	{
+		std::vector<size_t> offset_list;
+		size_t offset = 0;
+
+		while (offset < length)
+		{
+			size_t start_code_size = 0;
+			auto position = NalUnitScanner::FindAnnexBStartCode(bitstream + offset, length - offset, start_code_size);
+
+			if (position < 0)
+			{
+				break;
+			}
+
+			// Offset of 00 00 01, to compare with the byte loop
+			offset += position + start_code_size - 3;
+			offset_list.push_back(offset);
+			offset += 3;
+		}
+
+		return offset_list;
+	}
+
+	template <typename Tfunction>
+	double Measure(int iteration_count, Tfunction function)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		for (int iteration = 0; iteration < iteration_count; iteration++)
+		{
+			function();
+		}
+
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	bool Report(const char *name, size_t bytes, int iteration_count, const Result &result)
+	{
+		double total_bytes = static_cast<double>(bytes) * iteration_count;
+
+		::printf("%-29s %10zu bytes x %5d, %7.3f s, %9.2f MB/s%s\n",
+				 name, bytes, iteration_count, result.seconds,
+				 total_bytes / result.seconds / 1000000.0,
+				 result.valid ? "" : "  ** MISMATCH **");
+
+		return result.valid;
+	}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	size_t bitstream_size = ((argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 4096) * 1024;
+	int iteration_count = (argc > 2) ? std::atoi(argv[2]) : 50;
+	bool valid = true;
+
+	if ((bitstream_size == 0) || (iteration_count <= 0))
+	{
+		::printf("Usage: %s [<bitstream size in KB>] [<iteration count>]\n", argv[0]);
+		return 1;
+	}
+
+	::printf("kernel: %s\n", NalUnitScanner::GetKernelName());
+
+	std::mt19937 random(20211017);
+
+	// Annex-B bitstream: [00 00 00 01][NAL unit (escaped RBSP)] ...
+	std::vector<uint8_t> bitstream;
+	std::vector<std::vector<uint8_t>> rbsp_list;
+	std::vector<size_t> expected_offset_list;
+
+	while (bitstream.size() < bitstream_size)
+	{
+		// Like the slices of a frame: from a few bytes to tens of KB
+		auto rbsp = MakeRbsp(random, 16 + (random() % 32768));
+		// The first byte is the NAL unit header (nal_unit_type: 1) and the last byte is rbsp_stop_one_bit
+		rbsp.front() = 0x41;
+		rbsp.back() = 0x80;
+
+		std::vector<uint8_t> nal_unit(NalUnitScanner::GetMaxEscapedLength(rbsp.size()));
+		nal_unit.resize(NalUnitScanner::InsertEmulationPrevention(rbsp.data(), rbsp.size(), nal_unit.data()));
+
+		valid = (NalUnitScanner::HasStartCodeEmulation(nal_unit.data(), nal_unit.size()) == false) && valid;
+
+		expected_offset_list.push_back(bitstream.size() + 1);
+		bitstream.insert(bitstream.end(), {0x00, 0x00, 0x00, 0x01});
+		bitstream.insert(bitstream.end(), nal_unit.begin(), nal_unit.end());
+
+		rbsp_list.push_back(std::move(rbsp));
+	}
+
+	if (valid == false)
+	{
+		::printf("InsertEmulationPrevention() left a start code emulation in the NAL unit\n");
+		return 1;
+	}
+
+	// Start code search
+	{
+		std::vector<size_t> offset_list;
+		Result result;
+
+		result.seconds = Measure(iteration_count, [&]() {
+			offset_list = SplitByByteLoop(bitstream.data(), bitstream.size());
+		});
+		result.valid = (offset_list == expected_offset_list);
+
+		valid = Report("byte loop", bitstream.size(), iteration_count, result) && valid;
+	}
+
+	{
+		std::vector<size_t> offset_list;
+		Result result;
+
+		result.seconds = Measure(iteration_count, [&]() {
+			offset_list = SplitByScanner(bitstream.data(), bitstream.size());
+		});
+		result.valid = (offset_list == expected_offset_list);
+
+		valid = Report("FindAnnexBStartCode", bitstream.size(), iteration_count, result) && valid;
+	}
+
+	// Emulation prevention
+	{
+		size_t rbsp_bytes = 0;
+		size_t nal_unit_bytes = 0;
+		std::vector<std::vector<uint8_t>> nal_unit_list(rbsp_list.size());
+		std::vector<size_t> nal_unit_length_list(rbsp_list.size());
+		Result result;
+
+		for (size_t index = 0; index < rbsp_list.size(); index++)
+		{
+			rbsp_bytes += rbsp_list[index].size();
+			nal_unit_list[index].resize(NalUnitScanner::GetMaxEscapedLength(rbsp_list[index].size()));
+		}
+
+		result.seconds = Measure(iteration_count, [&]() {
+			for (size_t index = 0; index < rbsp_list.size(); index++)
+			{
+				auto &rbsp = rbsp_list[index];
+				nal_unit_length_list[index] = NalUnitScanner::InsertEmulationPrevention(rbsp.data(), rbsp.size(), nal_unit_list[index].data());
+			}
+		});
+
+		for (auto length : nal_unit_length_list)
+		{
+			nal_unit_bytes += length;
+		}
+
+		// Same as the NAL units of the bitstream
+		result.valid = (nal_unit_bytes + (nal_unit_list.size() * 4) == bitstream.size());
+
+		valid = Report("InsertEmulationPrevention", rbsp_bytes, iteration_count, result) && valid;
+
+		std::vector<std::vector<uint8_t>> rbsp_output_list(rbsp_list.size());
+		std::vector<size_t> rbsp_length_list(rbsp_list.size());
+
+		for (size_t index = 0; index < rbsp_list.size(); index++)
+		{
+			rbsp_output_list[index].resize(nal_unit_length_list[index]);
+		}
+
+		result.seconds = Measure(iteration_count, [&]() {
+			for (size_t index = 0; index < nal_unit_list.size(); index++)
+			{
+				rbsp_length_list[index] = NalUnitScanner::RemoveEmulationPrevention(nal_unit_list[index].data(), nal_unit_length_list[index], rbsp_output_list[index].data());
+			}
+		});
+		result.valid = true;
+
+		for (size_t index = 0; index < rbsp_list.size(); index++)
+		{
+			result.valid = result.valid &&
+						   (rbsp_length_list[index] == rbsp_list[index].size()) &&
+						   std::equal(rbsp_list[index].begin(), rbsp_list[index].end(), rbsp_output_list[index].begin());
+		}
+
+		valid = Report("RemoveEmulationPrevention", nal_unit_bytes, iteration_count, result) && valid;
+	}
+
+	// Annex-B -> AVCC
+	{
+		auto data = std::make_shared<const ov::Data>(bitstream.data(), bitstream.size());
+		std::shared_ptr<const ov::Data> avcc_data;
+		Result result;
+
+		result.seconds = Measure(iteration_count, [&]() {
+			avcc_data = H264Converter::ConvertAnnexbToAvcc(data);
+		});
+
+		// The start codes are replaced with the lengths (4 bytes), and the NAL units are converted back as they are
+		auto annexb_data = H264Converter::ConvertAvccToAnnexb(avcc_data);
+		result.valid = (avcc_data->GetLength() == bitstream.size()) && (annexb_data != nullptr) &&
+					   (annexb_data->GetLength() == bitstream.size()) &&
+					   std::equal(bitstream.begin(), bitstream.end(), annexb_data->GetDataAs<uint8_t>());
+
+		valid = Report("ConvertAnnexbToAvcc", bitstream.size(), iteration_count, result) && valid;
+	}
+
+	// AVCC -> Annex-B of the NAL units which are not escaped by the encoder (RBSP as it is)
+	{
+		std::vector<uint8_t> avcc;
+
+		for (auto &rbsp : rbsp_list)
+		{
+			auto length = static_cast<uint32_t>(rbsp.size());
+
+			avcc.insert(avcc.end(), {static_cast<uint8_t>(length >> 24), static_cast<uint8_t>(length >> 16), static_cast<uint8_t>(length >> 8), static_cast<uint8_t>(length)});
+			avcc.insert(avcc.end(), rbsp.begin(), rbsp.end());
+		}
+
+		auto data = std::make_shared<const ov::Data>(avcc.data(), avcc.size());
+		std::shared_ptr<const ov::Data> annexb_data;
+		Result result;
+
+		result.seconds = Measure(iteration_count, [&]() {
+			annexb_data = H264Converter::ConvertAvccToAnnexb(data);
+		});
+
+		// Emulation prevention is inserted, so the start codes are found only between the NAL units
+		// (A NAL unit which contains only 00 00 03 is not escaped, since it cannot be told from an escaped one)
+		result.valid = (annexb_data != nullptr) &&
+					   (SplitByScanner(annexb_data->GetDataAs<uint8_t>(), annexb_data->GetLength()).size() == rbsp_list.size());
+
+		valid = Report("ConvertAvccToAnnexb (escape)", avcc.size(), iteration_count, result) && valid;
+	}
+
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,22 @@
+LOCAL_PATH := $(call get_local_path)
+include $(DEFAULT_VARIABLES)
+
+LOCAL_STATIC_LIBRARIES := \
+	segment_publishers \
+	http \
+	socket \
+	ovcrypto \
+	ovlibrary \
+	jsoncpp
+
+LOCAL_LDFLAGS := -lpthread
+
+$(call add_pkg_config,openssl)
+$(call add_pkg_config,libpcre2-8)
+$(call add_pkg_config,srt)
+
+LOCAL_TARGET := bench_cmaf_chunk_fanout
+
+include $(BUILD_EXECUTABLE)
+
+BENCH_TARGET_LIST += $(BUILD_TARGET_WITH_PATH)
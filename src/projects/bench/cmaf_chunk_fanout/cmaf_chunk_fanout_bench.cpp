@@ -0,0 +1,263 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+//
+// Verifies CmafChunkFanout with many clients, and measures the cost of pushing a chunk on the packetizer thread
+//
+// Usage: bench_cmaf_chunk_fanout [<max client count>] [<chunk count>] [<worker count>]
+//
+// For each client count (1, 10, 100, ... max), the packetizer thread pushes the chunks of a file while the clients join
+// from another thread (the late ones receive the chunks from the first one), and then completes the file.
+// Every client must receive the chunks framed for chunked transfer encoding, in order and exactly once, and must be finished once.
+// One client fails to send in the middle, and must be finished (closed) without receiving the others.
+//
+#include <base/ovlibrary/crc.h>
+#include <publishers/segment/cmaf/cmaf_chunk_fanout.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	class BenchReceiver : public CmafChunkReceiver
+	{
+	public:
+		BenchReceiver(std::atomic<size_t> &finished_count, size_t fail_at)
+			: _finished_count(finished_count),
+			  _fail_at(fail_at)
+		{
+		}
+
+		bool SendChunk(const std::shared_ptr<const ov::Data> &chunk) override
+		{
+			_send_count++;
+
+			if ((_finished == 0) && (_chunk_count == _fail_at))
+			{
+				return false;
+			}
+
+			// "<length in hex>\r\n" + payload + "\r\n"
+			auto data = chunk->GetDataAs<char>();
+			auto length = chunk->GetLength();
+			char *end = nullptr;
+			auto payload_length = std::strtoul(data, &end, 16);
+			auto header_length = static_cast<size_t>(end - data) + 2;
+
+			if ((end == data) || (length != (header_length + payload_length + 2)) ||
+				(end[0] != '\r') || (end[1] != '\n') || (data[length - 2] != '\r') || (data[length - 1] != '\n'))
+			{
+				_valid = false;
+			}
+			else
+			{
+				_crc = ov::CRC::Crc32(_crc, reinterpret_cast<const uint8_t *>(data + header_length), payload_length);
+			}
+
+			_chunk_count++;
+
+			return true;
+		}
+
+		void OnChunksSent(size_t sent_bytes) override
+		{
+			_sent_bytes += sent_bytes;
+		}
+
+		void OnDeliveryFinished(bool result) override
+		{
+			_result = result;
+
+			if (_finished++ == 0)
+			{
+				_finished_count++;
+			}
+		}
+
+		ov::String ToString() const override
+		{
+			return "bench";
+		}
+
+		bool IsValid(size_t chunk_count, uint32_t crc, uint64_t total_bytes) const
+		{
+			if ((_valid == false) || (_finished != 1))
+			{
+				return false;
+			}
+
+			if (_fail_at < chunk_count)
+			{
+				// Closed at the failed chunk
+				return (_result == false) && (_send_count == (_fail_at + 1));
+			}
+
+			return _result && (_chunk_count == chunk_count) && (_send_count == chunk_count) && (_crc == crc) && (_sent_bytes == total_bytes);
+		}
+
+	protected:
+		std::atomic<size_t> &_finished_count;
+		const size_t _fail_at;
+
+		// Accessed by the worker of the file only
+		size_t _send_count = 0;
+		size_t _chunk_count = 0;
+		uint64_t _sent_bytes = 0;
+		uint32_t _crc = 0;
+		bool _valid = true;
+		int _finished = 0;
+		bool _result = false;
+	};
+
+	struct Result
+	{
+		double average_push_us = 0.0;
+		double max_push_us = 0.0;
+		double seconds = 0.0;
+		uint64_t delivered_bytes = 0;
+		size_t invalid_count = 0;
+		bool timed_out = false;
+	};
+
+	Result Run(CmafChunkFanout &fanout, size_t client_count, size_t chunk_count)
+	{
+		Result result;
+		std::atomic<size_t> finished_count{0};
+		std::vector<std::shared_ptr<BenchReceiver>> receiver_list;
+
+		auto file = std::make_shared<CmafChunkedFile>(fanout.GetNextWorkerIndex(), 1, 1000);
+
+		for (size_t index = 0; index < client_count; index++)
+		{
+			// The 4th client fails in the middle of the file
+			receiver_list.push_back(std::make_shared<BenchReceiver>(finished_count, (index == 3) ? (chunk_count / 2) : SIZE_MAX));
+		}
+
+		// The clients join while the chunks are pushed
+		std::thread joiner([&]() {
+			for (size_t index = 0; index < client_count; index++)
+			{
+				file->AddClient(receiver_list[index]);
+				fanout.Notify(file);
+
+				if ((index % 50) == 49)
+				{
+					std::this_thread::sleep_for(std::chrono::microseconds(200));
+				}
+			}
+		});
+
+		uint32_t crc = 0;
+		uint64_t total_bytes = 0;
+		double total_push_us = 0.0;
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (size_t index = 0; index < chunk_count; index++)
+		{
+			std::vector<uint8_t> payload(1000 + (index % 7) * 500, static_cast<uint8_t>(index));
+			auto chunk_data = std::make_shared<ov::Data>(payload.data(), payload.size());
+
+			crc = ov::CRC::Crc32(crc, payload.data(), payload.size());
+
+			auto push_start = std::chrono::steady_clock::now();
+
+			file->AddChunk(chunk_data);
+			fanout.Notify(file);
+
+			auto push_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - push_start).count();
+
+			total_push_us += push_us;
+			result.max_push_us = std::max(result.max_push_us, push_us);
+
+			// The interval of the chunks is shorter than a real stream, to keep the workers busy
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+
+		joiner.join();
+
+		file->SetCompleted();
+		fanout.Notify(file);
+
+		// Framed chunks: "<length in hex>\r\n" + payload + "\r\n"
+		for (size_t index = 0; index < chunk_count; index++)
+		{
+			auto length = 1000 + (index % 7) * 500;
+			total_bytes += ov::String::FormatString("%zx\r\n", length).GetLength() + length + 2;
+		}
+
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+		while (finished_count < client_count)
+		{
+			if (std::chrono::steady_clock::now() > deadline)
+			{
+				result.timed_out = true;
+				break;
+			}
+
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+
+		result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		result.average_push_us = total_push_us / chunk_count;
+
+		for (auto &receiver : receiver_list)
+		{
+			if (receiver->IsValid(chunk_count, crc, total_bytes) == false)
+			{
+				result.invalid_count++;
+			}
+		}
+
+		result.delivered_bytes = total_bytes * (client_count - ((client_count > 3) ? 1 : 0));
+
+		return result;
+	}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	size_t max_client_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 5000;
+	size_t chunk_count = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 200;
+	int worker_count = (argc > 3) ? std::atoi(argv[3]) : 2;
+	bool valid = true;
+
+	if ((max_client_count == 0) || (chunk_count < 2) || (worker_count <= 0))
+	{
+		::printf("Usage: %s [<max client count>] [<chunk count>] [<worker count>]\n", argv[0]);
+		return 1;
+	}
+
+	CmafChunkFanout fanout;
+	fanout.Start(worker_count);
+
+	for (size_t client_count = 1; client_count <= max_client_count; client_count = (client_count < max_client_count) ? std::min(client_count * 10, max_client_count) : (max_client_count + 1))
+	{
+		auto result = Run(fanout, client_count, chunk_count);
+		bool is_valid = (result.invalid_count == 0) && (result.timed_out == false);
+
+		::printf("clients: %5zu, chunks: %4zu, push: %6.2f us (max %7.2f us), delivered: %9.2f MB/s%s%s\n",
+				 client_count, chunk_count, result.average_push_us, result.max_push_us,
+				 result.delivered_bytes / result.seconds / 1000000.0,
+				 result.timed_out ? "  ** TIMED OUT **" : "",
+				 (result.invalid_count > 0) ? ov::String::FormatString("  ** %zu INVALID CLIENTS **", result.invalid_count).CStr() : "");
+
+		valid = is_valid && valid;
+	}
+
+	fanout.Stop();
+
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,17 @@
+LOCAL_PATH := $(call get_local_path)
+include $(DEFAULT_VARIABLES)
+
+LOCAL_STATIC_LIBRARIES := \
+	ovlibrary \
+	jsoncpp
+
+LOCAL_LDFLAGS := -lpthread
+
+$(call add_pkg_config,openssl)
+$(call add_pkg_config,libpcre2-8)
+
+LOCAL_TARGET := bench_copy_on_write_map
+
+include $(BUILD_EXECUTABLE)
+
+BENCH_TARGET_LIST += $(BUILD_TARGET_WITH_PATH)
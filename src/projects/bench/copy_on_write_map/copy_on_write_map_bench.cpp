@@ -0,0 +1,263 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+//
+// Looks up a session table from many threads while a writer adds/removes sessions,
+// like IcePort does for every packet (The values are shared_ptrs, like IcePortInfo)
+//
+// Usage: bench_copy_on_write_map [<reader count>] [<duration in ms>] [<session count>]
+//
+// - std::shared_mutex: a std::map protected by a std::shared_mutex
+// - atomic_load: snapshots published with std::atomic_load()/std::atomic_store() of std::shared_ptr
+// - ov::CopyOnWriteMap: snapshots reclaimed by ov::Epoch
+//
+// The readers check that the sessions which are never removed are always found with their own values,
+// and the snapshots retired to ov::Epoch must be reclaimed after the readers are finished.
+//
+#include <base/ovlibrary/copy_on_write_map.h>
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	using Value = std::shared_ptr<uint32_t>;
+
+	class SharedMutexMap
+	{
+	public:
+		bool Find(uint32_t key, Value *value) const
+		{
+			std::shared_lock<std::shared_mutex> lock(_mutex);
+
+			auto item = _map.find(key);
+
+			if (item == _map.end())
+			{
+				return false;
+			}
+
+			*value = item->second;
+			return true;
+		}
+
+		void Set(uint32_t key, const Value &value)
+		{
+			std::unique_lock<std::shared_mutex> lock(_mutex);
+			_map[key] = value;
+		}
+
+		void Remove(uint32_t key)
+		{
+			std::unique_lock<std::shared_mutex> lock(_mutex);
+			_map.erase(key);
+		}
+
+	private:
+		mutable std::shared_mutex _mutex;
+		std::map<uint32_t, Value> _map;
+	};
+
+	// The previous implementation of ov::CopyOnWriteMap (16 shards)
+	class AtomicLoadMap
+	{
+	public:
+		using Map = std::map<uint32_t, Value>;
+
+		AtomicLoadMap()
+		{
+			for (auto &shard : _shards)
+			{
+				shard.snapshot = std::make_shared<const Map>();
+			}
+		}
+
+		bool Find(uint32_t key, Value *value) const
+		{
+			auto snapshot = std::atomic_load(&(_shards[key % SHARD_COUNT].snapshot));
+			auto item = snapshot->find(key);
+
+			if (item == snapshot->end())
+			{
+				return false;
+			}
+
+			*value = item->second;
+			return true;
+		}
+
+		void Set(uint32_t key, const Value &value)
+		{
+			Update(key, [&](Map &map) {
+				map[key] = value;
+			});
+		}
+
+		void Remove(uint32_t key)
+		{
+			Update(key, [&](Map &map) {
+				map.erase(key);
+			});
+		}
+
+	private:
+		static constexpr size_t SHARD_COUNT = 16;
+
+		struct Shard
+		{
+			std::mutex mutex;
+			std::shared_ptr<const Map> snapshot;
+		};
+
+		template <typename Tupdater>
+		void Update(uint32_t key, Tupdater updater)
+		{
+			auto &shard = _shards[key % SHARD_COUNT];
+			std::lock_guard<std::mutex> lock_guard(shard.mutex);
+
+			auto new_map = std::make_shared<Map>(*std::atomic_load(&(shard.snapshot)));
+			updater(*new_map);
+			std::atomic_store(&(shard.snapshot), std::shared_ptr<const Map>(std::move(new_map)));
+		}
+
+		Shard _shards[SHARD_COUNT];
+	};
+
+	struct Result
+	{
+		uint64_t lookup_count = 0;
+		uint64_t update_count = 0;
+		double seconds = 0.0;
+		bool valid = true;
+	};
+
+	template <typename Tmap>
+	Result Run(size_t reader_count, int duration_ms, uint32_t session_count)
+	{
+		Tmap map;
+		std::atomic<bool> stop{false};
+		std::atomic<uint64_t> lookup_count{0};
+		std::atomic<bool> valid{true};
+
+		// Even keys are never removed, odd keys are added/removed by the writer
+		for (uint32_t key = 0; key < session_count; key += 2)
+		{
+			map.Set(key, std::make_shared<uint32_t>(key));
+		}
+
+		std::vector<std::thread> readers;
+		auto start = std::chrono::steady_clock::now();
+		auto end = start + std::chrono::milliseconds(duration_ms);
+
+		for (size_t reader_index = 0; reader_index < reader_count; reader_index++)
+		{
+			readers.emplace_back([&, reader_index]() {
+				uint64_t count = 0;
+				uint32_t key = static_cast<uint32_t>(reader_index * 7919) % session_count;
+
+				// The readers also stop at the deadline, because the readers of std::shared_mutex can starve the writer
+				while ((stop.load(std::memory_order_relaxed) == false) && (std::chrono::steady_clock::now() < end))
+				{
+					for (int index = 0; index < 256; index++)
+					{
+						Value value;
+						bool found = map.Find(key, &value);
+
+						if ((found && (*value != key)) || ((found == false) && ((key % 2) == 0)))
+						{
+							valid = false;
+						}
+
+						key = (key + 613) % session_count;
+					}
+
+					count += 256;
+				}
+
+				lookup_count += count;
+			});
+		}
+
+		uint64_t update_count = 0;
+
+		// A session joins or leaves about every 100 us
+		for (uint32_t key = 1; std::chrono::steady_clock::now() < end; key = (key + 2) % session_count)
+		{
+			if (key == 0)
+			{
+				key = 1;
+			}
+
+			map.Set(key, std::make_shared<uint32_t>(key));
+			map.Remove(key);
+			update_count += 2;
+
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+
+		stop = true;
+
+		for (auto &reader : readers)
+		{
+			reader.join();
+		}
+
+		auto elapsed = std::chrono::steady_clock::now() - start;
+
+		return {lookup_count.load(), update_count, std::chrono::duration<double>(elapsed).count(), valid.load()};
+	}
+
+	bool Report(const char *name, size_t reader_count, const Result &result)
+	{
+		::printf("%-18s readers: %3zu, lookups: %11" PRIu64 ", updates: %7" PRIu64 ", %7.3f s, %8.2f M lookups/s, %7.1f ns/lookup (all readers)%s\n",
+				 name, reader_count, result.lookup_count, result.update_count, result.seconds,
+				 static_cast<double>(result.lookup_count) / result.seconds / 1000000.0,
+				 (result.lookup_count > 0) ? (result.seconds * 1000000000.0 / static_cast<double>(result.lookup_count)) : 0.0,
+				 result.valid ? "" : "  ** WRONG VALUE OR MISSING SESSION **");
+
+		return result.valid;
+	}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	size_t reader_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 64;
+	int duration_ms = (argc > 2) ? std::atoi(argv[2]) : 1000;
+	uint32_t session_count = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 10000;
+	bool valid = true;
+
+	if ((reader_count == 0) || (duration_ms <= 0) || (session_count < 2))
+	{
+		::printf("Usage: %s [<reader count>] [<duration in ms>] [<session count>]\n", argv[0]);
+		return 1;
+	}
+
+	valid = Report("std::shared_mutex", reader_count, Run<SharedMutexMap>(reader_count, duration_ms, session_count)) && valid;
+	valid = Report("atomic_load", reader_count, Run<AtomicLoadMap>(reader_count, duration_ms, session_count)) && valid;
+	valid = Report("ov::CopyOnWriteMap", reader_count, Run<ov::CopyOnWriteMap<uint32_t, Value>>(reader_count, duration_ms, session_count)) && valid;
+
+	// No reader is left, so all the retired snapshots must be reclaimed
+	ov::Epoch::Reclaim();
+	auto retired_count = ov::Epoch::GetRetiredCount();
+
+	if (retired_count > 0)
+	{
+		::printf("** %zu snapshots are not reclaimed **\n", retired_count);
+		valid = false;
+	}
+
+	return valid ? 0 : 1;
+}
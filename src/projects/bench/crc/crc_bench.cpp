@@ -0,0 +1,246 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+//
+// Checks the known answers of ov::CRC with every kernel, and compares their throughput
+//
+// Usage: bench_crc [<buffer size in KB>] [<iteration count>]
+//
+// - bytewise: the byte-wise table
+// - slicing-by-8: 8 bytes at a time
+// - pclmul: PCLMULQDQ folding (CRC-32 only, skipped if the CPU does not support it)
+//
+// Every kernel must give the known answers (the check values of the CRC catalogue, and the values of zlib for the longer
+// inputs, which are folded by PCLMULQDQ), and the same CRC as the byte-wise table for every length/alignment.
+//
+#include <base/ovlibrary/crc.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Kernel = ov::CRC::Kernel;
+
+	struct KernelItem
+	{
+		Kernel kernel;
+		const char *name;
+	};
+
+	const KernelItem KERNEL_LIST[] = {
+		{Kernel::Bytewise, "bytewise"},
+		{Kernel::SlicingBy8, "slicing-by-8"},
+		{Kernel::Pclmul, "pclmul"},
+	};
+
+	enum class Input
+	{
+		CheckString,
+		Fox,
+		Zero4096,
+		Ff4096,
+		Pattern4099
+	};
+
+	struct KnownAnswer
+	{
+		Input input;
+		const char *name;
+		uint32_t crc32;
+		uint32_t crc32_mpeg2;
+	};
+
+	const KnownAnswer KNOWN_ANSWER_LIST[] = {
+		{Input::CheckString, "\"123456789\"", 0xCBF43926, 0x0376E6E7},
+		{Input::Fox, "\"The quick brown fox...\"", 0x414FA339, 0xBA62119E},
+		{Input::Zero4096, "00 x 4096", 0xC71C0011, 0x77FFC71C},
+		{Input::Ff4096, "FF x 4096", 0xF154670A, 0xAF19D570},
+		{Input::Pattern4099, "(i * 31 + 7) x 4099", 0xEE39A9CC, 0xFD1761C9},
+	};
+
+	std::vector<uint8_t> MakeInput(Input input)
+	{
+		switch (input)
+		{
+			case Input::CheckString: {
+				const char *text = "123456789";
+				return std::vector<uint8_t>(text, text + ::strlen(text));
+			}
+
+			case Input::Fox: {
+				const char *text = "The quick brown fox jumps over the lazy dog";
+				return std::vector<uint8_t>(text, text + ::strlen(text));
+			}
+
+			case Input::Zero4096:
+				return std::vector<uint8_t>(4096, 0x00);
+
+			case Input::Ff4096:
+				return std::vector<uint8_t>(4096, 0xFF);
+
+			case Input::Pattern4099: {
+				std::vector<uint8_t> data(4099);
+
+				for (size_t index = 0; index < data.size(); index++)
+				{
+					data[index] = static_cast<uint8_t>(index * 31 + 7);
+				}
+
+				return data;
+			}
+		}
+
+		return {};
+	}
+
+	uint32_t Calculate(const KernelItem &item, bool is_mpeg2, const uint8_t *data, size_t length)
+	{
+		return is_mpeg2 ? ov::CRC::Crc32Mpeg2(item.kernel, data, length) : ov::CRC::Crc32(item.kernel, 0, data, length);
+	}
+
+	bool CheckKnownAnswers(const KernelItem &item, bool is_mpeg2)
+	{
+		bool valid = true;
+
+		for (auto &answer : KNOWN_ANSWER_LIST)
+		{
+			auto data = MakeInput(answer.input);
+			auto expected = is_mpeg2 ? answer.crc32_mpeg2 : answer.crc32;
+			auto crc = Calculate(item, is_mpeg2, data.data(), data.size());
+
+			if (crc != expected)
+			{
+				::printf("%-13s %-12s %-25s %08" PRIX32 ", expected: %08" PRIX32 "  ** MISMATCH **\n",
+						 is_mpeg2 ? "CRC-32/MPEG-2" : "CRC-32", item.name, answer.name, crc, expected);
+				valid = false;
+			}
+		}
+
+		return valid;
+	}
+
+	// Every length/alignment up to 4 KB, in one call and in two calls (continued with the previous result)
+	bool CheckWithBytewise(const KernelItem &item, bool is_mpeg2, const std::vector<uint8_t> &buffer)
+	{
+		const KernelItem bytewise = KERNEL_LIST[0];
+		auto max_length = std::min(buffer.size(), static_cast<size_t>(4096));
+
+		for (size_t offset = 0; offset < 16; offset++)
+		{
+			for (size_t length = 0; (offset + length) <= max_length; length += (length < 512) ? 1 : 61)
+			{
+				auto data = buffer.data() + offset;
+				auto expected = Calculate(bytewise, is_mpeg2, data, length);
+				auto split = length / 3;
+				uint32_t crc;
+				uint32_t continued_crc;
+
+				if (is_mpeg2)
+				{
+					crc = ov::CRC::Crc32Mpeg2(item.kernel, data, length);
+					continued_crc = ov::CRC::Crc32Mpeg2(item.kernel, data + split, length - split, ov::CRC::Crc32Mpeg2(item.kernel, data, split));
+				}
+				else
+				{
+					crc = ov::CRC::Crc32(item.kernel, 0, data, length);
+					continued_crc = ov::CRC::Crc32(item.kernel, ov::CRC::Crc32(item.kernel, 0, data, split), data + split, length - split);
+				}
+
+				if ((crc != expected) || (continued_crc != expected))
+				{
+					::printf("%-13s %-12s offset: %zu, length: %zu, %08" PRIX32 "/%08" PRIX32 ", expected: %08" PRIX32 "  ** MISMATCH **\n",
+							 is_mpeg2 ? "CRC-32/MPEG-2" : "CRC-32", item.name, offset, length, crc, continued_crc, expected);
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool Run(const KernelItem &item, bool is_mpeg2, const std::vector<uint8_t> &buffer, int iteration_count)
+	{
+		bool valid = CheckKnownAnswers(item, is_mpeg2) && CheckWithBytewise(item, is_mpeg2, buffer);
+		volatile uint32_t crc = 0;
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (int iteration = 0; iteration < iteration_count; iteration++)
+		{
+			crc = crc ^ Calculate(item, is_mpeg2, buffer.data(), buffer.size());
+		}
+
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		double total_bytes = static_cast<double>(buffer.size()) * iteration_count;
+
+		::printf("%-13s %-12s %10zu bytes x %5d, %7.3f s, %9.2f MB/s%s\n",
+				 is_mpeg2 ? "CRC-32/MPEG-2" : "CRC-32", item.name, buffer.size(), iteration_count, seconds,
+				 total_bytes / seconds / 1000000.0,
+				 valid ? "" : "  ** MISMATCH **");
+
+		return valid;
+	}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	size_t buffer_size = ((argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1024) * 1024;
+	int iteration_count = (argc > 2) ? std::atoi(argv[2]) : 200;
+	bool valid = true;
+
+	if ((buffer_size == 0) || (iteration_count <= 0))
+	{
+		::printf("Usage: %s [<buffer size in KB>] [<iteration count>]\n", argv[0]);
+		return 1;
+	}
+
+	::printf("Crc32() kernel: %s\n", ov::CRC::GetCrc32KernelName());
+
+	std::mt19937 random(20211017);
+	std::vector<uint8_t> buffer(buffer_size);
+
+	for (auto &value : buffer)
+	{
+		value = static_cast<uint8_t>(random());
+	}
+
+	for (auto is_mpeg2 : {false, true})
+	{
+		for (auto &item : KERNEL_LIST)
+		{
+			if (ov::CRC::IsKernelSupported(item.kernel, is_mpeg2) == false)
+			{
+				::printf("%-13s %-12s (not supported)\n", is_mpeg2 ? "CRC-32/MPEG-2" : "CRC-32", item.name);
+				continue;
+			}
+
+			valid = Run(item, is_mpeg2, buffer, iteration_count) && valid;
+		}
+	}
+
+	// The default functions, which are used by the modules
+	{
+		auto data = MakeInput(Input::CheckString);
+
+		if ((ov::CRC::Crc32(0, data.data(), data.size()) != 0xCBF43926) ||
+			(ov::CRC::Crc32Mpeg2(data.data(), data.size()) != 0x0376E6E7))
+		{
+			::printf("Crc32()/Crc32Mpeg2() gave a wrong check value\n");
+			valid = false;
+		}
+	}
+
+	return valid ? 0 : 1;
+}
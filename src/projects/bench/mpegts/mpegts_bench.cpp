@@ -0,0 +1,169 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+//
+// Measures the throughput of mpegts::MpegTsDepacketizer with a captured .ts file
+//
+// Usage: bench_mpegts <.ts file> [<iteration count>]
+//        (ex: bench_mpegts projects/bench/mpegts/fixtures/h264_aac_5s.ts)
+//
+// The file is fed as the ingest does:
+// - 1316 bytes: 7 packets per datagram (SRT, MPEG-TS over UDP)
+// - 1500 bytes: datagrams which split the packets (the partial packets are kept across the datagrams)
+// - whole file: one buffer
+//
+// Every way must give the same elementary streams (count, length and CRC of the payloads per PID) as the whole file.
+//
+#include <base/ovlibrary/crc.h>
+#include <modules/mpegts/mpegts_depacketizer.h>
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <vector>
+
+namespace
+{
+	struct EsSummary
+	{
+		uint64_t count = 0;
+		uint64_t payload_bytes = 0;
+		uint32_t crc = 0;
+
+		bool operator==(const EsSummary &other) const
+		{
+			return (count == other.count) && (payload_bytes == other.payload_bytes) && (crc == other.crc);
+		}
+	};
+
+	struct Result
+	{
+		double seconds = 0.0;
+		bool track_info_available = false;
+		// PID -> Summary of the elementary streams
+		std::map<uint16_t, EsSummary> es_map;
+	};
+
+	void PopES(mpegts::MpegTsDepacketizer &depacketizer, std::map<uint16_t, EsSummary> *es_map)
+	{
+		while (depacketizer.IsESAvailable())
+		{
+			auto es = depacketizer.PopES();
+
+			if (es_map != nullptr)
+			{
+				auto &summary = (*es_map)[es->PID()];
+
+				summary.count++;
+				summary.payload_bytes += es->PayloadLength();
+				summary.crc = ov::CRC::Crc32(summary.crc, es->Payload(), es->PayloadLength());
+			}
+		}
+	}
+
+	// datagram_size 0: the whole file in one buffer
+	Result Run(const std::vector<uint8_t> &file, size_t datagram_size, int iteration_count)
+	{
+		Result result;
+
+		if (datagram_size == 0)
+		{
+			datagram_size = file.size();
+		}
+
+		// The datagrams are received into their own buffers
+		std::vector<std::shared_ptr<const ov::Data>> datagram_list;
+
+		for (size_t offset = 0; offset < file.size(); offset += datagram_size)
+		{
+			datagram_list.push_back(std::make_shared<const ov::Data>(file.data() + offset, std::min(datagram_size, file.size() - offset)));
+		}
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (int iteration = 0; iteration < iteration_count; iteration++)
+		{
+			mpegts::MpegTsDepacketizer depacketizer;
+			// Summarizes the first iteration only, so the others measure the depacketizer
+			auto es_map = (iteration == 0) ? &result.es_map : nullptr;
+
+			for (auto &datagram : datagram_list)
+			{
+				depacketizer.AddPacket(datagram);
+				PopES(depacketizer, es_map);
+			}
+
+			result.track_info_available = depacketizer.IsTrackInfoAvailable();
+		}
+
+		result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		return result;
+	}
+
+	bool Report(const char *name, size_t file_size, int iteration_count, const Result &result, const Result &expected)
+	{
+		uint64_t es_count = 0;
+
+		for (auto &item : result.es_map)
+		{
+			es_count += item.second.count;
+		}
+
+		bool valid = result.track_info_available && (result.es_map.empty() == false) && (result.es_map == expected.es_map);
+		double total_bytes = static_cast<double>(file_size) * iteration_count;
+
+		::printf("%-12s %10zu bytes x %5d, %7.3f s, %9.2f MB/s (%7.1f Mbps), %10.0f ES/s%s\n",
+				 name, file_size, iteration_count, result.seconds,
+				 total_bytes / result.seconds / 1000000.0,
+				 total_bytes * 8 / result.seconds / 1000000.0,
+				 static_cast<double>(es_count) * iteration_count / result.seconds,
+				 valid ? "" : "  ** MISMATCH **");
+
+		return valid;
+	}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	int iteration_count = (argc > 2) ? std::atoi(argv[2]) : 100;
+	bool valid = true;
+
+	if ((argc < 2) || (iteration_count <= 0))
+	{
+		::printf("Usage: %s <.ts file> [<iteration count>]\n", argv[0]);
+		return 1;
+	}
+
+	std::ifstream stream(argv[1], std::ios::binary);
+	std::vector<uint8_t> file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+	if (file.size() < 188)
+	{
+		::printf("Could not read the .ts file: %s\n", argv[1]);
+		return 1;
+	}
+
+	auto expected = Run(file, 0, 1);
+
+	for (auto &item : expected.es_map)
+	{
+		::printf("PID: %5u, ES: %6" PRIu64 ", payload: %10" PRIu64 " bytes, CRC: %08" PRIX32 "\n",
+				 item.first, item.second.count, item.second.payload_bytes, item.second.crc);
+	}
+
+	valid = Report("1316 bytes", file.size(), iteration_count, Run(file, 1316, iteration_count), expected) && valid;
+	valid = Report("1500 bytes", file.size(), iteration_count, Run(file, 1500, iteration_count), expected) && valid;
+	valid = Report("whole file", file.size(), iteration_count, Run(file, 0, iteration_count), expected) && valid;
+
+	return valid ? 0 : 1;
+}
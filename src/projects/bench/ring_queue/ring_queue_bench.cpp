@@ -0,0 +1,197 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+//
+// Compares ov::Queue with ov::SpscQueue/ov::MpscQueue
+//
+// Usage: bench_ring_queue [<item count per producer>] [<producer count>]
+//
+// Every item carries the producer index and its sequence number, so the consumer also checks
+// that the items of each producer are neither lost nor reordered.
+//
+#include <base/ovlibrary/lock_free_queue.h>
+#include <base/ovlibrary/queue.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr int ITEM_SEQUENCE_BITS = 40;
+	constexpr uint64_t ITEM_SEQUENCE_MASK = (1ULL << ITEM_SEQUENCE_BITS) - 1;
+
+	struct Result
+	{
+		double seconds = 0.0;
+		bool valid = false;
+	};
+
+	// The media paths pass shared_ptrs through the queues, so the items carry one too
+	using Item = std::pair<uint64_t, std::shared_ptr<int>>;
+
+	template <typename Tqueue>
+	Result Run(Tqueue &queue, size_t producer_count, uint64_t item_count)
+	{
+		auto payload = std::make_shared<int>(0);
+		std::vector<std::thread> producers;
+		std::vector<uint64_t> next_sequences(producer_count, 0ULL);
+		uint64_t total_count = producer_count * item_count;
+		bool valid = true;
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (size_t producer_index = 0; producer_index < producer_count; producer_index++)
+		{
+			producers.emplace_back([&queue, &payload, producer_index, item_count]() {
+				for (uint64_t sequence = 0; sequence < item_count; sequence++)
+				{
+					queue.Enqueue(Item((static_cast<uint64_t>(producer_index) << ITEM_SEQUENCE_BITS) | sequence, payload));
+				}
+			});
+		}
+
+		for (uint64_t count = 0; count < total_count; count++)
+		{
+			auto item = queue.Dequeue();
+
+			if (item.has_value() == false)
+			{
+				valid = false;
+				break;
+			}
+
+			auto producer_index = item->first >> ITEM_SEQUENCE_BITS;
+			auto sequence = item->first & ITEM_SEQUENCE_MASK;
+
+			if ((producer_index >= producer_count) || (next_sequences[producer_index] != sequence))
+			{
+				valid = false;
+			}
+			else
+			{
+				next_sequences[producer_index]++;
+			}
+		}
+
+		auto end = std::chrono::steady_clock::now();
+
+		for (auto &producer : producers)
+		{
+			producer.join();
+		}
+
+		return {std::chrono::duration<double>(end - start).count(), valid && (payload.use_count() == 1)};
+	}
+
+	// Enqueue and dequeue on the same thread: the cost of a hop when the consumer keeps up with the producer
+	template <typename Tqueue>
+	Result RunUncontended(Tqueue &queue, uint64_t item_count)
+	{
+		constexpr uint64_t BURST_SIZE = 16;
+
+		auto payload = std::make_shared<int>(0);
+		bool valid = true;
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (uint64_t sequence = 0; sequence < item_count; sequence += BURST_SIZE)
+		{
+			for (uint64_t index = 0; index < BURST_SIZE; index++)
+			{
+				queue.Enqueue(Item(sequence + index, payload));
+			}
+
+			for (uint64_t index = 0; index < BURST_SIZE; index++)
+			{
+				auto item = queue.Dequeue(0);
+
+				valid = valid && item.has_value() && (item->first == (sequence + index));
+			}
+		}
+
+		auto end = std::chrono::steady_clock::now();
+
+		return {std::chrono::duration<double>(end - start).count(), valid && (payload.use_count() == 1)};
+	}
+
+	bool Report(const char *name, size_t producer_count, uint64_t item_count, const Result &result)
+	{
+		// producer_count 0: the consumer thread also produces the items
+		auto count = std::max(producer_count, static_cast<size_t>(1)) * item_count;
+		double total_count = static_cast<double>(count);
+
+		::printf("%-10s producers: %2zu, items: %10" PRIu64 ", %7.3f s, %8.2f M items/s, %6.1f ns/item%s\n",
+				 name, producer_count, count, result.seconds,
+				 total_count / result.seconds / 1000000.0,
+				 result.seconds * 1000000000.0 / total_count,
+				 result.valid ? "" : "  ** LOST OR REORDERED **");
+
+		return result.valid;
+	}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	uint64_t item_count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000000ULL;
+	size_t max_producer_count = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 4;
+	bool valid = true;
+
+	if ((item_count == 0) || (item_count > ITEM_SEQUENCE_MASK) || (max_producer_count == 0))
+	{
+		::printf("Usage: %s [<item count per producer>] [<producer count>]\n", argv[0]);
+		return 1;
+	}
+
+	// Same thread (bursts of 16 items)
+	{
+		ov::Queue<Item> queue("bench.queue");
+		valid = Report("ov::Queue", 0, item_count, RunUncontended(queue, item_count)) && valid;
+	}
+
+	{
+		ov::SpscQueue<Item> queue("bench.spsc");
+		valid = Report("SpscQueue", 0, item_count, RunUncontended(queue, item_count)) && valid;
+	}
+
+	{
+		ov::MpscQueue<Item> queue("bench.mpsc");
+		valid = Report("MpscQueue", 0, item_count, RunUncontended(queue, item_count)) && valid;
+	}
+
+	// Single producer
+	{
+		ov::Queue<Item> queue("bench.queue");
+		valid = Report("ov::Queue", 1, item_count, Run(queue, 1, item_count)) && valid;
+	}
+
+	{
+		ov::SpscQueue<Item> queue("bench.spsc");
+		valid = Report("SpscQueue", 1, item_count, Run(queue, 1, item_count)) && valid;
+	}
+
+	// Multiple producers
+	for (size_t producer_count = 2; producer_count <= max_producer_count; producer_count *= 2)
+	{
+		{
+			ov::Queue<Item> queue("bench.queue");
+			valid = Report("ov::Queue", producer_count, item_count, Run(queue, producer_count, item_count)) && valid;
+		}
+
+		{
+			ov::MpscQueue<Item> queue("bench.mpsc");
+			valid = Report("MpscQueue", producer_count, item_count, Run(queue, producer_count, item_count)) && valid;
+		}
+	}
+
+	return valid ? 0 : 1;
+}
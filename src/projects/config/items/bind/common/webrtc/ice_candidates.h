@@ -23,12 +23,23 @@ namespace cfg
 				int _tcp_relay_worker_count{};
 				int _ice_worker_count{};
 
+				// Send RTP/RTCP packets of a frame with sendmmsg() (and UDP GSO if the kernel supports it)
+				bool _send_batching = false;
+
+				// Bind a SO_REUSEPORT socket for each ICE worker
+				bool _reuse_port = false;
+				// Select the socket by the 4-tuple using a BPF program (Only available when ReusePort is enabled)
+				bool _bpf_steering = false;
+
 			public:
 				CFG_DECLARE_REF_GETTER_OF(GetIceCandidateList, _ice_candidate_list);
 				CFG_DECLARE_REF_GETTER_OF(GetTcpRelay, _tcp_relay);
 
 				CFG_DECLARE_REF_GETTER_OF(GetTcpRelayWorkerCount, _tcp_relay_worker_count);
 				CFG_DECLARE_REF_GETTER_OF(GetIceWorkerCount, _ice_worker_count);
+				CFG_DECLARE_REF_GETTER_OF(IsSendBatchingEnabled, _send_batching);
+				CFG_DECLARE_REF_GETTER_OF(IsReusePortEnabled, _reuse_port);
+				CFG_DECLARE_REF_GETTER_OF(IsBpfSteeringEnabled, _bpf_steering);
 
 			protected:
 				void MakeList() override
@@ -38,6 +49,9 @@ namespace cfg
 
 					Register<Optional>("TcpRelayWorkerCount", &_tcp_relay_worker_count);
 					Register<Optional>("IceWorkerCount", &_ice_worker_count);
+					Register<Optional>("SendBatching", &_send_batching);
+					Register<Optional>("ReusePort", &_reuse_port);
+					Register<Optional>("BpfSteering", &_bpf_steering);
 				}
 			};
 		}  // namespace cmm
@@ -22,6 +22,9 @@ namespace cfg
 
 				int _worker_count{};
 
+				// Encrypts the responses in the kernel (kTLS) if available
+				bool _kernel_tls = false;
+
 			public:
 				explicit Signalling(const char *port)
 					: _port(port)
@@ -38,6 +41,7 @@ namespace cfg
 				CFG_DECLARE_REF_GETTER_OF(GetTlsPort, _tls_port);
 
 				CFG_DECLARE_REF_GETTER_OF(GetWorkerCount, _worker_count);
+				CFG_DECLARE_REF_GETTER_OF(IsKernelTlsEnabled, _kernel_tls);
 
 			protected:
 				void MakeList() override
@@ -46,6 +50,7 @@ namespace cfg
 					Register<Optional>({"TLSPort", "tlsPort"}, &_tls_port);
 
 					Register<Optional>("WorkerCount", &_worker_count);
+					Register<Optional>("KernelTLS", &_kernel_tls);
 				}
 			};
 		}  // namespace cmm
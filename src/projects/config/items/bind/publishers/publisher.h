@@ -23,6 +23,15 @@ namespace cfg
 
 				int _worker_count{};
 
+				// Bind a SO_REUSEPORT socket for each worker, so that connections are distributed among the workers by the kernel
+				bool _reuse_port = false;
+
+				// (HTTP only) Closes a persistent connection if the next request is not received within this time (0 = disabled)
+				int _keep_alive_timeout = 30 * 1000;
+
+				// (HTTPS only) Encrypts the responses in the kernel (kTLS) if available
+				bool _kernel_tls = false;
+
 			public:
 				explicit Publisher(const char *port)
 					: _port(port)
@@ -39,6 +48,9 @@ namespace cfg
 				CFG_DECLARE_REF_GETTER_OF(GetTlsPort, _tls_port);
 
 				CFG_DECLARE_REF_GETTER_OF(GetWorkerCount, _worker_count);
+				CFG_DECLARE_REF_GETTER_OF(IsReusePortEnabled, _reuse_port);
+				CFG_DECLARE_REF_GETTER_OF(GetKeepAliveTimeout, _keep_alive_timeout);
+				CFG_DECLARE_REF_GETTER_OF(IsKernelTlsEnabled, _kernel_tls);
 
 			protected:
 				void MakeList() override
@@ -47,6 +59,9 @@ namespace cfg
 					Register<Optional>({"TLSPort", "tlsPort"}, &_tls_port);
 
 					Register<Optional>("WorkerCount", &_worker_count);
+					Register<Optional>("ReusePort", &_reuse_port);
+					Register<Optional>("KeepAliveTimeout", &_keep_alive_timeout);
+					Register<Optional>("KernelTLS", &_kernel_tls);
 				};
 			};
 		}  // namespace pub
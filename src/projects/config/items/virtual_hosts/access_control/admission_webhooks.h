@@ -9,6 +9,7 @@
 #pragma once
 
 #include "base/common_types.h"
+#include "admission_webhooks_cache.h"
 #include "enables.h"
 
 namespace cfg
@@ -24,6 +25,7 @@ namespace cfg
 				CFG_DECLARE_REF_GETTER_OF(GetTimeoutMsec, _timeout_msec)
 				CFG_DECLARE_REF_GETTER_OF(GetEnabledProviders, _enables.GetProviders().GetValue())
 				CFG_DECLARE_REF_GETTER_OF(GetEnabledPublishers, _enables.GetPublishers().GetValue())
+				CFG_DECLARE_REF_GETTER_OF(GetCache, _cache)
 
 				bool IsEnabledProvider(ProviderType type) const
 				{
@@ -44,6 +46,7 @@ namespace cfg
 					Register("SecretKey", &_secret_key);
 					Register("Timeout", &_timeout_msec);
 					Register("Enables", &_enables);
+					Register<Optional>("Cache", &_cache);
 				}
 
 				ov::String _control_server_url;
@@ -51,6 +54,7 @@ namespace cfg
 				int _timeout_msec = 3000;
 
 				Enables _enables;
+				AdmissionWebhooksCache _cache;
 			};
 		}  // namespace sig
 	}	   // namespace vhost
@@ -0,0 +1,43 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+namespace cfg
+{
+	namespace vhost
+	{
+		namespace sig
+		{
+			struct AdmissionWebhooksCache : public Item
+			{
+				CFG_DECLARE_REF_GETTER_OF(GetTtlMsec, _ttl_msec)
+				CFG_DECLARE_REF_GETTER_OF(GetMaxEntries, _max_entries)
+				CFG_DECLARE_REF_GETTER_OF(GetIPv4Prefix, _ipv4_prefix)
+				CFG_DECLARE_REF_GETTER_OF(GetIPv6Prefix, _ipv6_prefix)
+
+			protected:
+				void MakeList() override
+				{
+					Register<Optional>("TTL", &_ttl_msec);
+					Register<Optional>("MaxEntries", &_max_entries);
+					Register<Optional>("IPv4Prefix", &_ipv4_prefix);
+					Register<Optional>("IPv6Prefix", &_ipv6_prefix);
+				}
+
+				// Upper bound of the TTL, which is the "lifetime" of the decision
+				// (-1: not set, the decisions without "lifetime" are not cached, 0: the decisions are not cached)
+				int _ttl_msec = -1;
+				int _max_entries = 10000;
+				// Clients in the same network (address & prefix) share the decision
+				int _ipv4_prefix = 32;
+				int _ipv6_prefix = 128;
+			};
+		}  // namespace sig
+	}	   // namespace vhost
+}  // namespace cfg
@@ -0,0 +1,38 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+namespace cfg
+{
+	namespace vhost
+	{
+		namespace app
+		{
+			namespace pub
+			{
+				// Low-Latency HLS (fMP4 partial segments with blocking playlist reload)
+				struct HlsLowLatency : public Item
+				{
+				protected:
+					// Target duration of the partial segment (Unit: second)
+					double _part_duration = 0.5;
+
+				public:
+					CFG_DECLARE_REF_GETTER_OF(GetPartDuration, _part_duration)
+
+				protected:
+					void MakeList() override
+					{
+						Register<Optional>("PartDuration", &_part_duration);
+					}
+				};
+			}  // namespace pub
+		}	   // namespace app
+	}		   // namespace vhost
+}  // namespace cfg
@@ -8,6 +8,7 @@
 //==============================================================================
 #pragma once
 
+#include "hls_low_latency.h"
 #include "publisher.h"
 
 namespace cfg
@@ -29,6 +30,8 @@ namespace cfg
 					CFG_DECLARE_REF_GETTER_OF(GetSegmentDuration, _segment_duration)
 					CFG_DECLARE_REF_GETTER_OF(GetCrossDomainList, _cross_domains.GetUrls())
 					CFG_DECLARE_REF_GETTER_OF(GetCrossDomains, _cross_domains)
+					CFG_DECLARE_REF_GETTER_OF(GetLowLatency, _low_latency)
+					CFG_DECLARE_REF_GETTER_OF(GetTsMuxer, _ts_muxer)
 
 				protected:
 					void MakeList() override
@@ -38,11 +41,17 @@ namespace cfg
 						Register<Optional>("SegmentCount", &_segment_count);
 						Register<Optional>("SegmentDuration", &_segment_duration);
 						Register<Optional>("CrossDomains", &_cross_domains);
+						Register<Optional>("LowLatency", &_low_latency);
+						Register<Optional>("TsMuxer", &_ts_muxer);
 					}
 
 					int _segment_count = 3;
 					int _segment_duration = 5;
 					cmn::CrossDomains _cross_domains;
+					// LL-HLS is enabled when <LowLatency> is specified
+					HlsLowLatency _low_latency;
+					// ffmpeg: Writer (libavformat), native: MpegTsPacketizer
+					ov::String _ts_muxer = "ffmpeg";
 					int _send_buffer_size = 1024 * 1024 * 20;  // 20M
 					int _recv_buffer_size = 0;
 				};
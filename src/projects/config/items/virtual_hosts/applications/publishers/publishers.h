@@ -42,6 +42,8 @@ namespace cfg
 							&_thumbnail_publisher};
 					}
 
+					// Deprecated: The streams are processed by the shared executor, so this value is ignored
+					// (It is still parsed so that the existing configurations can be loaded, and a warning is logged)
 					CFG_DECLARE_REF_GETTER_OF(GetStreamLoadBalancingThreadCount, _stream_load_balancing_thread_count)
 					CFG_DECLARE_REF_GETTER_OF(GetSessionLoadBalancingThreadCount, _session_load_balancing_thread_count)
 					// CFG_DECLARE_REF_GETTER_OF(GetRtmpPublisher, _rtmp_publisher)
@@ -28,6 +28,8 @@ namespace cfg
 					CFG_DECLARE_REF_GETTER_OF(GetTimeout, _timeout)
 					CFG_DECLARE_REF_GETTER_OF(IsRtxEnabled, _rtx)
 					CFG_DECLARE_REF_GETTER_OF(IsUlpfecEnalbed, _ulpfec)
+					CFG_DECLARE_REF_GETTER_OF(IsTransportCcEnabled, _transport_cc)
+					CFG_DECLARE_REF_GETTER_OF(IsAbrEnabled, _abr)
 
 				protected:
 					void MakeList() override
@@ -37,11 +39,17 @@ namespace cfg
 						Register<Optional>("Timeout", &_timeout);
 						Register<Optional>("Rtx", &_rtx);
 						Register<Optional>("Ulpfec", &_ulpfec);
+						Register<Optional>("TransportCc", &_transport_cc);
+						Register<Optional>("Abr", &_abr);
 					}
 
 					int _timeout = 30000;
 					bool _rtx = true;
 					bool _ulpfec = true;
+					// Transport-wide congestion control: estimates the bandwidth of each viewer and paces the packets
+					bool _transport_cc = true;
+					// Switches each viewer between the renditions of the same input stream (transcoder outputs) by its network condition
+					bool _abr = false;
 				};
 			}  // namespace pub
 		}	   // namespace app
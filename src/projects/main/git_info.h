@@ -0,0 +1,8 @@
+//
+// This header file is auto generated by update_git_info.sh
+// for updating informations related with OME git repository.
+//
+#pragma once
+
+#define OME_GIT_VERSION                    "0c11e11"
+#define OME_GIT_VERSION_EXTRA              " (0c11e11)"
\ No newline at end of file
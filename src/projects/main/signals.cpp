@@ -118,6 +118,8 @@ static void AbortHandler(int signum, siginfo_t *si, void *unused)
 	time_t t = ::time(nullptr);
 
 	logtc("OME received signal %d (%s), interrupt.", signum, GetSignalName(signum));
+	// The process is going to be terminated, so write the queued logs now
+	ov_log_flush();
 
 	std::tm local_time{};
 	::localtime_r(&t, &local_time);
@@ -13,8 +13,8 @@
 #include "mediarouter_private.h"
 #include "monitoring/monitoring.h"
 
-#define MIN_APPLICATION_WORKER_COUNT 1
-#define MAX_APPLICATION_WORKER_COUNT 64
+// Maximum number of packets delivered in a batch (the stream is scheduled again if more packets are left, so other streams are not starved)
+#define MAX_DRAIN_PACKET_COUNT 256
 using namespace cmn;
 
 std::shared_ptr<MediaRouteApplication> MediaRouteApplication::Create(const info::Application &application_info)
@@ -30,28 +30,7 @@ std::shared_ptr<MediaRouteApplication> MediaRouteApplication::Create(const info:
 MediaRouteApplication::MediaRouteApplication(const info::Application &application_info)
 	: _application_info(application_info)
 {
-	_max_worker_thread_count = _application_info.GetConfig().GetPublishers().GetStreamLoadBalancingThreadCount();
-	if (_max_worker_thread_count < MIN_APPLICATION_WORKER_COUNT)
-	{
-		_max_worker_thread_count = MIN_APPLICATION_WORKER_COUNT;
-	}
-	if (_max_worker_thread_count > MAX_APPLICATION_WORKER_COUNT)
-	{
-		_max_worker_thread_count = MAX_APPLICATION_WORKER_COUNT;
-	}
-
-	logti("Created Mediarouter application. application id(%u), app(%s), worker(%d)", _application_info.GetId(), _application_info.GetName().CStr(), _max_worker_thread_count);
-
-	for (uint32_t worker_id = 0; worker_id < _max_worker_thread_count; worker_id++)
-	{
-		_inbound_stream_indicator.push_back(std::make_shared<ov::Queue<std::shared_ptr<MediaRouteStream>>>(
-			ov::String::FormatString("%s - Mediarouter inbound indicator (%d/%d)", _application_info.GetName().CStr(), worker_id, _max_worker_thread_count),
-			100));
-
-		_outbound_stream_indicator.push_back(std::make_shared<ov::Queue<std::shared_ptr<MediaRouteStream>>>(
-			ov::String::FormatString("%s - Mediarouter outbound indicator (%d/%d)", _application_info.GetName().CStr(), worker_id, _max_worker_thread_count),
-			100));
-	}
+	logti("Created Mediarouter application. application id(%u), app(%s)", _application_info.GetId(), _application_info.GetName().CStr());
 }
 
 MediaRouteApplication::~MediaRouteApplication()
@@ -63,39 +42,23 @@ bool MediaRouteApplication::Start()
 {
 	_kill_flag = false;
 
-	for (uint32_t worker_id = 0; worker_id < _max_worker_thread_count; worker_id++)
+	// The packets of the streams are processed on the shared work-stealing executor
+	auto executor = ov::WorkStealingExecutor::GetSharedInstance();
+	if (executor == nullptr)
 	{
-		try
-		{
-			auto inbound_thread = std::thread(&MediaRouteApplication::InboundWorkerThread, this, worker_id);
-			pthread_setname_np(inbound_thread.native_handle(), "InboundWorker");
-			_inbound_threads.push_back(std::move(inbound_thread));
-		}
-		catch (const std::system_error &e)
-		{
-			_kill_flag = true;
-			logte("Failed to start Mediarouter application thread.");
-			return false;
-		}
+		logte("Failed to start Mediarouter application. Could not get the executor.");
+		return false;
 	}
 
-	for (uint32_t worker_id = 0; worker_id < _max_worker_thread_count; worker_id++)
+	bool is_parsed = false;
+	_application_info.GetConfig().GetPublishers().GetStreamLoadBalancingThreadCount(&is_parsed);
+	if (is_parsed)
 	{
-		try
-		{
-			auto outbound_thread = std::thread(&MediaRouteApplication::OutboundWorkerThread, this, worker_id);
-			pthread_setname_np(outbound_thread.native_handle(), "OutboundWorker");
-			_outbound_threads.push_back(std::move(outbound_thread));
-		}
-		catch (const std::system_error &e)
-		{
-			_kill_flag = true;
-			logte("Failed to start Mediarouter application thread.");
-			return false;
-		}
+		logtw("<StreamLoadBalancingThreadCount> of %s is deprecated and ignored. The streams are processed by the shared executor (%zu threads).",
+			  _application_info.GetName().CStr(), executor->GetThreadCount());
 	}
 
-	logti("Started Mediarouter application. application id(%u), app(%s)", _application_info.GetId(), _application_info.GetName().CStr());
+	logti("Started Mediarouter application. application id(%u), app(%s), executor threads(%zu)", _application_info.GetId(), _application_info.GetName().CStr(), executor->GetThreadCount());
 
 	return true;
 }
@@ -104,45 +67,44 @@ bool MediaRouteApplication::Stop()
 {
 	_kill_flag = true;
 
-	for (auto &indicator : _inbound_stream_indicator)
-	{
-		indicator->Stop();
-		indicator->Clear();
-	}
+	// Wait for the running drain tasks, and discard the pending ones
+	StopStreamExecutors();
+
+	_connectors.clear();
 
-	for (auto &indicator : _outbound_stream_indicator)
 	{
-		indicator->Stop();
-		indicator->Clear();
+		std::lock_guard<std::shared_mutex> lock(_observers_lock);
+		_observers.clear();
+		UpdateObserversSnapshot();
 	}
 
-	for (auto &worker : _inbound_threads)
+	logti("Mediarouter application. id(%u), app(%s) has been stopped", _application_info.GetId(), _application_info.GetName().CStr());
+
+	return true;
+}
+
+void MediaRouteApplication::StopStreamExecutors()
+{
+	std::vector<std::shared_ptr<MediaRouteStream>> stream_list;
+
 	{
-		if (worker.joinable())
+		std::shared_lock<std::shared_mutex> lock_guard(_streams_lock);
+
+		for (const auto &item : _inbound_streams)
 		{
-			worker.join();
+			stream_list.push_back(item.second);
 		}
-	}
 
-	for (auto &worker : _outbound_threads)
-	{
-		if (worker.joinable())
+		for (const auto &item : _outbound_streams)
 		{
-			worker.join();
+			stream_list.push_back(item.second);
 		}
 	}
 
-	_inbound_stream_indicator.clear();
-	_outbound_stream_indicator.clear();
-	_inbound_threads.clear();
-	_outbound_threads.clear();
-
-	_connectors.clear();
-	_observers.clear();
-
-	logti("Mediarouter application. id(%u), app(%s) has been stopped", _application_info.GetId(), _application_info.GetName().CStr());
-
-	return true;
+	for (const auto &stream : stream_list)
+	{
+		stream->GetSerialExecutor()->Stop();
+	}
 }
 
 // Called when an application is created
@@ -200,6 +162,7 @@ bool MediaRouteApplication::RegisterObserverApp(
 	}
 
 	_observers.push_back(app_obsrv);
+	UpdateObserversSnapshot();
 
 	logtd("Registered observer. %p app(%s) type(%d)", app_obsrv.get(), _application_info.GetName().CStr(), app_obsrv->GetObserverType());
 
@@ -223,12 +186,24 @@ bool MediaRouteApplication::UnregisterObserverApp(
 	}
 
 	_observers.erase(position);
+	UpdateObserversSnapshot();
 
 	logti("Unregistered observer. %p app(%s) type(%d)", app_obsrv.get(), _application_info.GetName().CStr(), app_obsrv->GetObserverType());
 
 	return true;
 }
 
+// Must be called while _observers_lock is held
+void MediaRouteApplication::UpdateObserversSnapshot()
+{
+	std::atomic_store(&_observers_snapshot, std::make_shared<const ObserverList>(_observers));
+}
+
+std::shared_ptr<const MediaRouteApplication::ObserverList> MediaRouteApplication::GetObserversSnapshot() const
+{
+	return std::atomic_load(&_observers_snapshot);
+}
+
 // OnStreamCreated is called from Provider, Transcoder, Relay
 bool MediaRouteApplication::OnStreamCreated(
 	const std::shared_ptr<MediaRouteApplicationConnector> &app_conn,
@@ -460,18 +435,42 @@ bool MediaRouteApplication::OnStreamDeleted(
 bool MediaRouteApplication::DeleteInboundStream(
 	const std::shared_ptr<info::Stream> &stream_info)
 {
-	std::lock_guard<std::shared_mutex> lock_guard(_streams_lock);
+	std::unique_lock<std::shared_mutex> lock_guard(_streams_lock);
+
+	auto bucket = _inbound_streams.find(stream_info->GetId());
+	if (bucket == _inbound_streams.end())
+	{
+		return true;
+	}
 
-	_inbound_streams.erase(stream_info->GetId());
+	auto stream = bucket->second;
+	_inbound_streams.erase(bucket);
+
+	lock_guard.unlock();
+
+	// Wait for the packets being delivered
+	stream->GetSerialExecutor()->Stop();
 
 	return true;
 }
 bool MediaRouteApplication::DeleteOutboundStream(
 	const std::shared_ptr<info::Stream> &stream_info)
 {
-	std::lock_guard<std::shared_mutex> lock_guard(_streams_lock);
+	std::unique_lock<std::shared_mutex> lock_guard(_streams_lock);
 
-	_outbound_streams.erase(stream_info->GetId());
+	auto bucket = _outbound_streams.find(stream_info->GetId());
+	if (bucket == _outbound_streams.end())
+	{
+		return true;
+	}
+
+	auto stream = bucket->second;
+	_outbound_streams.erase(bucket);
+
+	lock_guard.unlock();
+
+	// Wait for the packets being delivered
+	stream->GetSerialExecutor()->Stop();
 
 	return true;
 }
@@ -542,9 +541,11 @@ bool MediaRouteApplication::OnPacketReceived(
 				return false;
 			}
 
-			stream->Push(packet);
-
-			_inbound_stream_indicator[stream_info->GetId() % _max_worker_thread_count]->Enqueue(stream);
+			// DrainStream() drains all packets of the stream at once, so it only needs to be scheduled when the queue becomes non-empty
+			if (stream->Push(packet))
+			{
+				ScheduleDrainStream(stream, MediaRouteApplicationObserver::ObserverType::Transcoder);
+			}
 		}
 		break;
 
@@ -557,9 +558,10 @@ bool MediaRouteApplication::OnPacketReceived(
 				return false;
 			}
 
-			stream->Push(packet);
-
-			_outbound_stream_indicator[stream_info->GetId() % _max_worker_thread_count]->Enqueue(stream);
+			if (stream->Push(packet))
+			{
+				ScheduleDrainStream(stream, MediaRouteApplicationObserver::ObserverType::Publisher);
+			}
 		}
 		break;
 		default: {
@@ -645,29 +647,47 @@ bool MediaRouteApplication::IsExistingInboundStream(ov::String stream_name)
 	return false;
 }
 
-void MediaRouteApplication::InboundWorkerThread(uint32_t worker_id)
+void MediaRouteApplication::ScheduleDrainStream(const std::shared_ptr<MediaRouteStream> &stream,
+												MediaRouteApplicationObserver::ObserverType observer_type)
 {
-	logtd("Created Inbound worker thread #%d", worker_id);
+	// The stream owns the serial executor, and this application owns the stream,
+	// so keep weak references to avoid circular references
+	std::weak_ptr<MediaRouteApplication> application_ref = GetSharedPtrAs<MediaRouteApplication>();
+	std::weak_ptr<MediaRouteStream> stream_ref = stream;
 
-	while (!_kill_flag)
-	{
-		auto msg = _inbound_stream_indicator[worker_id]->Dequeue(ov::Infinite);
-		if (msg.has_value() == false)
+	stream->GetSerialExecutor()->Post([application_ref, stream_ref, observer_type]() {
+		auto application = application_ref.lock();
+		auto stream = stream_ref.lock();
+
+		if ((application != nullptr) && (stream != nullptr))
 		{
-			// It may be called due to a normal stop signal.
-			continue;
+			application->DrainStream(stream, observer_type);
 		}
-		auto stream = msg.value();
-		if (stream == nullptr)
+	});
+}
+
+void MediaRouteApplication::DrainStream(std::shared_ptr<MediaRouteStream> &stream,
+										MediaRouteApplicationObserver::ObserverType observer_type)
+{
+	std::vector<std::shared_ptr<MediaPacket>> packets;
+	size_t drain_count = 0;
+
+	while ((_kill_flag == false) && (stream->IsPacketQueueEmpty() == false))
+	{
+		if (drain_count >= MAX_DRAIN_PACKET_COUNT)
 		{
-			logtw("Not found stream info");
-			continue;
+			// Let the executor process other streams, and then come back to this stream
+			// (Only this task pops the packets, so the queue is still non-empty and the provider won't schedule again)
+			ScheduleDrainStream(stream, observer_type);
+			break;
 		}
 
-		// StreamDeliver media packet to Publiser(observer) of Transcoder(observer)
+		drain_count++;
+
 		auto media_packet = stream->Pop();
 		if (media_packet == nullptr)
 		{
+			// The packet is stashed or dropped
 			continue;
 		}
 
@@ -675,73 +695,36 @@ void MediaRouteApplication::InboundWorkerThread(uint32_t worker_id)
 		// Notify the Observer that the stream is parsed
 		if (stream->IsStreamPrepared() == false && stream->AreAllTracksParsed() == true)
 		{
+			// The packets popped so far must be delivered before the stream is prepared
+			DeliverPackets(stream, observer_type, packets);
+			packets.clear();
+
 			NotifyStreamPrepared(stream);
 		}
 
-		std::shared_lock<std::shared_mutex> lock(_observers_lock);
-		for (const auto &observer : _observers)
-		{
-			auto observer_type = observer->GetObserverType();
-
-			if (observer_type == MediaRouteApplicationObserver::ObserverType::Transcoder)
-			{
-				// Get Stream Info
-				auto stream_info = stream->GetStream();
-
-				// observer->OnSendFrame(stream_info, std::move(media_packet->ClonePacket()));
-				observer->OnSendFrame(stream_info, media_packet);
-			}
-		}
+		packets.push_back(std::move(media_packet));
 	}
 
-	logtd("Inbound worker thread #%d has beed stopped", worker_id);
+	DeliverPackets(stream, observer_type, packets);
 }
 
-void MediaRouteApplication::OutboundWorkerThread(uint32_t worker_id)
+void MediaRouteApplication::DeliverPackets(const std::shared_ptr<MediaRouteStream> &stream,
+										   MediaRouteApplicationObserver::ObserverType observer_type,
+										   const std::vector<std::shared_ptr<MediaPacket>> &packets)
 {
-	logtd("Created outbound worker thread #%d", worker_id);
-
-	while (!_kill_flag)
+	if (packets.empty())
 	{
-		auto msg = _outbound_stream_indicator[worker_id]->Dequeue(ov::Infinite);
-		if (msg.has_value() == false)
-		{
-			// It may be called due to a normal stop signal.
-			continue;
-		}
-		auto stream = msg.value();
-		if (stream == nullptr)
-		{
-			logtw("Not found stream info");
-			continue;
-		}
-
-		// StreamDeliver media packet to Publiser(observer) of Transcoder(observer)
-		auto media_packet = stream->Pop();
-		if (media_packet == nullptr)
-		{
-			continue;
-		}
+		return;
+	}
 
-		if (stream->IsStreamPrepared() == false && stream->AreAllTracksParsed() == true)
-		{
-			NotifyStreamPrepared(stream);
-		}
+	auto stream_info = stream->GetStream();
+	auto observers = GetObserversSnapshot();
 
-		std::shared_lock<std::shared_mutex> lock(_observers_lock);
-		for (const auto &observer : _observers)
+	for (const auto &observer : *observers)
+	{
+		if (observer->GetObserverType() == observer_type)
 		{
-			auto observer_type = observer->GetObserverType();
-
-			if (observer_type == MediaRouteApplicationObserver::ObserverType::Publisher)
-			{
-				// Get Stream Info
-				auto stream_info = stream->GetStream();
-
-				observer->OnSendFrame(stream_info, media_packet);
-			}
+			observer->OnSendFrames(stream_info, packets);
 		}
 	}
-
-	logtd("Outbound worker thread #%d has beed stopped", worker_id);
 }
@@ -114,9 +114,16 @@ private:
 	std::shared_mutex _connectors_lock;
 
 	// Information of Observer instance
-	std::vector<std::shared_ptr<MediaRouteApplicationObserver>> _observers;
+	using ObserverList = std::vector<std::shared_ptr<MediaRouteApplicationObserver>>;
+	ObserverList _observers;
 	std::shared_mutex _observers_lock;
 
+	// Copy-on-write snapshot of _observers used by the worker threads, so they don't need to acquire _observers_lock for every packet
+	// (It is replaced while _observers_lock is held, and is read by std::atomic_load())
+	std::shared_ptr<const ObserverList> _observers_snapshot = std::make_shared<const ObserverList>();
+	void UpdateObserversSnapshot();
+	std::shared_ptr<const ObserverList> GetObserversSnapshot() const;
+
 	// Information of MediaStream instance
 	// Inbound Streams
 	// Key : Stream.id
@@ -128,16 +135,19 @@ private:
 	std::shared_mutex _streams_lock;
 
 private:
-	void InboundWorkerThread(uint32_t worker_id);
-	void OutboundWorkerThread(uint32_t worker_id);
+	// Posts DrainStream() to the serial executor of the stream
+	void ScheduleDrainStream(const std::shared_ptr<MediaRouteStream> &stream,
+							 MediaRouteApplicationObserver::ObserverType observer_type);
 
-	volatile bool _kill_flag;
-	std::vector<std::thread> _inbound_threads;
-	std::vector<std::thread> _outbound_threads;
+	// Pops the packets of the stream and delivers them to the observers of observer_type as a batch
+	void DrainStream(std::shared_ptr<MediaRouteStream> &stream,
+					 MediaRouteApplicationObserver::ObserverType observer_type);
+	void DeliverPackets(const std::shared_ptr<MediaRouteStream> &stream,
+						MediaRouteApplicationObserver::ObserverType observer_type,
+						const std::vector<std::shared_ptr<MediaPacket>> &packets);
 
-	uint32_t _max_worker_thread_count;
+	// Stops the serial executors of all streams (waits for the running tasks)
+	void StopStreamExecutors();
 
-private:
-	std::vector<std::shared_ptr<ov::Queue<std::shared_ptr<MediaRouteStream>>>> _inbound_stream_indicator;
-	std::vector<std::shared_ptr<ov::Queue<std::shared_ptr<MediaRouteStream>>>> _outbound_stream_indicator;
+	std::atomic<bool> _kill_flag{false};
 };
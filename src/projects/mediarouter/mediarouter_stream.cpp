@@ -51,6 +51,10 @@ MediaRouteStream::MediaRouteStream(const std::shared_ptr<info::Stream> &stream)
 	: _stream(stream),
 	  _packets_queue(nullptr, 100)
 {
+	_serial_executor = ov::SerialExecutor::Create(
+		ov::WorkStealingExecutor::GetSharedInstance(),
+		ov::String::FormatString("%s/%s - Mediarouter stream", stream->GetApplicationInfo().GetName().CStr(), stream->GetName().CStr()).CStr());
+
 	logti("Trying to create media route stream: name(%s) id(%u)", stream->GetName().CStr(), stream->GetId());
 	_inout_type = MediaRouterStreamType::UNKNOWN;
 
@@ -68,6 +72,8 @@ MediaRouteStream::~MediaRouteStream()
 {
 	logti("Delete media route stream name(%s) id(%u)", _stream->GetName().CStr(), _stream->GetId());
 
+	_serial_executor->Stop();
+
 	_media_packet_stash.clear();
 
 	_stat_recv_pkt_lpts.clear();
@@ -192,11 +198,9 @@ bool MediaRouteStream::ProcessH264AVCCStream(std::shared_ptr<MediaTrack> &media_
 			auto nalu = read_stream.GetRemainData(nal_length);
 
 			// Exception handling for encoder that transmits AVCC in non-standard format ([Size][Start Code][NalU])
-			if ((nalu->GetLength() > 3 && nalu->GetDataAs<uint8_t>()[0] == 0x00 && nalu->GetDataAs<uint8_t>()[1] == 0x00 && nalu->GetDataAs<uint8_t>()[2] == 0x01) ||
-				(nalu->GetLength() > 3 && nalu->GetDataAs<uint8_t>()[0] == 0x00 && nalu->GetDataAs<uint8_t>()[1] == 0x00 && nalu->GetDataAs<uint8_t>()[2] == 0x00 && nalu->GetDataAs<uint8_t>()[3] == 0x01))
+			size_t start_code_size = 0;
+			if ((nal_length > 3) && (H264Parser::FindAnnexBStartCode(nalu->GetDataAs<uint8_t>(), std::min(nal_length, static_cast<size_t>(4)), start_code_size) == 0))
 			{
-				size_t start_code_size = (nalu->GetDataAs<uint8_t>()[2] == 0x01) ? 3 : 4;
-
 				read_stream.Skip(start_code_size);
 				nal_length -= start_code_size;
 				nalu = read_stream.GetRemainData(nal_length);
@@ -225,6 +229,9 @@ bool MediaRouteStream::ProcessH264AVCCStream(std::shared_ptr<MediaTrack> &media_
 				}
 			}
 
+			// A start code must not be found in the NAL unit after it is converted to Annex-B
+			nalu = H264Converter::EscapeNalUnitIfNeeded(nalu);
+
 			converted_data->Append(START_CODE, sizeof(START_CODE));
 			nalu_offset += START_CODE_LEN;
 
@@ -917,9 +924,19 @@ void MediaRouteStream::DropNonDecodingPackets()
 	}
 }
 
-void MediaRouteStream::Push(std::shared_ptr<MediaPacket> media_packet)
+bool MediaRouteStream::Push(std::shared_ptr<MediaPacket> media_packet)
+{
+	return _packets_queue.Enqueue(std::move(media_packet));
+}
+
+bool MediaRouteStream::IsPacketQueueEmpty() const
+{
+	return _packets_queue.IsEmpty();
+}
+
+const std::shared_ptr<ov::SerialExecutor> &MediaRouteStream::GetSerialExecutor() const
 {
-	_packets_queue.Enqueue(std::move(media_packet));
+	return _serial_executor;
 }
 
 std::shared_ptr<MediaPacket> MediaRouteStream::Pop()
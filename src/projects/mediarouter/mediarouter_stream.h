@@ -40,11 +40,16 @@ public:
 	MediaRouterStreamType GetInoutType();
 
 	// Queue interfaces
-	void Push(std::shared_ptr<MediaPacket> media_packet);
+	// Returns true if the queue was empty (the worker needs to be notified)
+	bool Push(std::shared_ptr<MediaPacket> media_packet);
 	bool ProcessInboundStream(std::shared_ptr<MediaTrack> &media_track, std::shared_ptr<MediaPacket> &media_packet);
 	bool ProcessOutboundStream(std::shared_ptr<MediaTrack> &media_track,std::shared_ptr<MediaPacket> &media_packet);
 
 	std::shared_ptr<MediaPacket> Pop();
+	bool IsPacketQueueEmpty() const;
+
+	// The packets of the stream are processed on this executor, in order
+	const std::shared_ptr<ov::SerialExecutor> &GetSerialExecutor() const;
 
 	// Query original stream information
 	std::shared_ptr<info::Stream> GetStream();
@@ -82,7 +87,9 @@ private:
 	std::map<MediaTrackId, std::shared_ptr<MediaPacket>> _media_packet_stash;
 
 	// Packets queue
-	ov::Queue<std::shared_ptr<MediaPacket>> _packets_queue;
+	// Pushed by the provider/transcoder threads, popped by the serial executor of the stream
+	ov::MpscQueue<std::shared_ptr<MediaPacket>> _packets_queue;
+	std::shared_ptr<ov::SerialExecutor> _serial_executor;
 
 	// TODO(Soulk) : Modified to use by tying statistical information into a class and creating a map with MediaTrackId as a key
 
@@ -16,6 +16,26 @@ AccessController::AccessController(PublisherType publisher_type, const cfg::Serv
 
 }
 
+std::shared_ptr<AdmissionWebhooksCache> AccessController::GetAdmissionWebhooksCache(const ov::String &vhost_name, const cfg::vhost::sig::AdmissionWebhooks &webhooks_config)
+{
+	std::lock_guard lock(_admission_webhooks_cache_mutex);
+
+	auto item = _admission_webhooks_cache_map.find(vhost_name);
+	if (item != _admission_webhooks_cache_map.end())
+	{
+		return item->second;
+	}
+
+	auto &cache_config = webhooks_config.GetCache();
+	auto cache = std::make_shared<AdmissionWebhooksCache>(
+		cache_config.GetTtlMsec(), std::max(cache_config.GetMaxEntries(), 1),
+		cache_config.GetIPv4Prefix(), cache_config.GetIPv6Prefix());
+
+	_admission_webhooks_cache_map[vhost_name] = cache;
+
+	return cache;
+}
+
 std::tuple<AccessController::VerificationResult, std::shared_ptr<const AdmissionWebhooks>> AccessController::VerifyByWebhooks(const std::shared_ptr<const ov::Url> &request_url, const std::shared_ptr<ov::SocketAddress> &client_address)
 {
 	auto orchestrator = ocst::Orchestrator::GetInstance();
@@ -71,14 +91,16 @@ std::tuple<AccessController::VerificationResult, std::shared_ptr<const Admission
 		auto secret_key = webhooks_config.GetSecretKey();
 		auto timeout_msec = webhooks_config.GetTimeoutMsec();
 
-		std::shared_ptr<AdmissionWebhooks> admission_webhooks;
+		ov::String direction, protocol;
 		if(_provider_type != ProviderType::Unknown)
 		{
-			admission_webhooks = AdmissionWebhooks::Query(_provider_type, control_server_url, timeout_msec, secret_key, client_address, request_url);
+			direction = "incoming";
+			protocol = StringFromProviderType(_provider_type);
 		}
 		else if(_publisher_type != PublisherType::Unknown)
 		{
-			admission_webhooks = AdmissionWebhooks::Query(_publisher_type, control_server_url, timeout_msec, secret_key, client_address, request_url);
+			direction = "outgoing";
+			protocol = StringFromPublisherType(_publisher_type);
 		}
 		else
 		{
@@ -86,6 +108,19 @@ std::tuple<AccessController::VerificationResult, std::shared_ptr<const Admission
 			return {AccessController::VerificationResult::Error, nullptr};
 		}
 
+		// Clients which request the same URL share the decision (and the in-flight query)
+		auto cache = GetAdmissionWebhooksCache(vhost_name, webhooks_config);
+		auto cache_key = cache->MakeKey(control_server_url_address, direction, protocol, request_url, client_address);
+
+		auto admission_webhooks = cache->Query(cache_key, [=]() -> std::shared_ptr<AdmissionWebhooks> {
+			if(_provider_type != ProviderType::Unknown)
+			{
+				return AdmissionWebhooks::Query(_provider_type, control_server_url, timeout_msec, secret_key, client_address, request_url);
+			}
+
+			return AdmissionWebhooks::Query(_publisher_type, control_server_url, timeout_msec, secret_key, client_address, request_url);
+		});
+
 		if(admission_webhooks == nullptr)
 		{
 			// Probably this doesn't happen
@@ -14,6 +14,7 @@
 #include "signed_policy/signed_policy.h"
 #include "signed_token/signed_token.h"
 #include "admission_webhooks/admission_webhooks.h"
+#include "admission_webhooks/admission_webhooks_cache.h"
 
 class AccessController
 {
@@ -36,7 +37,13 @@ public:
 	std::tuple<VerificationResult, std::shared_ptr<const AdmissionWebhooks>> VerifyByWebhooks(const std::shared_ptr<const ov::Url> &request_url, const std::shared_ptr<ov::SocketAddress> &client_address);
 	
 private:
+	std::shared_ptr<AdmissionWebhooksCache> GetAdmissionWebhooksCache(const ov::String &vhost_name, const cfg::vhost::sig::AdmissionWebhooks &webhooks_config);
+
 	const ProviderType _provider_type;
 	const PublisherType _publisher_type;
 	const cfg::Server _server_config;
+
+	// key: vhost name
+	std::mutex _admission_webhooks_cache_mutex;
+	std::map<ov::String, std::shared_ptr<AdmissionWebhooksCache>> _admission_webhooks_cache_map;
 };
\ No newline at end of file
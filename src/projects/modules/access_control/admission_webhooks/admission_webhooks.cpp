@@ -62,6 +62,19 @@ uint64_t AdmissionWebhooks::GetLifetime() const
 	return _lifetime;
 }
 
+std::shared_ptr<AdmissionWebhooks> AdmissionWebhooks::Clone(uint64_t elapsed_msec) const
+{
+	auto hooks = std::make_shared<AdmissionWebhooks>(*this);
+
+	if (_lifetime != 0)
+	{
+		// 0 means infinite, so keep at least 1
+		hooks->_lifetime = (_lifetime > elapsed_msec) ? (_lifetime - elapsed_msec) : 1;
+	}
+
+	return hooks;
+}
+
 void AdmissionWebhooks::SetError(ErrCode code, ov::String reason)
 {
 	_err_code = code;
@@ -134,7 +147,7 @@ void AdmissionWebhooks::ParseResponse(const std::shared_ptr<ov::Data> &data)
 	{
 		"allowed": true,
 		"new_url": "scheme://host[:port]/app/stream/file?query=value&query2=value2",
-		"lifetime": seconds   // 0 : infinite
+		"lifetime": milliseconds   // 0 : infinite
 	}
 
 	{
@@ -219,6 +232,8 @@ void AdmissionWebhooks::Run()
 	auto client = std::make_shared<http::clnt::HttpClient>();
 	client->SetMethod(http::Method::Post);
 	client->SetBlockingMode(ov::BlockingMode::Blocking);
+	// Reuse the connection to the control server
+	client->SetKeepAlive(true);
 	client->SetConnectionTimeout(_timeout_msec);
 	client->SetRequestHeader("X-OME-Signature", signature_sha1_base64);
 	client->SetRequestHeader("Content-Type", "application/json");
@@ -34,6 +34,9 @@ public:
 	ov::String GetErrReason() const;
 	std::shared_ptr<ov::Url> GetNewURL() const;
 	uint64_t GetLifetime() const;
+
+	// Copies the decision for another client (The lifetime is reduced by elapsed_msec, if the lifetime is not infinite)
+	std::shared_ptr<AdmissionWebhooks> Clone(uint64_t elapsed_msec) const;
 	
 private:
 	void Run();
@@ -0,0 +1,220 @@
+#include "admission_webhooks_cache.h"
+
+#define OV_LOG_TAG "AdmissionWebhooks"
+
+namespace
+{
+	std::atomic<uint64_t> g_query_count{0};
+	std::atomic<uint64_t> g_hit_count{0};
+	std::atomic<uint64_t> g_miss_count{0};
+	std::atomic<uint64_t> g_coalesced_count{0};
+	std::atomic<uint64_t> g_total_latency_msec{0};
+	std::atomic<uint64_t> g_max_latency_msec{0};
+}  // namespace
+
+AdmissionWebhooksCache::AdmissionWebhooksCache(int64_t max_ttl_msec, size_t max_entries, int ipv4_prefix, int ipv6_prefix)
+	: _max_ttl_msec(max_ttl_msec),
+	  _max_entries(std::max<size_t>(max_entries, 1)),
+	  _ipv4_prefix(std::clamp(ipv4_prefix, 0, 32)),
+	  _ipv6_prefix(std::clamp(ipv6_prefix, 0, 128))
+{
+}
+
+ov::String AdmissionWebhooksCache::MakeKey(const ov::String &control_server_url, const ov::String &direction, const ov::String &protocol,
+										   const std::shared_ptr<const ov::Url> &request_url, const std::shared_ptr<ov::SocketAddress> &client_address) const
+{
+	ov::String network;
+
+	if (client_address != nullptr)
+	{
+		switch (client_address->GetFamily())
+		{
+			case ov::SocketFamily::Inet: {
+				uint32_t address = ntohl(client_address->AddrInForIPv4()->s_addr);
+				uint32_t mask = (_ipv4_prefix == 0) ? 0U : (0xFFFFFFFFU << (32 - _ipv4_prefix));
+
+				network.Format("%08X/%d", address & mask, _ipv4_prefix);
+				break;
+			}
+
+			case ov::SocketFamily::Inet6: {
+				auto address = client_address->AddrInForIPv6()->s6_addr;
+				int remained_bits = _ipv6_prefix;
+
+				for (int index = 0; index < 16; index++)
+				{
+					uint8_t mask = (remained_bits >= 8) ? 0xFF : static_cast<uint8_t>(0xFF << (8 - std::max(remained_bits, 0)));
+					remained_bits -= 8;
+
+					network.AppendFormat("%02X", address[index] & mask);
+				}
+
+				network.AppendFormat("/%d", _ipv6_prefix);
+				break;
+			}
+
+			default:
+				network = client_address->GetIpAddress();
+				break;
+		}
+	}
+
+	return ov::String::FormatString("%s|%s/%s|%s|%s",
+									control_server_url.CStr(),
+									direction.CStr(), protocol.CStr(),
+									request_url->ToUrlString(true).CStr(),
+									network.CStr());
+}
+
+std::shared_ptr<const AdmissionWebhooks> AdmissionWebhooksCache::FindEntry(const ov::String &key, uint64_t now_msec)
+{
+	auto item = _entry_map.find(key);
+
+	if (item == _entry_map.end())
+	{
+		return nullptr;
+	}
+
+	auto entry = item->second;
+
+	if (entry->expired_time_msec <= now_msec)
+	{
+		_entry_list.erase(entry);
+		_entry_map.erase(item);
+
+		return nullptr;
+	}
+
+	// Move to the front (most recently used)
+	_entry_list.splice(_entry_list.begin(), _entry_list, entry);
+
+	return entry->hooks->Clone(now_msec - entry->cached_time_msec);
+}
+
+void AdmissionWebhooksCache::AddEntry(const ov::String &key, const std::shared_ptr<const AdmissionWebhooks> &hooks, uint64_t now_msec)
+{
+	switch (hooks->GetErrCode())
+	{
+		case AdmissionWebhooks::ErrCode::ALLOWED:
+		case AdmissionWebhooks::ErrCode::DENIED:
+			break;
+
+		default:
+			// Errors are not cached so that the next client queries again
+			return;
+	}
+
+	// The cached decision must not outlive the lifetime given by the control server (0: infinite)
+	uint64_t ttl_msec = hooks->GetLifetime();
+
+	if (_max_ttl_msec > 0)
+	{
+		auto max_ttl_msec = static_cast<uint64_t>(_max_ttl_msec);
+
+		ttl_msec = ((ttl_msec == 0) || (ttl_msec > max_ttl_msec)) ? max_ttl_msec : ttl_msec;
+	}
+
+	if (ttl_msec == 0)
+	{
+		// No lifetime and no upper bound
+		return;
+	}
+
+	auto item = _entry_map.find(key);
+
+	if (item != _entry_map.end())
+	{
+		_entry_list.erase(item->second);
+		_entry_map.erase(item);
+	}
+
+	while (_entry_list.size() >= _max_entries)
+	{
+		// Evict the least recently used entry
+		_entry_map.erase(_entry_list.back().key);
+		_entry_list.pop_back();
+	}
+
+	_entry_list.push_front({key, hooks, now_msec, now_msec + ttl_msec});
+	_entry_map[key] = _entry_list.begin();
+}
+
+std::shared_ptr<const AdmissionWebhooks> AdmissionWebhooksCache::Query(const ov::String &key, const QueryHandler &query_handler)
+{
+	std::promise<std::shared_ptr<const AdmissionWebhooks>> promise;
+
+	{
+		std::unique_lock lock(_mutex);
+
+		if (_max_ttl_msec != 0)
+		{
+			auto hooks = FindEntry(key, ov::Clock::NowMSec());
+
+			if (hooks != nullptr)
+			{
+				g_hit_count++;
+				return hooks;
+			}
+
+			g_miss_count++;
+		}
+
+		auto in_flight = _in_flight_map.find(key);
+
+		if (in_flight != _in_flight_map.end())
+		{
+			auto future = in_flight->second;
+			lock.unlock();
+
+			g_coalesced_count++;
+			logtd("Waiting for the in-flight query: %s", key.CStr());
+
+			return future.get();
+		}
+
+		_in_flight_map[key] = promise.get_future().share();
+	}
+
+	auto start_time_msec = ov::Clock::NowMSec();
+	std::shared_ptr<const AdmissionWebhooks> hooks = query_handler();
+	auto now_msec = ov::Clock::NowMSec();
+
+	auto latency_msec = now_msec - start_time_msec;
+	g_query_count++;
+	g_total_latency_msec += latency_msec;
+
+	auto max_latency_msec = g_max_latency_msec.load();
+	while ((latency_msec > max_latency_msec) && (g_max_latency_msec.compare_exchange_weak(max_latency_msec, latency_msec) == false))
+	{
+	}
+
+	{
+		std::lock_guard lock(_mutex);
+
+		if ((_max_ttl_msec != 0) && (hooks != nullptr))
+		{
+			AddEntry(key, hooks, now_msec);
+		}
+
+		_in_flight_map.erase(key);
+	}
+
+	// Wake up the clients which are waiting for this query
+	promise.set_value(hooks);
+
+	return hooks;
+}
+
+AdmissionWebhooksCache::Stats AdmissionWebhooksCache::GetStats()
+{
+	Stats stats;
+
+	stats.query_count = g_query_count;
+	stats.hit_count = g_hit_count;
+	stats.miss_count = g_miss_count;
+	stats.coalesced_count = g_coalesced_count;
+	stats.total_latency_msec = g_total_latency_msec;
+	stats.max_latency_msec = g_max_latency_msec;
+
+	return stats;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <base/ovsocket/socket_address.h>
+
+#include <future>
+#include <list>
+#include <unordered_map>
+
+#include "admission_webhooks.h"
+
+// Caches the decisions of the control server, and coalesces the requests with the same key
+//
+// When a popular stream goes live, many clients request the same URL at the same time.
+// Only the first client queries the control server, and the others wait for the decision of it.
+class AdmissionWebhooksCache
+{
+public:
+	struct Stats
+	{
+		// Number of queries sent to the control server
+		uint64_t query_count = 0;
+		uint64_t hit_count = 0;
+		uint64_t miss_count = 0;
+		// Number of requests which waited for the decision of the same in-flight query
+		uint64_t coalesced_count = 0;
+
+		// Latency of the queries
+		uint64_t total_latency_msec = 0;
+		uint64_t max_latency_msec = 0;
+	};
+
+	using QueryHandler = std::function<std::shared_ptr<AdmissionWebhooks>()>;
+
+	// A decision is cached for its "lifetime", up to max_ttl_msec
+	//
+	// max_ttl_msec < 0: No upper bound (the decisions without "lifetime" are not cached)
+	// max_ttl_msec == 0: The decisions are not cached (the requests are still coalesced)
+	AdmissionWebhooksCache(int64_t max_ttl_msec, size_t max_entries, int ipv4_prefix, int ipv6_prefix);
+
+	// Clients in the same network (masked by ipv4_prefix/ipv6_prefix) share the decision
+	ov::String MakeKey(const ov::String &control_server_url, const ov::String &direction, const ov::String &protocol,
+					   const std::shared_ptr<const ov::Url> &request_url, const std::shared_ptr<ov::SocketAddress> &client_address) const;
+
+	std::shared_ptr<const AdmissionWebhooks> Query(const ov::String &key, const QueryHandler &query_handler);
+
+	// Statistics of all caches
+	static Stats GetStats();
+
+protected:
+	struct Entry
+	{
+		ov::String key;
+		std::shared_ptr<const AdmissionWebhooks> hooks;
+		uint64_t cached_time_msec;
+		uint64_t expired_time_msec;
+	};
+
+	std::shared_ptr<const AdmissionWebhooks> FindEntry(const ov::String &key, uint64_t now_msec);
+	void AddEntry(const ov::String &key, const std::shared_ptr<const AdmissionWebhooks> &hooks, uint64_t now_msec);
+
+	const int64_t _max_ttl_msec;
+	const size_t _max_entries;
+	const int _ipv4_prefix;
+	const int _ipv6_prefix;
+
+	std::mutex _mutex;
+
+	// The most recently used entry is at the front
+	std::list<Entry> _entry_list;
+	std::unordered_map<ov::String, std::list<Entry>::iterator> _entry_map;
+
+	std::unordered_map<ov::String, std::shared_future<std::shared_ptr<const AdmissionWebhooks>>> _in_flight_map;
+};
@@ -1,6 +1,8 @@
 
 #include "h264_converter.h"
 
+#include <modules/bitstream/nalu/nal_unit_scanner.h>
+
 #include "h264_decoder_configuration_record.h"
 #include "h264_parser.h"
 
@@ -29,7 +31,8 @@ bool H264Converter::GetExtraDataFromAvccSequenceHeader(const cmn::PacketType typ
 
 std::shared_ptr<const ov::Data> H264Converter::ConvertAvccToAnnexb(const std::shared_ptr<const ov::Data> &data)
 {
-	auto annexb_data = std::make_shared<ov::Data>();
+	// The length of Annex-B is the same as AVCC (unless a NAL unit is escaped)
+	auto annexb_data = std::make_shared<ov::Data>(data->GetLength());
 
 	ov::ByteStream read_stream(data.get());
 
@@ -54,12 +57,31 @@ std::shared_ptr<const ov::Data> H264Converter::ConvertAvccToAnnexb(const std::sh
 		OV_ASSERT2(skipped == nal_length);
 
 		annexb_data->Append(START_CODE, sizeof(START_CODE));
-		annexb_data->Append(nal_data);
+		annexb_data->Append(EscapeNalUnitIfNeeded(nal_data));
 	}
 
 	return annexb_data;
 }
 
+std::shared_ptr<const ov::Data> H264Converter::EscapeNalUnitIfNeeded(const std::shared_ptr<const ov::Data> &nal_unit)
+{
+	auto buffer = nal_unit->GetDataAs<uint8_t>();
+	auto length = nal_unit->GetLength();
+
+	if (NalUnitScanner::HasStartCodeEmulation(buffer, length) == false)
+	{
+		return nal_unit;
+	}
+
+	auto escaped = std::make_shared<ov::Data>(NalUnitScanner::GetMaxEscapedLength(length));
+	escaped->SetLength(NalUnitScanner::GetMaxEscapedLength(length));
+	escaped->SetLength(NalUnitScanner::InsertEmulationPrevention(buffer, length, escaped->GetWritableDataAs<uint8_t>()));
+
+	logtd("Inserted emulation prevention bytes into the NAL unit which was not escaped (%zu -> %zu bytes)", length, escaped->GetLength());
+
+	return escaped;
+}
+
 bool H264Converter::ConvertAvccToAnnexb(cmn::PacketType type, const std::shared_ptr<ov::Data> &data, const std::shared_ptr<ov::Data> &sps_pps_annexb)
 {
 	auto annexb_data = std::make_shared<ov::Data>();
@@ -119,7 +141,7 @@ bool H264Converter::ConvertAvccToAnnexb(cmn::PacketType type, const std::shared_
 			}
 
 			annexb_data->Append(START_CODE, sizeof(START_CODE));
-			annexb_data->Append(nal_data);
+			annexb_data->Append(EscapeNalUnitIfNeeded(nal_data));
 		}
 
 		// Deprecated. The same function is performed in Mediarouter.
@@ -141,55 +163,6 @@ bool H264Converter::ConvertAvccToAnnexb(cmn::PacketType type, const std::shared_
 	return true;
 }
 
-static inline int GetStartPatternSize(const void *data, size_t length, int first_pattern_size)
-{
-	if (data != nullptr)
-	{
-		auto buffer = static_cast<const uint8_t *>(data);
-
-		if (first_pattern_size > 0)
-		{
-			if ((buffer[0] == 0x00) && (buffer[1] == 0x00))
-			{
-				if (
-					(first_pattern_size == 4) &&
-					((length >= 4) && (buffer[2] == 0x00) && (buffer[3] == 0x01)))
-				{
-					// 0x00 0x00 0x00 0x01 pattern
-					return 4;
-				}
-				else if (
-					(first_pattern_size == 3) &&
-					((length >= 3) && (buffer[2] == 0x01)))
-				{
-					// 0x00 0x00 0x01 pattern
-					return 3;
-				}
-			}
-
-			// pattern_size must be the same with the first_pattern_size
-			return -1;
-		}
-		else
-		{
-			// probe mode
-
-			if ((length >= 4) && ((buffer[0] == 0x00) && (buffer[1] == 0x00) && (buffer[2] == 0x00) && (buffer[3] == 0x01)))
-			{
-				// 0x00 0x00 0x00 0x01 pattern
-				return 4;
-			}
-			if ((length >= 3) && ((buffer[0] == 0x00) && (buffer[1] == 0x00) && (buffer[2] == 0x01)))
-			{
-				// 0x00 0x00 0x01 pattern
-				return 3;
-			}
-		}
-	}
-
-	return -1;
-}
-
 #if 0
 static bool ExtractSpsPpsOffset(const std::shared_ptr<const ov::Data> &data, const std::vector<size_t> &offset_list, const std::vector<size_t> &pattern_size_list,
 								const std::shared_ptr<ov::Data> &sps, const std::shared_ptr<ov::Data> &pps)
@@ -278,40 +251,35 @@ std::shared_ptr<const ov::Data> H264Converter::ConvertAnnexbToAvcc(const std::sh
 	off_t offset = 0;
 	off_t last_offset = 0;
 
-	auto avcc_data = std::make_shared<ov::Data>();
+	// The length of AVCC is the same as Annex-B if the start codes are 4 bytes
+	auto avcc_data = std::make_shared<ov::Data>(data->GetLength());
 	ov::ByteStream byte_stream(avcc_data);
 
 	// This code assumes that (NALULengthSizeMinusOne == 3)
 	while (remained > 0)
 	{
-		if (*buffer == 0x00)
-		{
-			auto pattern_size = GetStartPatternSize(buffer, remained, 0);
-
-			if (pattern_size > 0)
-			{
-				if (last_offset < offset)
-				{
-					auto nalu = data->Subdata(last_offset, offset - last_offset);
+		size_t pattern_size = 0;
+		auto pattern_offset = NalUnitScanner::FindAnnexBStartCode(buffer, remained, pattern_size);
 
-					byte_stream.WriteBE32(nalu->GetLength());
-					byte_stream.Write(nalu);
-
-					last_offset = offset;
-				}
+		if (pattern_offset < 0)
+		{
+			offset += remained;
+			break;
+		}
 
-				buffer += pattern_size;
-				offset += pattern_size;
-				last_offset += pattern_size;
-				remained -= pattern_size;
+		offset += pattern_offset;
 
-				continue;
-			}
+		if (last_offset < offset)
+		{
+			auto nalu = data->Subdata(last_offset, offset - last_offset);
+			byte_stream.WriteBE32(nalu->GetLength());
+			byte_stream.Write(nalu);
 		}
 
-		buffer++;
-		offset++;
-		remained--;
+		buffer += pattern_offset + pattern_size;
+		remained -= pattern_offset + pattern_size;
+		offset += pattern_size;
+		last_offset = offset;
 	}
 
 	if (last_offset < offset)
@@ -19,4 +19,9 @@ public:
 
 	static std::shared_ptr<const ov::Data> ConvertAvccToAnnexb(const std::shared_ptr<const ov::Data> &data);
 	static std::shared_ptr<const ov::Data> ConvertAnnexbToAvcc(const std::shared_ptr<const ov::Data> &data);
+
+	// Returns the NAL unit with emulation_prevention_three_byte inserted if the encoder didn't escape it
+	// (A start code must not be found in the NAL unit after it is framed with the start codes),
+	// otherwise returns nal_unit as it is
+	static std::shared_ptr<const ov::Data> EscapeNalUnitIfNeeded(const std::shared_ptr<const ov::Data> &nal_unit);
 };
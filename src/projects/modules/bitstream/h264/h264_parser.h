@@ -1,6 +1,7 @@
 #pragma once
 
 #include <modules/bitstream/nalu/nal_unit_bitstream_parser.h>
+#include <modules/bitstream/nalu/nal_unit_scanner.h>
 #include <base/ovlibrary/ovlibrary.h>
 #include <cstdint>
 
@@ -6,6 +6,7 @@
 
 #include <base/ovlibrary/ovlibrary.h>
 #include <modules/bitstream/nalu/nal_unit_bitstream_parser.h>
+#include <modules/bitstream/nalu/nal_unit_scanner.h>
 #include <cstdint>
 
 #include "h265_types.h"
@@ -1,4 +1,5 @@
 #include "nal_unit_bitstream_parser.h"
+#include "nal_unit_scanner.h"
 
 NalUnitBitstreamParser::NalUnitBitstreamParser(const uint8_t *bitstream, size_t length)
 	: BitReader(nullptr, 0)
@@ -18,18 +19,10 @@ NalUnitBitstreamParser::NalUnitBitstreamParser(const uint8_t *bitstream, size_t
                 rbsp_byte[ NumBytesInRBSP++ ] All b(8)
         }
     */
-    for (size_t original_bitstream_offset = 0; original_bitstream_offset < length;)
+    _bitstream.resize(length);
+    if (length > 0)
     {
-        if (original_bitstream_offset < length + 2 && bitstream[original_bitstream_offset] == 0x00 && bitstream[original_bitstream_offset + 1] == 0x00 && bitstream[original_bitstream_offset + 2] == 0x03)
-        {
-            _bitstream.emplace_back(bitstream[original_bitstream_offset++]);
-            _bitstream.emplace_back(bitstream[original_bitstream_offset++]);
-            original_bitstream_offset++;
-        }
-        else
-        {
-            _bitstream.emplace_back(bitstream[original_bitstream_offset++]);
-        }
+        _bitstream.resize(NalUnitScanner::RemoveEmulationPrevention(bitstream, length, _bitstream.data()));
     }
     
 	_buffer = _bitstream.data();
@@ -0,0 +1,265 @@
+#include "nal_unit_scanner.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#	include <immintrin.h>
+#	define NAL_UNIT_SCANNER_X86
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#	include <arm_neon.h>
+#	define NAL_UNIT_SCANNER_NEON
+#endif
+
+// All the patterns are [00 00 xx] (min_xx <= xx <= max_xx)
+// - start code: 00 00 01
+// - emulation prevention: 00 00 03
+// - RBSP which needs emulation prevention: 00 00 00 ~ 00 00 03
+//
+// Returns the offset of the first pattern, length if there is no pattern
+using FindPatternFunction = size_t (*)(const uint8_t *data, size_t length, uint8_t min_xx, uint8_t max_xx);
+
+static inline bool IsInRange(uint8_t value, uint8_t min_xx, uint8_t max_xx)
+{
+	return static_cast<uint8_t>(value - min_xx) <= static_cast<uint8_t>(max_xx - min_xx);
+}
+
+static size_t FindPatternScalar(const uint8_t *data, size_t length, uint8_t min_xx, uint8_t max_xx, size_t offset)
+{
+	size_t i = offset;
+
+	while(i + 2 < length)
+	{
+		if((data[i + 2] != 0x00) && (IsInRange(data[i + 2], min_xx, max_xx) == false))
+		{
+			// No pattern can start at i, i + 1 and i + 2
+			i += 3;
+		}
+		else if(data[i + 1] != 0x00)
+		{
+			i += 2;
+		}
+		else if(data[i] != 0x00)
+		{
+			i += 1;
+		}
+		else if(IsInRange(data[i + 2], min_xx, max_xx))
+		{
+			return i;
+		}
+		else
+		{
+			i += 1;
+		}
+	}
+
+	return length;
+}
+
+static size_t FindPatternScalar(const uint8_t *data, size_t length, uint8_t min_xx, uint8_t max_xx)
+{
+	return FindPatternScalar(data, length, min_xx, max_xx, 0);
+}
+
+#if defined(NAL_UNIT_SCANNER_X86)
+__attribute__((target("sse2")))
+static size_t FindPatternSse2(const uint8_t *data, size_t length, uint8_t min_xx, uint8_t max_xx)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i min = _mm_set1_epi8(static_cast<char>(min_xx));
+	const __m128i range = _mm_set1_epi8(static_cast<char>(max_xx - min_xx));
+
+	size_t i = 0;
+
+	// Compares 16 positions at once: data[i] == 0 && data[i + 1] == 0 && (data[i + 2] - min) <= range
+	for(; i + 2 + 16 <= length; i += 16)
+	{
+		__m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+		__m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 1));
+		__m128i third = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 2)), min);
+
+		__m128i match = _mm_and_si128(_mm_cmpeq_epi8(first, zero), _mm_cmpeq_epi8(second, zero));
+		match = _mm_and_si128(match, _mm_cmpeq_epi8(_mm_min_epu8(third, range), third));
+
+		int mask = _mm_movemask_epi8(match);
+		if(mask != 0)
+		{
+			return i + __builtin_ctz(mask);
+		}
+	}
+
+	return FindPatternScalar(data, length, min_xx, max_xx, i);
+}
+
+__attribute__((target("avx2")))
+static size_t FindPatternAvx2(const uint8_t *data, size_t length, uint8_t min_xx, uint8_t max_xx)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i min = _mm256_set1_epi8(static_cast<char>(min_xx));
+	const __m256i range = _mm256_set1_epi8(static_cast<char>(max_xx - min_xx));
+
+	size_t i = 0;
+
+	for(; i + 2 + 32 <= length; i += 32)
+	{
+		__m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+		__m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 1));
+		__m256i third = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 2)), min);
+
+		__m256i match = _mm256_and_si256(_mm256_cmpeq_epi8(first, zero), _mm256_cmpeq_epi8(second, zero));
+		match = _mm256_and_si256(match, _mm256_cmpeq_epi8(_mm256_min_epu8(third, range), third));
+
+		uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(match));
+		if(mask != 0)
+		{
+			return i + __builtin_ctz(mask);
+		}
+	}
+
+	// The rest is less than 34 bytes
+	return FindPatternSse2(data + i, length - i, min_xx, max_xx) + i;
+}
+#endif	// NAL_UNIT_SCANNER_X86
+
+#if defined(NAL_UNIT_SCANNER_NEON)
+static size_t FindPatternNeon(const uint8_t *data, size_t length, uint8_t min_xx, uint8_t max_xx)
+{
+	const uint8x16_t zero = vdupq_n_u8(0);
+	const uint8x16_t min = vdupq_n_u8(min_xx);
+	const uint8x16_t range = vdupq_n_u8(static_cast<uint8_t>(max_xx - min_xx));
+
+	size_t i = 0;
+
+	for(; i + 2 + 16 <= length; i += 16)
+	{
+		uint8x16_t first = vld1q_u8(data + i);
+		uint8x16_t second = vld1q_u8(data + i + 1);
+		uint8x16_t third = vsubq_u8(vld1q_u8(data + i + 2), min);
+
+		uint8x16_t match = vandq_u8(vandq_u8(vceqq_u8(first, zero), vceqq_u8(second, zero)), vcleq_u8(third, range));
+
+		// NEON has no movemask: narrows each byte to 4 bits
+		uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+		if(mask != 0)
+		{
+			return i + (__builtin_ctzll(mask) >> 2);
+		}
+	}
+
+	return FindPatternScalar(data, length, min_xx, max_xx, i);
+}
+#endif	// NAL_UNIT_SCANNER_NEON
+
+struct NalUnitScannerKernel
+{
+	const char *name;
+	FindPatternFunction find_pattern;
+};
+
+static NalUnitScannerKernel SelectKernel()
+{
+#if defined(NAL_UNIT_SCANNER_X86)
+	__builtin_cpu_init();
+
+	if(__builtin_cpu_supports("avx2"))
+	{
+		return {"avx2", FindPatternAvx2};
+	}
+
+	if(__builtin_cpu_supports("sse2"))
+	{
+		return {"sse2", FindPatternSse2};
+	}
+#elif defined(NAL_UNIT_SCANNER_NEON)
+	return {"neon", FindPatternNeon};
+#endif
+
+	return {"scalar", FindPatternScalar};
+}
+
+static const NalUnitScannerKernel &GetKernel()
+{
+	static const NalUnitScannerKernel kernel = SelectKernel();
+	return kernel;
+}
+
+int NalUnitScanner::FindAnnexBStartCode(const uint8_t *bitstream, size_t length, size_t &start_code_size)
+{
+	start_code_size = 0;
+
+	auto offset = GetKernel().find_pattern(bitstream, length, 0x01, 0x01);
+	if(offset >= length)
+	{
+		return -1;
+	}
+
+	// 00 00 00 01
+	if((offset > 0) && (bitstream[offset - 1] == 0x00))
+	{
+		start_code_size = 4;
+		return static_cast<int>(offset - 1);
+	}
+
+	start_code_size = 3;
+	return static_cast<int>(offset);
+}
+
+size_t NalUnitScanner::RemoveEmulationPrevention(const uint8_t *nal_unit, size_t length, uint8_t *rbsp)
+{
+	auto find_pattern = GetKernel().find_pattern;
+	size_t read_offset = 0;
+	size_t write_offset = 0;
+
+	while(read_offset < length)
+	{
+		auto offset = read_offset + find_pattern(nal_unit + read_offset, length - read_offset, 0x03, 0x03);
+		if(offset >= length)
+		{
+			::memcpy(rbsp + write_offset, nal_unit + read_offset, length - read_offset);
+			write_offset += length - read_offset;
+			break;
+		}
+
+		// Copy up to 00 00 and skip 03
+		::memcpy(rbsp + write_offset, nal_unit + read_offset, offset + 2 - read_offset);
+		write_offset += offset + 2 - read_offset;
+		read_offset = offset + 3;
+	}
+
+	return write_offset;
+}
+
+size_t NalUnitScanner::InsertEmulationPrevention(const uint8_t *rbsp, size_t length, uint8_t *nal_unit)
+{
+	auto find_pattern = GetKernel().find_pattern;
+	size_t read_offset = 0;
+	size_t write_offset = 0;
+
+	while(read_offset < length)
+	{
+		auto offset = read_offset + find_pattern(rbsp + read_offset, length - read_offset, 0x00, 0x03);
+		if(offset >= length)
+		{
+			::memcpy(nal_unit + write_offset, rbsp + read_offset, length - read_offset);
+			write_offset += length - read_offset;
+			break;
+		}
+
+		// Copy up to 00 00, insert 03, and continue from xx (zero bytes are counted again from it)
+		::memcpy(nal_unit + write_offset, rbsp + read_offset, offset + 2 - read_offset);
+		write_offset += offset + 2 - read_offset;
+		nal_unit[write_offset++] = 0x03;
+		read_offset = offset + 2;
+	}
+
+	return write_offset;
+}
+
+bool NalUnitScanner::HasStartCodeEmulation(const uint8_t *nal_unit, size_t length)
+{
+	return GetKernel().find_pattern(nal_unit, length, 0x00, 0x02) < length;
+}
+
+const char *NalUnitScanner::GetKernelName()
+{
+	return GetKernel().name;
+}
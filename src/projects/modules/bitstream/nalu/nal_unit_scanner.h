@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Scans the H.264/H.265 bitstream for the byte patterns of Annex-B (start code, emulation prevention)
+// with SIMD (SSE2/AVX2 on x86, NEON on ARM). The kernel is selected by the features of the CPU at runtime.
+class NalUnitScanner
+{
+public:
+	// Returns the offset of the first start code (00 00 01 or 00 00 00 01), -1 if there is no start code
+	// start_code_size : 3 or 4
+	static int FindAnnexBStartCode(const uint8_t *bitstream, size_t length, size_t &start_code_size);
+
+	// Removes emulation_prevention_three_byte (00 00 03 xx -> 00 00 xx) to get RBSP from the payload of the NAL unit
+	// rbsp must be at least length bytes, returns the length of RBSP
+	static size_t RemoveEmulationPrevention(const uint8_t *nal_unit, size_t length, uint8_t *rbsp);
+
+	// Inserts emulation_prevention_three_byte (00 00 xx -> 00 00 03 xx if xx <= 03) to make the payload of the NAL unit from RBSP
+	// nal_unit must be at least GetMaxEscapedLength(length) bytes, returns the length of the payload
+	static size_t InsertEmulationPrevention(const uint8_t *rbsp, size_t length, uint8_t *nal_unit);
+	static size_t GetMaxEscapedLength(size_t length)
+	{
+		// An emulation_prevention_three_byte follows two zero bytes at most
+		return length + (length / 2) + 1;
+	}
+
+	// Returns true if the NAL unit contains 00 00 00 ~ 00 00 02, which cannot appear in an escaped NAL unit
+	// (The encoder didn't insert emulation_prevention_three_byte, so a start code would be found in it in Annex-B)
+	static bool HasStartCodeEmulation(const uint8_t *nal_unit, size_t length);
+
+	// Name of the kernel which is selected (ex: "avx2")
+	static const char *GetKernelName();
+};
@@ -1,51 +1,32 @@
 #include "nal_unit_splitter.h"
+#include "nal_unit_scanner.h"
 
 std::shared_ptr<NalUnitList> NalUnitSplitter::Parse(const uint8_t* bitstream, size_t bitstream_length)
 {
     auto nal_unit_list = std::make_shared<NalUnitList>();
 
-    size_t offset = 0;
-    size_t start_pos = 0, end_pos = 0;
-    while(offset < bitstream_length)
+    size_t start_code_size = 0;
+    auto pos = NalUnitScanner::FindAnnexBStartCode(bitstream, bitstream_length, start_code_size);
+    if(pos == -1)
     {
-        size_t remaining = bitstream_length - offset;
-        const uint8_t* data = bitstream + offset;
+        return nal_unit_list;
+    }
 
-        if((remaining >= 3 && data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x01) || 
-            (remaining >= 4 && data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x00 && data[3] == 0x01))
-        {
-            end_pos = offset;
+    size_t offset = pos + start_code_size;
+    while(offset < bitstream_length)
+    {
+        // The nal unit ends at the next start code or the end of the bitstream
+        pos = NalUnitScanner::FindAnnexBStartCode(bitstream + offset, bitstream_length - offset, start_code_size);
+        size_t nal_unit_length = (pos == -1) ? (bitstream_length - offset) : pos;
 
-            if(data[2] == 0x01)
-            {
-                offset += 3;
-            }
-            else
-            {
-                offset += 4;
-            }
+        nal_unit_list->_nal_list.emplace_back(std::make_shared<ov::Data>(bitstream + offset, nal_unit_length));
 
-            if(start_pos == 0)
-            {
-                start_pos = offset;
-            }
-            else
-            {
-                nal_unit_list->_nal_list.emplace_back(std::make_shared<ov::Data>(bitstream + start_pos, end_pos - start_pos));
-                start_pos = offset;
-            }
-        }
-        else
-        {
-            offset ++;
-        }
-        
-        // last nal unit
-        if(offset == bitstream_length && start_pos != 0)
+        if(pos == -1)
         {
-            end_pos = offset;
-            nal_unit_list->_nal_list.emplace_back(std::make_shared<ov::Data>(bitstream + start_pos, end_pos - start_pos));
+            break;
         }
+
+        offset += pos + start_code_size;
     }
     
     return nal_unit_list;
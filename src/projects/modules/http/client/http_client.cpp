@@ -14,11 +14,18 @@
 #define HTTP_CLIENT_MAX_CHUNK_HEADER_LENGTH (32)
 #define HTTP_CLIENT_NEW_LINE "\r\n"
 #define HTTP_CLIENT_NEW_LINE_LENGTH (OV_COUNTOF(HTTP_CLIENT_NEW_LINE) - 1)
+// Maximum number of idle connections per server
+#define HTTP_CLIENT_MAX_IDLE_CONNECTIONS (32)
+// Idle connections older than this are closed (most servers close the idle connection after 5~60 seconds)
+#define HTTP_CLIENT_IDLE_CONNECTION_TIMEOUT (4 * 1000)
 
 namespace http
 {
 	namespace clnt
 	{
+		std::mutex HttpClient::_idle_connection_mutex;
+		std::unordered_map<ov::String, std::deque<HttpClient::IdleConnection>> HttpClient::_idle_connection_map;
+
 		HttpClient::HttpClient()
 			: _socket_pool(ov::SocketPool::GetTcpPool())
 		{
@@ -67,6 +74,16 @@ namespace http
 			return _recv_timeout_msec;
 		}
 
+		void HttpClient::SetKeepAlive(bool keep_alive)
+		{
+			_keep_alive = keep_alive;
+		}
+
+		bool HttpClient::IsKeepAlive() const
+		{
+			return _keep_alive;
+		}
+
 		void HttpClient::SetMethod(http::Method method)
 		{
 			_method = method;
@@ -200,7 +217,133 @@ namespace http
 			return -1;
 		}
 
-		std::shared_ptr<const ov::Error> HttpClient::PrepareForRequest(const ov::String &url, ov::SocketAddress *address)
+		ov::String HttpClient::GetConnectionKey(const std::shared_ptr<ov::SocketPool> &socket_pool, const std::shared_ptr<const ov::Url> &parsed_url)
+		{
+			return ov::String::FormatString("%p/%s://%s:%d", socket_pool.get(), parsed_url->Scheme().LowerCaseString().CStr(), parsed_url->Host().CStr(), parsed_url->Port());
+		}
+
+		bool HttpClient::AcquireIdleConnection()
+		{
+			auto key = GetConnectionKey(_socket_pool, _parsed_url);
+			auto now = ov::Clock::NowMSec();
+
+			while (true)
+			{
+				IdleConnection connection;
+
+				{
+					std::lock_guard lock_guard(_idle_connection_mutex);
+
+					auto item = _idle_connection_map.find(key);
+
+					if (item == _idle_connection_map.end())
+					{
+						return false;
+					}
+
+					auto &connection_list = item->second;
+
+					// The most recently used connection is the most likely to be alive
+					connection = std::move(connection_list.back());
+					connection_list.pop_back();
+
+					if (connection_list.empty())
+					{
+						_idle_connection_map.erase(item);
+					}
+				}
+
+				bool is_alive = (static_cast<int64_t>(now) - connection.idle_since_msec) < HTTP_CLIENT_IDLE_CONNECTION_TIMEOUT;
+
+				if (is_alive)
+				{
+					// If the server has closed the connection, recv() returns 0 (or some unexpected data is received)
+					char buffer;
+					auto result = ::recv(connection.socket->GetNativeHandle(), &buffer, 1, MSG_PEEK | MSG_DONTWAIT);
+
+					is_alive = (result < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK));
+				}
+
+				if (is_alive == false)
+				{
+					logtd("Idle connection is closed: %s", key.CStr());
+					connection.socket->Close();
+					continue;
+				}
+
+				logtd("Reuse the idle connection: %s", key.CStr());
+
+				_socket = connection.socket;
+				_tls_data = connection.tls_data;
+
+				if (_tls_data != nullptr)
+				{
+					_tls_data->SetIoCallback(GetSharedPtrAs<ov::TlsClientDataIoCallback>());
+				}
+
+				return true;
+			}
+		}
+
+		void HttpClient::ReleaseConnection()
+		{
+			if (_socket == nullptr)
+			{
+				return;
+			}
+
+			auto key = GetConnectionKey(_socket_pool, _parsed_url);
+
+			IdleConnection connection;
+			connection.socket = std::move(_socket);
+			connection.tls_data = std::move(_tls_data);
+			connection.idle_since_msec = ov::Clock::NowMSec();
+
+			if (connection.tls_data != nullptr)
+			{
+				// Prevent circular reference between HttpClient and TlsClientData
+				connection.tls_data->SetIoCallback(nullptr);
+			}
+
+			std::shared_ptr<ov::Socket> socket_to_close;
+
+			{
+				std::lock_guard lock_guard(_idle_connection_mutex);
+
+				auto &connection_list = _idle_connection_map[key];
+
+				if (connection_list.size() >= HTTP_CLIENT_MAX_IDLE_CONNECTIONS)
+				{
+					// Close the oldest connection
+					socket_to_close = connection_list.front().socket;
+					connection_list.pop_front();
+				}
+
+				connection_list.push_back(std::move(connection));
+			}
+
+			if (socket_to_close != nullptr)
+			{
+				socket_to_close->Close();
+			}
+		}
+
+		bool HttpClient::IsResponseReusable() const
+		{
+			if ((_keep_alive == false) || (_blocking_mode != ov::BlockingMode::Blocking))
+			{
+				return false;
+			}
+
+			if (_parser.GetHttpVersionAsNumber() < 1.1)
+			{
+				return false;
+			}
+
+			return (_parser.GetHeader("Connection").LowerCaseString() != "close");
+		}
+
+		std::shared_ptr<const ov::Error> HttpClient::PrepareForRequest(const ov::String &url, ov::SocketAddress *address, bool use_idle_connection)
 		{
 			if (_requested)
 			{
@@ -254,6 +397,24 @@ namespace http
 				return ov::Error::CreateError("HTTP", "Invalid address: %s:%d, URL: %s", parsed_url->Host().CStr(), port, url.CStr());
 			}
 
+			_url = url;
+			_parsed_url = parsed_url;
+
+			_request_header["Host"] = ov::String::FormatString(
+				"%s:%d", _parsed_url->Host().CStr(), _parsed_url->Port());
+
+			if (address != nullptr)
+			{
+				*address = socket_address;
+			}
+
+			_is_reused_connection = (use_idle_connection && _keep_alive && (_blocking_mode == ov::BlockingMode::Blocking)) ? AcquireIdleConnection() : false;
+
+			if (_is_reused_connection)
+			{
+				return nullptr;
+			}
+
 			_socket = _socket_pool->AllocSocket();
 
 			if (_socket == nullptr)
@@ -278,17 +439,6 @@ namespace http
 				_tls_data->SetIoCallback(GetSharedPtrAs<ov::TlsClientDataIoCallback>());
 			}
 
-			if (address != nullptr)
-			{
-				*address = socket_address;
-			}
-
-			_url = url;
-			_parsed_url = parsed_url;
-
-			_request_header["Host"] = ov::String::FormatString(
-				"%s:%d", _parsed_url->Host().CStr(), _parsed_url->Port());
-
 			return nullptr;
 		}
 
@@ -327,6 +477,11 @@ namespace http
 				_request_header["Content-Length"] = ov::Converter::ToString(_request_body->GetLength());
 			}
 
+			if (_keep_alive)
+			{
+				_request_header["Connection"] = "keep-alive";
+			}
+
 			logtd("Request headers: %zu:", _request_header.size());
 
 			for (auto header : _request_header)
@@ -337,8 +492,15 @@ namespace http
 
 			request_header.Append(HTTP_CLIENT_NEW_LINE);
 
-			SendData(request_header.ToData(false));
-			SendData(_request_body);
+			// Send the header and body at once, otherwise the body may be delayed by Nagle's algorithm
+			auto request_data = request_header.ToData(false);
+
+			if (_request_body != nullptr)
+			{
+				request_data->Append(_request_body);
+			}
+
+			SendData(request_data);
 		}
 
 		std::shared_ptr<const ov::OpensslError> HttpClient::TryTlsConnect()
@@ -362,7 +524,29 @@ namespace http
 
 			_response_handler = response_handler;
 
-			auto error = PrepareForRequest(url, &address);
+			auto error = PrepareForRequest(url, &address, true);
+
+			if ((error == nullptr) && _is_reused_connection)
+			{
+				logtd("Request an URL: %s (address: %s, reused connection)...", url.CStr(), address.ToString().CStr());
+
+				OnConnected(nullptr);
+
+				if (_need_to_retry == false)
+				{
+					return;
+				}
+
+				// The server closed the idle connection before receiving the request - try again with a new connection
+				logtd("Idle connection was closed by the server, retrying with a new connection: %s", url.CStr());
+
+				_need_to_retry = false;
+				_requested = false;
+				_received_bytes = 0;
+				_response_handler = response_handler;
+
+				error = PrepareForRequest(url, &address, false);
+			}
 
 			if (error == nullptr)
 			{
@@ -458,6 +642,7 @@ namespace http
 
 				if (error == nullptr)
 				{
+					_received_bytes += process_data->GetLength();
 					error = ProcessData(process_data);
 				}
 
@@ -493,13 +678,30 @@ namespace http
 				}
 			}
 
+			// Do not retry when timed out, since the server may have processed the request
+			if (_is_reused_connection && (_received_bytes == 0) && (need_to_callback || ((error != nullptr) && (error->GetCode() != EAGAIN))))
+			{
+				// The idle connection was closed by the server - Request() will try again with a new connection
+				_need_to_retry = true;
+				_response_body = nullptr;
+
+				CleanupVariables();
+				return;
+			}
+
 			auto response_handler = _response_handler;
+			bool is_reusable = (error == nullptr) && (need_to_callback == false) && IsResponseReusable();
 
 			if (response_handler != nullptr)
 			{
 				response_handler(_parser.GetStatusCode(), _response_body, error);
 			}
 
+			if (is_reusable)
+			{
+				ReleaseConnection();
+			}
+
 			CleanupVariables();
 		}
 
@@ -751,6 +953,7 @@ namespace http
 			_url.Clear();
 			_parsed_url = nullptr;
 			_response_handler = nullptr;
+			_is_reused_connection = false;
 
 			OV_SAFE_RESET(
 				_tls_data, nullptr, {
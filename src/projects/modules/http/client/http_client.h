@@ -11,6 +11,7 @@
 #include <base/ovlibrary/ovlibrary.h>
 #include <base/ovsocket/ovsocket.h>
 
+#include <deque>
 #include <unordered_map>
 
 #include "../http_datastructure.h"
@@ -46,6 +47,13 @@ namespace http
 
 			void SetTimeout(int timeout_msec);
 
+			// Reuses the connection for the subsequent requests to the same server (Blocking mode only)
+			//
+			// When the response is completed, the connection is returned to the idle connection pool
+			// instead of closing, and the next HttpClient which requests to the same scheme/host/port takes it.
+			void SetKeepAlive(bool keep_alive);
+			bool IsKeepAlive() const;
+
 			void SetMethod(http::Method method);
 			http::Method GetMethod() const;
 
@@ -105,7 +113,23 @@ namespace http
 			ssize_t OnTlsWriteData(const void *data, int64_t length) override;
 
 		protected:
-			std::shared_ptr<const ov::Error> PrepareForRequest(const ov::String &url, ov::SocketAddress *address);
+			struct IdleConnection
+			{
+				std::shared_ptr<ov::Socket> socket;
+				std::shared_ptr<ov::TlsClientData> tls_data;
+				int64_t idle_since_msec;
+			};
+
+			static ov::String GetConnectionKey(const std::shared_ptr<ov::SocketPool> &socket_pool, const std::shared_ptr<const ov::Url> &parsed_url);
+			// Takes an idle connection which is still alive from the pool
+			bool AcquireIdleConnection();
+			// Returns the connection to the pool (The response must be completed)
+			void ReleaseConnection();
+
+			bool IsResponseReusable() const;
+
+		protected:
+			std::shared_ptr<const ov::Error> PrepareForRequest(const ov::String &url, ov::SocketAddress *address, bool use_idle_connection);
 			std::shared_ptr<const ov::OpensslError> TryTlsConnect();
 			void SendRequestIfNeeded();
 			// Use this API when blocking mode
@@ -130,6 +154,13 @@ namespace http
 			int _recv_timeout_msec = 60 * 1000;
 			http::Method _method = http::Method::Get;
 
+			bool _keep_alive = false;
+			// Whether the connection is taken from the idle connection pool
+			bool _is_reused_connection = false;
+			// Set when the reused connection is closed by the server before receiving any response
+			bool _need_to_retry = false;
+			size_t _received_bytes = 0;
+
 			// Related to chunked transfer
 			bool _is_chunked_transfer = false;
 			ChunkParseStatus _chunk_parse_status = ChunkParseStatus::None;
@@ -160,6 +191,10 @@ namespace http
 			std::map<ov::String, ov::String, ov::CaseInsensitiveComparator> _response_header;
 
 			std::shared_ptr<ov::Data> _response_body;
+
+			// Idle connections (key: GetConnectionKey())
+			static std::mutex _idle_connection_mutex;
+			static std::unordered_map<ov::String, std::deque<IdleConnection>> _idle_connection_map;
 		};
 	}  // namespace clnt
 }  // namespace http
@@ -374,7 +374,9 @@ namespace http
 			// Send "Connection: Closed" header
 			Closed,
 			// Send "Connection: Keep-Alive" header
-			KeepAlive
+			KeepAlive,
+			// The response will be sent later by another thread (ex: Blocking playlist reload of LL-HLS)
+			Deferred
 		};
 
 		enum class InterceptorResult : char
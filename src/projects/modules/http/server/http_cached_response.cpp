@@ -0,0 +1,70 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "http_cached_response.h"
+
+#include <base/ovcrypto/crc_32.h>
+
+#include "../http_private.h"
+
+namespace http
+{
+	namespace svr
+	{
+		CachedResponse::CachedResponse(const ov::String &content_type, const ov::String &cache_control, const std::shared_ptr<const ov::Data> &body)
+			: _cache_control(cache_control),
+			  _body((body != nullptr) ? body : std::make_shared<const ov::Data>())
+		{
+			// The resource is immutable, so the checksum of the body identifies the representation
+			_etag.Format("\"%08x-%zx\"", ov::Crc32::Calculate(_body.get()), _body->GetLength());
+
+			_header_string.Format(
+				"Content-Type: %s\r\n"
+				"Cache-Control: %s\r\n"
+				"ETag: %s\r\n"
+				"Content-Length: %zu\r\n"
+				"\r\n",
+				content_type.CStr(), cache_control.CStr(), _etag.CStr(), _body->GetLength());
+		}
+
+		bool CachedResponse::IsMatch(const ov::String &if_none_match) const
+		{
+			// RFC7232 - 3.2.  If-None-Match
+			//
+			// If-None-Match = "*" / 1#entity-tag
+			//
+			// A recipient MUST use the weak comparison function when comparing
+			// entity-tags for If-None-Match (Section 2.3.2), since weak entity-tags
+			// can be used for cache validation even if there have been changes to
+			// the representation data.
+			auto tokens = if_none_match.Split(",");
+
+			for (auto &token : tokens)
+			{
+				auto etag = token.Trim();
+
+				if (etag == "*")
+				{
+					return true;
+				}
+
+				if (etag.HasPrefix("W/"))
+				{
+					etag = etag.Substring(2);
+				}
+
+				if (etag == _etag)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+	}  // namespace svr
+}  // namespace http
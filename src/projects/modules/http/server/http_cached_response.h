@@ -0,0 +1,68 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+namespace http
+{
+	namespace svr
+	{
+		// An immutable response entity (entity headers + body) which is shared by all requests for the same resource.
+		//
+		// The entity headers (Content-Type, Cache-Control, ETag, Content-Length) are serialized once when the resource is created,
+		// so HttpResponse only formats the status line and the per-request headers (Server, Connection, CORS, ...) when sending it.
+		class CachedResponse
+		{
+		public:
+			CachedResponse(const ov::String &content_type, const ov::String &cache_control, const std::shared_ptr<const ov::Data> &body);
+
+			static std::shared_ptr<const CachedResponse> Create(const ov::String &content_type, const ov::String &cache_control, const std::shared_ptr<const ov::Data> &body)
+			{
+				return std::make_shared<const CachedResponse>(content_type, cache_control, body);
+			}
+
+			// Quoted entity-tag (ex: "1a2b3c4d-5e6f")
+			const ov::String &GetETag() const
+			{
+				return _etag;
+			}
+
+			const ov::String &GetCacheControl() const
+			{
+				return _cache_control;
+			}
+
+			// Serialized entity headers, including the empty line at the end of the header section
+			const ov::String &GetHeaderString() const
+			{
+				return _header_string;
+			}
+
+			const std::shared_ptr<const ov::Data> &GetBody() const
+			{
+				return _body;
+			}
+
+			size_t GetContentLength() const
+			{
+				return _body->GetLength();
+			}
+
+			// Returns true if the value of If-None-Match header matches the ETag of this entity
+			bool IsMatch(const ov::String &if_none_match) const;
+
+		protected:
+			ov::String _etag;
+			ov::String _cache_control;
+			ov::String _header_string;
+			std::shared_ptr<const ov::Data> _body;
+		};
+	}  // namespace svr
+}  // namespace http
@@ -11,6 +11,9 @@
 #include "../http_private.h"
 #include "http_server.h"
 
+// Maximum size of the pipelined requests that can be kept while the current request is being processed
+#define HTTP_MAX_PIPELINED_DATA_SIZE (64 * 1024)
+
 namespace http
 {
 	namespace svr
@@ -24,22 +27,168 @@ namespace http
 
 		std::shared_ptr<HttpRequest> HttpConnection::GetRequest()
 		{
+			std::lock_guard<std::mutex> lock_guard(_request_mutex);
 			return _request;
 		}
 
 		std::shared_ptr<HttpResponse> HttpConnection::GetResponse()
 		{
+			std::lock_guard<std::mutex> lock_guard(_request_mutex);
 			return _response;
 		}
 
 		std::shared_ptr<const HttpRequest> HttpConnection::GetRequest() const
 		{
+			std::lock_guard<std::mutex> lock_guard(_request_mutex);
 			return _request;
 		}
 
 		std::shared_ptr<const HttpResponse> HttpConnection::GetResponse() const
 		{
+			std::lock_guard<std::mutex> lock_guard(_request_mutex);
 			return _response;
 		}
+
+		bool HttpConnection::IsKeepAliveAvailable() const
+		{
+			if ((_server == nullptr) || (_server->IsKeepAliveEnabled() == false))
+			{
+				return false;
+			}
+
+			auto request = GetRequest();
+
+			if ((request->GetConnectionType() != RequestConnectionType::HTTP) ||
+				// The boundary of the next request cannot be determined
+				request->IsHeaderExists("TRANSFER-ENCODING"))
+			{
+				return false;
+			}
+
+			auto connection = request->GetHeader("CONNECTION").UpperCaseString();
+
+			// RFC7230 - 6.3.  Persistence
+			//
+			// o  If the "close" connection option is present, the connection will
+			//    not persist after the current response; else,
+			if (connection.IndexOf("CLOSE") >= 0)
+			{
+				return false;
+			}
+
+			// o  If the received protocol is HTTP/1.1 (or later), the connection
+			//    will persist after the current response; else,
+			//
+			// o  If the received protocol is HTTP/1.0, the "keep-alive" connection
+			//    option is present, ...
+			return (request->GetHttpVersionAsNumber() > 1.0) || (connection.IndexOf("KEEP-ALIVE") >= 0);
+		}
+
+		bool HttpConnection::PrepareNextRequest()
+		{
+			std::shared_ptr<ov::Data> pipelined_data;
+
+			{
+				std::lock_guard<std::recursive_mutex> process_lock_guard(_process_mutex);
+
+				auto request = GetRequest();
+				auto response = GetResponse();
+				auto client_socket = request->GetRemote();
+
+				if ((client_socket == nullptr) || client_socket->IsClosing())
+				{
+					return false;
+				}
+
+				auto new_request = std::make_shared<HttpRequest>(client_socket, _server->_default_interceptor);
+				auto new_response = std::make_shared<HttpResponse>(client_socket);
+
+				new_request->SetTlsData(request->GetTlsData());
+				new_response->SetTlsData(response->GetTlsData());
+
+				// Set default headers
+				new_response->SetHeader("Server", "OvenMediaEngine");
+				new_response->SetHeader("Content-Type", "text/html");
+
+				{
+					std::lock_guard<std::mutex> lock_guard(_request_mutex);
+
+					_request = std::move(new_request);
+					_response = std::move(new_response);
+				}
+
+				_received_body_length = 0;
+				_is_request_received = false;
+
+				pipelined_data = std::move(_pipelined_data);
+				_pipelined_data = nullptr;
+
+				_idle_start_time = ov::Clock::NowMSec();
+			}
+
+			if ((pipelined_data != nullptr) && (pipelined_data->IsEmpty() == false))
+			{
+				logtd("Processing a pipelined request from %s (%zu bytes)", GetRequest()->GetRemote()->ToString().CStr(), pipelined_data->GetLength());
+				_server->ProcessData(GetSharedPtr(), pipelined_data);
+			}
+
+			return true;
+		}
+
+		std::shared_ptr<const ov::Data> HttpConnection::SplitRequestBody(const std::shared_ptr<const ov::Data> &data)
+		{
+			auto request = GetRequest();
+
+			if ((request->GetConnectionType() != RequestConnectionType::HTTP) || request->IsHeaderExists("TRANSFER-ENCODING"))
+			{
+				// Pass all data to the interceptor (WebSocket frames, chunked request body, ...)
+				return data;
+			}
+
+			size_t content_length = request->GetContentLength();
+			size_t remained_length = (content_length > _received_body_length) ? (content_length - _received_body_length) : 0;
+
+			if (data->GetLength() <= remained_length)
+			{
+				_received_body_length += data->GetLength();
+				_is_request_received = (_received_body_length == content_length);
+
+				return data;
+			}
+
+			// The data contains the next request
+			_received_body_length = content_length;
+			_is_request_received = true;
+
+			if (AppendPipelinedData(data->Subdata(remained_length)) == false)
+			{
+				return nullptr;
+			}
+
+			return data->Subdata(0, remained_length);
+		}
+
+		bool HttpConnection::AppendPipelinedData(const std::shared_ptr<const ov::Data> &data)
+		{
+			if (_pipelined_data == nullptr)
+			{
+				_pipelined_data = std::make_shared<ov::Data>();
+			}
+
+			if ((_pipelined_data->GetLength() + data->GetLength()) > HTTP_MAX_PIPELINED_DATA_SIZE)
+			{
+				logtw("Too many pipelined requests from %s (%zu bytes)", GetRequest()->GetRemote()->ToString().CStr(), _pipelined_data->GetLength() + data->GetLength());
+				return false;
+			}
+
+			return _pipelined_data->Append(data.get());
+		}
+
+		bool HttpConnection::IsIdle(uint64_t current_msec, uint64_t timeout_msec) const
+		{
+			uint64_t idle_start_time = _idle_start_time;
+
+			return (idle_start_time > 0) && ((current_msec - idle_start_time) >= timeout_msec);
+		}
 	}  // namespace svr
 }  // namespace http
@@ -8,6 +8,7 @@
 //==============================================================================
 #pragma once
 
+#include <atomic>
 #include <mutex>
 
 #include "http_request.h"
@@ -23,13 +24,16 @@ namespace http
 		// HttpRequest: Contains request informations (Request HTTP Header & Body)
 		// HttpResponse: Contains socket & response informations (Response HTTP Header & Body)
 
-		class HttpConnection
+		//
+		// An HTTP/1.1 persistent connection processes the requests one by one:
+		// the next request (including the pipelined one) is not processed until PrepareNextRequest() is called.
+		class HttpConnection : public ov::EnableSharedFromThis<HttpConnection>
 		{
 		public:
 			friend class HttpServer;
 
 			HttpConnection(const std::shared_ptr<HttpServer> &server, std::shared_ptr<HttpRequest> &http_request, std::shared_ptr<HttpResponse> &http_response);
-			virtual ~HttpConnection() = default;
+			~HttpConnection() override = default;
 
 			std::shared_ptr<HttpRequest> GetRequest();
 			std::shared_ptr<HttpResponse> GetResponse();
@@ -37,11 +41,53 @@ namespace http
 			std::shared_ptr<const HttpRequest> GetRequest() const;
 			std::shared_ptr<const HttpResponse> GetResponse() const;
 
+			// Whether the connection can be reused after the response of the current request is completed
+			// (The server allows keep-alive, and the client does not send "Connection: close")
+			bool IsKeepAliveAvailable() const;
+
+			// Called when the response of the current request is completed, instead of closing the connection.
+			// Replaces the request/response with new instances, and processes the pipelined request if any.
+			bool PrepareNextRequest();
+
+			// The number of requests received through this connection
+			uint32_t GetRequestCount() const
+			{
+				return _request_count;
+			}
+
 		protected:
+			// Splits the data into the body of the current request and the pipelined data of the next requests
+			//
+			// @return The body of the current request (Can be empty)
+			std::shared_ptr<const ov::Data> SplitRequestBody(const std::shared_ptr<const ov::Data> &data);
+			bool AppendPipelinedData(const std::shared_ptr<const ov::Data> &data);
+
+			bool IsRequestReceived() const
+			{
+				return _is_request_received;
+			}
+
+			bool IsIdle(uint64_t current_msec, uint64_t timeout_msec) const;
+
 			std::shared_ptr<HttpServer> _server = nullptr;
 
+			mutable std::mutex _request_mutex;
 			std::shared_ptr<HttpRequest> _request = nullptr;
 			std::shared_ptr<HttpResponse> _response = nullptr;
+
+			// Serializes ProcessData() and PrepareNextRequest()
+			std::recursive_mutex _process_mutex;
+
+			// Length of the request body received so far
+			size_t _received_body_length = 0;
+			// true if the header and the body of the current request are received
+			bool _is_request_received = false;
+			// The next requests received before the response of the current request is completed
+			std::shared_ptr<ov::Data> _pipelined_data;
+
+			std::atomic<uint32_t> _request_count{0};
+			// The time when the last response is completed (0 while a request is being processed)
+			std::atomic<uint64_t> _idle_start_time{0};
 		};
 	}  // namespace svr
 }  // namespace http
@@ -108,23 +108,80 @@ namespace http
 			return SendHeaderIfNeeded() + SendResponse();
 		}
 
-		uint32_t HttpResponse::SendHeaderIfNeeded()
+		uint32_t HttpResponse::Response(const std::shared_ptr<const CachedResponse> &cached_response, bool not_modified)
 		{
+			if (cached_response == nullptr)
+			{
+				OV_ASSERT2(cached_response != nullptr);
+				return 0;
+			}
+
+			std::lock_guard<decltype(_response_mutex)> lock(_response_mutex);
+
 			if (_is_header_sent)
 			{
-				// The headers are already sent
+				logtw("Cannot send the cached response: Header is sent: %s", _client_socket->ToString().CStr());
 				return 0;
 			}
 
-			std::shared_ptr<ov::Data> response = std::make_shared<ov::Data>();
-			ov::ByteStream stream(response.get());
+			// The entity headers are provided by the cached response
+			_response_header.erase("Content-Type");
+			_response_header.erase("Content-Length");
+			_response_data_list.clear();
+			_response_data_size = 0ULL;
 
-			if (_chunked_transfer == false)
+			auto header = std::make_shared<ov::Data>(256 + cached_response->GetHeaderString().GetLength());
+			ov::ByteStream stream(header.get());
+
+			if (not_modified)
 			{
-				// Calculate the content length
-				SetHeader("Content-Length", ov::Converter::ToString(_response_data_size));
+				// RFC7232 - 4.1.  304 Not Modified
+				//
+				// The server generating a 304 response MUST generate any of the
+				// following header fields that would have been sent in a 200 (OK)
+				// response to the same request: Cache-Control, Content-Location, Date,
+				// ETag, Expires, and Vary.
+				SetStatusCode(StatusCode::NotModified);
+				SerializeHeaders(stream);
+
+				stream.Append(ov::String::FormatString(
+								  "Cache-Control: %s\r\n"
+								  "ETag: %s\r\n"
+								  "\r\n",
+								  cached_response->GetCacheControl().CStr(), cached_response->GetETag().CStr())
+								  .ToData(false));
+			}
+			else
+			{
+				SerializeHeaders(stream);
+				stream.Append(cached_response->GetHeaderString().ToData(false));
+			}
+
+			if (Send(header) == false)
+			{
+				return 0;
 			}
 
+			_is_header_sent = true;
+
+			if (not_modified)
+			{
+				return header->GetLength();
+			}
+
+			// The body is shared with other requests, so it is sent without copying
+			auto &body = cached_response->GetBody();
+
+			if (body->IsEmpty() || Send(body))
+			{
+				return header->GetLength() + body->GetLength();
+			}
+
+			return header->GetLength();
+		}
+
+		void HttpResponse::SerializeHeaders(ov::ByteStream &stream)
+		{
 			// RFC7230 - 3.1.2.  Status Line
 			// status-line = HTTP-version SP status-code SP reason-phrase CRLF
 			// TODO(dimiden): Replace this HTTP version with the version that received from the request
@@ -137,7 +194,26 @@ namespace http
 				stream.Append(pair.second.ToData(false));
 				stream.Append("\r\n", 2);
 			});
+		}
+
+		uint32_t HttpResponse::SendHeaderIfNeeded()
+		{
+			if (_is_header_sent)
+			{
+				// The headers are already sent
+				return 0;
+			}
 
+			std::shared_ptr<ov::Data> response = std::make_shared<ov::Data>();
+			ov::ByteStream stream(response.get());
+
+			if (_chunked_transfer == false)
+			{
+				// Calculate the content length
+				SetHeader("Content-Length", ov::Converter::ToString(_response_data_size));
+			}
+
+			SerializeHeaders(stream);
 			stream.Append("\r\n", 2);
 
 			if (Send(response))
@@ -201,15 +277,21 @@ namespace http
 				return Send("0\r\n\r\n", 5);
 			}
 
-			bool result =
-				// Send the chunk header
-				Send(ov::String::FormatString("%x\r\n", data->GetLength()).ToData(false)) &&
-				// Send the chunk payload
-				Send(data) &&
-				// Send a last data of chunk
-				Send("\r\n", 2);
+			return Send(MakeChunkedData(data));
+		}
+
+		std::shared_ptr<ov::Data> HttpResponse::MakeChunkedData(const std::shared_ptr<const ov::Data> &data)
+		{
+			char header[sizeof(size_t) * 2 + 3];
+			auto header_length = ::snprintf(header, sizeof(header), "%zx\r\n", data->GetLength());
+
+			auto chunk = std::make_shared<ov::Data>(header_length + data->GetLength() + 2, true);
+
+			chunk->Append(header, header_length);
+			chunk->Append(data);
+			chunk->Append("\r\n", 2);
 
-			return result;
+			return chunk;
 		}
 
 		uint32_t HttpResponse::SendResponse()
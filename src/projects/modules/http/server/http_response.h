@@ -11,6 +11,7 @@
 #include <base/ovlibrary/converter.h>
 
 #include "../http_datastructure.h"
+#include "http_cached_response.h"
 
 namespace http
 {
@@ -81,8 +82,18 @@ namespace http
 			bool SendChunkedData(const void *data, size_t length);
 			bool SendChunkedData(const std::shared_ptr<const ov::Data> &data);
 
+			// Frames the data as a chunk of chunked transfer encoding ("%x\r\n" + data + "\r\n") in one buffer.
+			// The framed chunk can be sent to many responses using Send()
+			static std::shared_ptr<ov::Data> MakeChunkedData(const std::shared_ptr<const ov::Data> &data);
+
 			uint32_t Response();
 
+			// Sends the shared entity instead of the data appended by AppendData()/AppendString().
+			// If not_modified is true, sends "304 Not Modified" without the body (The client has the same entity)
+			//
+			// @return The number of bytes sent
+			uint32_t Response(const std::shared_ptr<const CachedResponse> &cached_response, bool not_modified = false);
+
 			bool Close();
 
 			void SetKeepAlive()
@@ -102,6 +113,8 @@ namespace http
 			}
 
 		protected:
+			// Status line + headers set by SetHeader() (without the empty line)
+			void SerializeHeaders(ov::ByteStream &stream);
 			uint32_t SendHeaderIfNeeded();
 			uint32_t SendResponse();
 
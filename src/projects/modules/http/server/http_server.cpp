@@ -28,7 +28,7 @@ namespace http
 			OV_ASSERT(_physical_port == nullptr, "%s: Physical port: %s", _server_name.CStr(), _physical_port->ToString().CStr());
 		}
 
-		bool HttpServer::Start(const ov::SocketAddress &address, int worker_count)
+		bool HttpServer::Start(const ov::SocketAddress &address, int worker_count, bool reuse_port)
 		{
 			auto lock_guard = std::lock_guard(_physical_port_mutex);
 
@@ -38,14 +38,22 @@ namespace http
 				return false;
 			}
 
-			_physical_port = PhysicalPortManager::GetInstance()->CreatePort(_server_name.CStr(), ov::SocketType::Tcp, address, worker_count);
+			_metrics = mon::Monitoring::GetInstance()->CreateHttpServerMetrics(_server_name, address.ToString(), IsTls());
+
+			auto shard_mode = reuse_port ? PhysicalPortShardMode::ReusePort : PhysicalPortShardMode::None;
+			_physical_port = PhysicalPortManager::GetInstance()->CreatePort(_server_name.CStr(), ov::SocketType::Tcp, address, worker_count, 0, 0, shard_mode);
 
 			if (_physical_port != nullptr)
 			{
+				_idle_timer.Push(std::bind(&HttpServer::CloseIdleConnections, this, std::placeholders::_1), 1000);
+				_idle_timer.Start();
+
 				return _physical_port->AddObserver(this);
 			}
 
-			return _physical_port != nullptr;
+			mon::Monitoring::GetInstance()->ReleaseHttpServerMetrics(_metrics);
+
+			return false;
 		}
 
 		bool HttpServer::Stop()
@@ -63,6 +71,14 @@ namespace http
 				return false;
 			}
 
+			_idle_timer.Stop();
+			_idle_timer.Clear();
+
+			logti("%s: %" PRIu64 " requests have been processed through %" PRIu64 " connections (%.2f requests per connection)",
+				  _server_name.CStr(), _metrics->GetRequestCount(), _metrics->GetConnectionCount(), _metrics->GetRequestsPerConnection());
+
+			mon::Monitoring::GetInstance()->ReleaseHttpServerMetrics(_metrics);
+
 			physical_port->RemoveObserver(this);
 			PhysicalPortManager::GetInstance()->DeletePort(physical_port);
 			physical_port = nullptr;
@@ -141,6 +157,9 @@ namespace http
 		{
 			if (client != nullptr)
 			{
+				// The next request must not be processed while PrepareNextRequest() is replacing the request/response
+				std::lock_guard<std::recursive_mutex> process_lock_guard(client->_process_mutex);
+
 				std::shared_ptr<HttpRequest> request = client->GetRequest();
 				std::shared_ptr<HttpResponse> response = client->GetResponse();
 
@@ -151,12 +170,24 @@ namespace http
 				switch (parser.GetParseStatus())
 				{
 					case StatusCode::OK: {
+						if (client->IsRequestReceived())
+						{
+							// The current request is being processed, so keep the next request (HTTP pipelining) until the response is completed
+							need_to_disconnect = (client->AppendPipelinedData(data) == false);
+							break;
+						}
+
 						auto interceptor = request->GetRequestInterceptor();
+						auto body = client->SplitRequestBody(data);
 
-						if (interceptor != nullptr)
+						if (body == nullptr)
+						{
+							need_to_disconnect = true;
+						}
+						else if (interceptor != nullptr)
 						{
 							// If the request is parsed, bypass to the interceptor
-							need_to_disconnect = (interceptor->OnHttpData(client, data) == InterceptorResult::Disconnect);
+							need_to_disconnect = (interceptor->OnHttpData(client, body) == InterceptorResult::Disconnect);
 						}
 						else
 						{
@@ -168,6 +199,9 @@ namespace http
 					}
 
 					case StatusCode::PartialContent: {
+						// The connection is no longer idle since the next request is being received
+						client->_idle_start_time = 0;
+
 						// Need to parse HTTP header
 						ssize_t processed_length = TryParseHeader(client, data);
 
@@ -175,6 +209,9 @@ namespace http
 						{
 							if (parser.GetParseStatus() == StatusCode::OK)
 							{
+								client->_request_count++;
+								_metrics->OnRequestReceived();
+
 								// Probe scheme
 								if (IsWebSocketRequest(request) == true)
 								{
@@ -215,7 +252,7 @@ namespace http
 
 								if (remote != nullptr)
 								{
-									logti("Client(%s) is requested uri: [%s]", remote->ToString().CStr(), request->GetUri().CStr());
+									logti("Client(%s) is requested uri: [%s] (request #%u)", remote->ToString().CStr(), request->GetUri().CStr(), client->GetRequestCount());
 								}
 
 								if (found_interceptor == false)
@@ -223,8 +260,12 @@ namespace http
 									logtw("No module could be found to handle this connection request : [%s]", request->GetUri().CStr());
 								}
 
+								// Data after the header may contain the body and the pipelined requests
+								auto body = client->SplitRequestBody(data->Subdata(processed_length));
+
+								need_to_disconnect = need_to_disconnect || (body == nullptr);
 								need_to_disconnect = need_to_disconnect || (interceptor->OnHttpPrepare(client) == InterceptorResult::Disconnect);
-								need_to_disconnect = need_to_disconnect || (interceptor->OnHttpData(client, data->Subdata(processed_length)) == InterceptorResult::Disconnect);
+								need_to_disconnect = need_to_disconnect || (interceptor->OnHttpData(client, body) == InterceptorResult::Disconnect);
 							}
 							else if (parser.GetParseStatus() == StatusCode::PartialContent)
 							{
@@ -270,6 +311,8 @@ namespace http
 				return nullptr;
 			}
 
+			_metrics->OnConnectionAccepted();
+
 			auto request = std::make_shared<HttpRequest>(client_socket, _default_interceptor);
 			auto response = std::make_shared<HttpResponse>(client_socket);
 
@@ -339,13 +382,13 @@ namespace http
 
 			if (reason == PhysicalPortDisconnectReason::Disconnect)
 			{
-				logti("The HTTP client(%s) has been disconnected from %s (%d)",
-					  remote->GetRemoteAddress()->ToString().CStr(), _physical_port->GetAddress().ToString().CStr(), response->GetStatusCode());
+				logti("The HTTP client(%s) has been disconnected from %s (%d, %u requests)",
+					  remote->GetRemoteAddress()->ToString().CStr(), _physical_port->GetAddress().ToString().CStr(), response->GetStatusCode(), client->GetRequestCount());
 			}
 			else
 			{
-				logti("The HTTP client(%s) is disconnected from %s (%d)",
-					  remote->GetRemoteAddress()->ToString().CStr(), _physical_port->GetAddress().ToString().CStr(), response->GetStatusCode());
+				logti("The HTTP client(%s) is disconnected from %s (%d, %u requests)",
+					  remote->GetRemoteAddress()->ToString().CStr(), _physical_port->GetAddress().ToString().CStr(), response->GetStatusCode(), client->GetRequestCount());
 			}
 
 			auto interceptor = request->GetRequestInterceptor();
@@ -441,6 +484,33 @@ namespace http
 			return true;
 		}
 
+		void HttpServer::SetKeepAliveTimeout(int timeout_in_msec)
+		{
+			_keep_alive_timeout = std::max(timeout_in_msec, 0);
+		}
+
+		ov::DelayQueueAction HttpServer::CloseIdleConnections(void *parameter)
+		{
+			int timeout = _keep_alive_timeout;
+
+			if (timeout > 0)
+			{
+				auto current_msec = ov::Clock::NowMSec();
+
+				DisconnectIf([current_msec, timeout](const std::shared_ptr<HttpConnection> &client) -> bool {
+					if (client->IsIdle(current_msec, timeout))
+					{
+						logtd("Closing the idle connection: %s (%u requests)", client->GetRequest()->GetRemote()->ToString().CStr(), client->GetRequestCount());
+						return true;
+					}
+
+					return false;
+				});
+			}
+
+			return ov::DelayQueueAction::Repeat;
+		}
+
 		bool HttpServer::IsWebSocketRequest(const std::shared_ptr<const HttpRequest> &request)
 		{
 			// RFC6455 - 4.2.1.  Reading the Client's Opening Handshake
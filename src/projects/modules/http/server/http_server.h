@@ -9,6 +9,7 @@
 #pragma once
 
 #include <modules/physical_port/physical_port.h>
+#include <monitoring/monitoring.h>
 
 #include <shared_mutex>
 
@@ -17,6 +18,8 @@
 #include "interceptors/default/http_default_interceptor.h"
 
 #define HTTP_SERVER_USE_DEFAULT_COUNT PHYSICAL_PORT_USE_DEFAULT_COUNT
+// A persistent connection is closed if the next request is not received within this time
+#define HTTP_SERVER_DEFAULT_KEEP_ALIVE_TIMEOUT (30 * 1000)
 
 // References
 //
@@ -37,6 +40,7 @@ namespace http
 		{
 		protected:
 			friend class HttpServerManager;
+			friend class HttpConnection;
 
 		public:
 			using ClientList = std::map<ov::Socket *, std::shared_ptr<HttpConnection>>;
@@ -45,7 +49,8 @@ namespace http
 			HttpServer(const char *server_name);
 			~HttpServer() override;
 
-			virtual bool Start(const ov::SocketAddress &address, int worker_count);
+			// reuse_port: Bind a SO_REUSEPORT socket for each worker
+			virtual bool Start(const ov::SocketAddress &address, int worker_count, bool reuse_port = false);
 			virtual bool Stop();
 
 			bool IsRunning() const;
@@ -59,6 +64,25 @@ namespace http
 			// If the iterator returns true, the client will be disconnected
 			bool DisconnectIf(ClientIterator iterator);
 
+			// timeout_in_msec: 0 disables the persistent connection (The connection is closed after each response)
+			void SetKeepAliveTimeout(int timeout_in_msec);
+			bool IsKeepAliveEnabled() const
+			{
+				return _keep_alive_timeout > 0;
+			}
+
+			virtual bool IsTls() const
+			{
+				return false;
+			}
+
+			// Counters of the server, registered to mon::Monitoring while the server is running
+			// (nullptr until the server is started)
+			std::shared_ptr<mon::HttpServerMetrics> GetMetrics() const
+			{
+				return _metrics;
+			}
+
 		protected:
 			// @return 파싱이 성공적으로 되었다면 true를, 데이터가 더 필요하거나 오류가 발생하였다면 false이 반환됨
 			ssize_t TryParseHeader(const std::shared_ptr<HttpConnection> &client, const std::shared_ptr<const ov::Data> &data);
@@ -75,6 +99,9 @@ namespace http
 			void OnDataReceived(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddress &address, const std::shared_ptr<const ov::Data> &data) override;
 			void OnDisconnected(const std::shared_ptr<ov::Socket> &remote, PhysicalPortDisconnectReason reason, const std::shared_ptr<const ov::Error> &error) override;
 
+			// Closes the persistent connections which did not send the next request within _keep_alive_timeout
+			ov::DelayQueueAction CloseIdleConnections(void *parameter);
+
 			std::shared_ptr<PhysicalPort> GetPhysicalPort()
 			{
 				return _physical_port;
@@ -95,6 +122,12 @@ namespace http
 
 			std::vector<std::shared_ptr<ocst::VirtualHost>> _virtual_host_list;
 
+			std::atomic<int> _keep_alive_timeout{HTTP_SERVER_DEFAULT_KEEP_ALIVE_TIMEOUT};
+			ov::DelayQueue _idle_timer;
+
+			// Created before the physical port, and kept after Stop() for the connections which are being closed
+			std::shared_ptr<mon::HttpServerMetrics> _metrics;
+
 		private:
 			bool IsWebSocketRequest(const std::shared_ptr<const HttpRequest> &request);
 		};
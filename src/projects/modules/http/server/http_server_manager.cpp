@@ -16,7 +16,7 @@ namespace http
 {
 	namespace svr
 	{
-		std::shared_ptr<HttpServer> HttpServerManager::CreateHttpServer(const char *server_name, const ov::SocketAddress &address, int worker_count)
+		std::shared_ptr<HttpServer> HttpServerManager::CreateHttpServer(const char *server_name, const ov::SocketAddress &address, int worker_count, bool reuse_port)
 		{
 			std::shared_ptr<HttpServer> http_server = nullptr;
 
@@ -59,7 +59,7 @@ namespace http
 					// Create a new HTTP server
 					http_server = std::make_shared<HttpServer>(server_name);
 
-					if (http_server->Start(address, worker_count))
+					if (http_server->Start(address, worker_count, reuse_port))
 					{
 						_http_servers[address] = http_server;
 					}
@@ -74,7 +74,7 @@ namespace http
 			}
 		}
 
-		std::shared_ptr<HttpsServer> HttpServerManager::CreateHttpsServer(const char *server_name, const ov::SocketAddress &address, const std::shared_ptr<info::Certificate> &certificate, int worker_count)
+		std::shared_ptr<HttpsServer> HttpServerManager::CreateHttpsServer(const char *server_name, const ov::SocketAddress &address, const std::shared_ptr<info::Certificate> &certificate, int worker_count, bool reuse_port)
 		{
 			std::shared_ptr<HttpsServer> https_server = nullptr;
 
@@ -110,7 +110,7 @@ namespace http
 
 					if (https_server->SetCertificate(certificate))
 					{
-						if (https_server->Start(address, worker_count))
+						if (https_server->Start(address, worker_count, reuse_port))
 						{
 							_http_servers[address] = https_server;
 						}
@@ -131,7 +131,7 @@ namespace http
 			}
 		}
 
-		std::shared_ptr<HttpsServer> HttpServerManager::CreateHttpsServer(const char *server_name, const ov::SocketAddress &address, const std::vector<std::shared_ptr<ocst::VirtualHost>> &virtual_host_list, int worker_count)
+		std::shared_ptr<HttpsServer> HttpServerManager::CreateHttpsServer(const char *server_name, const ov::SocketAddress &address, const std::vector<std::shared_ptr<ocst::VirtualHost>> &virtual_host_list, int worker_count, bool reuse_port)
 		{
 			// Check if TLS is enabled
 			auto vhost_list = ocst::Orchestrator::GetInstance()->GetVirtualHostList();
@@ -144,7 +144,7 @@ namespace http
 			// TODO(Dimiden): OME doesn't support SNI yet, so OME can handle only one certificate.
 			const auto &host_info = vhost_list[0]->host_info;
 
-			return CreateHttpsServer(server_name, address, host_info.GetCertificate(), worker_count);
+			return CreateHttpsServer(server_name, address, host_info.GetCertificate(), worker_count, reuse_port);
 		}
 
 		bool HttpServerManager::ReleaseServer(const std::shared_ptr<HttpServer> &http_server)
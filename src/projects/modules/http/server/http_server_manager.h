@@ -20,9 +20,9 @@ namespace http
 		class HttpServerManager : public ov::Singleton<HttpServerManager>
 		{
 		public:
-			std::shared_ptr<HttpServer> CreateHttpServer(const char *server_name, const ov::SocketAddress &address, int worker_count = HTTP_SERVER_USE_DEFAULT_COUNT);
-			std::shared_ptr<HttpsServer> CreateHttpsServer(const char *server_name, const ov::SocketAddress &address, const std::shared_ptr<info::Certificate> &certificate, int worker_count = HTTP_SERVER_USE_DEFAULT_COUNT);
-			std::shared_ptr<HttpsServer> CreateHttpsServer(const char *server_name, const ov::SocketAddress &address, const std::vector<std::shared_ptr<ocst::VirtualHost>> &virtual_host_list, int worker_count = HTTP_SERVER_USE_DEFAULT_COUNT);
+			std::shared_ptr<HttpServer> CreateHttpServer(const char *server_name, const ov::SocketAddress &address, int worker_count = HTTP_SERVER_USE_DEFAULT_COUNT, bool reuse_port = false);
+			std::shared_ptr<HttpsServer> CreateHttpsServer(const char *server_name, const ov::SocketAddress &address, const std::shared_ptr<info::Certificate> &certificate, int worker_count = HTTP_SERVER_USE_DEFAULT_COUNT, bool reuse_port = false);
+			std::shared_ptr<HttpsServer> CreateHttpsServer(const char *server_name, const ov::SocketAddress &address, const std::vector<std::shared_ptr<ocst::VirtualHost>> &virtual_host_list, int worker_count = HTTP_SERVER_USE_DEFAULT_COUNT, bool reuse_port = false);
 
 			bool ReleaseServer(const std::shared_ptr<HttpServer> &http_server);
 
@@ -20,6 +20,8 @@
 #define HTTP_BACKWARD_COMPATIBILITY "ECDHE-ECDSA-CHACHA20-POLY1305:ECDHE-RSA-CHACHA20-POLY1305:ECDHE-RSA-AES128-GCM-SHA256:ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-RSA-AES256-GCM-SHA384:ECDHE-ECDSA-AES256-GCM-SHA384:DHE-RSA-AES128-GCM-SHA256:DHE-DSS-AES128-GCM-SHA256:kEDH+AESGCM:ECDHE-RSA-AES128-SHA256:ECDHE-ECDSA-AES128-SHA256:ECDHE-RSA-AES128-SHA:ECDHE-ECDSA-AES128-SHA:ECDHE-RSA-AES256-SHA384:ECDHE-ECDSA-AES256-SHA384:ECDHE-RSA-AES256-SHA:ECDHE-ECDSA-AES256-SHA:DHE-RSA-AES128-SHA256:DHE-RSA-AES128-SHA:DHE-DSS-AES128-SHA256:DHE-RSA-AES256-SHA256:DHE-DSS-AES256-SHA:DHE-RSA-AES256-SHA:ECDHE-RSA-DES-CBC3-SHA:ECDHE-ECDSA-DES-CBC3-SHA:EDH-RSA-DES-CBC3-SHA:AES128-GCM-SHA256:AES256-GCM-SHA384:AES128-SHA256:AES256-SHA256:AES128-SHA:AES256-SHA:AES:DES-CBC3-SHA:HIGH:SEED:!aNULL:!eNULL:!EXPORT:!DES:!RC4:!MD5:!PSK:!RSAPSK:!aDH:!aECDH:!EDH-DSS-DES-CBC3-SHA:!KRB5-DES-CBC3-SHA:!SRP"
 // Fastest suite only, which is still considered `secure`.
 #define HTTP_FAST_NOT_VERY_SECURE "AES128-SHA"
+// The kernel can encrypt AEAD ciphers only, so AES-GCM is preferred when kTLS is enabled
+#define HTTP_FAST_KERNEL_TLS "AES128-GCM-SHA256:" HTTP_FAST_NOT_VERY_SECURE
 
 namespace http
 {
@@ -38,6 +40,19 @@ namespace http
 			return true;
 		}
 
+		bool HttpsServer::Stop()
+		{
+			if (HttpServer::Stop() == false)
+			{
+				return false;
+			}
+
+			logti("%s: TLS connections encrypted by kernel: %" PRIu64 ", userspace: %" PRIu64,
+				  _server_name.CStr(), _metrics->GetKernelTlsConnectionCount(), _metrics->GetUserspaceTlsConnectionCount());
+
+			return true;
+		}
+
 		void HttpsServer::OnConnected(const std::shared_ptr<ov::Socket> &remote)
 		{
 			auto client = ProcessConnect(remote);
@@ -49,15 +64,24 @@ namespace http
 					return;
 				}
 
+				bool kernel_tls = _kernel_tls;
+
 				auto tls_data = std::make_shared<ov::TlsServerData>(
 					ov::TlsServerData::Method::Tls,
 					_certificate->GetCertificate(), _certificate->GetChainCertificate(),
-					HTTP_FAST_NOT_VERY_SECURE);
+					kernel_tls ? HTTP_FAST_KERNEL_TLS : HTTP_FAST_NOT_VERY_SECURE);
 
 				tls_data->SetWriteCallback([remote](const void *data, size_t length) -> ssize_t {
 					return remote->Send(data, length) ? length : -1L;
 				});
 
+				if (kernel_tls)
+				{
+					tls_data->SetKernelTlsCallback([remote](const std::shared_ptr<const ov::Data> &crypto_info) -> bool {
+						return remote->EnableKernelTlsTx(crypto_info->GetData(), crypto_info->GetLength());
+					});
+				}
+
 				client->GetRequest()->SetTlsData(tls_data);
 				client->GetResponse()->SetTlsData(tls_data);
 			}
@@ -79,9 +103,17 @@ namespace http
 			if (tls_data != nullptr)
 			{
 				std::shared_ptr<const ov::Data> plain_data;
+				auto state = tls_data->GetState();
 
 				if (tls_data->Decrypt(data, &plain_data))
 				{
+					if ((state == ov::TlsServerData::State::WaitingForAccept) && (tls_data->GetState() == ov::TlsServerData::State::Accepted))
+					{
+						_metrics->OnTlsAccepted(tls_data->IsKernelTlsEnabled());
+
+						logtd("[%s] TLS is accepted (kTLS: %s)", remote->ToString().CStr(), tls_data->IsKernelTlsEnabled() ? "enabled" : "disabled");
+					}
+
 					if ((plain_data != nullptr) && (plain_data->GetLength() > 0))
 					{
 						// plain_data is HTTP data
@@ -27,6 +27,26 @@ namespace http
 			// TODO(Dimiden): OME doesn't support SNI yet, so OME can handle only one certificate.
 			bool SetCertificate(const std::shared_ptr<info::Certificate> &certificate);
 
+			bool Stop() override;
+
+			// Hands the TX keys to the kernel after the TLS handshake (kTLS) to encrypt the responses in the kernel.
+			// If kTLS is not available, the connection falls back to the userspace encryption.
+			// Affects the connections accepted after this call.
+			void SetKernelTls(bool enabled)
+			{
+				_kernel_tls = enabled;
+			}
+
+			bool IsKernelTlsEnabled() const
+			{
+				return _kernel_tls;
+			}
+
+			bool IsTls() const override
+			{
+				return true;
+			}
+
 		protected:
 			//--------------------------------------------------------------------
 			// Implementation of PhysicalPortObserver
@@ -36,6 +56,8 @@ namespace http
 
 		protected:
 			std::shared_ptr<info::Certificate> _certificate;
+
+			std::atomic<bool> _kernel_tls{false};
 		};
 	}  // namespace svr
 }  // namespace http
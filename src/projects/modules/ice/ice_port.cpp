@@ -42,7 +42,7 @@ IcePort::~IcePort()
 	Close();
 }
 
-bool IcePort::CreateIceCandidates(const std::vector<std::vector<RtcIceCandidate>> &ice_candidate_list, int ice_worker_count)
+bool IcePort::CreateIceCandidates(const std::vector<std::vector<RtcIceCandidate>> &ice_candidate_list, int ice_worker_count, bool send_batching, PhysicalPortShardMode shard_mode)
 {
 	std::lock_guard<std::recursive_mutex> lock_guard(_physical_port_list_mutex);
 
@@ -75,7 +75,7 @@ bool IcePort::CreateIceCandidates(const std::vector<std::vector<RtcIceCandidate>
 			address.SetHostname(nullptr);
 
 			// Create an ICE port using candidate information
-			auto physical_port = CreatePhysicalPort(address, socket_type, ice_worker_count);
+			auto physical_port = CreatePhysicalPort(address, socket_type, ice_worker_count, shard_mode);
 			if (physical_port == nullptr)
 			{
 				logte("Could not create physical port for %s/%s", address.ToString().CStr(), transport.CStr());
@@ -83,7 +83,15 @@ bool IcePort::CreateIceCandidates(const std::vector<std::vector<RtcIceCandidate>
 				break;
 			}
 
-			logti("ICE port is bound to %s/%s (%p)", address.ToString().CStr(), transport.CStr(), physical_port.get());
+			if (send_batching && (socket_type == ov::SocketType::Udp))
+			{
+				if (physical_port->SetSendBatching(true) == false)
+				{
+					logtw("Could not enable send batching for %s/%s", address.ToString().CStr(), transport.CStr());
+				}
+			}
+
+			logti("ICE port is bound to %s/%s (%p, shards: %d)", address.ToString().CStr(), transport.CStr(), physical_port.get(), physical_port->GetShardCount());
 			_physical_port_list.push_back(physical_port);
 		}
 	}
@@ -161,9 +169,9 @@ bool IcePort::CreateTurnServer(uint16_t listening_port, ov::SocketType socket_ty
 	return true;
 }
 
-std::shared_ptr<PhysicalPort> IcePort::CreatePhysicalPort(const ov::SocketAddress &address, ov::SocketType type, int worker_count)
+std::shared_ptr<PhysicalPort> IcePort::CreatePhysicalPort(const ov::SocketAddress &address, ov::SocketType type, int worker_count, PhysicalPortShardMode shard_mode)
 {
-	auto physical_port = PhysicalPortManager::GetInstance()->CreatePort("ICE", type, address, worker_count);
+	auto physical_port = PhysicalPortManager::GetInstance()->CreatePort("ICE", type, address, worker_count, 0, 0, shard_mode);
 	if (physical_port != nullptr)
 	{
 		if (physical_port->AddObserver(this))
@@ -208,13 +216,11 @@ bool IcePort::Close()
 
 ov::String IcePort::GenerateUfrag()
 {
-	std::lock_guard<std::mutex> lock_guard(_user_port_table_lock);
-
 	while (true)
 	{
 		ov::String ufrag = ov::Random::GenerateString(6);
 
-		if (_user_port_table.find(ufrag) == _user_port_table.end())
+		if (_user_port_table.Find(ufrag) == false)
 		{
 			logtd("Generated ufrag: %s", ufrag.CStr());
 
@@ -230,18 +236,19 @@ void IcePort::AddSession(const std::shared_ptr<IcePortObserver> &observer, uint3
 	const ov::String &local_ufrag = offer_sdp->GetIceUfrag();
 	const ov::String &remote_ufrag = peer_sdp->GetIceUfrag();
 
+	std::shared_ptr<IcePortInfo> info;
+
 	{
-		std::lock_guard<std::mutex> lock_guard(_user_port_table_lock);
+		std::shared_ptr<IcePortInfo> old_info;
 
-		auto item = _user_port_table.find(local_ufrag);
-		if (item != _user_port_table.end())
+		if (_user_port_table.Find(local_ufrag, &old_info))
 		{
-			OV_ASSERT(false, "Duplicated ufrag: %s:%s, session_id: %d (old session_id: %d)", local_ufrag.CStr(), remote_ufrag.CStr(), session_id, item->second->session_id);
+			OV_ASSERT(false, "Duplicated ufrag: %s:%s, session_id: %d (old session_id: %d)", local_ufrag.CStr(), remote_ufrag.CStr(), session_id, old_info->session_id);
 		}
 
 		logtd("Trying to add session: %d (ufrag: %s:%s)...", session_id, local_ufrag.CStr(), remote_ufrag.CStr());
 
-		std::shared_ptr<IcePortInfo> info = std::make_shared<IcePortInfo>(expired_ms, life_time_epoch_ms);
+		info = std::make_shared<IcePortInfo>(expired_ms, life_time_epoch_ms);
 
 		info->observer = observer;
 		info->user_data = user_data;
@@ -254,10 +261,10 @@ void IcePort::AddSession(const std::shared_ptr<IcePortObserver> &observer, uint3
 
 		info->UpdateBindingTime();
 
-		_user_port_table[local_ufrag] = info;
+		_user_port_table.Set(local_ufrag, info);
 	}
 
-	SetIceState(_user_port_table[local_ufrag], IcePortConnectionState::New);
+	SetIceState(info, IcePortConnectionState::New);
 }
 
 bool IcePort::RemoveSession(uint32_t session_id)
@@ -267,8 +274,7 @@ bool IcePort::RemoveSession(uint32_t session_id)
 	{
 		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
 
-		auto item = _session_port_table.find(session_id);
-		if (item == _session_port_table.end())
+		if (_session_port_table.Remove(session_id, &ice_port_info) == false)
 		{
 			/*
 			The case of reaching here is as follows.
@@ -279,47 +285,41 @@ bool IcePort::RemoveSession(uint32_t session_id)
 			*/
 			logtd("Could not find session: %d", session_id);
 
+			// If it exists only in _user_port_table, find it and remove it.
+			std::shared_ptr<IcePortInfo> removed_ice_port_info;
+
+			_user_port_table.RemoveIf([session_id, &removed_ice_port_info](const ov::String &ufrag, const std::shared_ptr<IcePortInfo> &info) -> bool {
+				if (info->session_id == session_id)
+				{
+					removed_ice_port_info = info;
+					return true;
+				}
+
+				return false;
+			});
+
+			if (removed_ice_port_info == nullptr)
 			{
-				// If it exists only in _user_port_table, find it and remove it.
-				// TODO(Dimiden): In this case, apply a more efficient method of deletion.
-				std::lock_guard<std::mutex> lock_guard(_user_port_table_lock);
+				return false;
+			}
+
+			logtd("This is because the stun request was not received from this session.");
+
+			// Close only TCP (TURN)
+			auto remote = removed_ice_port_info->remote;
 
-				auto it = _user_port_table.begin();
-				while(it != _user_port_table.end())
+			if (remote != nullptr)
+			{
+				if (remote->GetSocket().GetType() == ov::SocketType::Tcp)
 				{
-					auto ice_port_info = it->second;
-					if (ice_port_info->session_id == session_id)
-					{
-						_user_port_table.erase(it++);
-						logtd("This is because the stun request was not received from this session.");
-
-						// Close only TCP (TURN)
-						auto remote = ice_port_info->remote;
-
-						if (remote != nullptr)
-						{
-							if (remote->GetSocket().GetType() == ov::SocketType::Tcp)
-							{
-								remote->CloseIfNeeded();
-							}
-						}
-
-						return true;
-					}
-					else
-					{
-						it++;
-					}
+					remote->CloseIfNeeded();
 				}
 			}
 
-			return false;
+			return true;
 		}
 
-		ice_port_info = item->second;
-
-		_session_port_table.erase(item);
-		_address_port_table.erase(ice_port_info->address);
+		_address_port_table.Remove(ice_port_info->address);
 
 		// Close only TCP (TURN)
 		auto remote = ice_port_info->remote;
@@ -333,10 +333,7 @@ bool IcePort::RemoveSession(uint32_t session_id)
 		}
 	}
 
-	{
-		std::lock_guard<std::mutex> lock_guard(_user_port_table_lock);
-		_user_port_table.erase(ice_port_info->offer_sdp->GetIceUfrag());
-	}
+	_user_port_table.Remove(ice_port_info->offer_sdp->GetIceUfrag());
 
 	return true;
 }
@@ -361,30 +358,24 @@ void IcePort::CheckTimedoutItem()
 	}
 
 	std::vector<std::shared_ptr<IcePortInfo>> delete_list;
-	{
-		std::lock_guard<std::mutex> lock_guard(_user_port_table_lock);
 
-		for (auto item = _user_port_table.begin(); item != _user_port_table.end();)
+	_user_port_table.RemoveIf([&delete_list](const ov::String &ufrag, const std::shared_ptr<IcePortInfo> &info) -> bool {
+		if (info->IsExpired())
 		{
-			if (item->second->IsExpired())
-			{
-				delete_list.push_back(item->second);
-				item = _user_port_table.erase(item);
-			}
-			else
-			{
-				++item;
-			}
+			delete_list.push_back(info);
+			return true;
 		}
-	}
+
+		return false;
+	});
 
 	{
 		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
 
 		for (auto &deleted_ice_port : delete_list)
 		{
-			_session_port_table.erase(deleted_ice_port->session_id);
-			_address_port_table.erase(deleted_ice_port->address);
+			_session_port_table.Remove(deleted_ice_port->session_id);
+			_address_port_table.Remove(deleted_ice_port->address);
 		}
 	}
 
@@ -413,22 +404,30 @@ bool IcePort::Send(uint32_t session_id, std::shared_ptr<RtcpPacket> packet)
 	return Send(session_id, packet->GetData());
 }
 
-bool IcePort::Send(uint32_t session_id, const std::shared_ptr<const ov::Data> &data)
+std::shared_ptr<IcePort::IcePortInfo> IcePort::GetIcePortInfo(uint32_t session_id) const
 {
 	std::shared_ptr<IcePortInfo> ice_port_info;
-	{
-		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
 
-		auto item = _session_port_table.find(session_id);
-		if (item == _session_port_table.end())
-		{
-			logtd("ClientSocket not found for session #%d", session_id);
-			return false;
-		}
+	_session_port_table.Find(session_id, &ice_port_info);
+
+	return ice_port_info;
+}
 
-		ice_port_info = item->second;
+bool IcePort::Send(uint32_t session_id, const std::shared_ptr<const ov::Data> &data)
+{
+	std::shared_ptr<IcePortInfo> ice_port_info;
+
+	if (_session_port_table.Find(session_id, &ice_port_info) == false)
+	{
+		logtd("ClientSocket not found for session #%d", session_id);
+		return false;
 	}
 
+	return Send(ice_port_info, data);
+}
+
+bool IcePort::Send(const std::shared_ptr<IcePortInfo> &ice_port_info, const std::shared_ptr<const ov::Data> &data)
+{
 	std::shared_ptr<const ov::Data> send_data = nullptr;
 
 	// Send throutgh TURN data channel
@@ -551,14 +550,7 @@ void IcePort::OnApplicationPacketReceived(const std::shared_ptr<ov::Socket> &rem
 						GateInfo &gate_info, const std::shared_ptr<const ov::Data> &data)
 {
 	std::shared_ptr<IcePortInfo> ice_port_info;
-	{
-		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
-		auto item = _address_port_table.find(address);
-		if (item != _address_port_table.end())
-		{
-			ice_port_info = item->second;
-		}
-	}
+	_address_port_table.Find(address, &ice_port_info);
 
 	if (ice_port_info == nullptr)
 	{
@@ -700,16 +692,12 @@ bool IcePort::ProcessStunBindingRequest(const std::shared_ptr<ov::Socket> &remot
 	{
 		// WebRTC Publisher registers ufrag with session information 
 		// through IcePort::AddSession function after signaling with player
-		std::unique_lock<std::mutex> lock_guard(_user_port_table_lock);
-		auto info = _user_port_table.find(local_ufrag);
-		if (info == _user_port_table.end())
+		if (_user_port_table.Find(local_ufrag, &ice_port_info) == false)
 		{
 			// Stun may arrive first before AddSession, it is not an error
 			logtd("User not found: %s (AddSession() needed)", local_ufrag.CStr());
 			return false;
 		}
-
-		ice_port_info = info->second;
 	}
 
 	if (ice_port_info->peer_sdp->GetIceUfrag() != remote_ufrag)
@@ -722,17 +710,13 @@ bool IcePort::ProcessStunBindingRequest(const std::shared_ptr<ov::Socket> &remot
 		logtw("Failed to check integrity");
 
 		SetIceState(ice_port_info, IcePortConnectionState::Failed);
-		{
-			std::lock_guard<std::mutex> lock_guard(_user_port_table_lock);
-
-			_user_port_table.erase(local_ufrag);
-		}
+		_user_port_table.Remove(local_ufrag);
 
 		{
 			std::lock_guard<std::mutex> lock_guard(_port_table_lock);
 
-			_address_port_table.erase(ice_port_info->address);
-			_session_port_table.erase(ice_port_info->session_id);
+			_address_port_table.Remove(ice_port_info->address);
+			_session_port_table.Remove(ice_port_info->session_id);
 		}
 
 		return false;
@@ -915,12 +899,12 @@ bool IcePort::ProcessStunBindingResponse(const std::shared_ptr<ov::Socket> &remo
 	{
 		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
 
-		if (_session_port_table.find(ice_port_info->session_id) == _session_port_table.end())
+		if (_session_port_table.Find(ice_port_info->session_id) == false)
 		{
 			logti("Add the client to the port list: %s", address.ToString().CStr());
 
-			_address_port_table[address] = ice_port_info;
-			_session_port_table[ice_port_info->session_id] = ice_port_info;
+			_address_port_table.Set(address, ice_port_info);
+			_session_port_table.Set(ice_port_info->session_id, ice_port_info);
 		}
 		else
 		{
@@ -1112,14 +1096,7 @@ bool IcePort::ProcessTurnChannelBindRequest(const std::shared_ptr<ov::Socket> &r
 {
 	//TODO(Getroot): Check validation
 	std::shared_ptr<IcePortInfo> ice_port_info;
-	{
-		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
-		auto item = _address_port_table.find(address);
-		if (item != _address_port_table.end())
-		{
-			ice_port_info = item->second;
-		}
-	}
+	_address_port_table.Find(address, &ice_port_info);
 
 	if (ice_port_info == nullptr)
 	{
@@ -57,7 +57,9 @@ protected:
 		}
 	};
 
+public:
 	// A data structure to tracking client connection status
+	// (The sessions keep it to send the packets without looking up the tables, see GetIcePortInfo())
 	struct IcePortInfo
 	{
 		std::shared_ptr<IcePortObserver> observer;
@@ -110,6 +112,41 @@ protected:
 		
 	};
 
+protected:
+	// Distributes the addresses over the shards of _address_port_table
+	// (The clients behind a NAT share an IP, and the clients of a host may use the same port on different IPs)
+	struct SocketAddressShardHash
+	{
+		size_t operator()(const ov::SocketAddress &address) const
+		{
+			size_t hash = address.Port();
+
+			switch (address.GetFamily())
+			{
+				case ov::SocketFamily::Inet: {
+					hash ^= static_cast<size_t>(address.AddrInForIPv4()->s_addr) * 0x9E3779B97F4A7C15ULL;
+					break;
+				}
+
+				case ov::SocketFamily::Inet6: {
+					auto bytes = address.AddrInForIPv6()->s6_addr;
+
+					for (size_t index = 0; index < sizeof(in6_addr); index++)
+					{
+						hash = (hash * 31) + bytes[index];
+					}
+					break;
+				}
+
+				default:
+					break;
+			}
+
+			// Mix the high bits into the low bits, which select the shard
+			return hash ^ (hash >> 32) ^ (hash >> 16);
+		}
+	};
+
 	struct BindingRequestInfo
 	{
 		BindingRequestInfo(ov::String transaction_id, const std::shared_ptr<IcePortInfo> &ice_port)
@@ -139,19 +176,20 @@ public:
 	~IcePort() override;
 
 	bool CreateTurnServer(uint16_t listening_port, ov::SocketType socket_type, int tcp_relay_worker_count);
-	bool CreateIceCandidates(const std::vector<std::vector<RtcIceCandidate>> &ice_candidate_list, int ice_worker_count);
+	bool CreateIceCandidates(const std::vector<std::vector<RtcIceCandidate>> &ice_candidate_list, int ice_worker_count, bool send_batching = false, PhysicalPortShardMode shard_mode = PhysicalPortShardMode::None);
 	bool Close();
 
 	IcePortConnectionState GetState(uint32_t session_id) const
 	{
-		auto item = _session_port_table.find(session_id);
-		if(item == _session_port_table.end())
+		std::shared_ptr<IcePortInfo> ice_port_info;
+
+		if(_session_port_table.Find(session_id, &ice_port_info) == false)
 		{
 			OV_ASSERT(false, "Invalid session_id: %d", session_id);
 			return IcePortConnectionState::Failed;
 		}
 
-		return item->second->state;
+		return ice_port_info->state;
 	}
 
 	ov::String GenerateUfrag();
@@ -161,14 +199,19 @@ public:
 					int stun_timeout_ms,  uint64_t life_time_epoch_ms, std::any user_data);
 	bool RemoveSession(uint32_t session_id);
 
+	// Returns nullptr until the STUN binding of the session is completed
+	std::shared_ptr<IcePortInfo> GetIcePortInfo(uint32_t session_id) const;
+
 	bool Send(uint32_t session_id, std::shared_ptr<RtpPacket> packet);
 	bool Send(uint32_t session_id, std::shared_ptr<RtcpPacket> packet);
 	bool Send(uint32_t session_id, const std::shared_ptr<const ov::Data> &data);
+	// Sends the data to the client of ice_port_info (from GetIcePortInfo()) without looking up the tables
+	bool Send(const std::shared_ptr<IcePortInfo> &ice_port_info, const std::shared_ptr<const ov::Data> &data);
 
 	ov::String ToString() const;
 
 protected:
-	std::shared_ptr<PhysicalPort> CreatePhysicalPort(const ov::SocketAddress &address, ov::SocketType type, int ice_worker_count);
+	std::shared_ptr<PhysicalPort> CreatePhysicalPort(const ov::SocketAddress &address, ov::SocketType type, int ice_worker_count, PhysicalPortShardMode shard_mode = PhysicalPortShardMode::None);
 
 	bool ParseIceCandidate(const ov::String &ice_candidate, std::vector<ov::String> *ip_list, ov::SocketType *socket_type, int *start_port, int *end_port);
 
@@ -230,19 +273,22 @@ private:
 	std::vector<std::shared_ptr<PhysicalPort>> _physical_port_list;
 	std::recursive_mutex _physical_port_list_mutex;
 
+	// These tables are looked up without holding the table locks (for every packet sent/received),
+	// and the writers replace the snapshot of the table (See ov::CopyOnWriteMap)
+
 	// Mapping table containing related information until STUN binding.
 	// Once binding is complete, there is no need because it can be found by destination ip & port.
 	// key: offer ufrag
 	// value: IcePortInfo
-	std::mutex _user_port_table_lock;
-	std::map<const ov::String, std::shared_ptr<IcePortInfo>> _user_port_table;
-	
+	ov::CopyOnWriteMap<ov::String, std::shared_ptr<IcePortInfo>> _user_port_table;
+
+	// Serializes the writers of _address_port_table and _session_port_table to keep them consistent
+	std::mutex _port_table_lock;
 	// Find IcePortInfo with peer's ip:port
 	// key: SocketAddress value: IcePortInfo
-	std::mutex _port_table_lock;
-	std::map<ov::SocketAddress, std::shared_ptr<IcePortInfo>> _address_port_table;
+	ov::CopyOnWriteMap<ov::SocketAddress, std::shared_ptr<IcePortInfo>, SocketAddressShardHash> _address_port_table;
 	// Find IcePortInfo with peer's session id
-	std::map<session_id_t, std::shared_ptr<IcePortInfo>> _session_port_table;
+	ov::CopyOnWriteMap<session_id_t, std::shared_ptr<IcePortInfo>> _session_port_table;
 
 	// Insert item when send stun binding request
 	// Remove item when receive stun binding response or timed out
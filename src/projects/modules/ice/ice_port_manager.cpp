@@ -57,7 +57,20 @@ bool IcePortManager::CreateIceCandidates(std::shared_ptr<IcePortObserver> observ
 	auto ice_worker_count = ice_candidates_config.GetIceWorkerCount(&is_parsed);
 	ice_worker_count = is_parsed ? ice_worker_count : PHYSICAL_PORT_USE_DEFAULT_COUNT;
 
-	if(_ice_port->CreateIceCandidates(ice_candidate_list, ice_worker_count) == false)
+	auto send_batching = ice_candidates_config.IsSendBatchingEnabled();
+
+	auto shard_mode = PhysicalPortShardMode::None;
+
+	if (ice_candidates_config.IsReusePortEnabled())
+	{
+		shard_mode = ice_candidates_config.IsBpfSteeringEnabled() ? PhysicalPortShardMode::ReusePortWithBpf : PhysicalPortShardMode::ReusePort;
+	}
+	else if (ice_candidates_config.IsBpfSteeringEnabled())
+	{
+		logtw("BpfSteering is ignored because ReusePort is not enabled");
+	}
+
+	if(_ice_port->CreateIceCandidates(ice_candidate_list, ice_worker_count, send_batching, shard_mode) == false)
 	{
 		Release(observer);
 
@@ -27,42 +27,130 @@ namespace mpegts
 
 	bool MpegTsDepacketizer::AddPacket(const std::shared_ptr<const ov::Data> &packet)
 	{
-		_buffer->Append(packet);
+		auto data = packet->GetDataAs<uint8_t>();
+		size_t length = packet->GetLength();
+		bool result = true;
 
-		while(_buffer->GetLength() >= MPEGTS_MIN_PACKET_SIZE)
+		// Complete the packet which was split at the end of the previous datagram
+		if(_partial_packet_length > 0)
 		{
-			auto packet = std::make_shared<MpegTsPacket>(_buffer);
-			
-			uint32_t parsed_length = packet->Parse();
-			if(parsed_length == 0)
+			auto copy_length = std::min(length, MPEGTS_MIN_PACKET_SIZE - _partial_packet_length);
+
+			::memcpy(_partial_packet + _partial_packet_length, data, copy_length);
+			_partial_packet_length += copy_length;
+			data += copy_length;
+			length -= copy_length;
+
+			if(_partial_packet_length < MPEGTS_MIN_PACKET_SIZE)
 			{
-				_buffer = _buffer->Subdata(MPEGTS_MIN_PACKET_SIZE);
-				return false;
+				return true;
 			}
 
-			_buffer = _buffer->Subdata(parsed_length);
+			_partial_packet_length = 0;
+			result = ParsePacket(_partial_packet);
+		}
+
+		while(length > 0)
+		{
+			auto skip_length = FindSyncByte(data, length);
+			data += skip_length;
+			length -= skip_length;
+
+			if(length < MPEGTS_MIN_PACKET_SIZE)
+			{
+				break;
+			}
 
-			if(AddPacket(packet) == false)
+			// Packets in the datagram are parsed without copying
+			if(ParsePacket(data) == false)
 			{
-				return false;
+				result = false;
 			}
+
+			data += MPEGTS_MIN_PACKET_SIZE;
+			length -= MPEGTS_MIN_PACKET_SIZE;
 		}
 
-		return true;
+		if(length > 0)
+		{
+			::memcpy(_partial_packet, data, length);
+			_partial_packet_length = length;
+		}
+
+		return result;
+	}
+
+	size_t MpegTsDepacketizer::FindSyncByte(const uint8_t *data, size_t length)
+	{
+		// 0x47 can appear in the payload, so an offset is accepted only if the next packet also starts with the sync byte
+		// (a packet at the end of the data cannot be confirmed, it is accepted only at the expected offset)
+		if((data[0] == MPEGTS_SYNC_BYTE) && ((length <= MPEGTS_MIN_PACKET_SIZE) || (data[MPEGTS_MIN_PACKET_SIZE] == MPEGTS_SYNC_BYTE)))
+		{
+			return 0;
+		}
+
+		size_t offset = 1;
+
+		while(offset < length)
+		{
+			auto sync_byte = static_cast<const uint8_t *>(::memchr(data + offset, MPEGTS_SYNC_BYTE, length - offset));
+			if(sync_byte == nullptr)
+			{
+				break;
+			}
+
+			offset = static_cast<size_t>(sync_byte - data);
+
+			if(offset + MPEGTS_MIN_PACKET_SIZE >= length)
+			{
+				// Cannot be confirmed in this data, the next data is expected to start with a packet
+				break;
+			}
+
+			if(data[offset + MPEGTS_MIN_PACKET_SIZE] == MPEGTS_SYNC_BYTE)
+			{
+				logtw("Could not find the sync byte, %zu bytes are skipped", offset);
+				return offset;
+			}
+
+			offset++;
+		}
+
+		logtw("Could not find the sync byte, %zu bytes are skipped", length);
+
+		return length;
+	}
+
+	bool MpegTsDepacketizer::ParsePacket(const uint8_t *buffer)
+	{
+		MpegTsPacket packet(buffer);
+
+		if(packet.Parse() == 0)
+		{
+			logtd("Could not parse MPEG-TS packet");
+			return false;
+		}
+
+		return AddPacket(packet);
 	}
 
 	bool MpegTsDepacketizer::AddPacket(const std::shared_ptr<MpegTsPacket> &packet)
+	{
+		return AddPacket(*packet);
+	}
+
+	bool MpegTsDepacketizer::AddPacket(const MpegTsPacket &packet)
 	{
 		auto packet_type = GetPacketType(packet);
 
 		// Check continuity counter
 		// TODO(Getroot): Later, it can be used for jitter buffer to correct the UDP packet order
-		if(packet->HasPayload())
+		if(packet.HasPayload())
 		{	
-			auto it = _last_continuity_counter_map.find(packet->PacketIdentifier());
+			auto it = _last_continuity_counter_map.find(packet.PacketIdentifier());
 			if(it == _last_continuity_counter_map.end())
 			{
-				_last_continuity_counter_map.emplace(packet->PacketIdentifier(), packet->ContinuityCounter());
+				_last_continuity_counter_map.emplace(packet.PacketIdentifier(), packet.ContinuityCounter());
 			}
 			else
 			{
@@ -78,13 +166,13 @@ namespace mpegts
 					expected_counter = 0;
 				}
 
-				if(packet->ContinuityCounter() != expected_counter)
+				if(packet.ContinuityCounter() != expected_counter)
 				{
 					logtw("An out-of-order packet was received.(PID : %d Expected : %d, Received : %d",
-						packet->PacketIdentifier(), expected_counter, packet->ContinuityCounter());
+						packet.PacketIdentifier(), expected_counter, packet.ContinuityCounter());
 				}
 
-				_last_continuity_counter_map[packet->PacketIdentifier()] = packet->ContinuityCounter();
+				_last_continuity_counter_map[packet.PacketIdentifier()] = packet.ContinuityCounter();
 			}	
 		}
 
@@ -103,7 +191,7 @@ namespace mpegts
 		else if(packet_type == PacketType::UNSUPPORTED_SECTION)
 		{
 			// FFMPEG ususally sends PID 17 (DVB - SDT), but we don't use this table now
-			logtd("Ignored unsupported or unknown MPEG-TS packets.(PID: %d)", packet->PacketIdentifier());
+			logtd("Ignored unsupported or unknown MPEG-TS packets.(PID: %d)", packet.PacketIdentifier());
 			return false;
 		}
 		
@@ -181,9 +269,9 @@ namespace mpegts
 		return es;
 	}
 
-	PacketType MpegTsDepacketizer::GetPacketType(const std::shared_ptr<MpegTsPacket> &packet)
+	PacketType MpegTsDepacketizer::GetPacketType(const MpegTsPacket &packet)
 	{
-		switch(packet->PacketIdentifier())
+		switch(packet.PacketIdentifier())
 		{
 			// Well known PIDs
 			case static_cast<uint16_t>(WellKnownPacketId::PAT):
@@ -198,7 +286,7 @@ namespace mpegts
 
 		// PMT's PID are in PAT, PES's PID are in PMT
 		// For quickly search they are stored in packet_type_table
-		auto it = _packet_type_table.find(packet->PacketIdentifier());
+		auto it = _packet_type_table.find(packet.PacketIdentifier());
 		if(it == _packet_type_table.end())
 		{
 			return PacketType::UNKNOWN;
@@ -209,18 +297,18 @@ namespace mpegts
 		return packet_type;
 	}
 
-	bool MpegTsDepacketizer::ParseSection(const std::shared_ptr<MpegTsPacket> &packet)
+	bool MpegTsDepacketizer::ParseSection(const MpegTsPacket &packet)
 	{
-		BitReader bit_reader(packet->Payload(), packet->PayloadLength());
+		BitReader bit_reader(packet.Payload(), packet.PayloadLength());
 
 		// First packet of section, it means need to create new section draft and completed previous section
-		if(packet->PayloadUnitStartIndicator())
+		if(packet.PayloadUnitStartIndicator())
 		{
 			// read pointer field - 8 bits
 			auto pointer_field = bit_reader.ReadBytes<uint8_t>();
 
 			// Check if there was an incomplete section
-			auto prev_section = GetSectionDraft(packet->PacketIdentifier());
+			auto prev_section = GetSectionDraft(packet.PacketIdentifier());
 			if(prev_section != nullptr)
 			{
 				// Extract remaining data of previous section
@@ -232,14 +320,14 @@ namespace mpegts
 					// Previous section completed
 					if(CompleteSection(prev_section) == false)
 					{
-						logte("Could not complete section(PID: %d)", packet->PacketIdentifier());
+						logte("Could not complete section(PID: %d)", packet.PacketIdentifier());
 						return false;
 					}
 				}
 				else
 				{
 					// Somethind wrong
-					logte("Could not complete section(PID: %d)", packet->PacketIdentifier());
+					logte("Could not complete section(PID: %d)", packet.PacketIdentifier());
 				}
 			}
 
@@ -249,13 +337,13 @@ namespace mpegts
 			// Parsing new section
 			while(bit_reader.BytesReamined() > 0)
 			{
-				auto new_section = std::make_shared<Section>(packet->PacketIdentifier());
+				auto new_section = std::make_shared<Section>(packet.PacketIdentifier());
 				// There can be more than 2 sections
 				auto consumed_bytes = new_section->AppendData(bit_reader.CurrentPosition(), bit_reader.BytesReamined());
 				if(consumed_bytes == 0)
 				{
 					// Something wrong
-					logte("Could not parse section(PID: %d)", packet->PacketIdentifier());
+					logte("Could not parse section(PID: %d)", packet.PacketIdentifier());
 					return false;
 				}
 
@@ -265,7 +353,7 @@ namespace mpegts
 				{
 					if(CompleteSection(new_section) == false)
 					{
-						logte("Could not complete section(PID: %d)", packet->PacketIdentifier());
+						logte("Could not complete section(PID: %d)", packet.PacketIdentifier());
 						return false;
 					}
 				}
@@ -279,17 +367,17 @@ namespace mpegts
 		// There is only continuation of section data
 		else
 		{
-			auto section = GetSectionDraft(packet->PacketIdentifier());
+			auto section = GetSectionDraft(packet.PacketIdentifier());
 			if(section == nullptr)
 			{
 				// Something wrong
-				logte("Could not find section(PID: %d) for depacketizing", packet->PacketIdentifier());
+				logte("Could not find section(PID: %d) for depacketizing", packet.PacketIdentifier());
 				return false;
 			}
 
 			// There is no new section in this packet, so all remained data has to be consumed
-			auto consumed_length = section->AppendData(packet->Payload(), packet->PayloadLength());
-			if(consumed_length != packet->PayloadLength())
+			auto consumed_length = section->AppendData(packet.Payload(), packet.PayloadLength());
+			if(consumed_length != packet.PayloadLength())
 			{
 				return false;
 			}
@@ -303,21 +391,29 @@ namespace mpegts
 		return true;
 	}
 
-	bool MpegTsDepacketizer::ParsePes(const std::shared_ptr<MpegTsPacket> &packet)
+	bool MpegTsDepacketizer::ParsePes(const MpegTsPacket &packet)
 	{
 		// First packet of pes, it has pes header
-		if(packet->PayloadUnitStartIndicator())
+		if(packet.PayloadUnitStartIndicator())
 		{
 			// If there is previous PES, that is completed
-			auto prev_pes = GetPesDraft(packet->PacketIdentifier());
+			auto prev_pes = GetPesDraft(packet.PacketIdentifier());
 			if(prev_pes != nullptr)
 			{
 				CompletePes(prev_pes);
 			}
 
-			auto pes = std::make_shared<Pes>(packet->PacketIdentifier());
-			auto consumed_length = pes->AppendData(packet->Payload(), packet->PayloadLength());
-			if(consumed_length != packet->PayloadLength())
+			// Reserve the buffer as much as the previous PES to avoid reallocation while assembling
+			size_t capacity = 0;
+			auto length_it = _pes_length_map.find(packet.PacketIdentifier());
+			if(length_it != _pes_length_map.end())
+			{
+				capacity = length_it->second;
+			}
+
+			auto pes = std::make_shared<Pes>(packet.PacketIdentifier(), capacity);
+			auto consumed_length = pes->AppendData(packet.Payload(), packet.PayloadLength());
+			if(consumed_length != packet.PayloadLength())
 			{
 				logte("Something wrong with parsing PES");
 				return false;
@@ -338,17 +434,17 @@ namespace mpegts
 		}
 		else
 		{
-			auto pes = GetPesDraft(packet->PacketIdentifier());
+			auto pes = GetPesDraft(packet.PacketIdentifier());
 			if(pes == nullptr)
 			{
 				// This can be called if the encoder sends faster than the server starts. 
 				// These packets can be ignored. 
-				logtd("Could not find the pes draft (PID: %d)", packet->PacketIdentifier());
+				logtd("Could not find the pes draft (PID: %d)", packet.PacketIdentifier());
 				return false;
 			}
 
-			auto consumed_length = pes->AppendData(packet->Payload(), packet->PayloadLength());
-			if(consumed_length != packet->PayloadLength())
+			auto consumed_length = pes->AppendData(packet.Payload(), packet.PayloadLength());
+			if(consumed_length != packet.PayloadLength())
 			{
 				logte("Something wrong with parsing PES");
 				return false;
@@ -486,9 +582,14 @@ namespace mpegts
 	{
 		if(pes->SetEndOfData() == false)
 		{
+			std::lock_guard<std::shared_mutex> lock(_pes_draft_map_lock);
+			_pes_draft_map.erase(pes->PID());
+
 			return false;
 		}
 
+		_pes_length_map[pes->PID()] = pes->GetDataLength();
+
 		// there is no media track, extracts it
 		if(_media_tracks.find(pes->PID()) == _media_tracks.end())
 		{
@@ -43,8 +43,10 @@ namespace mpegts
 		MpegTsDepacketizer();
 		~MpegTsDepacketizer();
 
+		// The datagram can contain several packets, and a packet can be split across datagrams
 		bool AddPacket(const std::shared_ptr<const ov::Data> &packet);
 		bool AddPacket(const std::shared_ptr<MpegTsPacket> &packet);
+		bool AddPacket(const MpegTsPacket &packet);
 
 		bool IsTrackInfoAvailable();
 		bool IsESAvailable();
@@ -57,10 +59,15 @@ namespace mpegts
 		const std::shared_ptr<Pes> PopES();
 
 	private:
-		PacketType GetPacketType(const std::shared_ptr<MpegTsPacket> &packet);
+		// Parses a packet of MPEGTS_MIN_PACKET_SIZE bytes in place
+		bool ParsePacket(const uint8_t *buffer);
+		// Returns the length of the data to skip until the next sync byte
+		size_t FindSyncByte(const uint8_t *data, size_t length);
 
-		bool ParseSection(const std::shared_ptr<MpegTsPacket> &packet);
-		bool ParsePes(const std::shared_ptr<MpegTsPacket> &packet);
+		PacketType GetPacketType(const MpegTsPacket &packet);
+
+		bool ParseSection(const MpegTsPacket &packet);
+		bool ParsePes(const MpegTsPacket &packet);
 		
 		const std::shared_ptr<Section> GetSectionDraft(uint16_t pid);	
 		// incompleted section will be inserted
@@ -85,6 +92,8 @@ namespace mpegts
 		// there is only one pes saved per pid
 		std::shared_mutex _pes_draft_map_lock;
 		std::map<uint16_t, std::shared_ptr<Pes>> _pes_draft_map;
+		// PID : Length of the last PES, it is used to reserve the buffer of the next PES
+		std::map<uint16_t, size_t> _pes_length_map;
 
 		// PID : Last continuity counter
 		std::map<uint16_t, uint8_t> _last_continuity_counter_map;
@@ -118,6 +127,8 @@ namespace mpegts
 		// PES's PID comes from PMT/ES_INFO
 		std::map<uint16_t, PacketType>	_packet_type_table;
 
-		std::shared_ptr<ov::Data> _buffer = std::make_shared<ov::Data>();
+		// A packet which is split across datagrams is assembled here, other packets are parsed in place
+		uint8_t _partial_packet[MPEGTS_MIN_PACKET_SIZE];
+		size_t _partial_packet_length = 0;
 	};
 }
\ No newline at end of file
@@ -17,11 +17,12 @@ namespace mpegts
 {
 	MpegTsPacket::MpegTsPacket()
 	{
-		_data = std::make_shared<ov::Data>(MPEGTS_MIN_PACKET_SIZE);
-		_buffer = _data->GetWritableDataAs<uint8_t>();
+		auto data = std::make_shared<ov::Data>(MPEGTS_MIN_PACKET_SIZE);
+		_buffer = data->GetWritableDataAs<uint8_t>();
+		_data = data;
 	}
 
-	MpegTsPacket::MpegTsPacket(const std::shared_ptr<ov::Data> &data)
+	MpegTsPacket::MpegTsPacket(const std::shared_ptr<const ov::Data> &data)
 	{
 		if(data->GetLength() < MPEGTS_MIN_PACKET_SIZE)
 		{
@@ -29,7 +30,12 @@ namespace mpegts
 		}
 
 		_data = data;
-		_buffer = _data->GetWritableDataAs<uint8_t>();
+		_buffer = _data->GetDataAs<uint8_t>();
+	}
+
+	MpegTsPacket::MpegTsPacket(const uint8_t *buffer)
+	{
+		_buffer = buffer;
 	}
 
 	MpegTsPacket::~MpegTsPacket()
@@ -38,37 +44,37 @@ namespace mpegts
 	}
 
 	// Getter
-	uint8_t MpegTsPacket::SyncByte()
+	uint8_t MpegTsPacket::SyncByte() const
 	{
 		return _sync_byte;
 	}
 
-	bool MpegTsPacket::TransportErrorIndicator()
+	bool MpegTsPacket::TransportErrorIndicator() const
 	{
 		return _transport_error_indicator;
 	}
 
-	bool MpegTsPacket::PayloadUnitStartIndicator()
+	bool MpegTsPacket::PayloadUnitStartIndicator() const
 	{
 		return _payload_unit_start_indicator;
 	}
 
-	uint16_t MpegTsPacket::PacketIdentifier()
+	uint16_t MpegTsPacket::PacketIdentifier() const
 	{
 		return _packet_identifier;
 	}
 
-	uint8_t MpegTsPacket::TransportScramblingControl()
+	uint8_t MpegTsPacket::TransportScramblingControl() const
 	{
 		return _transport_scrambling_control;
 	}
 
-	uint8_t MpegTsPacket::AdaptationFieldControl()
+	uint8_t MpegTsPacket::AdaptationFieldControl() const
 	{
 		return _adaptation_field_control;
 	}
 
-	bool MpegTsPacket::HasAdaptationField()
+	bool MpegTsPacket::HasAdaptationField() const
 	{
 		// 01: No adaptation_field, payload only
 		// 10: Adaptation_field only, no payload
@@ -76,7 +82,7 @@ namespace mpegts
 		return OV_GET_BIT(_adaptation_field_control, 1);
 	}
 	
-	bool MpegTsPacket::HasPayload()
+	bool MpegTsPacket::HasPayload() const
 	{
 		// 01: No adaptation_field, payload only
 		// 10: Adaptation_field only, no payload
@@ -84,22 +90,22 @@ namespace mpegts
 		return OV_GET_BIT(_adaptation_field_control, 0);
 	}
 
-	uint8_t MpegTsPacket::ContinuityCounter()
+	uint8_t MpegTsPacket::ContinuityCounter() const
 	{
 		return _continuity_counter;
 	}
 
-	const AdaptationField& MpegTsPacket::GetAdaptationField()
+	const AdaptationField& MpegTsPacket::GetAdaptationField() const
 	{
 		return _adaptation_field;
 	}
 
-	const uint8_t* MpegTsPacket::Payload()
+	const uint8_t* MpegTsPacket::Payload() const
 	{
 		return _payload;
 	}
 
-	size_t MpegTsPacket::PayloadLength()
+	size_t MpegTsPacket::PayloadLength() const
 	{
 		return _payload_length;
 	}
@@ -107,91 +113,104 @@ namespace mpegts
 	uint32_t MpegTsPacket::Parse()
 	{
 		// already parsed
-		if(_ts_parser != nullptr)
+		if(_parsed == true)
 		{
 			return 0;
 		}
 
 		// this time, ome only supports for 188 bytes mpegts packet
-		if(_data->GetLength() < MPEGTS_MIN_PACKET_SIZE)
+		if(_buffer == nullptr)
 		{
 			return 0;
 		}
 
-		_ts_parser = std::make_shared<BitReader>(_buffer, _data->GetLength());
+		_parsed = true;
 
+		// The fixed header is read directly from the buffer, it is parsed for every packet
 		//  76543210  76543210  76543210  76543210
 		// [ssssssss][tpTPPPPP][PPPPPPPP][SSaacccc]...
 
-		_sync_byte = _ts_parser->ReadBytes<uint8_t>();
-		_transport_error_indicator = _ts_parser->ReadBoolBit();
+		_sync_byte = _buffer[0];
+		_transport_error_indicator = OV_GET_BIT(_buffer[1], 7);
 		if(_transport_error_indicator)
 		{
 			// error
 			return 0;	
 		}
 
-		_payload_unit_start_indicator = _ts_parser->ReadBoolBit();
-		_transport_priority = _ts_parser->ReadBit();
-		_packet_identifier = _ts_parser->ReadBits<uint16_t>(13);
-		_transport_scrambling_control = _ts_parser->ReadBits<uint8_t>(2);
-		_adaptation_field_control = _ts_parser->ReadBits<uint8_t>(2);
-		_continuity_counter = _ts_parser->ReadBits<uint8_t>(4);
+		_payload_unit_start_indicator = OV_GET_BIT(_buffer[1], 6);
+		_transport_priority = OV_GET_BIT(_buffer[1], 5);
+		_packet_identifier = ((_buffer[1] & 0x1F) << 8) | _buffer[2];
+		_transport_scrambling_control = (_buffer[3] >> 6) & 0x03;
+		_adaptation_field_control = (_buffer[3] >> 4) & 0x03;
+		_continuity_counter = _buffer[3] & 0x0F;
+
+		size_t header_length = 4;
 		
 		if(HasAdaptationField())
 		{
-			if(ParseAdaptationHeader() == false)
+			BitReader parser(_buffer + header_length, _packet_size - header_length);
+
+			if(ParseAdaptationHeader(&parser) == false)
 			{
 				logte("Could not parse adaptation header");
 				return 0;
 			}
+
+			header_length += parser.BytesConsumed();
 		}
 
 		if(HasPayload())
 		{
-			ParsePayload();
+			ParsePayload(header_length);
 		}
 		
 		// Now, it must be 188 bytes
-		return _ts_parser->BytesConsumed();
+		return _packet_size;
 	}
 
-	bool MpegTsPacket::ParseAdaptationHeader()
+	bool MpegTsPacket::ParseAdaptationHeader(BitReader *parser)
 	{
-		_adaptation_field._length = _ts_parser->ReadBytes<uint8_t>();
+		_adaptation_field._length = parser->ReadBytes<uint8_t>();
+
+		// The adaptation field cannot exceed the packet (188 - 4 (header) - 1 (adaptation field length))
+		if(_adaptation_field._length > _packet_size - 5)
+		{
+			return false;
+		}
 		
-		_ts_parser->StartSection();
+		parser->StartSection();
 
 		if(_adaptation_field._length > 0)
 		{
-			_adaptation_field._discontinuity_indicator = _ts_parser->ReadBoolBit();
-			_adaptation_field._random_access_indicator = _ts_parser->ReadBoolBit();
-			_adaptation_field._elementary_stream_priority_indicator = _ts_parser->ReadBoolBit();
+			_adaptation_field._discontinuity_indicator = parser->ReadBoolBit();
+			_adaptation_field._random_access_indicator = parser->ReadBoolBit();
+			_adaptation_field._elementary_stream_priority_indicator = parser->ReadBoolBit();
 
 			// 5 flags
-			_adaptation_field._pcr_flag = _ts_parser->ReadBoolBit();
-			_adaptation_field._opcr_flag = _ts_parser->ReadBoolBit();
-			_adaptation_field._splicing_point_flag = _ts_parser->ReadBoolBit();
-			_adaptation_field._transport_private_data_flag = _ts_parser->ReadBoolBit();
-			_adaptation_field._adaptation_field_extension_flag = _ts_parser->ReadBoolBit();
+			_adaptation_field._pcr_flag = parser->ReadBoolBit();
+			_adaptation_field._opcr_flag = parser->ReadBoolBit();
+			_adaptation_field._splicing_point_flag = parser->ReadBoolBit();
+			_adaptation_field._transport_private_data_flag = parser->ReadBoolBit();
+			_adaptation_field._adaptation_field_extension_flag = parser->ReadBoolBit();
 
 			// Need to parse pcr, opcr, splicing_point_flag, _transport_private_data_flag, _adaptation_field_extension_flag
 			if(_adaptation_field._pcr_flag == true)
 			{
-				_adaptation_field._pcr._base = _ts_parser->ReadBits<uint64_t>(33);
-				_adaptation_field._pcr._reserved = _ts_parser->ReadBits<uint8_t>(6);
-				_adaptation_field._pcr._extension = _ts_parser->ReadBits<uint16_t>(9);
+				_adaptation_field._pcr._base = parser->ReadBits<uint64_t>(33);
+				_adaptation_field._pcr._reserved = parser->ReadBits<uint8_t>(6);
+				_adaptation_field._pcr._extension = parser->ReadBits<uint16_t>(9);
 			}
 
 			if(_adaptation_field._opcr_flag == true)
 			{
 				// We don't use it now, skip for splicing point flag
-				_ts_parser->SkipBytes(6);
+				parser->SkipBytes(6);
 			}
 
 			if(_adaptation_field._splicing_point_flag == true)
 			{
-				_adaptation_field._splice_countdown = _ts_parser->ReadBytes<uint8_t>();
+				_adaptation_field._splice_countdown = parser->ReadBytes<uint8_t>();
 			}
 
 			if(_adaptation_field._transport_private_data_flag)
@@ -206,17 +225,17 @@ namespace mpegts
 		}	
 		
 		// It may contain 
-		auto skip_bytes = _adaptation_field._length - _ts_parser->BytesSetionConsumed();
+		auto skip_bytes = _adaptation_field._length - parser->BytesSetionConsumed();
 
-		return _ts_parser->SkipBytes(skip_bytes);
+		return parser->SkipBytes(skip_bytes);
 	}
 
-	bool MpegTsPacket::ParsePayload()
+	bool MpegTsPacket::ParsePayload(size_t header_length)
 	{
-		_payload = _ts_parser->CurrentPosition();
-		_payload_length = _packet_size - _ts_parser->BytesConsumed();
+		// The payload refers to the buffer
+		_payload = _buffer + header_length;
+		_payload_length = _packet_size - header_length;
 		
-		// Just skip A packet
-		return _ts_parser->SkipBytes(_payload_length);
+		return true;
 	}
-}
\ No newline at end of file
+}
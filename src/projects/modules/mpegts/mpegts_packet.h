@@ -152,7 +152,10 @@ namespace mpegts
 	{
 	public:
 		MpegTsPacket();
-		MpegTsPacket(const std::shared_ptr<ov::Data> &data);
+		MpegTsPacket(const std::shared_ptr<const ov::Data> &data);
+		// The packet refers to the buffer without copying, so buffer must be valid while the packet is used
+		// (buffer must have at least MPEGTS_MIN_PACKET_SIZE bytes)
+		MpegTsPacket(const uint8_t *buffer);
 		virtual ~MpegTsPacket();
 
 		//Note: Now, it only supports 188 bytes of mpegts packet
@@ -161,20 +164,20 @@ namespace mpegts
 		uint32_t Parse();
 
 		// Getter
-		uint8_t SyncByte();
-		bool TransportErrorIndicator();
-		bool PayloadUnitStartIndicator();
-		uint16_t PacketIdentifier();
-		uint8_t TransportScramblingControl();
-		uint8_t AdaptationFieldControl();
-		bool HasAdaptationField();
-		bool HasPayload();
-		uint8_t ContinuityCounter();
+		uint8_t SyncByte() const;
+		bool TransportErrorIndicator() const;
+		bool PayloadUnitStartIndicator() const;
+		uint16_t PacketIdentifier() const;
+		uint8_t TransportScramblingControl() const;
+		uint8_t AdaptationFieldControl() const;
+		bool HasAdaptationField() const;
+		bool HasPayload() const;
+		uint8_t ContinuityCounter() const;
 
-		const AdaptationField &GetAdaptationField();
+		const AdaptationField &GetAdaptationField() const;
 
-		const uint8_t* Payload();
-		size_t PayloadLength();
+		const uint8_t* Payload() const;
+		size_t PayloadLength() const;
 
 	private:
 		uint8_t _packet_size = MPEGTS_MIN_PACKET_SIZE;	// at this time, it only supports for 188 bytes packet
@@ -208,13 +211,14 @@ namespace mpegts
 
 		AdaptationField	_adaptation_field;
 
-		std::shared_ptr<BitReader>	_ts_parser = nullptr;
+		bool						_parsed = false;
 		const uint8_t *				_buffer = nullptr;
 		const uint8_t *				_payload = nullptr;
 		size_t						_payload_length = 0;
-		std::shared_ptr<ov::Data>	_data = nullptr;
+		// Keeps the buffer alive when the packet is created from ov::Data
+		std::shared_ptr<const ov::Data>	_data = nullptr;
 
-		bool ParseAdaptationHeader();
-		bool ParsePayload();
+		bool ParseAdaptationHeader(BitReader *parser);
+		bool ParsePayload(size_t header_length);
 	};
 }
@@ -0,0 +1,769 @@
+//==============================================================================
+//
+//  MPEGTS Packetizer
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "mpegts_packetizer.h"
+
+#include <base/ovlibrary/crc.h>
+#include <modules/bitstream/h264/h264_converter.h>
+#include <modules/bitstream/h264/h264_decoder_configuration_record.h>
+#include <modules/bitstream/nalu/nal_unit_scanner.h>
+
+#include "mpegts_pes.h"
+#include "mpegts_section.h"
+
+#define OV_LOG_TAG "MpegTsPacketizer"
+
+#define MPEGTS_PACKET_HEADER_SIZE 4
+#define MPEGTS_PACKET_PAYLOAD_SIZE (MPEGTS_MIN_PACKET_SIZE - MPEGTS_PACKET_HEADER_SIZE)
+
+#define MPEGTS_PMT_PID 0x1000
+#define MPEGTS_FIRST_ES_PID 0x0100
+#define MPEGTS_PROGRAM_NUMBER 1
+#define MPEGTS_TRANSPORT_STREAM_ID 1
+
+#define MPEGTS_VIDEO_STREAM_ID 0xE0
+#define MPEGTS_AUDIO_STREAM_ID 0xC0
+#define MPEGTS_MP3_STREAM_TYPE 0x03
+
+// Same as FFmpeg (max_delay: 0.7s) - PTS/DTS are shifted by (2 * max_delay), and PCR precedes DTS by max_delay
+#define MPEGTS_MAX_DELAY (90000 * 7 / 10)
+#define MPEGTS_TIMESTAMP_OFFSET (MPEGTS_MAX_DELAY * 2)
+#define MPEGTS_TIMESTAMP_MASK ((1LL << 33) - 1)
+
+// Same as the default pes_payload_size of FFmpeg
+#define MPEGTS_AUDIO_PES_PAYLOAD_SIZE 2930
+
+// (PES header: 6) + (optional header: 3) + (PTS: 5) + (DTS: 5)
+#define MPEGTS_MAX_PES_HEADER_SIZE (MPEGTS_PES_HEADER_SIZE + MPEGTS_MIN_PES_OPTIONAL_HEADER_SIZE + 10)
+
+// Access unit delimiters which are inserted if the access unit doesn't start with it
+static constexpr uint8_t H264_AUD[] = {0x00, 0x00, 0x00, 0x01, 0x09, 0xF0};
+static constexpr uint8_t H265_AUD[] = {0x00, 0x00, 0x00, 0x01, 0x46, 0x01, 0x50};
+
+namespace mpegts
+{
+	// Returns the pointer to the first NAL unit header (after the start code)
+	static const uint8_t *FindFirstNalUnit(const uint8_t *data, size_t length)
+	{
+		if ((length >= 4) && (data[0] == 0x00) && (data[1] == 0x00) && (data[2] == 0x00) && (data[3] == 0x01))
+		{
+			return (length > 4) ? (data + 4) : nullptr;
+		}
+
+		if ((length >= 3) && (data[0] == 0x00) && (data[1] == 0x00) && (data[2] == 0x01))
+		{
+			return (length > 3) ? (data + 3) : nullptr;
+		}
+
+		return nullptr;
+	}
+
+	static bool HasH264Sps(const uint8_t *data, size_t length)
+	{
+		// Find the SPS (nal_unit_type: 7) before the first slice
+		for (size_t index = 0; (index + 3) < length; index++)
+		{
+			if ((data[index] == 0x00) && (data[index + 1] == 0x00) && (data[index + 2] == 0x01))
+			{
+				auto nal_unit_type = data[index + 3] & 0x1F;
+
+				if (nal_unit_type == 7)
+				{
+					return true;
+				}
+
+				if ((nal_unit_type >= 1) && (nal_unit_type <= 5))
+				{
+					return false;
+				}
+
+				index += 2;
+			}
+		}
+
+		return false;
+	}
+
+	static inline uint8_t *WriteTimestamp(uint8_t *buffer, uint8_t prefix, int64_t timestamp)
+	{
+		timestamp &= MPEGTS_TIMESTAMP_MASK;
+
+		// prefix (4 bits) + timestamp[32..30] (3 bits) + marker (1 bit)
+		buffer[0] = static_cast<uint8_t>((prefix << 4) | (((timestamp >> 30) & 0x07) << 1) | 0x01);
+		// timestamp[29..15] (15 bits) + marker (1 bit)
+		buffer[1] = static_cast<uint8_t>(timestamp >> 22);
+		buffer[2] = static_cast<uint8_t>((((timestamp >> 15) & 0x7F) << 1) | 0x01);
+		// timestamp[14..0] (15 bits) + marker (1 bit)
+		buffer[3] = static_cast<uint8_t>(timestamp >> 7);
+		buffer[4] = static_cast<uint8_t>(((timestamp & 0x7F) << 1) | 0x01);
+
+		return buffer + 5;
+	}
+
+	MpegTsPacketizer::MpegTsPacketizer()
+	{
+		// The first packet of each PID has the continuity counter 0
+		_pat_continuity_counter = 0x0F;
+		_pmt_continuity_counter = 0x0F;
+	}
+
+	bool MpegTsPacketizer::AddTrack(const std::shared_ptr<const MediaTrack> &media_track)
+	{
+		if (media_track == nullptr)
+		{
+			return false;
+		}
+
+		auto track = std::make_shared<Track>();
+
+		track->media_track = media_track;
+		track->pid = static_cast<uint16_t>(MPEGTS_FIRST_ES_PID + _track_list.size());
+		track->continuity_counter = 0x0F;
+
+		switch (media_track->GetCodecId())
+		{
+			case cmn::MediaCodecId::H264:
+				track->stream_type = static_cast<uint8_t>(WellKnownStreamTypes::H264);
+				track->stream_id = MPEGTS_VIDEO_STREAM_ID;
+				break;
+
+			case cmn::MediaCodecId::H265:
+				track->stream_type = static_cast<uint8_t>(WellKnownStreamTypes::H265);
+				track->stream_id = MPEGTS_VIDEO_STREAM_ID;
+				break;
+
+			case cmn::MediaCodecId::Aac:
+				track->stream_type = static_cast<uint8_t>(WellKnownStreamTypes::AAC);
+				track->stream_id = MPEGTS_AUDIO_STREAM_ID;
+				break;
+
+			case cmn::MediaCodecId::Mp3:
+				track->stream_type = MPEGTS_MP3_STREAM_TYPE;
+				track->stream_id = MPEGTS_AUDIO_STREAM_ID;
+				break;
+
+			default:
+				logte("Not supported codec: %s", ::StringFromMediaCodecId(media_track->GetCodecId()).CStr());
+				return false;
+		}
+
+		if (media_track->GetTimeBase().GetDen() == 0)
+		{
+			logte("Invalid timebase: %s", media_track->GetTimeBase().ToString().CStr());
+			return false;
+		}
+
+		// PCR is carried by the first video track (or the first track if there is no video track)
+		if ((_pcr_track == nullptr) ||
+			((media_track->GetMediaType() == cmn::MediaType::Video) && (_pcr_track->media_track->GetMediaType() != cmn::MediaType::Video)))
+		{
+			_pcr_track = track;
+		}
+
+		_track_list.push_back(track);
+		_track_map[media_track->GetId()] = track;
+
+		logtd("Track %s (PID: 0x%04X) is added", ::StringFromMediaType(media_track->GetMediaType()).CStr(), track->pid);
+
+		return true;
+	}
+
+	std::shared_ptr<MpegTsPacketizer::Track> MpegTsPacketizer::GetTrack(uint32_t track_id) const
+	{
+		auto item = _track_map.find(track_id);
+
+		return (item != _track_map.end()) ? item->second : nullptr;
+	}
+
+	int64_t MpegTsPacketizer::ConvertTo90kHz(const std::shared_ptr<Track> &track, int64_t timestamp) const
+	{
+		auto &timebase = track->media_track->GetTimeBase();
+
+		return timestamp * 90000LL * timebase.GetNum() / timebase.GetDen();
+	}
+
+	uint8_t *MpegTsPacketizer::AllocPacket()
+	{
+		auto offset = _data->GetLength();
+		auto new_length = offset + MPEGTS_MIN_PACKET_SIZE;
+
+		if (new_length > _data->GetCapacity())
+		{
+			// Grow exponentially (Reserve() allocates the exact size)
+			_data->Reserve(std::max(new_length, _data->GetCapacity() * 2));
+		}
+
+		_data->SetLength(new_length);
+
+		return _data->GetWritableDataAs<uint8_t>() + offset;
+	}
+
+	void MpegTsPacketizer::PrepareSegmentIfNeeded()
+	{
+		if (_data != nullptr)
+		{
+			return;
+		}
+
+		// Reserve the buffer as large as the previous segment to avoid reallocation
+		auto capacity = std::max<size_t>(_last_segment_length + (_last_segment_length / 8), MPEGTS_MIN_PACKET_SIZE * 64);
+		_data = std::make_shared<ov::Data>(capacity, true);
+
+		// GetFirstPts()/GetDuration() returns the values of the last segment until the next segment starts
+		for (auto &track : _track_list)
+		{
+			track->first_pts = -1LL;
+			track->duration = 0LL;
+		}
+
+		WriteTables();
+	}
+
+	void MpegTsPacketizer::WriteSection(uint16_t pid, uint8_t *continuity_counter, const uint8_t *section, size_t section_length)
+	{
+		// Sections written by this packetizer always fit in a packet
+		OV_ASSERT2((section_length + 1) <= MPEGTS_PACKET_PAYLOAD_SIZE);
+
+		auto packet = AllocPacket();
+
+		*continuity_counter = (*continuity_counter + 1) & 0x0F;
+
+		packet[0] = MPEGTS_SYNC_BYTE;
+		// payload_unit_start_indicator: 1
+		packet[1] = static_cast<uint8_t>(0x40 | ((pid >> 8) & 0x1F));
+		packet[2] = static_cast<uint8_t>(pid & 0xFF);
+		// adaptation_field_control: payload only
+		packet[3] = static_cast<uint8_t>(0x10 | *continuity_counter);
+		// pointer_field
+		packet[4] = 0x00;
+
+		::memcpy(packet + 5, section, section_length);
+		::memset(packet + 5 + section_length, 0xFF, MPEGTS_PACKET_PAYLOAD_SIZE - 1 - section_length);
+	}
+
+	void MpegTsPacketizer::WriteTables()
+	{
+		uint8_t section[MPEGTS_PACKET_PAYLOAD_SIZE];
+		uint8_t *current;
+
+		auto write_section_header = [&](uint8_t table_id, uint16_t table_id_extension) {
+			current = section;
+
+			*current++ = table_id;
+			// section_syntax_indicator (1) + '0' + reserved (2) + section_length (12, filled later)
+			*current++ = 0xB0;
+			*current++ = 0x00;
+			*current++ = static_cast<uint8_t>(table_id_extension >> 8);
+			*current++ = static_cast<uint8_t>(table_id_extension & 0xFF);
+			// reserved (2) + version_number (5): 0 + current_next_indicator (1): 1
+			*current++ = 0xC1;
+			// section_number, last_section_number
+			*current++ = 0x00;
+			*current++ = 0x00;
+		};
+
+		auto complete_section = [&]() -> size_t {
+			// section_length: from after the section_length field to the end of CRC
+			auto section_length = (current - section) - MPEGTS_TABLE_HEADER_SIZE + 4;
+			section[1] |= static_cast<uint8_t>((section_length >> 8) & 0x0F);
+			section[2] = static_cast<uint8_t>(section_length & 0xFF);
+
+			auto crc = ov::CRC::Crc32Mpeg2(section, current - section);
+			*current++ = static_cast<uint8_t>(crc >> 24);
+			*current++ = static_cast<uint8_t>(crc >> 16);
+			*current++ = static_cast<uint8_t>(crc >> 8);
+			*current++ = static_cast<uint8_t>(crc);
+
+			return current - section;
+		};
+
+		// PAT
+		write_section_header(static_cast<uint8_t>(WellKnownTableId::PROGRAM_ASSOCIATION_SECTION), MPEGTS_TRANSPORT_STREAM_ID);
+		*current++ = static_cast<uint8_t>(MPEGTS_PROGRAM_NUMBER >> 8);
+		*current++ = static_cast<uint8_t>(MPEGTS_PROGRAM_NUMBER & 0xFF);
+		*current++ = static_cast<uint8_t>(0xE0 | ((MPEGTS_PMT_PID >> 8) & 0x1F));
+		*current++ = static_cast<uint8_t>(MPEGTS_PMT_PID & 0xFF);
+		WriteSection(static_cast<uint16_t>(WellKnownPacketId::PAT), &_pat_continuity_counter, section, complete_section());
+
+		// PMT
+		auto pcr_pid = (_pcr_track != nullptr) ? _pcr_track->pid : static_cast<uint16_t>(WellKnownPacketId::NULL_PACKET);
+		write_section_header(static_cast<uint8_t>(WellKnownTableId::PROGRAM_MAP_SECTION), MPEGTS_PROGRAM_NUMBER);
+		*current++ = static_cast<uint8_t>(0xE0 | ((pcr_pid >> 8) & 0x1F));
+		*current++ = static_cast<uint8_t>(pcr_pid & 0xFF);
+		// reserved (4) + program_info_length (12): 0
+		*current++ = 0xF0;
+		*current++ = 0x00;
+
+		for (auto &track : _track_list)
+		{
+			*current++ = track->stream_type;
+			*current++ = static_cast<uint8_t>(0xE0 | ((track->pid >> 8) & 0x1F));
+			*current++ = static_cast<uint8_t>(track->pid & 0xFF);
+			// reserved (4) + ES_info_length (12): 0
+			*current++ = 0xF0;
+			*current++ = 0x00;
+		}
+
+		WriteSection(MPEGTS_PMT_PID, &_pmt_continuity_counter, section, complete_section());
+	}
+
+	void MpegTsPacketizer::WritePes(const std::shared_ptr<Track> &track, int64_t pts, int64_t dts, bool is_key_frame, const Fragment *fragment_list, size_t fragment_count)
+	{
+		// Make the PES header
+		uint8_t pes_header[MPEGTS_MAX_PES_HEADER_SIZE];
+		uint8_t *current = pes_header;
+		bool has_dts = (pts != dts);
+		bool is_video = (track->stream_id == MPEGTS_VIDEO_STREAM_ID);
+
+		size_t payload_length = 0;
+		for (size_t index = 0; index < fragment_count; index++)
+		{
+			payload_length += fragment_list[index].length;
+		}
+
+		*current++ = 0x00;
+		*current++ = 0x00;
+		*current++ = 0x01;
+		*current++ = track->stream_id;
+
+		// PES_packet_length: 0 (unbounded) is allowed only for video
+		size_t pes_packet_length = MPEGTS_MIN_PES_OPTIONAL_HEADER_SIZE + (has_dts ? 10 : 5) + payload_length;
+		pes_packet_length = (is_video || (pes_packet_length > 0xFFFF)) ? 0 : pes_packet_length;
+		*current++ = static_cast<uint8_t>(pes_packet_length >> 8);
+		*current++ = static_cast<uint8_t>(pes_packet_length & 0xFF);
+
+		// '10' + PES_scrambling_control (2) + PES_priority (1) + data_alignment_indicator (1) + copyright (1) + original_or_copy (1)
+		*current++ = is_video ? 0x84 : 0x80;
+		// PTS_DTS_flags (2) + other flags (6)
+		*current++ = has_dts ? 0xC0 : 0x80;
+		// PES_header_data_length
+		*current++ = has_dts ? 10 : 5;
+
+		current = WriteTimestamp(current, has_dts ? 0x03 : 0x02, pts);
+
+		if (has_dts)
+		{
+			current = WriteTimestamp(current, 0x01, dts);
+		}
+
+		// Split the PES into the TS packets
+		size_t pes_header_length = current - pes_header;
+		size_t remained = pes_header_length + payload_length;
+		size_t pes_header_offset = 0;
+		size_t fragment_index = 0;
+		size_t fragment_offset = 0;
+		bool is_first_packet = true;
+
+		while (remained > 0)
+		{
+			auto packet = AllocPacket();
+			uint8_t *payload = packet + MPEGTS_PACKET_HEADER_SIZE;
+
+			track->continuity_counter = (track->continuity_counter + 1) & 0x0F;
+
+			packet[0] = MPEGTS_SYNC_BYTE;
+			packet[1] = static_cast<uint8_t>((is_first_packet ? 0x40 : 0x00) | ((track->pid >> 8) & 0x1F));
+			packet[2] = static_cast<uint8_t>(track->pid & 0xFF);
+
+			// Adaptation field
+			bool write_pcr = is_first_packet && (track == _pcr_track);
+			bool random_access = is_first_packet && is_key_frame;
+			size_t adaptation_field_length = 0;
+
+			if (write_pcr || random_access)
+			{
+				// adaptation_field_length (1) + flags (1) + PCR (6)
+				adaptation_field_length = 2 + (write_pcr ? 6 : 0);
+			}
+
+			size_t payload_length_of_packet = std::min(remained, MPEGTS_PACKET_PAYLOAD_SIZE - adaptation_field_length);
+			size_t stuffing_length = MPEGTS_PACKET_PAYLOAD_SIZE - adaptation_field_length - payload_length_of_packet;
+
+			if ((adaptation_field_length > 0) || (stuffing_length > 0))
+			{
+				auto adaptation_field = payload;
+
+				if (adaptation_field_length == 0)
+				{
+					// Only stuffing bytes (If stuffing_length is 1, there is only the adaptation_field_length field)
+					adaptation_field_length = std::min<size_t>(stuffing_length, 2);
+					stuffing_length -= adaptation_field_length;
+				}
+
+				payload += adaptation_field_length;
+
+				if (adaptation_field_length > 1)
+				{
+					uint8_t flags = 0x00;
+					uint8_t *field = adaptation_field + 2;
+
+					if (random_access)
+					{
+						// random_access_indicator
+						flags |= 0x40;
+					}
+
+					if (write_pcr)
+					{
+						// PCR_flag
+						flags |= 0x10;
+
+						// program_clock_reference_base (33) + reserved (6) + program_clock_reference_extension (9): 0
+						int64_t pcr_base = (dts - MPEGTS_MAX_DELAY) & MPEGTS_TIMESTAMP_MASK;
+						field[0] = static_cast<uint8_t>(pcr_base >> 25);
+						field[1] = static_cast<uint8_t>(pcr_base >> 17);
+						field[2] = static_cast<uint8_t>(pcr_base >> 9);
+						field[3] = static_cast<uint8_t>(pcr_base >> 1);
+						field[4] = static_cast<uint8_t>(((pcr_base & 0x01) << 7) | 0x7E);
+						field[5] = 0x00;
+					}
+
+					adaptation_field[1] = flags;
+				}
+
+				if (stuffing_length > 0)
+				{
+					::memset(payload, 0xFF, stuffing_length);
+					payload += stuffing_length;
+					adaptation_field_length += stuffing_length;
+				}
+
+				adaptation_field[0] = static_cast<uint8_t>(adaptation_field_length - 1);
+
+				// adaptation_field_control: adaptation field + payload
+				packet[3] = static_cast<uint8_t>(0x30 | track->continuity_counter);
+			}
+			else
+			{
+				// adaptation_field_control: payload only
+				packet[3] = static_cast<uint8_t>(0x10 | track->continuity_counter);
+			}
+
+			// Copy the PES header and the payload into the packet
+			size_t to_copy = payload_length_of_packet;
+
+			if (pes_header_offset < pes_header_length)
+			{
+				auto length = std::min(to_copy, pes_header_length - pes_header_offset);
+				::memcpy(payload, pes_header + pes_header_offset, length);
+
+				payload += length;
+				to_copy -= length;
+				pes_header_offset += length;
+			}
+
+			while (to_copy > 0)
+			{
+				auto &fragment = fragment_list[fragment_index];
+				auto length = std::min(to_copy, fragment.length - fragment_offset);
+
+				::memcpy(payload, fragment.data + fragment_offset, length);
+
+				payload += length;
+				to_copy -= length;
+				fragment_offset += length;
+
+				if (fragment_offset == fragment.length)
+				{
+					fragment_index++;
+					fragment_offset = 0;
+				}
+			}
+
+			remained -= payload_length_of_packet;
+			is_first_packet = false;
+		}
+	}
+
+	bool MpegTsPacketizer::WriteVideoPacket(const std::shared_ptr<Track> &track, const std::shared_ptr<const MediaPacket> &packet)
+	{
+		auto data = packet->GetData();
+
+		switch (packet->GetBitstreamFormat())
+		{
+			case cmn::BitstreamFormat::H264_ANNEXB:
+			case cmn::BitstreamFormat::H265_ANNEXB:
+				break;
+
+			case cmn::BitstreamFormat::H264_AVCC:
+				data = H264Converter::ConvertAvccToAnnexb(data);
+				break;
+
+			default:
+				logte("Not supported bitstream format: %d", static_cast<int>(packet->GetBitstreamFormat()));
+				return false;
+		}
+
+		if ((data == nullptr) || (data->GetLength() == 0))
+		{
+			logte("Could not write an empty packet");
+			return false;
+		}
+
+		bool is_key_frame = (packet->GetFlag() == MediaPacketFlag::Key);
+		auto buffer = data->GetDataAs<uint8_t>();
+		auto length = data->GetLength();
+
+		auto nal_unit = FindFirstNalUnit(buffer, length);
+
+		if (nal_unit == nullptr)
+		{
+			logte("Could not find a start code of the NAL unit");
+			return false;
+		}
+
+		Fragment fragment_list[4];
+		size_t fragment_count = 0;
+		// Offset of the data which is not added to fragment_list yet
+		size_t offset = 0;
+
+		// Insert AUD if needed
+		if (track->stream_type == static_cast<uint8_t>(WellKnownStreamTypes::H264))
+		{
+			bool has_aud = ((nal_unit[0] & 0x1F) == 9);
+
+			if (has_aud == false)
+			{
+				fragment_list[fragment_count++] = {H264_AUD, sizeof(H264_AUD)};
+			}
+
+			// Insert SPS/PPS if the IDR frame doesn't have them
+			if (is_key_frame && (HasH264Sps(buffer, length) == false))
+			{
+				auto &codec_extradata = track->media_track->GetCodecExtradata();
+
+				if (track->codec_extradata != codec_extradata)
+				{
+					track->codec_extradata = codec_extradata;
+					track->parameter_sets = nullptr;
+
+					AVCDecoderConfigurationRecord config;
+
+					if ((codec_extradata != nullptr) && AVCDecoderConfigurationRecord::Parse(codec_extradata->GetDataAs<uint8_t>(), codec_extradata->GetLength(), config))
+					{
+						track->parameter_sets = std::get<0>(config.GetSpsPpsAsAnnexB(4));
+					}
+				}
+
+				if (track->parameter_sets != nullptr)
+				{
+					if (has_aud)
+					{
+						// AUD must be the first NAL unit of the access unit, so SPS/PPS are inserted after it
+						size_t start_code_size;
+						auto aud_offset = static_cast<size_t>(nal_unit - buffer);
+						auto next_offset = NalUnitScanner::FindAnnexBStartCode(nal_unit, length - aud_offset, start_code_size);
+
+						offset = (next_offset >= 0) ? (aud_offset + next_offset) : length;
+						fragment_list[fragment_count++] = {buffer, offset};
+					}
+
+					fragment_list[fragment_count++] = {track->parameter_sets->GetDataAs<uint8_t>(), track->parameter_sets->GetLength()};
+				}
+			}
+		}
+		else if (((nal_unit[0] >> 1) & 0x3F) != 35)
+		{
+			fragment_list[fragment_count++] = {H265_AUD, sizeof(H265_AUD)};
+		}
+
+		if (offset < length)
+		{
+			fragment_list[fragment_count++] = {buffer + offset, length - offset};
+		}
+
+		auto pts = ConvertTo90kHz(track, packet->GetPts()) + MPEGTS_TIMESTAMP_OFFSET;
+		auto dts = ConvertTo90kHz(track, packet->GetDts()) + MPEGTS_TIMESTAMP_OFFSET;
+
+		WritePes(track, pts, dts, is_key_frame, fragment_list, fragment_count);
+
+		return true;
+	}
+
+	bool MpegTsPacketizer::WriteAudioPacket(const std::shared_ptr<Track> &track, const std::shared_ptr<const MediaPacket> &packet)
+	{
+		auto &data = packet->GetData();
+
+		if ((data == nullptr) || (data->GetLength() == 0))
+		{
+			logte("Could not write an empty packet");
+			return false;
+		}
+
+		std::array<uint8_t, 7> adts_header{};
+		size_t length = data->GetLength();
+
+		switch (packet->GetBitstreamFormat())
+		{
+			case cmn::BitstreamFormat::AAC_ADTS:
+				break;
+
+			case cmn::BitstreamFormat::AAC_RAW: {
+				if (track->is_aac_config_parsed == false)
+				{
+					auto &codec_extradata = track->media_track->GetCodecExtradata();
+
+					if ((codec_extradata == nullptr) ||
+						(AACSpecificConfig::Parse(codec_extradata->GetDataAs<uint8_t>(), codec_extradata->GetLength(), track->aac_config) == false))
+					{
+						logte("Could not parse the AAC specific config");
+						return false;
+					}
+
+					track->is_aac_config_parsed = true;
+				}
+
+				// Make an ADTS header (protection_absent: 1, adts_buffer_fullness: 0x7FF)
+				auto &config = track->aac_config;
+				auto profile = static_cast<uint8_t>(config.GetAacProfile());
+				auto sampling_frequency = static_cast<uint8_t>(config.SamplingFrequency());
+				auto channel = config.Channel();
+				auto frame_length = length + adts_header.size();
+
+				adts_header[0] = 0xFF;
+				adts_header[1] = 0xF1;
+				adts_header[2] = static_cast<uint8_t>(((profile & 0x03) << 6) | ((sampling_frequency & 0x0F) << 2) | ((channel >> 2) & 0x01));
+				adts_header[3] = static_cast<uint8_t>(((channel & 0x03) << 6) | ((frame_length >> 11) & 0x03));
+				adts_header[4] = static_cast<uint8_t>((frame_length >> 3) & 0xFF);
+				adts_header[5] = static_cast<uint8_t>(((frame_length & 0x07) << 5) | 0x1F);
+				adts_header[6] = 0xFC;
+
+				length += adts_header.size();
+				break;
+			}
+
+			default:
+				// MP3 frames are written as they are
+				if (track->stream_type != MPEGTS_MP3_STREAM_TYPE)
+				{
+					logte("Not supported bitstream format: %d", static_cast<int>(packet->GetBitstreamFormat()));
+					return false;
+				}
+				break;
+		}
+
+		track->pending_packet_list.push_back(packet);
+		track->pending_adts_header_list.push_back(adts_header);
+		track->pending_length += length;
+
+		if (track->pending_length >= MPEGTS_AUDIO_PES_PAYLOAD_SIZE)
+		{
+			FlushAudioPackets(track);
+		}
+
+		return true;
+	}
+
+	void MpegTsPacketizer::FlushAudioPackets(const std::shared_ptr<Track> &track)
+	{
+		auto &packet_list = track->pending_packet_list;
+
+		if (packet_list.empty())
+		{
+			return;
+		}
+
+		std::vector<Fragment> fragment_list;
+		fragment_list.reserve(packet_list.size() * 2);
+
+		for (size_t index = 0; index < packet_list.size(); index++)
+		{
+			auto &packet = packet_list[index];
+			auto &adts_header = track->pending_adts_header_list[index];
+
+			if (packet->GetBitstreamFormat() == cmn::BitstreamFormat::AAC_RAW)
+			{
+				fragment_list.push_back({adts_header.data(), adts_header.size()});
+			}
+
+			fragment_list.push_back({packet->GetData()->GetDataAs<uint8_t>(), packet->GetData()->GetLength()});
+		}
+
+		auto &first_packet = packet_list.front();
+		auto pts = ConvertTo90kHz(track, first_packet->GetPts()) + MPEGTS_TIMESTAMP_OFFSET;
+		auto dts = ConvertTo90kHz(track, first_packet->GetDts()) + MPEGTS_TIMESTAMP_OFFSET;
+
+		WritePes(track, pts, dts, first_packet->GetFlag() == MediaPacketFlag::Key, fragment_list.data(), fragment_list.size());
+
+		packet_list.clear();
+		track->pending_adts_header_list.clear();
+		track->pending_length = 0;
+	}
+
+	bool MpegTsPacketizer::WritePacket(const std::shared_ptr<const MediaPacket> &packet)
+	{
+		auto track = GetTrack(packet->GetTrackId());
+
+		if (track == nullptr)
+		{
+			OV_ASSERT2(false);
+			logtc("Could not find the track: %d (%zu)", packet->GetTrackId(), _track_map.size());
+			return false;
+		}
+
+		PrepareSegmentIfNeeded();
+
+		bool result = (track->stream_id == MPEGTS_VIDEO_STREAM_ID) ? WriteVideoPacket(track, packet) : WriteAudioPacket(track, packet);
+
+		if (result)
+		{
+			if (track->first_pts < 0LL)
+			{
+				track->first_pts = packet->GetPts();
+			}
+
+			track->duration += packet->GetDuration();
+		}
+
+		return result;
+	}
+
+	std::shared_ptr<const ov::Data> MpegTsPacketizer::Finalize()
+	{
+		PrepareSegmentIfNeeded();
+
+		for (auto &track : _track_list)
+		{
+			FlushAudioPackets(track);
+		}
+
+		auto data = std::move(_data);
+		_data = nullptr;
+
+		_last_segment_length = data->GetLength();
+
+		return data;
+	}
+
+	int64_t MpegTsPacketizer::GetFirstPts(uint32_t track_id) const
+	{
+		auto track = GetTrack(track_id);
+
+		return ((track != nullptr) && (track->first_pts >= 0LL)) ? track->first_pts : 0LL;
+	}
+
+	int64_t MpegTsPacketizer::GetFirstPts(cmn::MediaType type) const
+	{
+		for (auto &track : _track_list)
+		{
+			if (track->media_track->GetMediaType() == type)
+			{
+				return std::max<int64_t>(track->first_pts, 0LL);
+			}
+		}
+
+		return 0LL;
+	}
+
+	int64_t MpegTsPacketizer::GetDuration(uint32_t track_id) const
+	{
+		auto track = GetTrack(track_id);
+
+		return (track != nullptr) ? track->duration : 0LL;
+	}
+}  // namespace mpegts
@@ -0,0 +1,119 @@
+//==============================================================================
+//
+//  MPEGTS Packetizer
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/info/media_track.h>
+#include <base/mediarouter/media_buffer.h>
+#include <base/ovlibrary/ovlibrary.h>
+#include <modules/bitstream/aac/aac_specific_config.h>
+
+#include "mpegts_packet.h"
+
+/*  PES Packetization Process
+
+	ES 1 -> [PES Header | Payload                                                 ]
+	Packet 1: [TS Header][Adaptation field: PCR][PES Header |    Payload     ] : payload_unit_start_indicator = 1
+	Packet 2: [TS Header][                    Payload                        ]
+	Packet 3: [TS Header][Adaptation field: stuffing         ][    Payload   ]
+
+	Each packet is written into the segment buffer directly (188 bytes per packet), and
+	PAT/PMT are written at the beginning of every segment so that each segment can be decoded independently.
+*/
+
+namespace mpegts
+{
+	class MpegTsPacketizer
+	{
+	public:
+		MpegTsPacketizer();
+
+		bool AddTrack(const std::shared_ptr<const MediaTrack> &media_track);
+
+		bool WritePacket(const std::shared_ptr<const MediaPacket> &packet);
+
+		// Returns the TS packets written since the last call, and the next packet starts a new segment
+		// (GetFirstPts() and GetDuration() return the values of the returned segment until the next packet is written)
+		std::shared_ptr<const ov::Data> Finalize();
+
+		// Get the first packet pts of the segment
+		// Unit: the timebase of the MediaTrack
+		int64_t GetFirstPts(uint32_t track_id) const;
+		int64_t GetFirstPts(cmn::MediaType type) const;
+
+		// Get the duration of the segment
+		// Unit: the timebase of the MediaTrack
+		int64_t GetDuration(uint32_t track_id) const;
+
+	protected:
+		struct Track
+		{
+			std::shared_ptr<const MediaTrack> media_track;
+
+			uint16_t pid = 0;
+			uint8_t stream_id = 0;
+			uint8_t stream_type = 0;
+			uint8_t continuity_counter = 0;
+
+			// Unit: Timebase of the track
+			int64_t first_pts = -1LL;
+			int64_t duration = 0LL;
+
+			// To prepend an ADTS header to the raw AAC frame
+			bool is_aac_config_parsed = false;
+			AACSpecificConfig aac_config;
+
+			// SPS/PPS to insert before the IDR frame which doesn't have them (Annex B)
+			std::shared_ptr<const ov::Data> codec_extradata;
+			std::shared_ptr<ov::Data> parameter_sets;
+
+			// Audio frames are merged into a PES to reduce the overhead of the PES header and stuffing
+			std::vector<std::shared_ptr<const MediaPacket>> pending_packet_list;
+			std::vector<std::array<uint8_t, 7>> pending_adts_header_list;
+			size_t pending_length = 0;
+		};
+
+		// A part of the PES payload
+		struct Fragment
+		{
+			const uint8_t *data;
+			size_t length;
+		};
+
+		std::shared_ptr<Track> GetTrack(uint32_t track_id) const;
+
+		bool WriteVideoPacket(const std::shared_ptr<Track> &track, const std::shared_ptr<const MediaPacket> &packet);
+		bool WriteAudioPacket(const std::shared_ptr<Track> &track, const std::shared_ptr<const MediaPacket> &packet);
+		void FlushAudioPackets(const std::shared_ptr<Track> &track);
+
+		void PrepareSegmentIfNeeded();
+		void WriteTables();
+		void WriteSection(uint16_t pid, uint8_t *continuity_counter, const uint8_t *section, size_t section_length);
+		void WritePes(const std::shared_ptr<Track> &track, int64_t pts, int64_t dts, bool is_key_frame, const Fragment *fragment_list, size_t fragment_count);
+
+		// Appends a packet to the segment, and returns the pointer to write the packet
+		uint8_t *AllocPacket();
+
+		// Unit: 90kHz
+		int64_t ConvertTo90kHz(const std::shared_ptr<Track> &track, int64_t timestamp) const;
+
+		std::vector<std::shared_ptr<Track>> _track_list;
+		// Key: MediaTrack.GetId()
+		std::map<uint32_t, std::shared_ptr<Track>> _track_map;
+
+		// The track which carries PCR
+		std::shared_ptr<Track> _pcr_track;
+
+		uint8_t _pat_continuity_counter = 0;
+		uint8_t _pmt_continuity_counter = 0;
+
+		std::shared_ptr<ov::Data> _data;
+		// Used to reserve the buffer of the next segment
+		size_t _last_segment_length = 0;
+	};
+}  // namespace mpegts
@@ -4,7 +4,8 @@
 
 namespace mpegts
 {
-	Pes::Pes(uint16_t pid)
+	Pes::Pes(uint16_t pid, size_t capacity)
+		: _data(std::max(capacity, static_cast<size_t>(MPEGTS_PES_HEADER_SIZE)), true)
 	{
 		_pid = pid;
 	}
@@ -33,12 +34,18 @@ namespace mpegts
 
 			if(_data.GetLength() >= MPEGTS_PES_HEADER_SIZE)
 			{
-				BitReader parser(_data.GetWritableDataAs<uint8_t>(), MPEGTS_PES_HEADER_SIZE);
+				BitReader parser(_data.GetDataAs<uint8_t>(), MPEGTS_PES_HEADER_SIZE);
 				if(ParsePesHeader(&parser) == false)
 				{
 					logte("Could not parse table header");
 					return 0;
 				}
+
+				// If PES packet length is known, the buffer is allocated at once
+				if(_pes_packet_length != 0)
+				{
+					_data.Reserve(MPEGTS_PES_HEADER_SIZE + _pes_packet_length);
+				}
 			}
 		}
 
@@ -56,7 +63,7 @@ namespace mpegts
 
 			if(_data.GetLength() >= MPEGTS_PES_HEADER_SIZE + MPEGTS_MIN_PES_OPTIONAL_HEADER_SIZE)
 			{
-				BitReader parser(_data.GetWritableDataAs<uint8_t>(), MPEGTS_PES_HEADER_SIZE + MPEGTS_MIN_PES_OPTIONAL_HEADER_SIZE);
+				BitReader parser(_data.GetDataAs<uint8_t>(), MPEGTS_PES_HEADER_SIZE + MPEGTS_MIN_PES_OPTIONAL_HEADER_SIZE);
 				// PES header is already parsed so skips header
 				parser.SkipBytes(MPEGTS_PES_HEADER_SIZE);
 				if(ParsePesOptionalHeader(&parser) == false)
@@ -81,7 +88,7 @@ namespace mpegts
 
 			if(_data.GetLength() >= MPEGTS_PES_HEADER_SIZE + MPEGTS_MIN_PES_OPTIONAL_HEADER_SIZE + _header_data_length)
 			{
-				BitReader parser(_data.GetWritableDataAs<uint8_t>(), MPEGTS_PES_HEADER_SIZE + MPEGTS_MIN_PES_OPTIONAL_HEADER_SIZE + _header_data_length);
+				BitReader parser(_data.GetDataAs<uint8_t>(), MPEGTS_PES_HEADER_SIZE + MPEGTS_MIN_PES_OPTIONAL_HEADER_SIZE + _header_data_length);
 				// PES header and optional header are already parsed so skips that
 				parser.SkipBytes(MPEGTS_PES_HEADER_SIZE + MPEGTS_MIN_PES_OPTIONAL_HEADER_SIZE);
 				if(ParsePesOPtionalData(&parser) == false)
@@ -258,8 +265,20 @@ namespace mpegts
 	// All pes data has been inserted
 	bool Pes::SetEndOfData()
 	{
+		size_t header_length = MPEGTS_PES_HEADER_SIZE;
+		if(IsAudioStream() || IsVideoStream())
+		{
+			header_length += MPEGTS_MIN_PES_OPTIONAL_HEADER_SIZE + _header_data_length;
+		}
+
+		if(_data.GetLength() < header_length)
+		{
+			logtw("PES is too short (pid: %d, length: %zu)", _pid, _data.GetLength());
+			return false;
+		}
+
 		// Set payload
-		_payload = _data.GetWritableDataAs<uint8_t>();
+		_payload = _data.GetDataAs<uint8_t>();
 		_payload_length = _data.GetLength();
 
 		_payload += MPEGTS_PES_HEADER_SIZE;
@@ -350,4 +369,19 @@ namespace mpegts
 	{
 		return _payload_length;
 	}
+
+	std::shared_ptr<ov::Data> Pes::GetPayloadData()
+	{
+		if(_completed == false)
+		{
+			return nullptr;
+		}
+
+		return _data.Subdata(_payload - _data.GetDataAs<uint8_t>(), _payload_length);
+	}
+
+	size_t Pes::GetDataLength() const
+	{
+		return _data.GetLength();
+	}
 }
\ No newline at end of file
@@ -45,7 +45,8 @@ namespace mpegts
 	class Pes
 	{
 	public:
-		Pes(uint16_t pid);
+		// capacity: Expected length of the PES packet to reserve the buffer (ex: length of the previous PES of the PID)
+		Pes(uint16_t pid, size_t capacity = 0);
 		~Pes();
 		
 		// return consumed length
@@ -74,6 +75,10 @@ namespace mpegts
 
 		const uint8_t* Payload();
 		uint32_t PayloadLength();
+		// Payload which shares the buffer of the PES (copy-on-write)
+		std::shared_ptr<ov::Data> GetPayloadData();
+		// Length of the PES packet including the header
+		size_t GetDataLength() const;
 
 		inline bool IsAudioStream() const
 		{
@@ -130,8 +135,9 @@ namespace mpegts
 		int64_t _pts = -1LL;
 		int64_t _dts = -1LL;
 
+		// PES header + payload, it is taken from the memory pool
 		ov::Data _data;
-		uint8_t* _payload = nullptr;
+		const uint8_t* _payload = nullptr;
 		uint32_t _payload_length = 0;
 	};
 }
\ No newline at end of file
@@ -192,16 +192,18 @@ namespace mpegts
 				break;
 		}
 
-		_crc = parser->ReadBytes<uint32_t>();
-
-		/*TODO(Getroot): It seems having a problem, check later
-		auto _check_crc = ov::CRC::Crc32(0, _data.GetWritableDataAs<uint8_t>(), MPEGTS_TABLE_HEADER_SIZE + _section_length - 4); // excluding last 4 bytes for crc
-		if(_crc != _check_crc)
+		// CRC_32 is the last 4 bytes of the section, the parser may not be located there
+		// (multiple programs in PAT, unsupported tables)
+		auto crc_offset = MPEGTS_TABLE_HEADER_SIZE + _section_length - 4;
+		_crc = ByteReader<uint32_t>::ReadBigEndian(_data.GetDataAs<uint8_t>() + crc_offset);
+
+		// CRC_32 of PSI is CRC-32/MPEG-2 (not reflected, no final XOR), not CRC-32 of zlib
+		auto check_crc = ov::CRC::Crc32Mpeg2(_data.GetDataAs<uint8_t>(), crc_offset);
+		if(_crc != check_crc)
 		{
-			// error
+			logtw("CRC mismatch (pid: %u, table id: %u, expected: %08X, calculated: %08X)", _pid, _table_id, _crc, check_crc);
 			return false;
 		}
-		*/
 
 		_completed = true;
 
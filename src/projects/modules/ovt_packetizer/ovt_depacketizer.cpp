@@ -7,9 +7,10 @@
 #define OV_LOG_TAG		"OvtDepacketizer"
 
 OvtDepacketizer::OvtDepacketizer()
+	// The buffer is subdata of the media packet, so it is allocated again from the pool after every media packet
+	: _media_packet_buffer(INIT_PAYLOAD_BUFFER_SIZE, true)
 {
 	_packet_buffer.Reserve(INIT_PACKET_BUFFER_SIZE);
-	_media_packet_buffer.Reserve(INIT_PAYLOAD_BUFFER_SIZE);
 }
 
 OvtDepacketizer::~OvtDepacketizer()
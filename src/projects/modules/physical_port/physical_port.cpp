@@ -22,7 +22,8 @@ bool PhysicalPort::Create(const char *name,
 						  const ov::SocketAddress &address,
 						  int worker_count,
 						  int send_buffer_size,
-						  int recv_buffer_size)
+						  int recv_buffer_size,
+						  PhysicalPortShardMode shard_mode)
 {
 	if ((_server_socket != nullptr) || (_datagram_socket != nullptr))
 	{
@@ -30,22 +31,30 @@ bool PhysicalPort::Create(const char *name,
 		OV_ASSERT2((_server_socket == nullptr) && (_datagram_socket == nullptr));
 	}
 
-	logtd("Trying to start physical port [%s] on %s/%s (worker: %d, send_buffer_size: %d, recv_buffer_size: %d)...",
+	logtd("Trying to start physical port [%s] on %s/%s (worker: %d, send_buffer_size: %d, recv_buffer_size: %d, shard mode: %s)...",
 		  name,
 		  address.ToString().CStr(), ov::StringFromSocketType(type),
-		  worker_count, send_buffer_size, recv_buffer_size);
+		  worker_count, send_buffer_size, recv_buffer_size,
+		  StringFromPhysicalPortShardMode(shard_mode));
 
 	bool result = false;
 
 	switch (type)
 	{
 		case ov::SocketType::Srt:
+			if (shard_mode != PhysicalPortShardMode::None)
+			{
+				logtw("SO_REUSEPORT sharding is not supported for SRT, only one socket will be used: %s", address.ToString().CStr());
+				shard_mode = PhysicalPortShardMode::None;
+			}
+			[[fallthrough]];
+
 		case ov::SocketType::Tcp:
-			result = CreateServerSocket(name, type, address, worker_count, send_buffer_size, recv_buffer_size);
+			result = CreateServerSocket(name, type, address, worker_count, send_buffer_size, recv_buffer_size, shard_mode);
 			break;
 
 		case ov::SocketType::Udp:
-			result = CreateDatagramSocket(name, type, address, worker_count);
+			result = CreateDatagramSocket(name, type, address, worker_count, shard_mode);
 			break;
 
 		case ov::SocketType::Unknown:
@@ -56,13 +65,65 @@ bool PhysicalPort::Create(const char *name,
 	return result;
 }
 
+int PhysicalPort::PrepareShards(PhysicalPortShardMode shard_mode)
+{
+	if (shard_mode == PhysicalPortShardMode::None)
+	{
+		return 1;
+	}
+
+	// Each worker owns one shard, so the worker threads are pinned to different CPUs
+	_socket_pool->PinWorkersToCpus();
+
+	return std::max(_socket_pool->GetWorkerCount(), 1);
+}
+
+template <typename Tsocket, typename... Targuments>
+std::shared_ptr<Tsocket> PhysicalPort::AllocShardSocket(int shard_index, int shard_count, Targuments... args)
+{
+	if (shard_count == 1)
+	{
+		// Use the least loaded worker
+		return _socket_pool->AllocSocket<Tsocket>(args...);
+	}
+
+	auto socket = _socket_pool->AllocSocketOnWorker<Tsocket>(_socket_pool->GetWorker(shard_index), args...);
+
+	if ((socket != nullptr) && (socket->SetReusePort(true) == false))
+	{
+		_socket_pool->ReleaseSocket(socket);
+		return nullptr;
+	}
+
+	return socket;
+}
+
+bool PhysicalPort::AttachSteeringProgram(const std::shared_ptr<ov::Socket> &socket, int shard_count)
+{
+	if (_shard_mode != PhysicalPortShardMode::ReusePortWithBpf)
+	{
+		return true;
+	}
+
+	// If the program cannot be attached, the kernel distributes the traffic by its own 4-tuple hash,
+	// so the port still works
+	if (socket->AttachReusePortSteering(shard_count) == false)
+	{
+		logtw("Could not attach the BPF steering program to %s, falling back to the kernel hash", _address.ToString().CStr());
+		return false;
+	}
+
+	return true;
+}
+
 bool PhysicalPort::CreateServerSocket(
 	const char *name,
 	ov::SocketType type,
 	const ov::SocketAddress &address,
 	int worker_count,
 	int send_buffer_size,
-	int recv_buffer_size)
+	int recv_buffer_size,
+	PhysicalPortShardMode shard_mode)
 {
 	_socket_pool = ov::SocketPool::Create(name, type);
 
@@ -70,28 +131,55 @@ bool PhysicalPort::CreateServerSocket(
 	{
 		if (_socket_pool->Initialize(worker_count))
 		{
-			auto socket = _socket_pool->AllocSocket<ov::ServerSocket>(_socket_pool);
+			_shard_mode = shard_mode;
+			auto shard_count = PrepareShards(shard_mode);
+			bool succeeded = true;
 
-			if (socket != nullptr)
+			for (int shard_index = 0; shard_index < shard_count; shard_index++)
 			{
+				auto socket = AllocShardSocket<ov::ServerSocket>(shard_index, shard_count, _socket_pool);
+
+				if (socket == nullptr)
+				{
+					succeeded = false;
+					break;
+				}
+
+				// Connections accepted by a shard are handled by the worker of the shard
+				socket->SetKeepClientsOnWorker(shard_count > 1);
+
 				if (socket->Prepare(
 						address,
 						std::bind(&PhysicalPort::OnClientConnectionStateChanged, this,
 								  std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
 						std::bind(&PhysicalPort::OnClientData, this,
 								  std::placeholders::_1, std::placeholders::_2),
-						send_buffer_size, recv_buffer_size, 4096))
+						send_buffer_size, recv_buffer_size, 4096) == false)
 				{
-					_type = type;
-					_server_socket = socket;
-					_address = address;
+					_socket_pool->ReleaseSocket(socket);
+					succeeded = false;
+					break;
+				}
+
+				_server_socket_list.push_back(socket);
+			}
+
+			if (succeeded)
+			{
+				_type = type;
+				_server_socket = _server_socket_list.front();
+				_address = address;
 
-					return true;
+				if (shard_count > 1)
+				{
+					AttachSteeringProgram(_server_socket, shard_count);
 				}
 
-				_socket_pool->ReleaseSocket(socket);
+				return true;
 			}
 
+			ReleaseSockets();
+
 			OV_SAFE_RESET(_socket_pool, nullptr, _socket_pool->Uninitialize(), _socket_pool);
 		}
 		else
@@ -107,7 +195,8 @@ bool PhysicalPort::CreateDatagramSocket(
 	const char *name,
 	ov::SocketType type,
 	const ov::SocketAddress &address,
-	int worker_count)
+	int worker_count,
+	PhysicalPortShardMode shard_mode)
 {
 	_socket_pool = ov::SocketPool::Create(name, type);
 
@@ -115,25 +204,51 @@ bool PhysicalPort::CreateDatagramSocket(
 	{
 		if (_socket_pool->Initialize(worker_count))
 		{
-			auto socket = _socket_pool->AllocSocket<ov::DatagramSocket>();
+			_shard_mode = shard_mode;
+			auto shard_count = PrepareShards(shard_mode);
+			bool succeeded = true;
 
-			if (socket != nullptr)
+			for (int shard_index = 0; shard_index < shard_count; shard_index++)
 			{
+				auto socket = AllocShardSocket<ov::DatagramSocket>(shard_index, shard_count);
+
+				if (socket == nullptr)
+				{
+					succeeded = false;
+					break;
+				}
+
 				if (socket->Prepare(
 						address,
 						std::bind(&PhysicalPort::OnDatagram, this,
-								  std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)))
+								  std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+						std::bind(&PhysicalPort::OnDatagrams, this,
+								  std::placeholders::_1, std::placeholders::_2)) == false)
 				{
-					_type = type;
-					_datagram_socket = socket;
-					_address = address;
+					_socket_pool->ReleaseSocket(socket);
+					succeeded = false;
+					break;
+				}
+
+				_datagram_socket_list.push_back(socket);
+			}
+
+			if (succeeded)
+			{
+				_type = type;
+				_datagram_socket = _datagram_socket_list.front();
+				_address = address;
 
-					return true;
+				if (shard_count > 1)
+				{
+					AttachSteeringProgram(_datagram_socket, shard_count);
 				}
 
-				_socket_pool->ReleaseSocket(socket);
+				return true;
 			}
 
+			ReleaseSockets();
+
 			OV_SAFE_RESET(_socket_pool, nullptr, _socket_pool->Uninitialize(), _socket_pool);
 		}
 		else
@@ -145,6 +260,25 @@ bool PhysicalPort::CreateDatagramSocket(
 	return false;
 }
 
+void PhysicalPort::ReleaseSockets()
+{
+	for (auto &socket : _server_socket_list)
+	{
+		_socket_pool->ReleaseSocket(socket);
+	}
+
+	for (auto &socket : _datagram_socket_list)
+	{
+		_socket_pool->ReleaseSocket(socket);
+	}
+
+	_server_socket_list.clear();
+	_datagram_socket_list.clear();
+
+	_server_socket = nullptr;
+	_datagram_socket = nullptr;
+}
+
 void PhysicalPort::OnClientConnectionStateChanged(const std::shared_ptr<ov::ClientSocket> &client, ov::SocketConnectionState state, const std::shared_ptr<ov::Error> &error)
 {
 	switch (state)
@@ -222,17 +356,18 @@ void PhysicalPort::OnDatagram(const std::shared_ptr<ov::DatagramSocket> &client,
 	}
 }
 
-bool PhysicalPort::Close()
+void PhysicalPort::OnDatagrams(const std::shared_ptr<ov::DatagramSocket> &client, const std::vector<ov::DatagramPacket> &packets)
 {
-	auto socket = GetSocket();
-
-	if (socket != nullptr)
+	// Notify observers
+	for (auto &observer : _observer_list)
 	{
-		_socket_pool->ReleaseSocket(socket);
-
-		_server_socket = nullptr;
-		_datagram_socket = nullptr;
+		observer->OnDatagramsReceived(client, packets);
 	}
+}
+
+bool PhysicalPort::Close()
+{
+	ReleaseSockets();
 
 	_socket_pool->Uninitialize();
 	_socket_pool = nullptr;
@@ -284,6 +419,24 @@ std::shared_ptr<ov::Socket> PhysicalPort::GetSocket()
 	}
 }
 
+bool PhysicalPort::SetSendBatching(bool enabled)
+{
+	if (_datagram_socket_list.empty())
+	{
+		logte("Send batching is only available for UDP physical port: %s", ToString().CStr());
+		return false;
+	}
+
+	bool result = true;
+
+	for (auto &socket : _datagram_socket_list)
+	{
+		result &= socket->SetSendBatching(enabled);
+	}
+
+	return result;
+}
+
 bool PhysicalPort::AddObserver(PhysicalPortObserver *observer)
 {
 	auto item = std::find(_observer_list.begin(), _observer_list.end(), observer);
@@ -312,12 +465,18 @@ ov::String PhysicalPort::ToString() const
 {
 	ov::String description;
 
-	description.Format("<PhysicalPort: %p, type: %d, address: %s, ref_count: %d",
-					   this, _type, _address.ToString().CStr(), static_cast<int>(_ref_count));
+	description.Format("<PhysicalPort: %p, type: %d, address: %s, ref_count: %d, shard mode: %s",
+					   this, _type, _address.ToString().CStr(), static_cast<int>(_ref_count),
+					   StringFromPhysicalPortShardMode(_shard_mode));
+
+	for (auto &socket : _server_socket_list)
+	{
+		description.AppendFormat(", socket: %s", socket->ToString().CStr());
+	}
 
-	if (_server_socket != nullptr)
+	for (auto &socket : _datagram_socket_list)
 	{
-		description.AppendFormat(", socket: %s", _server_socket->ToString().CStr());
+		description.AppendFormat(", socket: %s", socket->ToString().CStr());
 	}
 
 	description.Append('>');
@@ -10,6 +10,7 @@
 
 #include <base/ovsocket/ovsocket.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <thread>
@@ -18,6 +19,33 @@
 
 class PhysicalPortManager;
 
+enum class PhysicalPortShardMode
+{
+	// Only one socket is bound to the address
+	None,
+	// A SO_REUSEPORT socket is bound for each worker (pinned to a CPU),
+	// and the kernel distributes the connections/datagrams among them
+	ReusePort,
+	// Same as ReusePort, but a BPF program selects the socket by the 4-tuple
+	// (A remote address/port always lands on the same shard)
+	ReusePortWithBpf
+};
+
+static const char *StringFromPhysicalPortShardMode(PhysicalPortShardMode mode)
+{
+	switch (mode)
+	{
+		case PhysicalPortShardMode::None:
+			return "None";
+		case PhysicalPortShardMode::ReusePort:
+			return "ReusePort";
+		case PhysicalPortShardMode::ReusePortWithBpf:
+			return "ReusePortWithBpf";
+	}
+
+	return "Unknown";
+}
+
 class PhysicalPort : public ov::EnableSharedFromThis<PhysicalPort>
 {
 protected:
@@ -37,7 +65,8 @@ public:
 				const ov::SocketAddress &address,
 				int worker_count,
 				int send_buffer_size,
-				int recv_buffer_size);
+				int recv_buffer_size,
+				PhysicalPortShardMode shard_mode = PhysicalPortShardMode::None);
 
 	bool Close();
 
@@ -76,6 +105,20 @@ public:
 		return _socket_pool->GetWorkerCount();
 	}
 
+	PhysicalPortShardMode GetShardMode() const
+	{
+		return _shard_mode;
+	}
+
+	// The number of sockets bound to the address
+	int GetShardCount() const
+	{
+		return static_cast<int>(std::max(_server_socket_list.size(), _datagram_socket_list.size()));
+	}
+
+	// Only available for UDP physical port
+	bool SetSendBatching(bool enabled);
+
 	bool AddObserver(PhysicalPortObserver *observer);
 
 	bool RemoveObserver(PhysicalPortObserver *observer);
@@ -88,12 +131,22 @@ protected:
 							const ov::SocketAddress &address,
 							int worker_count,
 							int send_buffer_size,
-							int recv_buffer_size);
+							int recv_buffer_size,
+							PhysicalPortShardMode shard_mode);
 
 	bool CreateDatagramSocket(const char *name,
 							  ov::SocketType type,
 							  const ov::SocketAddress &address,
-							  int worker_count);
+							  int worker_count,
+							  PhysicalPortShardMode shard_mode);
+
+	// Returns the number of sockets to be bound to the address, and pins the workers to CPUs if needed
+	int PrepareShards(PhysicalPortShardMode shard_mode);
+	// Allocates a socket on the worker of the shard
+	template <typename Tsocket, typename... Targuments>
+	std::shared_ptr<Tsocket> AllocShardSocket(int shard_index, int shard_count, Targuments... args);
+	bool AttachSteeringProgram(const std::shared_ptr<ov::Socket> &socket, int shard_count);
+	void ReleaseSockets();
 
 	// For TCP physical port
 	void OnClientConnectionStateChanged(const std::shared_ptr<ov::ClientSocket> &client, ov::SocketConnectionState state, const std::shared_ptr<ov::Error> &error);
@@ -101,15 +154,22 @@ protected:
 
 	// For UDP physical port
 	void OnDatagram(const std::shared_ptr<ov::DatagramSocket> &client, const ov::SocketAddress &remote_address, const std::shared_ptr<ov::Data> &data);
+	void OnDatagrams(const std::shared_ptr<ov::DatagramSocket> &client, const std::vector<ov::DatagramPacket> &packets);
 
 	std::shared_ptr<ov::SocketPool> _socket_pool;
 
 	ov::SocketType _type = ov::SocketType::Unknown;
 	ov::SocketAddress _address;
+	PhysicalPortShardMode _shard_mode = PhysicalPortShardMode::None;
 
+	// The first shard (Used when the caller needs a representative socket of this port)
 	std::shared_ptr<ov::ServerSocket> _server_socket;
 	std::shared_ptr<ov::DatagramSocket> _datagram_socket;
 
+	// All sockets bound to the address (only one socket if sharding is not used)
+	std::vector<std::shared_ptr<ov::ServerSocket>> _server_socket_list;
+	std::vector<std::shared_ptr<ov::DatagramSocket>> _datagram_socket_list;
+
 	std::atomic<int> _ref_count{0};
 
 	// Because the life cycle of PhysicalPort is the same as that of the OME now, we do not need to use mutex for _observer_list
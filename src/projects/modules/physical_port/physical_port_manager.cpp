@@ -23,7 +23,8 @@ std::shared_ptr<PhysicalPort> PhysicalPortManager::CreatePort(const char *name,
 															  const ov::SocketAddress &address,
 															  int worker_count,
 															  int send_buffer_size,
-															  int recv_buffer_size)
+															  int recv_buffer_size,
+															  PhysicalPortShardMode shard_mode)
 {
 	auto lock_guard = std::lock_guard(_port_list_mutex);
 
@@ -40,7 +41,7 @@ std::shared_ptr<PhysicalPort> PhysicalPortManager::CreatePort(const char *name,
 	{
 		port = std::make_shared<PhysicalPort>(PhysicalPort::PrivateToken{nullptr});
 
-		if (port->Create(name, type, address, worker_count, send_buffer_size, recv_buffer_size))
+		if (port->Create(name, type, address, worker_count, send_buffer_size, recv_buffer_size, shard_mode))
 		{
 			_port_list[key] = port;
 		}
@@ -63,6 +64,12 @@ std::shared_ptr<PhysicalPort> PhysicalPortManager::CreatePort(const char *name,
 			logtw("The number of workers in the existing socket pool differs from the number of workers passed by the argument: socket pool: %d, argument: %d",
 				  port->GetWorkerCount(), worker_count);
 		}
+
+		if (port->GetShardMode() != shard_mode)
+		{
+			logtw("The shard mode of the existing physical port differs from the shard mode passed by the argument: physical port: %s, argument: %s",
+				  StringFromPhysicalPortShardMode(port->GetShardMode()), StringFromPhysicalPortShardMode(shard_mode));
+		}
 	}
 
 	return port;
@@ -48,6 +48,16 @@ public:
 	// Called when the packet is received
 	virtual void OnDataReceived(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddress &address, const std::shared_ptr<const ov::Data> &data) = 0;
 
+	// Called when several datagrams are received at once (UDP only)
+	// Each packet keeps its own source address, so the default implementation just delivers them one by one
+	virtual void OnDatagramsReceived(const std::shared_ptr<ov::Socket> &remote, const std::vector<ov::DatagramPacket> &packets)
+	{
+		for (auto &packet : packets)
+		{
+			OnDataReceived(remote, packet.address, packet.data);
+		}
+	}
+
 	// Called when the client is disconnected
 	virtual void OnDisconnected(const std::shared_ptr<ov::Socket> &remote, PhysicalPortDisconnectReason reason, const std::shared_ptr<const ov::Error> &error)
 	{
@@ -0,0 +1,376 @@
+#include "bandwidth_estimator.h"
+
+#include <cmath>
+
+#define OV_LOG_TAG "BandwidthEstimator"
+
+// Packets which are sent within this interval belong to the same group
+#define BURST_TIME_INTERVAL_US				5000
+
+// Trendline estimator
+#define TRENDLINE_WINDOW_SIZE				20
+#define TRENDLINE_SMOOTHING_COEFFICIENT		0.9
+#define TRENDLINE_THRESHOLD_GAIN			4.0
+#define TRENDLINE_MAX_NUM_OF_DELTAS			60
+
+// Adaptive threshold of the overuse detector
+#define OVERUSE_THRESHOLD_K_UP				0.0087
+#define OVERUSE_THRESHOLD_K_DOWN			0.039
+#define OVERUSE_THRESHOLD_MIN				6.0
+#define OVERUSE_THRESHOLD_MAX				600.0
+#define OVERUSE_TIME_THRESHOLD_MS			10.0
+#define OVERUSE_MAX_ADAPT_OFFSET_MS			15.0
+
+// Rate control
+#define ACKED_BITRATE_WINDOW_US				500000
+#define RATE_DECREASE_FACTOR				0.85
+#define RATE_INCREASE_FACTOR_PER_SECOND		1.08
+#define RATE_DECREASE_HOLD_TIME_US			200000
+#define LOSS_HIGH_THRESHOLD					0.10
+#define LOSS_DECREASE_HOLD_TIME_US			300000
+#define LOSS_SMOOTHING_COEFFICIENT			0.5
+
+BandwidthEstimator::BandwidthEstimator(uint32_t initial_bitrate, uint32_t min_bitrate, uint32_t max_bitrate)
+	: _estimated_bitrate(initial_bitrate),
+	  _min_bitrate(min_bitrate),
+	  _max_bitrate(max_bitrate)
+{
+	_sent_packets.resize(BANDWIDTH_ESTIMATOR_SENT_HISTORY_SIZE);
+}
+
+void BandwidthEstimator::OnPacketSent(uint16_t transport_sequence_number, size_t size, int64_t send_time_us)
+{
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+
+	auto &sent_packet = _sent_packets[transport_sequence_number % BANDWIDTH_ESTIMATOR_SENT_HISTORY_SIZE];
+
+	sent_packet.sequence_number = transport_sequence_number;
+	sent_packet.size = size;
+	sent_packet.send_time_us = send_time_us;
+	sent_packet.is_valid = true;
+	sent_packet.is_acked = false;
+}
+
+bool BandwidthEstimator::OnTransportFeedback(const std::shared_ptr<TransportCc> &feedback, int64_t now_us)
+{
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+
+	size_t total_count = 0;
+	size_t lost_count = 0;
+
+	for (const auto &packet_feedback : feedback->GetPacketFeedbacks())
+	{
+		auto &sent_packet = _sent_packets[packet_feedback.sequence_number % BANDWIDTH_ESTIMATOR_SENT_HISTORY_SIZE];
+
+		if ((sent_packet.is_valid == false) || (sent_packet.sequence_number != packet_feedback.sequence_number))
+		{
+			// Too old, or not sent by this session
+			continue;
+		}
+
+		if (sent_packet.is_acked)
+		{
+			// A packet can be reported again in the next feedback
+			continue;
+		}
+
+		total_count++;
+
+		if (packet_feedback.received)
+		{
+			sent_packet.is_acked = true;
+			OnPacketArrived(sent_packet, packet_feedback.arrival_time_us, now_us);
+		}
+		else
+		{
+			lost_count++;
+		}
+	}
+
+	if (total_count == 0)
+	{
+		return false;
+	}
+
+	_loss_rate = (LOSS_SMOOTHING_COEFFICIENT * _loss_rate) +
+				 ((1.0 - LOSS_SMOOTHING_COEFFICIENT) * static_cast<double>(lost_count) / static_cast<double>(total_count));
+
+	auto previous_bitrate = _estimated_bitrate;
+
+	UpdateEstimate(_loss_rate, now_us);
+
+	return (previous_bitrate != _estimated_bitrate);
+}
+
+void BandwidthEstimator::OnPacketArrived(const SentPacket &sent_packet, int64_t arrival_time_us, int64_t now_us)
+{
+	UpdateAckedBitrate(sent_packet.size, arrival_time_us);
+
+	if (_current_group.is_valid == false)
+	{
+		_current_group = {sent_packet.send_time_us, sent_packet.send_time_us, arrival_time_us, true};
+		return;
+	}
+
+	if (sent_packet.send_time_us < _current_group.first_send_time_us)
+	{
+		// Reordered packet
+		return;
+	}
+
+	if ((sent_packet.send_time_us - _current_group.first_send_time_us) <= BURST_TIME_INTERVAL_US)
+	{
+		_current_group.last_send_time_us = std::max(_current_group.last_send_time_us, sent_packet.send_time_us);
+		_current_group.last_arrival_time_us = std::max(_current_group.last_arrival_time_us, arrival_time_us);
+		return;
+	}
+
+	// A new group is started, so the current group is completed
+	if (_previous_group.is_valid)
+	{
+		double send_delta_ms = static_cast<double>(_current_group.last_send_time_us - _previous_group.last_send_time_us) / 1000.0;
+		double arrival_delta_ms = static_cast<double>(_current_group.last_arrival_time_us - _previous_group.last_arrival_time_us) / 1000.0;
+
+		UpdateTrendline(arrival_delta_ms - send_delta_ms, send_delta_ms, _current_group.last_arrival_time_us, now_us);
+	}
+
+	_previous_group = _current_group;
+	_current_group = {sent_packet.send_time_us, sent_packet.send_time_us, arrival_time_us, true};
+}
+
+void BandwidthEstimator::UpdateTrendline(double delay_variation_ms, double send_delta_ms, int64_t arrival_time_us, int64_t now_us)
+{
+	_num_of_deltas = std::min<size_t>(_num_of_deltas + 1, 1000);
+
+	if (_first_arrival_time_us < 0)
+	{
+		_first_arrival_time_us = arrival_time_us;
+	}
+
+	_accumulated_delay_ms += delay_variation_ms;
+	_smoothed_delay_ms = (TRENDLINE_SMOOTHING_COEFFICIENT * _smoothed_delay_ms) + ((1.0 - TRENDLINE_SMOOTHING_COEFFICIENT) * _accumulated_delay_ms);
+
+	_delay_history.emplace_back(static_cast<double>(arrival_time_us - _first_arrival_time_us) / 1000.0, _smoothed_delay_ms);
+	if (_delay_history.size() > TRENDLINE_WINDOW_SIZE)
+	{
+		_delay_history.pop_front();
+	}
+
+	double trend = _previous_trend;
+
+	if (_delay_history.size() == TRENDLINE_WINDOW_SIZE)
+	{
+		// Slope of the linear regression of the smoothed delay
+		double sum_x = 0.0;
+		double sum_y = 0.0;
+
+		for (const auto &point : _delay_history)
+		{
+			sum_x += point.first;
+			sum_y += point.second;
+		}
+
+		double mean_x = sum_x / _delay_history.size();
+		double mean_y = sum_y / _delay_history.size();
+
+		double numerator = 0.0;
+		double denominator = 0.0;
+
+		for (const auto &point : _delay_history)
+		{
+			numerator += (point.first - mean_x) * (point.second - mean_y);
+			denominator += (point.first - mean_x) * (point.first - mean_x);
+		}
+
+		if (denominator != 0.0)
+		{
+			trend = numerator / denominator;
+		}
+	}
+
+	DetectOveruse(trend, send_delta_ms, now_us);
+}
+
+void BandwidthEstimator::DetectOveruse(double trend, double send_delta_ms, int64_t now_us)
+{
+	if (_num_of_deltas < 2)
+	{
+		return;
+	}
+
+	double modified_trend = std::min<size_t>(_num_of_deltas, TRENDLINE_MAX_NUM_OF_DELTAS) * trend * TRENDLINE_THRESHOLD_GAIN;
+
+	if (modified_trend > _threshold)
+	{
+		if (_time_over_using_ms < 0.0)
+		{
+			// Initialize the timer. Assume that the overuse started halfway between the last two groups
+			_time_over_using_ms = send_delta_ms / 2.0;
+		}
+		else
+		{
+			_time_over_using_ms += send_delta_ms;
+		}
+
+		_overuse_counter++;
+
+		if ((_time_over_using_ms > OVERUSE_TIME_THRESHOLD_MS) && (_overuse_counter > 1) && (trend >= _previous_trend))
+		{
+			_time_over_using_ms = 0.0;
+			_overuse_counter = 0;
+			_bandwidth_usage = BandwidthUsage::Overusing;
+		}
+	}
+	else if (modified_trend < -_threshold)
+	{
+		_time_over_using_ms = -1.0;
+		_overuse_counter = 0;
+		_bandwidth_usage = BandwidthUsage::Underusing;
+	}
+	else
+	{
+		_time_over_using_ms = -1.0;
+		_overuse_counter = 0;
+		_bandwidth_usage = BandwidthUsage::Normal;
+	}
+
+	_previous_trend = trend;
+
+	UpdateThreshold(modified_trend, now_us);
+}
+
+void BandwidthEstimator::UpdateThreshold(double modified_trend, int64_t now_us)
+{
+	if (_last_threshold_update_time_us < 0)
+	{
+		_last_threshold_update_time_us = now_us;
+	}
+
+	double abs_trend = std::fabs(modified_trend);
+
+	if (abs_trend > (_threshold + OVERUSE_MAX_ADAPT_OFFSET_MS))
+	{
+		// Avoid adapting the threshold to the big latency spikes
+		_last_threshold_update_time_us = now_us;
+		return;
+	}
+
+	double k = (abs_trend < _threshold) ? OVERUSE_THRESHOLD_K_DOWN : OVERUSE_THRESHOLD_K_UP;
+	double time_delta_ms = std::min(static_cast<double>(now_us - _last_threshold_update_time_us) / 1000.0, 100.0);
+
+	_threshold += k * (abs_trend - _threshold) * time_delta_ms;
+	_threshold = std::clamp(_threshold, OVERUSE_THRESHOLD_MIN, OVERUSE_THRESHOLD_MAX);
+
+	_last_threshold_update_time_us = now_us;
+}
+
+void BandwidthEstimator::UpdateAckedBitrate(size_t size, int64_t arrival_time_us)
+{
+	if (_first_acked_time_us < 0)
+	{
+		_first_acked_time_us = arrival_time_us;
+	}
+
+	_acked_packets.emplace_back(arrival_time_us, size);
+	_acked_bytes_in_window += size;
+
+	while ((_acked_packets.empty() == false) && (_acked_packets.front().first < (arrival_time_us - ACKED_BITRATE_WINDOW_US)))
+	{
+		_acked_bytes_in_window -= _acked_packets.front().second;
+		_acked_packets.pop_front();
+	}
+
+	// The bitrate is unknown until the window is filled
+	if ((arrival_time_us - _first_acked_time_us) >= ACKED_BITRATE_WINDOW_US)
+	{
+		_acked_bitrate = static_cast<uint32_t>(_acked_bytes_in_window * 8 * 1000000 / ACKED_BITRATE_WINDOW_US);
+	}
+}
+
+void BandwidthEstimator::UpdateEstimate(double loss_rate, int64_t now_us)
+{
+	if (_last_update_time_us < 0)
+	{
+		_last_update_time_us = now_us;
+	}
+
+	double elapsed_seconds = std::min(static_cast<double>(now_us - _last_update_time_us) / 1000000.0, 1.0);
+	double bitrate = _estimated_bitrate;
+
+	switch (_bandwidth_usage)
+	{
+		case BandwidthUsage::Overusing:
+			// Multiplicative decrease, once per hold time
+			if ((_last_delay_decrease_time_us < 0) || ((now_us - _last_delay_decrease_time_us) >= RATE_DECREASE_HOLD_TIME_US))
+			{
+				bitrate = (_acked_bitrate > 0) ? std::min(bitrate, RATE_DECREASE_FACTOR * _acked_bitrate) : (RATE_DECREASE_FACTOR * bitrate);
+				_last_delay_decrease_time_us = now_us;
+			}
+			break;
+
+		case BandwidthUsage::Normal: {
+			// Multiplicative increase, but do not exceed the bitrate which the viewer can actually receive too much
+			double increased_bitrate = bitrate * std::pow(RATE_INCREASE_FACTOR_PER_SECOND, elapsed_seconds);
+
+			if (_acked_bitrate > 0)
+			{
+				double limit = (1.5 * _acked_bitrate) + 10000.0;
+
+				if (bitrate < limit)
+				{
+					bitrate = std::min(increased_bitrate, limit);
+				}
+			}
+			else
+			{
+				bitrate = increased_bitrate;
+			}
+			break;
+		}
+
+		case BandwidthUsage::Underusing:
+			// The queues on the path are being drained, so hold the bitrate
+			break;
+	}
+
+	if ((loss_rate > LOSS_HIGH_THRESHOLD) &&
+		((_last_loss_decrease_time_us < 0) || ((now_us - _last_loss_decrease_time_us) >= LOSS_DECREASE_HOLD_TIME_US)))
+	{
+		bitrate *= (1.0 - (0.5 * loss_rate));
+		_last_loss_decrease_time_us = now_us;
+	}
+
+	auto previous_bitrate = _estimated_bitrate;
+	_estimated_bitrate = static_cast<uint32_t>(std::clamp(bitrate, static_cast<double>(_min_bitrate), static_cast<double>(_max_bitrate)));
+	_last_update_time_us = now_us;
+
+	if (previous_bitrate != _estimated_bitrate)
+	{
+		logtd("Estimated bitrate: %u -> %u bps (acked: %u bps, loss: %.2f%%, usage: %d)",
+			  previous_bitrate, _estimated_bitrate, _acked_bitrate, loss_rate * 100.0, static_cast<int>(_bandwidth_usage));
+	}
+}
+
+uint32_t BandwidthEstimator::GetEstimatedBitrate() const
+{
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+	return _estimated_bitrate;
+}
+
+uint32_t BandwidthEstimator::GetAckedBitrate() const
+{
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+	return _acked_bitrate;
+}
+
+double BandwidthEstimator::GetLossRate() const
+{
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+	return _loss_rate;
+}
+
+BandwidthEstimator::BandwidthUsage BandwidthEstimator::GetBandwidthUsage() const
+{
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+	return _bandwidth_usage;
+}
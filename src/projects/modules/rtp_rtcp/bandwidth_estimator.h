@@ -0,0 +1,117 @@
+#pragma once
+
+#include "base/ovlibrary/ovlibrary.h"
+#include "rtcp_info/transport_cc.h"
+
+#include <deque>
+#include <mutex>
+
+// Number of sent packets which can be matched with the transport-cc feedback
+#define BANDWIDTH_ESTIMATOR_SENT_HISTORY_SIZE		1024
+
+#define BANDWIDTH_ESTIMATOR_INITIAL_BITRATE			(5 * 1000 * 1000)
+#define BANDWIDTH_ESTIMATOR_MIN_BITRATE				(50 * 1000)
+#define BANDWIDTH_ESTIMATOR_MAX_BITRATE				(50 * 1000 * 1000)
+
+// Estimates the available bandwidth of the path to a viewer from the transport-cc feedback,
+// in the same way as the Google Congestion Control (draft-ietf-rmcat-gcc-02):
+//
+// - Delay-based: The packets which are sent in a burst (5 ms) are grouped, and the trend of the one-way delay variation
+//   between the groups is estimated by a linear regression. If the trend exceeds the adaptive threshold, the path is overused
+//   and the estimate decreases to 85% of the acknowledged bitrate, otherwise the estimate increases by 8% per second.
+// - Loss-based: If more than 10% of the packets are lost, the estimate decreases in proportion to the loss rate.
+//
+// The estimator does not need a timer, it is updated whenever the feedback is received.
+class BandwidthEstimator
+{
+public:
+	enum class BandwidthUsage : uint8_t
+	{
+		Normal,
+		Underusing,
+		Overusing
+	};
+
+	BandwidthEstimator(uint32_t initial_bitrate = BANDWIDTH_ESTIMATOR_INITIAL_BITRATE,
+					   uint32_t min_bitrate = BANDWIDTH_ESTIMATOR_MIN_BITRATE,
+					   uint32_t max_bitrate = BANDWIDTH_ESTIMATOR_MAX_BITRATE);
+
+	// Called whenever a packet which has the transport-wide sequence number is sent
+	void OnPacketSent(uint16_t transport_sequence_number, size_t size, int64_t send_time_us);
+
+	// Returns true if the estimate has been changed
+	bool OnTransportFeedback(const std::shared_ptr<TransportCc> &feedback, int64_t now_us);
+
+	// bits per second
+	uint32_t GetEstimatedBitrate() const;
+	// The bitrate which the viewer has actually received (bits per second)
+	uint32_t GetAckedBitrate() const;
+	// 0.0 ~ 1.0
+	double GetLossRate() const;
+	BandwidthUsage GetBandwidthUsage() const;
+
+private:
+	struct SentPacket
+	{
+		uint16_t sequence_number = 0;
+		size_t size = 0;
+		int64_t send_time_us = 0;
+		bool is_valid = false;
+		bool is_acked = false;
+	};
+
+	// Packets which are sent in a burst
+	struct PacketGroup
+	{
+		int64_t first_send_time_us = 0;
+		int64_t last_send_time_us = 0;
+		int64_t last_arrival_time_us = 0;
+		bool is_valid = false;
+	};
+
+	void OnPacketArrived(const SentPacket &sent_packet, int64_t arrival_time_us, int64_t now_us);
+	void UpdateTrendline(double delay_variation_ms, double send_delta_ms, int64_t arrival_time_us, int64_t now_us);
+	void DetectOveruse(double trend, double send_delta_ms, int64_t now_us);
+	void UpdateThreshold(double modified_trend, int64_t now_us);
+	void UpdateAckedBitrate(size_t size, int64_t arrival_time_us);
+	void UpdateEstimate(double loss_rate, int64_t now_us);
+
+	mutable std::mutex _mutex;
+
+	std::vector<SentPacket> _sent_packets;
+
+	PacketGroup _current_group;
+	PacketGroup _previous_group;
+
+	// Trendline estimator
+	int64_t _first_arrival_time_us = -1;
+	double _accumulated_delay_ms = 0.0;
+	double _smoothed_delay_ms = 0.0;
+	// (arrival time from the first arrival, smoothed delay)
+	std::deque<std::pair<double, double>> _delay_history;
+	size_t _num_of_deltas = 0;
+
+	// Overuse detector
+	double _threshold = 12.5;
+	double _previous_trend = 0.0;
+	double _time_over_using_ms = -1.0;
+	int _overuse_counter = 0;
+	int64_t _last_threshold_update_time_us = -1;
+	BandwidthUsage _bandwidth_usage = BandwidthUsage::Normal;
+
+	// Acknowledged bitrate
+	// (arrival time, size)
+	std::deque<std::pair<int64_t, size_t>> _acked_packets;
+	int64_t _first_acked_time_us = -1;
+	size_t _acked_bytes_in_window = 0;
+	uint32_t _acked_bitrate = 0;
+
+	// Rate control
+	uint32_t _estimated_bitrate;
+	uint32_t _min_bitrate;
+	uint32_t _max_bitrate;
+	int64_t _last_update_time_us = -1;
+	int64_t _last_delay_decrease_time_us = -1;
+	int64_t _last_loss_decrease_time_us = -1;
+	double _loss_rate = 0.0;
+};
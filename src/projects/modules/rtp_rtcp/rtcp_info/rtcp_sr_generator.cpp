@@ -8,7 +8,7 @@ RtcpSRGenerator::RtcpSRGenerator(uint32_t ssrc)
     _last_generated_time = std::chrono::system_clock::now();
 }
 
-void RtcpSRGenerator::AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet)
+void RtcpSRGenerator::AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet, uint32_t timestamp_offset)
 {
     _packet_count ++;
     _octec_count += rtp_packet.PayloadSize();
@@ -29,7 +29,7 @@ void RtcpSRGenerator::AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet)
 		report->SetSenderSsrc(_ssrc);
 		report->SetMsw(msw);
 		report->SetLsw(lsw);
-		report->SetTimestamp(rtp_packet.Timestamp());
+		report->SetTimestamp(rtp_packet.Timestamp() + timestamp_offset);
 		report->SetPacketCount(_packet_count);
 		report->SetOctetCount(_octec_count);
 
@@ -9,7 +9,8 @@ class RtcpSRGenerator
 public:
     RtcpSRGenerator(uint32_t ssrc);
 
-	void AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet);
+	// timestamp_offset: Offset which is added to the timestamp of the packet when it is sent (ex: The stream of the session has been switched)
+	void AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet, uint32_t timestamp_offset = 0);
 	bool IsAvailableRtcpSRPacket() const;
 	std::shared_ptr<RtcpPacket>   PopRtcpSRPacket();
 	
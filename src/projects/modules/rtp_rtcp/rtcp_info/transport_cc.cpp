@@ -0,0 +1,155 @@
+#include "transport_cc.h"
+#include "rtcp_private.h"
+#include <base/ovlibrary/byte_io.h>
+
+// Packet status symbols
+#define TRANSPORT_CC_STATUS_NOT_RECEIVED	0
+#define TRANSPORT_CC_STATUS_SMALL_DELTA		1
+#define TRANSPORT_CC_STATUS_LARGE_DELTA		2
+
+#define TRANSPORT_CC_FIXED_FIELD_SIZE		16
+#define TRANSPORT_CC_REFERENCE_TIME_UNIT_US	64000
+#define TRANSPORT_CC_DELTA_UNIT_US			250
+
+bool TransportCc::Parse(const RtcpPacket &packet)
+{
+	const uint8_t *payload = packet.GetPayload();
+	size_t payload_size = packet.GetPayloadSize();
+
+	if(payload_size < static_cast<size_t>(TRANSPORT_CC_FIXED_FIELD_SIZE))
+	{
+		logtd("Payload is too small to parse Transport-cc feedback");
+		return false;
+	}
+
+	_src_ssrc = ByteReader<uint32_t>::ReadBigEndian(&payload[0]);
+	_media_ssrc = ByteReader<uint32_t>::ReadBigEndian(&payload[4]);
+	_base_sequence_number = ByteReader<uint16_t>::ReadBigEndian(&payload[8]);
+	uint16_t status_count = ByteReader<uint16_t>::ReadBigEndian(&payload[10]);
+
+	// 24 bits signed integer
+	int32_t reference_time = static_cast<int32_t>(ByteReader<uint32_t>::ReadBigEndian(&payload[12]) >> 8);
+	if(reference_time & 0x800000)
+	{
+		reference_time -= 0x1000000;
+	}
+	_feedback_packet_count = payload[15];
+
+	size_t offset = TRANSPORT_CC_FIXED_FIELD_SIZE;
+
+	// Collect the status symbols
+	std::vector<uint8_t> symbols;
+	symbols.reserve(status_count);
+
+	while(symbols.size() < status_count)
+	{
+		if(offset + 2 > payload_size)
+		{
+			logtd("Transport-cc feedback is truncated in packet chunks");
+			return false;
+		}
+
+		uint16_t chunk = ByteReader<uint16_t>::ReadBigEndian(&payload[offset]);
+		offset += 2;
+
+		if((chunk & 0x8000) == 0)
+		{
+			// Run length chunk
+			//  0                   1
+			//  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5
+			// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+			// |T| S |       Run Length        |
+			// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+			uint8_t symbol = (chunk >> 13) & 0x03;
+			size_t run_length = std::min<size_t>(chunk & 0x1FFF, status_count - symbols.size());
+
+			symbols.insert(symbols.end(), run_length, symbol);
+		}
+		else if((chunk & 0x4000) == 0)
+		{
+			// Status vector chunk with 14 one-bit symbols
+			for(int i = 13; (i >= 0) && (symbols.size() < status_count); i--)
+			{
+				symbols.push_back((chunk >> i) & 0x01);
+			}
+		}
+		else
+		{
+			// Status vector chunk with 7 two-bit symbols
+			for(int i = 6; (i >= 0) && (symbols.size() < status_count); i--)
+			{
+				symbols.push_back((chunk >> (i * 2)) & 0x03);
+			}
+		}
+	}
+
+	// Read the receive deltas
+	_packet_feedbacks.clear();
+	_packet_feedbacks.reserve(status_count);
+
+	int64_t arrival_time_us = static_cast<int64_t>(reference_time) * TRANSPORT_CC_REFERENCE_TIME_UNIT_US;
+	uint16_t sequence_number = _base_sequence_number;
+
+	for(auto symbol : symbols)
+	{
+		PacketFeedback feedback;
+		feedback.sequence_number = sequence_number++;
+
+		switch(symbol)
+		{
+			case TRANSPORT_CC_STATUS_SMALL_DELTA:
+				if(offset + 1 > payload_size)
+				{
+					logtd("Transport-cc feedback is truncated in receive deltas");
+					return false;
+				}
+
+				arrival_time_us += static_cast<int64_t>(payload[offset]) * TRANSPORT_CC_DELTA_UNIT_US;
+				offset += 1;
+				feedback.received = true;
+				break;
+
+			case TRANSPORT_CC_STATUS_LARGE_DELTA:
+				if(offset + 2 > payload_size)
+				{
+					logtd("Transport-cc feedback is truncated in receive deltas");
+					return false;
+				}
+
+				arrival_time_us += static_cast<int64_t>(static_cast<int16_t>(ByteReader<uint16_t>::ReadBigEndian(&payload[offset]))) * TRANSPORT_CC_DELTA_UNIT_US;
+				offset += 2;
+				feedback.received = true;
+				break;
+
+			case TRANSPORT_CC_STATUS_NOT_RECEIVED:
+			default:
+				feedback.received = false;
+				break;
+		}
+
+		feedback.arrival_time_us = feedback.received ? arrival_time_us : 0;
+
+		_packet_feedbacks.push_back(feedback);
+	}
+
+	return true;
+}
+
+// RtcpInfo must provide raw data
+std::shared_ptr<ov::Data> TransportCc::GetData() const
+{
+	return nullptr;
+}
+
+void TransportCc::DebugPrint()
+{
+	size_t received_count = 0;
+
+	for(const auto &feedback : _packet_feedbacks)
+	{
+		received_count += feedback.received ? 1 : 0;
+	}
+
+	logtd("Transport-cc >> base seq(%u) status count(%zu) received(%zu) fb pkt count(%u)",
+		  _base_sequence_number, _packet_feedbacks.size(), received_count, _feedback_packet_count);
+}
@@ -2,6 +2,7 @@
 #include "rtcp_info/sender_report.h"
 #include "rtcp_info/receiver_report.h"
 #include "rtcp_info/nack.h"
+#include "rtcp_info/transport_cc.h"
 
 #include "rtcp_info/rtcp_private.h"
 
@@ -42,6 +43,10 @@ bool RtcpReceiver::ParseCompoundPacket(const std::shared_ptr<const ov::Data> &pa
 				{
 					info = std::make_shared<NACK>();
 				}
+				else if(rtcp_packet.GetFMT() == static_cast<uint8_t>(RTPFBFMT::TRANSPORT_CC))
+				{
+					info = std::make_shared<TransportCc>();
+				}
 				else
 				{
 					logtd("Does not support RTPFB format : %d", rtcp_packet.GetFMT());
@@ -8,7 +8,14 @@ std::shared_ptr<ov::Data> RtpDepacketizerH264::ParseAndAssembleFrame(std::vector
 		return nullptr;
 	}
 
-	auto bitstream = std::make_shared<ov::Data>();
+	// A start code per payload (the buffer grows if STAP-A has many NAL units)
+	size_t capacity = 0;
+	for(const auto &payload : payload_list)
+	{
+		capacity += payload->GetLength() + ANNEXB_START_PREFIX_LENGTH;
+	}
+
+	auto bitstream = std::make_shared<ov::Data>(capacity, true);
 
 	for(const auto &payload : payload_list)
 	{
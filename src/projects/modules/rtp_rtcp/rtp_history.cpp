@@ -1,65 +1,83 @@
 #include "rtp_history.h"
 
+#include <thread>
+
 RtpHistory::RtpHistory(uint8_t origin_payload_type, uint8_t rtx_payload_type, uint32_t rtx_ssrc, uint32_t max_history_size)
 {
 	_origin_paylod_type = origin_payload_type;
 	_rtx_paylod_type = rtx_payload_type;
 	_rtx_ssrc = rtx_ssrc;
-	_max_history_size = max_history_size;
 
-	_history.reserve(_max_history_size);
+	// Power of 2, which divides 65536
+	_max_history_size = 1;
+	while((_max_history_size < max_history_size) && (_max_history_size < 65536))
+	{
+		_max_history_size <<= 1;
+	}
+
+	_slots = std::make_unique<Slot[]>(_max_history_size);
+	_slot_mask = _max_history_size - 1;
 }
 
 // Converting to RtxRtpPacket
 bool RtpHistory::StoreRtpPacket(const std::shared_ptr<RtpPacket> &packet)
 {
-	std::lock_guard<std::shared_mutex> guard(_history_lock);
+	auto &slot = _slots[GetIndex(packet->SequenceNumber())];
+
+	// The readers which see the odd version don't access the slot
+	auto version = slot.version.load(std::memory_order_relaxed);
+	slot.version.store(version + 1, std::memory_order_seq_cst);
 
-	_history[GetIndex(packet->SequenceNumber())] = packet;
+	// Wait for the readers which pinned the slot before
+	while(slot.readers.load(std::memory_order_seq_cst) != 0)
+	{
+		std::this_thread::yield();
+	}
+
+	slot.seq_no = packet->SequenceNumber();
+	slot.packet = packet;
+	slot.rtx_packet = nullptr;
+	slot.rtx_state.store(RtxState::None, std::memory_order_relaxed);
+
+	slot.version.store(version + 2, std::memory_order_release);
 
 	return true;
 }
 
 std::shared_ptr<RtxRtpPacket> RtpHistory::GetRtxRtpPacket(uint16_t seq_no)
 {
-	auto index = GetIndex(seq_no);
-	// First, look in the cache
-	std::shared_lock<std::shared_mutex> cache_guard(_history_cache_lock);
-	auto cache_item = _history_cache.find(index);
-	if(cache_item != _history_cache.end())
-	{
-		// Found!
-		auto rtx_packet = cache_item->second;
-		
-		if(rtx_packet->GetOriginalSequenceNumber() == seq_no)// && ov::Clock::GetElapsedMiliSecondsFromNow(rtx_packet->GetCreatedTime()) < VALID_TIME_MS_STORED_RTP_PACKET)
-		{
-			return rtx_packet;
-		}
-	}
-	cache_guard.unlock();
+	auto &slot = _slots[GetIndex(seq_no)];
+	std::shared_ptr<RtxRtpPacket> rtx_packet;
 
-	// find in rtp history
-	std::shared_lock<std::shared_mutex> history_guard(_history_lock);
-	auto rtp_item = _history.find(index);
-	if(rtp_item != _history.end())
+	// Pin the slot, the writer doesn't replace the packet until it is unpinned
+	slot.readers.fetch_add(1, std::memory_order_seq_cst);
+
+	auto version = slot.version.load(std::memory_order_seq_cst);
+	if(((version & 1) == 0) && (slot.packet != nullptr) && (slot.seq_no == seq_no))
 	{
-		auto rtp_packet = rtp_item->second;
-		history_guard.unlock();
+		// now, I consider all requests are valid because webrtc player doesn't ask for too old packet anyway
+		auto rtx_state = slot.rtx_state.load(std::memory_order_acquire);
 
-		// now, I consider all requests are valid because webrtc player doesn't ask for too old packet anyway 
-		//auto elapsed_ms = ov::Clock::GetElapsedMiliSecondsFromNow(rtp_packet->GetCreatedTime());
-		//if(elapsed_ms < VALID_TIME_MS_STORED_RTP_PACKET)
-		if(rtp_packet->SequenceNumber() == seq_no)
+		if(rtx_state == RtxState::Created)
 		{
-			// Create Rtx Packet and store it
-			auto rtx_packet = std::make_shared<RtxRtpPacket>(GetRtxSsrc(), GetRtxPayloadType(), *rtp_packet);
-			cache_guard.lock();
-			_history_cache[index] = rtx_packet;
-			return rtx_packet;
+			rtx_packet = slot.rtx_packet;
+		}
+		else
+		{
+			rtx_packet = std::make_shared<RtxRtpPacket>(GetRtxSsrc(), GetRtxPayloadType(), *slot.packet);
+
+			// Only the first reader stores it, the others which are requesting at the same time use their own packet
+			if((rtx_state == RtxState::None) && slot.rtx_state.compare_exchange_strong(rtx_state, RtxState::Creating, std::memory_order_acquire))
+			{
+				slot.rtx_packet = rtx_packet;
+				slot.rtx_state.store(RtxState::Created, std::memory_order_release);
+			}
 		}
 	}
 
-	return nullptr;
+	slot.readers.fetch_sub(1, std::memory_order_release);
+
+	return rtx_packet;
 }
 
 uint8_t	RtpHistory::GetOriginPayloadType()
@@ -77,7 +95,7 @@ uint8_t RtpHistory::GetRtxPayloadType()
 	return _rtx_paylod_type;
 }
 
-uint16_t RtpHistory::GetIndex(uint16_t seq_no)
+uint32_t RtpHistory::GetIndex(uint16_t seq_no)
 {
-	return seq_no % _max_history_size;
-}
\ No newline at end of file
+	return seq_no & _slot_mask;
+}
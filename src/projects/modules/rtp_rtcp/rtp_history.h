@@ -4,10 +4,17 @@
 #include "rtx_rtp_packet.h"
 
 // WebRTC-Native-Code uses 9600 value
-#define DEFAULT_MAX_HISTORY_CAPACITY	1500
+// It is rounded up to a power of 2 so that the index of a sequence number is kept across the wraparound of uint16_t
+#define DEFAULT_MAX_HISTORY_CAPACITY	2048
 // Stored RTP packet is only valid for 3 second after being created
 #define VALID_TIME_MS_STORED_RTP_PACKET	3000
 
+// A ring of RTP packets indexed by the sequence number.
+//
+// StoreRtpPacket() is called only by the packetizer thread, and GetRtxRtpPacket() is called by the threads of all sessions
+// which received NACK. The readers never take a lock: they pin the slot, and validate the slot with the version
+// (odd while the writer is replacing the packet) and the sequence number, like a seqlock.
+// The writer waits for the pinned readers only when it replaces the slot, which is rarely requested since the packet is old.
 class RtpHistory
 {
 public:
@@ -22,31 +29,37 @@ public:
 	uint8_t GetRtxPayloadType();
 
 private:
-	uint16_t GetIndex(uint16_t seq_no);
-	
-	// This map maps a hash(made with "origin sequence number" % max_history_size) and an RtpPacket.
-	// And this map never erases items for performance reason. 
-
-	// Yes, this map will have a collision once per max_history_size. 
-	// However, the default value of 9600 is a very large value, and collision packets 
-	// with 9600 sequence number differences are very old packets. 
-	// Since RTP packets have a creation time, old packets may not be used. 
-	// This can avoid collision. Therefore, set max_history_size to a large value as possible.
-	std::shared_mutex	_history_lock;
-	std::unordered_map<uint16_t, std::shared_ptr<RtpPacket>> _history;
-
-	// Creating RtxRtpPacket requires computing resources, but not all of them are used
-	// (only for packets requested by the session with NACK). 
-	// Therefore, it is unnecessary to create all packets with RtxRtpPacket in advance. 
-	// It is also wasteful to create another RtxRtpPacket once created. 
-	// When GetRtxRtpPacket() is called, it first looks for a packet in the cache and 
-	// checks if it is valid (by creation time). 
-	// If it is not valid, a new RtxRtpPacket is created, cached, and returned.
-	std::shared_mutex	_history_cache_lock;
-	std::unordered_map<uint16_t, std::shared_ptr<RtxRtpPacket>> _history_cache;
+	enum class RtxState : uint8_t
+	{
+		None,
+		Creating,
+		Created
+	};
+
+	struct Slot
+	{
+		// Odd while the writer is replacing the packet
+		std::atomic<uint32_t> version{0};
+		// The number of readers which are accessing packet/rtx_packet
+		std::atomic<uint32_t> readers{0};
+
+		uint16_t seq_no = 0;
+		std::shared_ptr<RtpPacket> packet;
+
+		// Creating RtxRtpPacket requires computing resources, but not all of them are used
+		// (only for packets requested by the session with NACK).
+		// Therefore, RtxRtpPacket is created when it is requested first, and shared by all sessions.
+		std::atomic<RtxState> rtx_state{RtxState::None};
+		std::shared_ptr<RtxRtpPacket> rtx_packet;
+	};
+
+	uint32_t GetIndex(uint16_t seq_no);
+
+	std::unique_ptr<Slot[]> _slots;
+	uint32_t _slot_mask;
 
 	uint8_t		_origin_paylod_type;
 	uint32_t	_rtx_ssrc;
 	uint8_t		_rtx_paylod_type;
 	uint32_t	_max_history_size;
-};
\ No newline at end of file
+};
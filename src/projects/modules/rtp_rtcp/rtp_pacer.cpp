@@ -0,0 +1,296 @@
+#include "rtp_pacer.h"
+
+#include <algorithm>
+#include <chrono>
+
+#define OV_LOG_TAG "RtpPacer"
+
+static int64_t GetCurrentTimeUs()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+RtpPacer::RtpPacer(uint32_t pacing_bitrate, SendCallback send_callback)
+	: _send_callback(std::move(send_callback)),
+	  _pacing_bitrate(pacing_bitrate)
+{
+}
+
+void RtpPacer::SetPacingBitrate(uint32_t pacing_bitrate)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	if (_is_sending == false)
+	{
+		// Apply the elapsed time to the budget at the previous bitrate
+		_is_sending = true;
+		SendPackets(lock);
+	}
+
+	_pacing_bitrate = pacing_bitrate;
+}
+
+uint32_t RtpPacer::GetPacingBitrate() const
+{
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+	return _pacing_bitrate;
+}
+
+void RtpPacer::Enqueue(const std::shared_ptr<RtpPacket> &packet, bool is_high_priority, bool is_retransmission)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	if (_is_stopped)
+	{
+		return;
+	}
+
+	if ((is_high_priority == false) && _is_waiting_for_keyframe)
+	{
+		if (packet->IsKeyframeStart() == false)
+		{
+			// The viewer cannot decode the frames until the keyframe
+			_dropped_count++;
+			return;
+		}
+
+		_is_waiting_for_keyframe = false;
+	}
+
+	auto now_us = GetCurrentTimeUs();
+
+	QueuedPacket queued_packet;
+	queued_packet.packet = packet;
+	queued_packet.is_retransmission = is_retransmission;
+	queued_packet.enqueued_time_us = now_us;
+
+	if (is_high_priority)
+	{
+		_high_priority_queue.push_back(std::move(queued_packet));
+	}
+	else
+	{
+		_normal_priority_queue.push_back(std::move(queued_packet));
+	}
+
+	_queued_bytes += packet->GetData()->GetLength();
+
+	if (_is_sending)
+	{
+		// The sending thread picks up the packet when it has sent the current packets
+		_is_process_requested = true;
+		return;
+	}
+
+	_is_sending = true;
+	SendPackets(lock);
+}
+
+void RtpPacer::Process()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	if (_is_stopped)
+	{
+		return;
+	}
+
+	if (_is_sending)
+	{
+		_is_process_requested = true;
+		return;
+	}
+
+	_is_sending = true;
+	SendPackets(lock);
+}
+
+void RtpPacer::SendPackets(std::unique_lock<std::mutex> &lock)
+{
+	_sending_thread_id = std::this_thread::get_id();
+
+	do
+	{
+		_is_process_requested = false;
+
+		ProcessInternal(GetCurrentTimeUs());
+
+		if (_send_list.empty())
+		{
+			break;
+		}
+
+		lock.unlock();
+
+		for (auto &queued_packet : _send_list)
+		{
+			if (_is_stopped)
+			{
+				// Stop() has been called (by another thread, or by the send callback)
+				break;
+			}
+
+			_send_callback(queued_packet.packet, queued_packet.is_retransmission);
+		}
+
+		_send_list.clear();
+
+		lock.lock();
+	} while (_is_process_requested && (_is_stopped == false));
+
+	_sending_thread_id = std::thread::id();
+	_is_sending = false;
+
+	_sending_finished.notify_all();
+}
+
+void RtpPacer::Stop()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	_is_stopped = true;
+
+	_high_priority_queue.clear();
+	_normal_priority_queue.clear();
+	_queued_bytes = 0;
+
+	if (_sending_thread_id != std::this_thread::get_id())
+	{
+		_sending_finished.wait(lock, [this]() -> bool {
+			return _is_sending == false;
+		});
+	}
+}
+
+bool RtpPacer::IsStopped() const
+{
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+	return _is_stopped;
+}
+
+void RtpPacer::DropExpiredPackets(std::deque<QueuedPacket> &queue, int64_t now_us)
+{
+	while ((queue.empty() == false) && ((now_us - queue.front().enqueued_time_us) > (RTP_PACER_MAX_QUEUE_DELAY_MS * 1000)))
+	{
+		_queued_bytes -= queue.front().packet->GetData()->GetLength();
+		queue.pop_front();
+		_dropped_count++;
+	}
+}
+
+void RtpPacer::DropExpiredFrames(int64_t now_us)
+{
+	auto &queue = _normal_priority_queue;
+
+	if (queue.empty() || ((now_us - queue.front().enqueued_time_us) <= (RTP_PACER_MAX_QUEUE_DELAY_MS * 1000)))
+	{
+		return;
+	}
+
+	// Dropping a part of a frame breaks the frames until the next keyframe, so skip to the newest keyframe
+	auto keyframe = std::find_if(queue.rbegin(), queue.rend(), [](const QueuedPacket &queued_packet) -> bool {
+		return queued_packet.packet->IsKeyframeStart();
+	});
+
+	auto drop_count = static_cast<size_t>(std::distance(keyframe, queue.rend()));
+
+	if (keyframe == queue.rend())
+	{
+		// There is no keyframe in the queue, so the packets are dropped until a keyframe is enqueued
+		drop_count = queue.size();
+		_is_waiting_for_keyframe = true;
+	}
+	else
+	{
+		// Keep the keyframe
+		drop_count--;
+	}
+
+	for (size_t index = 0; index < drop_count; index++)
+	{
+		_queued_bytes -= queue.front().packet->GetData()->GetLength();
+		queue.pop_front();
+	}
+
+	_dropped_count += drop_count;
+}
+
+void RtpPacer::ProcessInternal(int64_t now_us)
+{
+	if (_last_process_time_us < 0)
+	{
+		_last_process_time_us = now_us;
+	}
+
+	auto elapsed_us = now_us - _last_process_time_us;
+	_last_process_time_us = now_us;
+
+	if (_pacing_bitrate == 0)
+	{
+		// Pacing is disabled: send everything
+		_budget_bytes = std::numeric_limits<double>::max();
+	}
+	else
+	{
+		double bytes_per_us = static_cast<double>(_pacing_bitrate) / 8.0 / 1000000.0;
+		// A packet must be able to be sent even if the bitrate is very low
+		double max_budget_bytes = std::max(bytes_per_us * RTP_PACER_MAX_BURST_MS * 1000.0, static_cast<double>(RTP_DEFAULT_MAX_PACKET_SIZE));
+
+		_budget_bytes = std::min(_budget_bytes + (bytes_per_us * elapsed_us), max_budget_bytes);
+	}
+
+	auto previous_dropped_count = _dropped_count;
+	DropExpiredPackets(_high_priority_queue, now_us);
+	DropExpiredFrames(now_us);
+
+	if (previous_dropped_count != _dropped_count)
+	{
+		logtd("%" PRIu64 " packets are dropped because they have been queued for more than %d ms (pacing bitrate: %u bps%s)",
+			  _dropped_count - previous_dropped_count, RTP_PACER_MAX_QUEUE_DELAY_MS, _pacing_bitrate,
+			  _is_waiting_for_keyframe ? ", waiting for a keyframe" : "");
+	}
+
+	while (_budget_bytes > 0.0)
+	{
+		std::deque<QueuedPacket> *queue = nullptr;
+
+		if (_high_priority_queue.empty() == false)
+		{
+			queue = &_high_priority_queue;
+		}
+		else if (_normal_priority_queue.empty() == false)
+		{
+			queue = &_normal_priority_queue;
+		}
+		else
+		{
+			break;
+		}
+
+		auto queued_packet = std::move(queue->front());
+		queue->pop_front();
+
+		auto length = queued_packet.packet->GetData()->GetLength();
+		_queued_bytes -= length;
+		_budget_bytes -= length;
+
+		_send_list.push_back(std::move(queued_packet));
+	}
+
+	if (_pacing_bitrate == 0)
+	{
+		_budget_bytes = 0.0;
+	}
+}
+
+size_t RtpPacer::GetQueuedBytes() const
+{
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+	return _queued_bytes;
+}
+
+uint64_t RtpPacer::GetDroppedCount() const
+{
+	std::lock_guard<std::mutex> lock_guard(_mutex);
+	return _dropped_count;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "base/ovlibrary/ovlibrary.h"
+#include "rtp_packet.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Burst which can be sent at once (in milliseconds of the pacing bitrate)
+#define RTP_PACER_MAX_BURST_MS			50
+// Packets which are queued longer than this are dropped (The viewer cannot play them anyway)
+#define RTP_PACER_MAX_QUEUE_DELAY_MS	2000
+
+// Sends the RTP packets of a session at the pacing bitrate (usually a multiple of the estimated bandwidth),
+// so a viewer on a constrained link does not receive a keyframe as a single huge burst.
+//
+// - High priority packets (audio, retransmission) are sent before the normal priority packets (video)
+// - The queue is processed whenever a packet is enqueued or Process() is called. The budget is accumulated for up to
+//   RTP_PACER_MAX_BURST_MS, so the owner calls Process() at least that often while the packets are queued
+//   (ex: whenever the stream worker has delivered a batch of packets), otherwise they wait for the next call.
+// - The packets are sent outside the lock of the queue, so Enqueue() never waits for the socket.
+//   Only one thread sends at a time: a thread which calls Process() while another is sending leaves the packets to it.
+// - If a video packet is queued for more than RTP_PACER_MAX_QUEUE_DELAY_MS, the video packets are dropped up to
+//   the newest keyframe in the queue (or the next keyframe to be enqueued), so the viewer never receives a partial frame
+class RtpPacer
+{
+public:
+	// Called by one thread at a time (without the lock of the queue), so the packets of a session are sent in order
+	using SendCallback = std::function<bool(const std::shared_ptr<RtpPacket> &packet, bool is_retransmission)>;
+
+	RtpPacer(uint32_t pacing_bitrate, SendCallback send_callback);
+
+	void SetPacingBitrate(uint32_t pacing_bitrate);
+	uint32_t GetPacingBitrate() const;
+
+	void Enqueue(const std::shared_ptr<RtpPacket> &packet, bool is_high_priority, bool is_retransmission);
+
+	// Sends the queued packets as many as the budget allows
+	void Process();
+
+	// Drops the queued packets. The send callback is not called after this returns
+	// (Waits for the thread which is sending the packets, unless it is called from the send callback)
+	void Stop();
+	bool IsStopped() const;
+
+	size_t GetQueuedBytes() const;
+	uint64_t GetDroppedCount() const;
+
+private:
+	struct QueuedPacket
+	{
+		std::shared_ptr<RtpPacket> packet;
+		bool is_retransmission = false;
+		int64_t enqueued_time_us = 0;
+	};
+
+	// Moves the packets which can be sent within the budget to _send_list
+	void ProcessInternal(int64_t now_us);
+	// Sends the packets until there is nothing more to send (called by the thread which set _is_sending)
+	void SendPackets(std::unique_lock<std::mutex> &lock);
+	void DropExpiredPackets(std::deque<QueuedPacket> &queue, int64_t now_us);
+	// Drops the expired video packets up to the newest keyframe of the queue
+	void DropExpiredFrames(int64_t now_us);
+
+	mutable std::mutex _mutex;
+
+	SendCallback _send_callback;
+
+	// true while a thread is sending the packets of _send_list
+	bool _is_sending = false;
+	// Set when Enqueue()/Process() is called while another thread is sending
+	bool _is_process_requested = false;
+	std::thread::id _sending_thread_id;
+	std::condition_variable _sending_finished;
+	// Used only by the sending thread
+	std::vector<QueuedPacket> _send_list;
+
+	std::deque<QueuedPacket> _high_priority_queue;
+	std::deque<QueuedPacket> _normal_priority_queue;
+	size_t _queued_bytes = 0;
+
+	uint32_t _pacing_bitrate = 0;
+	// Bytes which can be sent now. It can be negative because a packet is sent as a whole
+	double _budget_bytes = 0.0;
+	int64_t _last_process_time_us = -1;
+
+	// The video packets are dropped until a keyframe is enqueued
+	bool _is_waiting_for_keyframe = false;
+
+	// Also checked by the sending thread without the lock
+	std::atomic<bool> _is_stopped{false};
+
+	uint64_t _dropped_count = 0;
+};
@@ -37,6 +37,7 @@ RtpPacket::RtpPacket(RtpPacket &src)
 	_marker = src._marker;
 	_payload_type = src._payload_type;
 	_origin_payload_type = src._origin_payload_type;
+	_is_keyframe_start = src._is_keyframe_start;
 	_ssrc = src._ssrc;
 	_payload_offset = src._payload_offset;
 	_payload_size = src._payload_size;
@@ -94,6 +95,7 @@ bool RtpPacket::Parse(const std::shared_ptr<const ov::Data> &data)
 	// It is specific values only for OME
 	_is_fec = false;
 	_origin_payload_type = 0;
+	_is_keyframe_start = false;
 
 	// Marker
 	_marker = (buffer[1] & 0x80) != 0;
@@ -192,6 +194,11 @@ bool RtpPacket::IsUlpfec() const
 	return _is_fec;
 }
 
+bool RtpPacket::IsKeyframeStart() const
+{
+	return _is_keyframe_start;
+}
+
 uint8_t RtpPacket::PayloadType() const
 {
 	return _payload_type;
@@ -261,6 +268,11 @@ void RtpPacket::SetUlpfec(bool is_fec, uint8_t origin_payload_type)
 	_origin_payload_type = origin_payload_type;
 }
 
+void RtpPacket::SetKeyframeStart(bool is_keyframe_start)
+{
+	_is_keyframe_start = is_keyframe_start;
+}
+
 void RtpPacket::SetSequenceNumber(uint16_t seq_no)
 {
 	_sequence_number = seq_no;
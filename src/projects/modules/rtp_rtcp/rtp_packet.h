@@ -51,6 +51,8 @@ public:
 	// For FEC Payload
 	bool		IsUlpfec() const;
 	uint8_t 	OriginPayloadType() const;
+	// Whether the packet is the first packet of a keyframe (It is specific value only for OME, not serialized)
+	bool		IsKeyframeStart() const;
 	uint16_t	SequenceNumber() const;
 	uint32_t	Timestamp() const;
 	uint32_t	Ssrc() const;
@@ -62,6 +64,7 @@ public:
 	void		SetPayloadType(uint8_t payload_type);
 	// For FEC Payload
 	void 		SetUlpfec(bool is_fec, uint8_t origin_payload_type);
+	void		SetKeyframeStart(bool is_keyframe_start);
 	void		SetSequenceNumber(uint16_t seq_no);
 	void		SetTimestamp(uint32_t timestamp);
 	void		SetSsrc(uint32_t ssrc);
@@ -99,6 +102,7 @@ protected:
 	uint8_t		_payload_type = 0;
 	bool		_is_fec = false;
 	uint8_t 	_origin_payload_type = 0;
+	bool		_is_keyframe_start = false;
 	uint8_t		_padding_size = 0;
 	uint16_t	_sequence_number = 0;
 	uint32_t	_timestamp = 0;
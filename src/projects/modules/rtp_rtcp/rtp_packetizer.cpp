@@ -135,6 +135,9 @@ bool RtpPacketizer::PacketizeVideo(cmn::MediaCodecId video_type,
 			return false;
 		}
 
+		// A session can start (or switch to this stream) only from the first packet of a keyframe
+		packet->SetKeyframeStart((i == 0) && (frame_type == FrameType::VideoFrameKey));
+
 		_rtp_packet_count ++;
 		_stream->OnRtpPacketized(packet);
 
@@ -152,6 +155,7 @@ bool RtpPacketizer::GenerateRedAndFecPackets(std::shared_ptr<RtpPacket> packet)
 {
 	// Send RED
 	auto red_packet = PackageAsRed(packet);
+	red_packet->SetKeyframeStart(packet->IsKeyframeStart());
 
 	// Separate the sequence number of the RED packet from RTP packet.
 	// Because FEC packet should not affect the sequence number of the RTP packet.
@@ -72,6 +72,11 @@ bool RtpRtcp::Stop()
 }
 
 bool RtpRtcp::SendRtpPacket(const std::shared_ptr<RtpPacket> &rtp_packet)
+{
+	return SendRtpPacket(rtp_packet, rtp_packet->GetData());
+}
+
+bool RtpRtcp::SendRtpPacket(const std::shared_ptr<RtpPacket> &rtp_packet, const std::shared_ptr<ov::Data> &data, uint32_t timestamp_offset)
 {
 	std::shared_lock<std::shared_mutex> lock(_state_lock);
 	// nothing to do before node start
@@ -86,7 +91,7 @@ bool RtpRtcp::SendRtpPacket(const std::shared_ptr<RtpPacket> &rtp_packet)
     {
 		auto rtcp_sr_generator = it->second;
 		
-		rtcp_sr_generator->AddRTPPacketAndGenerateRtcpSR(*rtp_packet);
+		rtcp_sr_generator->AddRTPPacketAndGenerateRtcpSR(*rtp_packet, timestamp_offset);
 		if(rtcp_sr_generator->IsAvailableRtcpSRPacket())
 		{
 			auto rtcp_sr_packet = rtcp_sr_generator->PopRtcpSRPacket();
@@ -103,7 +108,7 @@ bool RtpRtcp::SendRtpPacket(const std::shared_ptr<RtpPacket> &rtp_packet)
 	}
 
 	_last_sent_rtp_packet = rtp_packet;
-	return SendDataToNextNode(NodeType::Rtp, rtp_packet->GetData());
+	return SendDataToNextNode(NodeType::Rtp, data);
 }
 
 bool RtpRtcp::SendFir(uint32_t media_ssrc)
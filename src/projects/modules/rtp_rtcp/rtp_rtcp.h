@@ -30,6 +30,9 @@ public:
 	bool Stop() override;
 
 	bool SendRtpPacket(const std::shared_ptr<RtpPacket> &packet);
+	// Sends data (a writable copy of packet, ex: from RtpSendBufferPool) instead of the packet's own data,
+	// packet is used for RTCP SR generation only (timestamp_offset is added to the RTP timestamp of the SR)
+	bool SendRtpPacket(const std::shared_ptr<RtpPacket> &packet, const std::shared_ptr<ov::Data> &data, uint32_t timestamp_offset = 0);
 	bool SendFir(uint32_t media_ssrc);
 
 	uint8_t GetReceivedPayloadType(uint32_t ssrc);
@@ -0,0 +1,116 @@
+#include "rtp_send_buffer_pool.h"
+#include "base/ovlibrary/byte_io.h"
+
+#include <atomic>
+
+RtpSendBufferPool &RtpSendBufferPool::GetInstance()
+{
+	static thread_local RtpSendBufferPool pool;
+
+	return pool;
+}
+
+RtpSendBufferPool::RtpSendBufferPool()
+{
+	_buffer_list.reserve(RTP_SEND_BUFFER_POOL_MAX_COUNT);
+}
+
+bool RtpSendBufferPool::IsReusable(const std::shared_ptr<ov::Data> &buffer)
+{
+	// The pool is the only owner of the instance and its memory (Data::Clone() shares the memory)
+	if ((buffer.use_count() == 1) && (buffer->IsBufferShared() == false))
+	{
+		// Make sure that the last reader of the buffer (ex: socket worker) has finished before overwriting it
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return true;
+	}
+
+	return false;
+}
+
+std::shared_ptr<ov::Data> RtpSendBufferPool::GetBuffer(size_t capacity, bool *is_allocated)
+{
+	std::shared_ptr<ov::Data> buffer;
+	bool allocated = false;
+
+	if ((_buffer_list.empty() == false) && IsReusable(_buffer_list[_next_index]))
+	{
+		buffer = _buffer_list[_next_index];
+		_next_index = (_next_index + 1) % _buffer_list.size();
+	}
+	else
+	{
+		buffer = std::make_shared<ov::Data>(std::max<size_t>(capacity, RTP_DEFAULT_MAX_PACKET_SIZE + RTP_SEND_BUFFER_SRTP_TRAILER_SIZE));
+		allocated = true;
+
+		if (_buffer_list.size() < RTP_SEND_BUFFER_POOL_MAX_COUNT)
+		{
+			// Grow the slab: insert the buffer at the current position so that the order of use is kept
+			_buffer_list.insert(_buffer_list.begin() + _next_index, buffer);
+			_next_index = (_next_index + 1) % _buffer_list.size();
+		}
+	}
+
+	if (buffer->GetCapacity() < capacity)
+	{
+		buffer->Reserve(capacity);
+	}
+
+	if (is_allocated != nullptr)
+	{
+		*is_allocated = allocated;
+	}
+
+	return buffer;
+}
+
+std::shared_ptr<ov::Data> RtpSendBufferPool::Copy(const std::shared_ptr<RtpPacket> &packet, bool *is_allocated)
+{
+	auto source = packet->GetData();
+	auto length = source->GetLength();
+
+	auto buffer = GetBuffer(length + RTP_SEND_BUFFER_SRTP_TRAILER_SIZE, is_allocated);
+
+	buffer->SetLength(length);
+	::memcpy(buffer->GetWritableData(), source->GetData(), length);
+
+	return buffer;
+}
+
+std::shared_ptr<ov::Data> RtpSendBufferPool::Copy(const std::shared_ptr<RtpPacket> &packet, uint8_t extension_id, uint16_t transport_sequence_number, bool *is_allocated)
+{
+	auto source = packet->GetData();
+	auto source_bytes = source->GetDataAs<uint8_t>();
+	auto length = source->GetLength();
+
+	// V(2) P(1) X(1) CC(4)
+	size_t fixed_header_size = FIXED_HEADER_SIZE + ((source_bytes[0] & 0x0F) * 4);
+
+	if ((extension_id == 0) || (extension_id > 14) || (source_bytes[0] & 0x10) || (length < fixed_header_size))
+	{
+		return Copy(packet, is_allocated);
+	}
+
+	auto buffer = GetBuffer(length + RTP_TRANSPORT_CC_EXTENSION_SIZE + RTP_SEND_BUFFER_SRTP_TRAILER_SIZE, is_allocated);
+
+	buffer->SetLength(length + RTP_TRANSPORT_CC_EXTENSION_SIZE);
+	auto bytes = buffer->GetWritableDataAs<uint8_t>();
+
+	::memcpy(bytes, source_bytes, fixed_header_size);
+	// Set the X bit
+	bytes[0] |= 0x10;
+
+	auto extension = bytes + fixed_header_size;
+	extension[0] = 0xBE;
+	extension[1] = 0xDE;
+	extension[2] = 0x00;
+	extension[3] = 0x01;
+	// L = 1 means that the data is 2 bytes
+	extension[4] = static_cast<uint8_t>((extension_id << 4) | 0x01);
+	ByteWriter<uint16_t>::WriteBigEndian(&extension[5], transport_sequence_number);
+	extension[7] = 0x00;
+
+	::memcpy(extension + RTP_TRANSPORT_CC_EXTENSION_SIZE, source_bytes + fixed_header_size, length - fixed_header_size);
+
+	return buffer;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include "rtp_packet.h"
+
+// Maximum number of buffers that a thread keeps
+#define RTP_SEND_BUFFER_POOL_MAX_COUNT		4096
+// SRTP appends an authentication tag (and MKI) to the packet in place
+#define RTP_SEND_BUFFER_SRTP_TRAILER_SIZE	32
+// One-byte header extension (RFC 8285) which has only the transport-wide sequence number
+// [0xBE 0xDE][length = 1][ID | L = 1][sequence number (2 bytes)][padding]
+#define RTP_TRANSPORT_CC_EXTENSION_SIZE		8
+
+// Each session encrypts the RTP packet of the stream with its own SRTP key, so the packet must be copied for each session.
+// RtpSendBufferPool keeps the copies in a slab owned by the calling thread (one per stream worker),
+// and a buffer is reused as soon as nobody refers to it (ex: after the socket sends it),
+// so the packet can be sent to many sessions without allocating memory.
+class RtpSendBufferPool
+{
+public:
+	// Returns the pool of the calling thread
+	static RtpSendBufferPool &GetInstance();
+
+	// Copies the RTP packet into a buffer which has enough capacity for SRTP protection.
+	// is_allocated is set to true if a new buffer is allocated (The pool is growing or exhausted)
+	std::shared_ptr<ov::Data> Copy(const std::shared_ptr<RtpPacket> &packet, bool *is_allocated = nullptr);
+
+	// Copies the RTP packet and inserts the transport-wide sequence number as a header extension of the copy.
+	// The packetized RTP packet is shared by all sessions, but the transport-wide sequence number belongs to each session.
+	// If the packet already has a header extension, the packet is copied as it is.
+	std::shared_ptr<ov::Data> Copy(const std::shared_ptr<RtpPacket> &packet, uint8_t extension_id, uint16_t transport_sequence_number, bool *is_allocated = nullptr);
+
+	size_t GetBufferCount() const
+	{
+		return _buffer_list.size();
+	}
+
+protected:
+	RtpSendBufferPool();
+
+	static bool IsReusable(const std::shared_ptr<ov::Data> &buffer);
+
+	// Returns a buffer which has the capacity or more
+	std::shared_ptr<ov::Data> GetBuffer(size_t capacity, bool *is_allocated);
+
+	std::vector<std::shared_ptr<ov::Data>> _buffer_list;
+	// The buffers are usually released in the order in which they were sent,
+	// so the next buffer of the last used one is checked first
+	size_t _next_index = 0;
+};
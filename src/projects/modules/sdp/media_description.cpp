@@ -74,6 +74,11 @@ bool MediaDescription::UpdateData(ov::String &sdp)
 		sdp.AppendFormat("a=msid:%s %s\r\n", _msid.CStr(), _msid_appdata.CStr());
 	}
 
+	for(const auto &extmap : _extmap_list)
+	{
+		sdp.AppendFormat("a=extmap:%d %s\r\n", extmap.first, extmap.second.CStr());
+	}
+
 	// Payloads
 	for(auto &payload : _payload_list)
 	{
@@ -341,6 +346,21 @@ bool MediaDescription::ParsingMediaLine(char type, std::string content)
 					EnableRtcpFb(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str(), true);
 				}
 			}
+			else if(content.compare(0, OV_COUNTOF("extmap") - 1, "extmap") == 0)
+			{
+				// a=extmap:1 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
+				// a=extmap:2/sendrecv urn:ietf:params:rtp-hdrext:toffset
+				if(std::regex_search(content, matches, std::regex("^extmap:(\\d+)(?:\\/\\w+)? (\\S+)")))
+				{
+					if(matches.size() != 2 + 1)
+					{
+						parsing_error = true;
+						break;
+					}
+
+					AddExtmap(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str());
+				}
+			}
 			else if(content.compare(0, OV_COUNTOF("mid") - 1, "mid") == 0)
 			{
 				// a=mid:video,
@@ -791,4 +811,32 @@ void MediaDescription::EnableRtcpFb(uint8_t id, const PayloadAttr::RtcpFbType &t
 	}
 
 	payload->EnableRtcpFb(type, on);
+}
+
+// a=extmap:1 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
+void MediaDescription::AddExtmap(uint8_t id, const ov::String &uri)
+{
+	for(auto &extmap : _extmap_list)
+	{
+		if(extmap.second == uri)
+		{
+			extmap.first = id;
+			return;
+		}
+	}
+
+	_extmap_list.emplace_back(id, uri);
+}
+
+uint8_t MediaDescription::GetExtmapId(const ov::String &uri) const
+{
+	for(const auto &extmap : _extmap_list)
+	{
+		if(extmap.second == uri)
+		{
+			return extmap.first;
+		}
+	}
+
+	return 0;
 }
\ No newline at end of file
@@ -101,6 +101,11 @@ public:
 	bool EnableRtcpFb(uint8_t id, const ov::String &type, bool on);
 	void EnableRtcpFb(uint8_t id, const PayloadAttr::RtcpFbType &type, bool on);
 
+	// a=extmap:1 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
+	void AddExtmap(uint8_t id, const ov::String &uri);
+	// Returns 0 if the extension is not negotiated
+	uint8_t GetExtmapId(const ov::String &uri) const;
+
 	// a=fmtp:96 packetization-mode=1;profile-level-id=42e01f;level-asymmetry-allowed=1
 	// a=fmtp:96 profile-level-id=1;moe=AAC-hbr;sizelength=13
 	void SetFmtp(uint8_t id, const ov::String &fmtp);
@@ -148,4 +153,7 @@ private:
 	ov::String _cname;
 
 	std::vector<std::shared_ptr<PayloadAttr>> _payload_list;
+
+	// id, uri
+	std::vector<std::pair<uint8_t, ov::String>> _extmap_list;
 };
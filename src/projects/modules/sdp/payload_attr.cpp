@@ -107,7 +107,8 @@ ov::String PayloadAttr::GetCodecParams() const
 
 bool PayloadAttr::EnableRtcpFb(const ov::String &type, const bool on)
 {
-	ov::String type_name = type.UpperCaseString();
+	// "transport-cc", "ccm fir" and "nack pli" in the SDP are matched with "TRANSPORT_CC", "CCM_FIR" and "NACK_PLI"
+	ov::String type_name = type.UpperCaseString().Replace("-", "_").Replace(" ", "_");
 
 	if(type_name == "GOOG_REMB")
 	{
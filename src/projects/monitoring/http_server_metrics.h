@@ -0,0 +1,105 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+
+#include "base/common_types.h"
+
+namespace mon
+{
+	// Counters of an HTTP(S) server (created by http::svr::HttpServer::Start(), see Monitoring::CreateHttpServerMetrics())
+	class HttpServerMetrics
+	{
+	public:
+		HttpServerMetrics(const ov::String &server_name, const ov::String &address, bool is_tls)
+			: _server_name(server_name),
+			  _address(address),
+			  _is_tls(is_tls)
+		{
+		}
+
+		const ov::String &GetServerName() const
+		{
+			return _server_name;
+		}
+
+		const ov::String &GetAddress() const
+		{
+			return _address;
+		}
+
+		bool IsTls() const
+		{
+			return _is_tls;
+		}
+
+		void OnConnectionAccepted()
+		{
+			_connection_count++;
+		}
+
+		void OnRequestReceived()
+		{
+			_request_count++;
+		}
+
+		// is_kernel_tls: true if the responses of the connection are encrypted by the kernel (kTLS)
+		void OnTlsAccepted(bool is_kernel_tls)
+		{
+			if (is_kernel_tls)
+			{
+				_kernel_tls_connection_count++;
+			}
+			else
+			{
+				_userspace_tls_connection_count++;
+			}
+		}
+
+		uint64_t GetConnectionCount() const
+		{
+			return _connection_count;
+		}
+
+		uint64_t GetRequestCount() const
+		{
+			return _request_count;
+		}
+
+		// Average number of requests per connection (persistent connections serve several requests)
+		double GetRequestsPerConnection() const
+		{
+			uint64_t connection_count = _connection_count;
+
+			return (connection_count > 0) ? (static_cast<double>(_request_count) / connection_count) : 0.0;
+		}
+
+		uint64_t GetKernelTlsConnectionCount() const
+		{
+			return _kernel_tls_connection_count;
+		}
+
+		uint64_t GetUserspaceTlsConnectionCount() const
+		{
+			return _userspace_tls_connection_count;
+		}
+
+	private:
+		const ov::String _server_name;
+		const ov::String _address;
+		const bool _is_tls;
+
+		std::atomic<uint64_t> _connection_count{0};
+		std::atomic<uint64_t> _request_count{0};
+
+		std::atomic<uint64_t> _kernel_tls_connection_count{0};
+		std::atomic<uint64_t> _userspace_tls_connection_count{0};
+	};
+}  // namespace mon
@@ -3,6 +3,9 @@
 //
 
 #include "monitoring.h"
+
+#include <algorithm>
+
 #include "monitoring_private.h"
 
 
@@ -15,6 +18,32 @@ namespace mon
 			auto &host = t.second;
 			host->ShowInfo();
 		}
+
+		auto buffer_pool_stats = GetBufferPoolStats();
+
+		logti("Memory pool - buffer (hit: %" PRIu64 ", miss: %" PRIu64 ", resident: %" PRIu64 " bytes)",
+			  buffer_pool_stats.hit_count, buffer_pool_stats.miss_count, buffer_pool_stats.resident_bytes);
+
+		for (const auto &executor : GetExecutorList())
+		{
+			logti("%s", executor->ToString().CStr());
+		}
+
+		for (const auto &http_server_metrics : GetHttpServerMetricsList())
+		{
+			ov::String tls_info;
+
+			if (http_server_metrics->IsTls())
+			{
+				tls_info.Format(", TLS connections encrypted by kernel: %" PRIu64 ", userspace: %" PRIu64,
+								http_server_metrics->GetKernelTlsConnectionCount(), http_server_metrics->GetUserspaceTlsConnectionCount());
+			}
+
+			logti("HTTP server - %s (%s) - connections: %" PRIu64 ", requests: %" PRIu64 " (%.2f requests per connection)%s",
+				  http_server_metrics->GetServerName().CStr(), http_server_metrics->GetAddress().CStr(),
+				  http_server_metrics->GetConnectionCount(), http_server_metrics->GetRequestCount(),
+				  http_server_metrics->GetRequestsPerConnection(), tls_info.CStr());
+		}
 	}
 
 	void Monitoring::Release()
@@ -154,4 +183,38 @@ namespace mon
 		auto stream_metric = app_metric->GetStreamMetrics(stream);
 		return stream_metric;
 	}
+
+	ov::MemoryPool::Stats Monitoring::GetBufferPoolStats() const
+	{
+		return ov::MemoryPool::GetBufferStats();
+	}
+
+	std::vector<std::shared_ptr<ov::WorkStealingExecutor>> Monitoring::GetExecutorList() const
+	{
+		return ov::WorkStealingExecutor::GetInstanceList();
+	}
+
+	std::shared_ptr<HttpServerMetrics> Monitoring::CreateHttpServerMetrics(const ov::String &server_name, const ov::String &address, bool is_tls)
+	{
+		auto metrics = std::make_shared<HttpServerMetrics>(server_name, address, is_tls);
+
+		std::lock_guard<std::mutex> lock_guard(_http_server_metrics_list_lock);
+		_http_server_metrics_list.push_back(metrics);
+
+		return metrics;
+	}
+
+	void Monitoring::ReleaseHttpServerMetrics(const std::shared_ptr<HttpServerMetrics> &metrics)
+	{
+		std::lock_guard<std::mutex> lock_guard(_http_server_metrics_list_lock);
+
+		_http_server_metrics_list.erase(std::remove(_http_server_metrics_list.begin(), _http_server_metrics_list.end(), metrics), _http_server_metrics_list.end());
+	}
+
+	std::vector<std::shared_ptr<HttpServerMetrics>> Monitoring::GetHttpServerMetricsList()
+	{
+		std::lock_guard<std::mutex> lock_guard(_http_server_metrics_list_lock);
+
+		return _http_server_metrics_list;
+	}
 }  // namespace mon
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "base/info/host.h"
 #include "base/info/info.h"
 #include "host_metrics.h"
+#include "http_server_metrics.h"
 #include <shared_mutex>
 
 #define MonitorInstance				mon::Monitoring::GetInstance()
@@ -43,10 +44,24 @@ namespace mon
         std::shared_ptr<ApplicationMetrics> GetApplicationMetrics(const info::Application &app_info);
         std::shared_ptr<StreamMetrics>  GetStreamMetrics(const info::Stream &stream_info);
 
+		// Statistics of ov::MemoryPool (large buffers of ov::Data such as video frames)
+		ov::MemoryPool::Stats GetBufferPoolStats() const;
+
+		// The executors which process the packets of the streams (ov::WorkStealingExecutor)
+		std::vector<std::shared_ptr<ov::WorkStealingExecutor>> GetExecutorList() const;
+
+		// Counters of the HTTP(S) servers (The servers create the metrics when they are started)
+		std::shared_ptr<HttpServerMetrics> CreateHttpServerMetrics(const ov::String &server_name, const ov::String &address, bool is_tls);
+		void ReleaseHttpServerMetrics(const std::shared_ptr<HttpServerMetrics> &metrics);
+		std::vector<std::shared_ptr<HttpServerMetrics>> GetHttpServerMetricsList();
+
 	private:
 		ov::String _server_name;
 		ov::String _server_id;
 		std::shared_mutex _map_guard;
 		std::map<uint32_t, std::shared_ptr<HostMetrics>> _hosts;
+
+		std::mutex _http_server_metrics_list_lock;
+		std::vector<std::shared_ptr<HttpServerMetrics>> _http_server_metrics_list;
 	};
 }  // namespace mon
\ No newline at end of file
@@ -53,6 +53,49 @@ namespace mon
 		UpdateDate();
 	}
 
+	void StreamMetrics::SetEstimatedBandwidth(uint32_t session_id, uint64_t bps)
+	{
+		std::lock_guard<std::mutex> lock_guard(_estimated_bandwidth_map_lock);
+		_estimated_bandwidth_map[session_id] = bps;
+	}
+
+	void StreamMetrics::RemoveEstimatedBandwidth(uint32_t session_id)
+	{
+		std::lock_guard<std::mutex> lock_guard(_estimated_bandwidth_map_lock);
+		_estimated_bandwidth_map.erase(session_id);
+	}
+
+	uint64_t StreamMetrics::GetEstimatedBandwidth(uint32_t session_id) const
+	{
+		std::lock_guard<std::mutex> lock_guard(_estimated_bandwidth_map_lock);
+
+		auto item = _estimated_bandwidth_map.find(session_id);
+		return (item != _estimated_bandwidth_map.end()) ? item->second : 0;
+	}
+
+	StreamMetrics::BandwidthEstimateSummary StreamMetrics::GetEstimatedBandwidthSummary() const
+	{
+		std::lock_guard<std::mutex> lock_guard(_estimated_bandwidth_map_lock);
+
+		BandwidthEstimateSummary summary;
+		uint64_t total = 0;
+
+		for (const auto &item : _estimated_bandwidth_map)
+		{
+			summary.min = (summary.session_count == 0) ? item.second : std::min(summary.min, item.second);
+			summary.max = std::max(summary.max, item.second);
+			total += item.second;
+			summary.session_count++;
+		}
+
+		if (summary.session_count > 0)
+		{
+			summary.avg = total / summary.session_count;
+		}
+
+		return summary;
+	}
+
 	void StreamMetrics::IncreaseBytesIn(uint64_t value)
 	{
 		CommonMetrics::IncreaseBytesIn(value);
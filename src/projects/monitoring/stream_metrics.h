@@ -10,12 +10,24 @@
 #include "base/info/stream.h"
 #include "common_metrics.h"
 
+#include <map>
+#include <mutex>
+
 namespace mon
 {
 	class ApplicationMetrics;
 	class StreamMetrics : public info::Stream, public CommonMetrics
 	{
 	public:
+		struct BandwidthEstimateSummary
+		{
+			uint32_t session_count = 0;
+			// bits per second
+			uint64_t min = 0;
+			uint64_t avg = 0;
+			uint64_t max = 0;
+		};
+
 		StreamMetrics(const std::shared_ptr<ApplicationMetrics> &app_metrics, const info::Stream &stream)
 		: info::Stream(stream), 
             _app_metrics(app_metrics)
@@ -42,6 +54,13 @@ namespace mon
 		void SetOriginRequestTimeMSec(int64_t value);
 		void SetOriginResponseTimeMSec(int64_t value);
 
+		// Bandwidth estimated for each session of the stream (ex: by transport-cc of WebRTC)
+		void SetEstimatedBandwidth(uint32_t session_id, uint64_t bps);
+		void RemoveEstimatedBandwidth(uint32_t session_id);
+		// Returns 0 if the bandwidth of the session is not estimated
+		uint64_t GetEstimatedBandwidth(uint32_t session_id) const;
+		BandwidthEstimateSummary GetEstimatedBandwidthSummary() const;
+
 		// Overriding from CommonMetrics 
 		void IncreaseBytesIn(uint64_t value) override;
 		void IncreaseBytesOut(PublisherType type, uint64_t value) override;
@@ -52,6 +71,10 @@ namespace mon
 		std::atomic<int64_t> _request_time_to_origin_msec = 0;
 		std::atomic<int64_t> _response_time_from_origin_msec = 0;
 
+		// Session ID, Estimated bandwidth (bps)
+		mutable std::mutex _estimated_bandwidth_map_lock;
+		std::map<uint32_t, uint64_t> _estimated_bandwidth_map;
+
 		std::shared_ptr<ApplicationMetrics>	_app_metrics;
 	};
 }
\ No newline at end of file
@@ -186,7 +186,8 @@ namespace pvd
 							break;
 					}
 
-					auto data = std::make_shared<ov::Data>(es->Payload(), es->PayloadLength());
+					// The payload shares the pooled buffer of the PES
+					auto data = es->GetPayloadData();
 					auto media_packet = std::make_shared<MediaPacket>(cmn::MediaType::Video,
 												es->PID(),
 												data,
@@ -198,10 +199,7 @@ namespace pvd
 				}
 				else if(es->IsAudioStream())
 				{
-					auto payload = es->Payload();
-					auto payload_length = es->PayloadLength();
-
-					auto data = std::make_shared<ov::Data>(payload, payload_length);
+					auto data = es->GetPayloadData();
 					auto media_packet = std::make_shared<MediaPacket>(cmn::MediaType::Audio,
 												es->PID(),
 												data,
@@ -1236,7 +1236,7 @@ namespace pvd
 				return true;
 			}
 
-			auto data = std::make_shared<ov::Data>(flv_video.Payload(), flv_video.PayloadLength());
+			auto data = ov::Data::CreatePooled(flv_video.Payload(), flv_video.PayloadLength());
 			auto video_frame = std::make_shared<MediaPacket>(cmn::MediaType::Video,
 											  RTMP_VIDEO_TRACK_ID,
 											  data,
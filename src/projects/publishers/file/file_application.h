@@ -13,6 +13,12 @@ public:
 	FileApplication(const std::shared_ptr<pub::Publisher> &publisher, const info::Application &application_info);
 	~FileApplication() final;
 
+	// Writing the files can block
+	bool IsBlockingIo() const override
+	{
+		return true;
+	}
+
 private:
 	bool Start() override;
 	bool Stop() override;
@@ -13,6 +13,12 @@ public:
 	RtmpPushApplication(const std::shared_ptr<pub::Publisher> &publisher, const info::Application &application_info);
 	~RtmpPushApplication() final;
 
+	// Sending to the remote servers can block
+	bool IsBlockingIo() const override
+	{
+		return true;
+	}
+
 private:
 	bool Start() override;
 	bool Stop() override;
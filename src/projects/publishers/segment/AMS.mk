@@ -2,7 +2,9 @@ LOCAL_PATH := $(call get_local_path)
 include $(DEFAULT_VARIABLES)
 
 LOCAL_STATIC_LIBRARIES := \
-	segment_stream
+	segment_stream \
+	mpegts_module \
+	bitstream
 
 LOCAL_TARGET := segment_publishers
 
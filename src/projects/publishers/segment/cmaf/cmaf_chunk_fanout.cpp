@@ -0,0 +1,267 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "cmaf_chunk_fanout.h"
+
+#include <modules/http/server/http_response.h>
+
+#include "cmaf_private.h"
+
+CmafChunkedFile::CmafChunkedFile(size_t worker_index, uint32_t sequence_number, uint64_t duration_in_msec)
+	: _worker_index(worker_index),
+	  _sequence_number(sequence_number),
+	  _duration_in_msec(duration_in_msec)
+{
+}
+
+void CmafChunkedFile::AddChunk(const std::shared_ptr<const ov::Data> &chunk_data)
+{
+	// Frame the chunk once, and then it is shared by all clients
+	auto chunk = http::svr::HttpResponse::MakeChunkedData(chunk_data);
+
+	std::lock_guard<std::mutex> lock(_chunk_guard);
+	_chunk_list.push_back(chunk);
+}
+
+void CmafChunkedFile::SetCompleted()
+{
+	std::lock_guard<std::mutex> lock(_chunk_guard);
+	_completed = true;
+}
+
+void CmafChunkedFile::AddClient(const std::shared_ptr<CmafChunkReceiver> &client)
+{
+	std::lock_guard<std::mutex> lock(_chunk_guard);
+	_new_client_list.push_back(client);
+}
+
+void CmafChunkedFile::Deliver()
+{
+	std::vector<std::shared_ptr<const ov::Data>> chunk_list;
+	size_t first_index = 0;
+	bool completed;
+
+	{
+		std::lock_guard<std::mutex> lock(_chunk_guard);
+
+		for (auto &client : _new_client_list)
+		{
+			_client_list.emplace_back(client);
+		}
+		_new_client_list.clear();
+
+		if (_client_list.empty())
+		{
+			return;
+		}
+
+		// Copy the chunks which are not sent to some clients yet, so that the packetizer can append a chunk while sending
+		first_index = std::min_element(_client_list.begin(), _client_list.end(), [](const Client &a, const Client &b) -> bool {
+						  return a.cursor < b.cursor;
+					  })->cursor;
+
+		chunk_list.assign(_chunk_list.begin() + first_index, _chunk_list.end());
+		completed = _completed;
+	}
+
+	auto last_index = first_index + chunk_list.size();
+
+	// The clients which are still receiving are moved to the front, so the finished ones are removed at once
+	auto remaining = _client_list.begin();
+
+	for (auto client_item = _client_list.begin(); client_item != _client_list.end(); ++client_item)
+	{
+		auto &client = client_item->client;
+
+		bool result = true;
+		size_t sent_bytes = 0;
+
+		for (auto index = client_item->cursor; index < last_index; index++)
+		{
+			auto &chunk = chunk_list[index - first_index];
+
+			if (client->SendChunk(chunk) == false)
+			{
+				result = false;
+				break;
+			}
+
+			sent_bytes += chunk->GetLength();
+		}
+
+		client_item->cursor = last_index;
+
+		if (sent_bytes > 0)
+		{
+			client->OnChunksSent(sent_bytes);
+		}
+
+		if (result == false)
+		{
+			logtw("Failed to send the chunked data of #%u to %s", _sequence_number, client->ToString().CStr());
+
+			client->OnDeliveryFinished(false);
+			continue;
+		}
+
+		if (completed)
+		{
+			client->OnDeliveryFinished(true);
+			continue;
+		}
+
+		if (remaining != client_item)
+		{
+			*remaining = std::move(*client_item);
+		}
+
+		++remaining;
+	}
+
+	_client_list.erase(remaining, _client_list.end());
+}
+
+CmafChunkFanout::~CmafChunkFanout()
+{
+	Stop();
+}
+
+bool CmafChunkFanout::Start(int worker_count)
+{
+	if (_workers.empty() == false)
+	{
+		return true;
+	}
+
+	worker_count = std::max(worker_count, 1);
+
+	for (int index = 0; index < worker_count; index++)
+	{
+		auto worker = std::make_shared<Worker>();
+		worker->Start();
+		_workers.push_back(worker);
+	}
+
+	return true;
+}
+
+bool CmafChunkFanout::Stop()
+{
+	for (const auto &worker : _workers)
+	{
+		worker->Stop();
+	}
+
+	_workers.clear();
+
+	return true;
+}
+
+size_t CmafChunkFanout::GetNextWorkerIndex()
+{
+	return _worker_index++;
+}
+
+void CmafChunkFanout::Notify(const std::shared_ptr<CmafChunkedFile> &file)
+{
+	if (_workers.empty())
+	{
+		OV_ASSERT2(false);
+		return;
+	}
+
+	_workers[file->GetWorkerIndex() % _workers.size()]->Enqueue(file);
+}
+
+bool CmafChunkFanout::Worker::Start()
+{
+	if (_stop_thread_flag == false)
+	{
+		return true;
+	}
+
+	_stop_thread_flag = false;
+	_worker_thread = std::thread(&CmafChunkFanout::Worker::WorkerThread, this);
+	pthread_setname_np(_worker_thread.native_handle(), "CmafFanout");
+
+	return true;
+}
+
+bool CmafChunkFanout::Worker::Stop()
+{
+	if (_stop_thread_flag)
+	{
+		return true;
+	}
+
+	_stop_thread_flag = true;
+	_queue_event.Notify();
+
+	if (_worker_thread.joinable())
+	{
+		_worker_thread.join();
+	}
+
+	std::lock_guard<std::mutex> lock(_queue_guard);
+	_queue.clear();
+
+	return true;
+}
+
+void CmafChunkFanout::Worker::Enqueue(const std::shared_ptr<CmafChunkedFile> &file)
+{
+	{
+		std::lock_guard<std::mutex> lock(_queue_guard);
+
+		if (file->_is_queued)
+		{
+			// The worker will send all the chunks appended so far
+			return;
+		}
+
+		file->_is_queued = true;
+		_queue.push_back(file);
+	}
+
+	_queue_event.Notify();
+}
+
+std::shared_ptr<CmafChunkedFile> CmafChunkFanout::Worker::Dequeue()
+{
+	std::lock_guard<std::mutex> lock(_queue_guard);
+
+	if (_queue.empty())
+	{
+		return nullptr;
+	}
+
+	auto file = _queue.front();
+	_queue.pop_front();
+
+	// If a chunk is appended while delivering, the file is queued again
+	file->_is_queued = false;
+
+	return file;
+}
+
+void CmafChunkFanout::Worker::WorkerThread()
+{
+	while (_stop_thread_flag == false)
+	{
+		_queue_event.Wait();
+
+		auto file = Dequeue();
+
+		if (file == nullptr)
+		{
+			continue;
+		}
+
+		file->Deliver();
+	}
+}
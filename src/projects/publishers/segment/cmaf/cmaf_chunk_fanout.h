@@ -0,0 +1,147 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <base/ovlibrary/semaphore.h>
+
+#include <deque>
+#include <thread>
+
+// A client which receives the chunks of CmafChunkedFile (CmafStreamServer wraps the HTTP connection)
+//
+// The functions are called by the worker of CmafChunkFanout which delivers the file
+class CmafChunkReceiver
+{
+public:
+	virtual ~CmafChunkReceiver() = default;
+
+	// chunk: Already framed for chunked transfer encoding
+	virtual bool SendChunk(const std::shared_ptr<const ov::Data> &chunk) = 0;
+
+	// Called after the chunks which are sent at once
+	virtual void OnChunksSent(size_t sent_bytes) = 0;
+
+	// Called once, when all the chunks of the completed file are sent (result: true), or a chunk could not be sent (result: false).
+	// The receiver is removed from the file after this
+	virtual void OnDeliveryFinished(bool result) = 0;
+
+	virtual ov::String ToString() const = 0;
+};
+
+// A CMAF file (segment) which is being created.
+//
+// The packetizer appends the chunks (already framed for chunked transfer encoding) to the chunk list,
+// and the clients which request this file are serviced by CmafChunkFanout from their own cursor.
+// So the packetizer doesn't wait for sending the chunks to the clients.
+class CmafChunkedFile
+{
+public:
+	CmafChunkedFile(size_t worker_index, uint32_t sequence_number, uint64_t duration_in_msec);
+
+	size_t GetWorkerIndex() const
+	{
+		return _worker_index;
+	}
+
+	uint32_t GetSequenceNumber() const
+	{
+		return _sequence_number;
+	}
+
+	uint64_t GetDurationInMsec() const
+	{
+		return _duration_in_msec;
+	}
+
+	// Called by the packetizer
+	void AddChunk(const std::shared_ptr<const ov::Data> &chunk_data);
+	void SetCompleted();
+
+	// The client receives the chunks from the first one
+	void AddClient(const std::shared_ptr<CmafChunkReceiver> &client);
+
+	// Sends the chunks which are not sent yet to the clients (Called by CmafChunkFanout)
+	void Deliver();
+
+protected:
+	friend class CmafChunkFanout;
+
+	struct Client
+	{
+		Client(const std::shared_ptr<CmafChunkReceiver> &client)
+			: client(client)
+		{
+		}
+
+		std::shared_ptr<CmafChunkReceiver> client;
+		// Index of the chunk to send next
+		size_t cursor = 0;
+	};
+
+	const size_t _worker_index;
+	const uint32_t _sequence_number;
+	const uint64_t _duration_in_msec;
+
+	// Guarded by _chunk_guard
+	std::mutex _chunk_guard;
+	std::vector<std::shared_ptr<const ov::Data>> _chunk_list;
+	std::vector<std::shared_ptr<CmafChunkReceiver>> _new_client_list;
+	bool _completed = false;
+
+	// Accessed by the worker of CmafChunkFanout only
+	std::vector<Client> _client_list;
+
+	// Guarded by the queue of the worker
+	bool _is_queued = false;
+};
+
+// Sends the chunks of CmafChunkedFile to the clients.
+//
+// Each file is always delivered by the same worker (the worker is selected per stream),
+// so the chunks of a stream are sent in order.
+class CmafChunkFanout
+{
+public:
+	~CmafChunkFanout();
+
+	bool Start(int worker_count);
+	bool Stop();
+
+	// Selects a worker for a new stream
+	size_t GetNextWorkerIndex();
+
+	// Wakes up the worker of the file to deliver the chunks
+	void Notify(const std::shared_ptr<CmafChunkedFile> &file);
+
+protected:
+	class Worker
+	{
+	public:
+		bool Start();
+		bool Stop();
+
+		void Enqueue(const std::shared_ptr<CmafChunkedFile> &file);
+
+	protected:
+		std::shared_ptr<CmafChunkedFile> Dequeue();
+
+		void WorkerThread();
+
+		std::mutex _queue_guard;
+		std::deque<std::shared_ptr<CmafChunkedFile>> _queue;
+		ov::Semaphore _queue_event;
+
+		std::atomic<bool> _stop_thread_flag{true};
+		std::thread _worker_thread;
+	};
+
+	std::vector<std::shared_ptr<Worker>> _workers;
+	std::atomic<size_t> _worker_index{0};
+};
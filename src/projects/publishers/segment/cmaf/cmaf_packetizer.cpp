@@ -1046,7 +1046,7 @@ bool CmafPacketizer::UpdatePlayList()
 
 	ov::String play_list = xml.str().c_str();
 
-	SetPlayList(play_list);
+	SetPlayList(play_list, DASH_PLAYLIST_CONTENT_TYPE, "max-age=2");
 
 	return true;
 }
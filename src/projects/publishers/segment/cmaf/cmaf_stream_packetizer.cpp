@@ -59,7 +59,7 @@ bool CmafStreamPacketizer::AppendAudioFrame(const std::shared_ptr<const Packetiz
 // Get PlayList
 // - MPD
 //====================================================================================================
-bool CmafStreamPacketizer::GetPlayList(ov::String &play_list)
+bool CmafStreamPacketizer::GetPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list)
 {
 	return _packetizer->GetPlayList(play_list);
 }
@@ -27,7 +27,7 @@ public:
 	// Implement StreamPacketizer Interface
 	bool AppendVideoFrame(const std::shared_ptr<const PacketizerFrameData> &data) override;
 	bool AppendAudioFrame(const std::shared_ptr<const PacketizerFrameData> &data) override;
-	bool GetPlayList(ov::String &play_list) override;
+	bool GetPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list) override;
 	std::shared_ptr<const SegmentItem> GetSegmentData(const ov::String &file_name) const override;
 
 private:
@@ -15,11 +15,97 @@
 #include "cmaf_packetizer.h"
 #include "cmaf_private.h"
 
+CmafStreamServer::HttpChunkReceiver::HttpChunkReceiver(const std::shared_ptr<http::svr::HttpConnection> &client, const std::shared_ptr<mon::StreamMetrics> &metric, PublisherType publisher_type)
+	: _client(client),
+	  _metric(metric),
+	  _publisher_type(publisher_type)
+{
+}
+
+bool CmafStreamServer::HttpChunkReceiver::SendChunk(const std::shared_ptr<const ov::Data> &chunk)
+{
+	return _client->GetResponse()->Send(chunk);
+}
+
+void CmafStreamServer::HttpChunkReceiver::OnChunksSent(size_t sent_bytes)
+{
+	// The number of bytes passed to the socket (The socket pool sends them when the socket is writable)
+	if (_metric != nullptr)
+	{
+		_metric->IncreaseBytesOut(_publisher_type, sent_bytes);
+	}
+}
+
+void CmafStreamServer::HttpChunkReceiver::OnDeliveryFinished(bool result)
+{
+	auto response = _client->GetResponse();
+
+	if (result)
+	{
+		// Send the last chunk
+		if (response->SendChunkedData(nullptr) == false)
+		{
+			logtw("Could not send the last CMAF chunk to %s", ToString().CStr());
+		}
+		else if (_client->IsKeepAliveAvailable())
+		{
+			// The chunked response is completed - wait for the next request
+			_client->PrepareNextRequest();
+			return;
+		}
+	}
+
+	response->Close();
+}
+
+ov::String CmafStreamServer::HttpChunkReceiver::ToString() const
+{
+	return _client->GetResponse()->GetRemote()->ToString();
+}
+
 std::shared_ptr<SegmentStreamInterceptor> CmafStreamServer::CreateInterceptor()
 {
 	return std::make_shared<CmafInterceptor>();
 }
 
+bool CmafStreamServer::PrepareInterceptors(
+	const std::shared_ptr<http::svr::HttpServer> &http_server,
+	const std::shared_ptr<http::svr::HttpsServer> &https_server,
+	int thread_count, const SegmentProcessHandler &process_handler)
+{
+	if (DashStreamServer::PrepareInterceptors(http_server, https_server, thread_count, process_handler) == false)
+	{
+		return false;
+	}
+
+	// The chunks are sent by the workers of CmafChunkFanout instead of the packetizer
+	return _chunk_fanout.Start(thread_count);
+}
+
+bool CmafStreamServer::Stop()
+{
+	_chunk_fanout.Stop();
+
+	return DashStreamServer::Stop();
+}
+
+std::shared_ptr<CmafStreamServer::CmafChunkedStream> CmafStreamServer::FindChunkedStream(const ov::String &app_name, const ov::String &stream_name)
+{
+	auto app_item = _http_chunk_stream_list.find(app_name);
+	if (app_item == _http_chunk_stream_list.end())
+	{
+		return nullptr;
+	}
+
+	auto stream_item = app_item->second.find(stream_name);
+	if (stream_item == app_item->second.end())
+	{
+		return nullptr;
+	}
+
+	return stream_item->second;
+}
+
 http::svr::ConnectionPolicy CmafStreamServer::ProcessSegmentRequest(const std::shared_ptr<http::svr::HttpConnection> &client,
 																	const SegmentStreamRequestInfo &request_info,
 																	SegmentType segment_type)
@@ -31,75 +117,92 @@ http::svr::ConnectionPolicy CmafStreamServer::ProcessSegmentRequest(const std::s
 	bool is_video = ((type == DashFileType::VideoSegment) || (type == DashFileType::VideoInit));
 
 	// Check if the requested file is being created
+	std::shared_ptr<CmafChunkedFile> chunked_file;
+
 	{
-		auto key = ov::String::FormatString("%s/%s/%s", request_info.vhost_app_name.CStr(), request_info.stream_name.CStr(), request_info.file_name.CStr());
+		std::shared_lock<std::shared_mutex> lock(_http_chunk_stream_guard);
+
+		auto chunked_stream = FindChunkedStream(request_info.vhost_app_name.ToString(), request_info.stream_name);
+
+		if (chunked_stream != nullptr)
+		{
+			std::lock_guard<std::mutex> file_list_lock(chunked_stream->file_list_guard);
 
-		std::unique_lock<std::mutex> lock(_http_chunk_guard);
+			auto file_item = chunked_stream->file_list.find(request_info.file_name);
+			if (file_item != chunked_stream->file_list.end())
+			{
+				chunked_file = file_item->second;
+			}
+		}
+	}
 
-		auto chunk_item = _http_chunk_list.find(key);
-		if (chunk_item != _http_chunk_list.end())
+	if (chunked_file != nullptr)
+	{
+		// Find stream info
+		std::shared_ptr<pub::Stream> stream_info;
+		for (auto observer : _observers)
 		{
-			// Find stream info
-			std::shared_ptr<pub::Stream> stream_info;
-			for (auto observer : _observers)
+			auto segment_publisher = std::dynamic_pointer_cast<SegmentPublisher>(observer);
+			if (segment_publisher != nullptr)
 			{
-				auto segment_publisher = std::dynamic_pointer_cast<SegmentPublisher>(observer);
-				if (segment_publisher != nullptr)
+				stream_info = segment_publisher->GetStreamAs<pub::Stream>(request_info.vhost_app_name, request_info.stream_name);
+				if (stream_info != nullptr)
 				{
-					stream_info = segment_publisher->GetStreamAs<pub::Stream>(request_info.vhost_app_name, request_info.stream_name);
-					if (stream_info != nullptr)
-					{
-						// For statistics
-						auto segment_request_info = SegmentRequestInfo(
-							GetPublisherType(),
-							*std::static_pointer_cast<info::Stream>(stream_info),
-							client->GetRequest()->GetRemote()->GetRemoteAddress()->GetIpAddress(),
-							static_cast<int>(chunk_item->second->sequence_number),
-							is_video ? SegmentDataType::Video : SegmentDataType::Audio,
-							static_cast<int64_t>(chunk_item->second->duration_in_msec / 1000));
-
-						segment_publisher->UpdateSegmentRequestInfo(segment_request_info);
-
-						break;
-					}
+					// For statistics
+					auto segment_request_info = SegmentRequestInfo(
+						GetPublisherType(),
+						*std::static_pointer_cast<info::Stream>(stream_info),
+						client->GetRequest()->GetRemote()->GetRemoteAddress()->GetIpAddress(),
+						static_cast<int>(chunked_file->GetSequenceNumber()),
+						is_video ? SegmentDataType::Video : SegmentDataType::Audio,
+						static_cast<int64_t>(chunked_file->GetDurationInMsec() / 1000));
+
+					segment_publisher->UpdateSegmentRequestInfo(segment_request_info);
+
+					break;
 				}
 			}
+		}
 
-			if (stream_info == nullptr)
-			{
-				// The stream has been deleted, but if it remains in the Worker queue, this code will run.
-				response->SetStatusCode(http::StatusCode::NotFound);
-				_http_chunk_list.clear();
+		if (stream_info == nullptr)
+		{
+			// The stream has been deleted, but if it remains in the Worker queue, this code will run.
+			response->SetStatusCode(http::StatusCode::NotFound);
 
-				return http::svr::ConnectionPolicy::Closed;
+			std::lock_guard<std::shared_mutex> lock(_http_chunk_stream_guard);
+			auto app_item = _http_chunk_stream_list.find(request_info.vhost_app_name.ToString());
+			if (app_item != _http_chunk_stream_list.end())
+			{
+				app_item->second.erase(request_info.stream_name);
 			}
 
-			client->GetRequest()->SetExtra(stream_info);
-
-			// The file is being created
-			logtd("Requested file is being created");
+			return http::svr::ConnectionPolicy::Closed;
+		}
 
-			// Set HTTP header
-			response->SetHeader("Content-Type", is_video ? "video/mp4" : "audio/mp4");
+		client->GetRequest()->SetExtra(stream_info);
 
-			// Enable chunked transfer
-			response->SetKeepAlive();
-			response->SetChunkedTransfer();
+		// The file is being created
+		logtd("Requested file is being created");
 
-			// Append data to HTTP response
-			response->AppendData(chunk_item->second->chunked_data);
-			auto sent_bytes = response->Response();
+		// Set HTTP header
+		response->SetHeader("Content-Type", is_video ? "video/mp4" : "audio/mp4");
 
-			auto metric = GetStreamMetric(client);
-			if (metric != nullptr)
-			{
-				metric->IncreaseBytesOut(GetPublisherType(), sent_bytes);
-			}
+		// Enable chunked transfer ("Connection" header is set by SegmentStreamServer::ProcessRequest())
+		response->SetChunkedTransfer();
 
-			chunk_item->second->client_list.push_back(client);
+		// Send the header, and then the chunks created so far are sent by CmafChunkFanout
+		auto sent_bytes = response->Response();
 
-			return http::svr::ConnectionPolicy::KeepAlive;
+		auto metric = GetStreamMetric(client);
+		if (metric != nullptr)
+		{
+			metric->IncreaseBytesOut(GetPublisherType(), sent_bytes);
 		}
+
+		chunked_file->AddClient(std::make_shared<HttpChunkReceiver>(client, metric, GetPublisherType()));
+		_chunk_fanout.Notify(chunked_file);
+
+		return http::svr::ConnectionPolicy::KeepAlive;
 	}
 
 	return DashStreamServer::ProcessSegmentRequest(client, request_info, segment_type);
@@ -112,85 +215,100 @@ void CmafStreamServer::OnCmafChunkDataPush(const ov::String &app_name, const ov:
 										   bool is_video,
 										   std::shared_ptr<ov::Data> &chunk_data)
 {
-	auto key = ov::String::FormatString("%s/%s/%s", app_name.CStr(), stream_name.CStr(), file_name.CStr());
+	std::shared_ptr<CmafChunkedFile> chunked_file;
 
-	std::unique_lock<std::mutex> lock(_http_chunk_guard);
-
-	auto chunk_item = _http_chunk_list.find(key);
-	if (chunk_item == _http_chunk_list.end())
 	{
-		// New chunk data is arrived
-		logtd("Create a new chunk for [%s/%s, %s], size: %zu bytes", app_name.CStr(), stream_name.CStr(), file_name.CStr(), chunk_data->GetLength());
-		_http_chunk_list.emplace(key, std::make_shared<CmafHttpChunkedData>(sequence_number, duration_in_msec, chunk_data));
-		return;
-	}
+		std::shared_lock<std::shared_mutex> lock(_http_chunk_stream_guard);
 
-	chunk_item->second->AddChunkData(chunk_data);
+		auto chunked_stream = FindChunkedStream(app_name, stream_name);
+
+		if (chunked_stream != nullptr)
+		{
+			std::lock_guard<std::mutex> file_list_lock(chunked_stream->file_list_guard);
 
-	auto client_item = chunk_item->second->client_list.begin();
+			auto file_item = chunked_stream->file_list.find(file_name);
+			if (file_item != chunked_stream->file_list.end())
+			{
+				chunked_file = file_item->second;
+			}
+		}
+	}
 
-	while (client_item != chunk_item->second->client_list.end())
+	if (chunked_file == nullptr)
 	{
-		auto &client = *client_item;
+		// New chunk data is arrived
+		logtd("Create a new chunk for [%s/%s, %s], size: %zu bytes", app_name.CStr(), stream_name.CStr(), file_name.CStr(), chunk_data->GetLength());
 
-		auto response = client->GetResponse();
-		auto metric = GetStreamMetric(client);
+		std::lock_guard<std::shared_mutex> lock(_http_chunk_stream_guard);
 
-		if (response->SendChunkedData(chunk_data))
+		auto &chunked_stream = _http_chunk_stream_list[app_name][stream_name];
+		if (chunked_stream == nullptr)
 		{
-			if (metric != nullptr)
-			{
-				metric->IncreaseBytesOut(GetPublisherType(), chunk_data->GetLength());
-			}
-			++client_item;
+			chunked_stream = std::make_shared<CmafChunkedStream>(_chunk_fanout.GetNextWorkerIndex());
 		}
-		else
-		{
-			logtw("Failed to send the chunked data for [%s/%s, %s] to %s (%zu bytes)", app_name.CStr(), stream_name.CStr(), file_name.CStr(), response->GetRemote()->ToString().CStr(), chunk_data->GetLength());
 
-			client_item = chunk_item->second->client_list.erase(client_item);
-			response->Close();
-		}
+		chunked_file = std::make_shared<CmafChunkedFile>(chunked_stream->worker_index, sequence_number, duration_in_msec);
+		chunked_file->AddChunk(chunk_data);
+
+		std::lock_guard<std::mutex> file_list_lock(chunked_stream->file_list_guard);
+		chunked_stream->file_list[file_name] = chunked_file;
+
+		// There is no client yet
+		return;
 	}
+
+	chunked_file->AddChunk(chunk_data);
+
+	// The clients are serviced by the worker of the stream
+	_chunk_fanout.Notify(chunked_file);
 }
 
 void CmafStreamServer::OnCmafChunkedComplete(const ov::String &app_name, const ov::String &stream_name,
 											 const ov::String &file_name,
 											 bool is_video)
 {
-	std::shared_ptr<CmafHttpChunkedData> chunked_data;
+	std::shared_ptr<CmafChunkedFile> chunked_file;
 
 	{
-		auto key = ov::String::FormatString("%s/%s/%s", app_name.CStr(), stream_name.CStr(), file_name.CStr());
-
-		std::unique_lock<std::mutex> lock(_http_chunk_guard);
+		std::lock_guard<std::shared_mutex> lock(_http_chunk_stream_guard);
 
-		auto chunk_item = _http_chunk_list.find(key);
+		auto chunked_stream = FindChunkedStream(app_name, stream_name);
 
-		if (chunk_item == _http_chunk_list.end())
+		if (chunked_stream != nullptr)
 		{
-			logtw("Could not find a CMAF chunk [%s/%s, %s]", app_name.CStr(), stream_name.CStr(), file_name.CStr());
-			OV_ASSERT2(false);
-			return;
-		}
+			std::lock_guard<std::mutex> file_list_lock(chunked_stream->file_list_guard);
 
-		chunked_data = chunk_item->second;
-
-		_http_chunk_list.erase(chunk_item);
-	}
+			auto file_item = chunked_stream->file_list.find(file_name);
+			if (file_item != chunked_stream->file_list.end())
+			{
+				chunked_file = file_item->second;
+				chunked_stream->file_list.erase(file_item);
+			}
 
-	logtd("The chunk is completed [%s/%s, %s]", app_name.CStr(), stream_name.CStr(), file_name.CStr());
+			if (chunked_stream->file_list.empty())
+			{
+				auto &app_stream_list = _http_chunk_stream_list[app_name];
 
-	for (auto client : chunked_data->client_list)
-	{
-		auto response = client->GetResponse();
+				app_stream_list.erase(stream_name);
 
-		if (response->SendChunkedData(nullptr) == false)
-		{
-			logtw("[%s] Could not response the CMAF chunk: [%s/%s, %s]",
-				  response->GetRemote()->ToString().CStr(), app_name.CStr(), stream_name.CStr(), file_name.CStr());
+				if (app_stream_list.empty())
+				{
+					_http_chunk_stream_list.erase(app_name);
+				}
+			}
 		}
+	}
 
-		response->Close();
+	if (chunked_file == nullptr)
+	{
+		logtw("Could not find a CMAF chunk [%s/%s, %s]", app_name.CStr(), stream_name.CStr(), file_name.CStr());
+		OV_ASSERT2(false);
+		return;
 	}
-}
\ No newline at end of file
+
+	logtd("The chunk is completed [%s/%s, %s]", app_name.CStr(), stream_name.CStr(), file_name.CStr());
+
+	// The worker sends the remaining chunks and the last chunk to the clients
+	chunked_file->SetCompleted();
+	_chunk_fanout.Notify(chunked_file);
+}
@@ -9,12 +9,15 @@
 #pragma once
 
 #include "../dash/dash_stream_server.h"
+#include "cmaf_chunk_fanout.h"
 #include "cmaf_interceptor.h"
 #include "cmaf_packetizer.h"
 
 class CmafStreamServer : public DashStreamServer, public ChunkedTransferInterface
 {
 public:
+	bool Stop() override;
+
 	PublisherType GetPublisherType() const noexcept override
 	{
 		return PublisherType::LlDash;
@@ -26,33 +29,52 @@ public:
 	}
 
 protected:
+	// Sends the chunks to an HTTP client which requested a file being created
+	class HttpChunkReceiver : public CmafChunkReceiver
+	{
+	public:
+		HttpChunkReceiver(const std::shared_ptr<http::svr::HttpConnection> &client, const std::shared_ptr<mon::StreamMetrics> &metric, PublisherType publisher_type);
+
+		//--------------------------------------------------------------------
+		// Implementation of CmafChunkReceiver
+		//--------------------------------------------------------------------
+		bool SendChunk(const std::shared_ptr<const ov::Data> &chunk) override;
+		void OnChunksSent(size_t sent_bytes) override;
+		void OnDeliveryFinished(bool result) override;
+		ov::String ToString() const override;
+
+	protected:
+		std::shared_ptr<http::svr::HttpConnection> _client;
+		std::shared_ptr<mon::StreamMetrics> _metric;
+		PublisherType _publisher_type;
+	};
+
 	std::shared_ptr<SegmentStreamInterceptor> CreateInterceptor() override;
 
-	struct CmafHttpChunkedData
+	// Files which are being created for a stream
+	struct CmafChunkedStream
 	{
-	public:
-		CmafHttpChunkedData(const uint32_t sequence_number, const uint64_t duration_in_msec, const std::shared_ptr<const ov::Data> &data)
-			: sequence_number(sequence_number),
-			  duration_in_msec(duration_in_msec)
+		CmafChunkedStream(size_t worker_index)
+			: worker_index(worker_index)
 		{
-			chunked_data = std::make_shared<ov::Data>(104 * 1024);
-			chunked_data->Append(data);
 		}
 
-		void AddChunkData(const std::shared_ptr<const ov::Data> &data)
-		{
-			chunked_data->Append(data);
-		}
+		// All files of the stream are delivered by the same worker of CmafChunkFanout
+		const size_t worker_index;
 
-		uint32_t sequence_number = 0U;
-		uint64_t duration_in_msec = 0U;
-		std::shared_ptr<ov::Data> chunked_data;
-		std::vector<std::shared_ptr<http::svr::HttpConnection>> client_list;
+		std::mutex file_list_guard;
+		// Key: file name
+		std::unordered_map<ov::String, std::shared_ptr<CmafChunkedFile>> file_list;
 	};
 
 	//--------------------------------------------------------------------
 	// Overriding functions of DashStreamServer
 	//--------------------------------------------------------------------
+	bool PrepareInterceptors(
+		const std::shared_ptr<http::svr::HttpServer> &http_server,
+		const std::shared_ptr<http::svr::HttpsServer> &https_server,
+		int thread_count, const SegmentProcessHandler &process_handler) override;
+
 	http::svr::ConnectionPolicy ProcessSegmentRequest(const std::shared_ptr<http::svr::HttpConnection> &client,
 													  const SegmentStreamRequestInfo &request_info, SegmentType segment_type) override;
 
@@ -70,8 +92,13 @@ protected:
 							   const ov::String &file_name,
 							   bool is_video) override;
 
-	// A temporary queue for the intermediate chunks
-	// Key: [app name]/[stream name]/[file name]
-	std::unordered_map<ov::String, std::shared_ptr<CmafHttpChunkedData>> _http_chunk_list;
-	std::mutex _http_chunk_guard;
+	// _http_chunk_stream_guard must be locked
+	std::shared_ptr<CmafChunkedStream> FindChunkedStream(const ov::String &app_name, const ov::String &stream_name);
+
+	// The files which are being created
+	// Key: [app name], [stream name]
+	std::unordered_map<ov::String, std::unordered_map<ov::String, std::shared_ptr<CmafChunkedStream>>> _http_chunk_stream_list;
+	std::shared_mutex _http_chunk_stream_guard;
+
+	CmafChunkFanout _chunk_fanout;
 };
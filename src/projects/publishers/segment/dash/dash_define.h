@@ -10,6 +10,7 @@
 
 #define DASH_INIT_FILE_PREFIX				"init"
 #define DASH_PLAYLIST_FILE_NAME				"manifest"
+#define DASH_PLAYLIST_CONTENT_TYPE			"application/dash+xml"
 #define DASH_MPD_VIDEO_SUFFIX				/* <prefix>									*/	"_video"
 #define DASH_MPD_AUDIO_SUFFIX				/* <prefix>									*/	"_audio"
 #define DASH_LOW_LATENCY_SUFFIX				/* <prefix>									*/	"_ll"
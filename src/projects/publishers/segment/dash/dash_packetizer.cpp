@@ -684,7 +684,7 @@ bool DashPacketizer::UpdatePlayList()
 
 	ov::String play_list = xml.str().c_str();
 
-	SetPlayList(play_list);
+	SetPlayList(play_list, DASH_PLAYLIST_CONTENT_TYPE, "max-age=2");
 
 	if (_stat_stop_watch.IsElapsed(5000) && _stat_stop_watch.Update())
 	{
@@ -41,7 +41,7 @@ bool DashPublisher::Start()
 	worker_count = is_parsed ? worker_count : HTTP_SERVER_USE_DEFAULT_COUNT;
 
 	return SegmentPublisher::Start(dash_config.GetPort(), dash_config.GetTlsPort(),
-								   std::make_shared<DashStreamServer>(), worker_count);
+								   std::make_shared<DashStreamServer>(), worker_count, dash_config.IsReusePortEnabled(), dash_config.GetKeepAliveTimeout(), dash_config.IsKernelTlsEnabled());
 }
 
 std::shared_ptr<pub::Application> DashPublisher::OnCreatePublisherApplication(const info::Application &application_info)
@@ -40,7 +40,7 @@ bool DashStreamPacketizer::AppendAudioData(const std::shared_ptr<MediaPacket> &d
 	return _packetizer->AppendAudioFrame(data);
 }
 
-bool DashStreamPacketizer::GetPlayList(ov::String &play_list)
+bool DashStreamPacketizer::GetPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list)
 {
 	return _packetizer->GetPlayList(play_list);
 }
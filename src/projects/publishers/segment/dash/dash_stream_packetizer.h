@@ -36,6 +36,6 @@ public:
 		return false;
 	}
 
-	bool GetPlayList(ov::String &play_list) override;
+	bool GetPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list) override;
 	std::shared_ptr<const SegmentItem> GetSegmentData(const ov::String &file_name) const override;
 };
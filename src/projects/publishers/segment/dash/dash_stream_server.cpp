@@ -107,7 +107,7 @@ http::svr::ConnectionPolicy DashStreamServer::ProcessStreamRequest(const std::sh
 	response->SetStatusCode(http::StatusCode::NotFound);
 	response->Response();
 
-	return http::svr::ConnectionPolicy::Closed;
+	return http::svr::ConnectionPolicy::KeepAlive;
 }
 
 http::svr::ConnectionPolicy DashStreamServer::ProcessPlayListRequest(const std::shared_ptr<http::svr::HttpConnection> &client,
@@ -116,7 +116,7 @@ http::svr::ConnectionPolicy DashStreamServer::ProcessPlayListRequest(const std::
 {
 	auto response = client->GetResponse();
 
-	ov::String play_list;
+	std::shared_ptr<const http::svr::CachedResponse> play_list;
 
 	auto item = std::find_if(_observers.begin(), _observers.end(),
 							 [client, request_info, &play_list](std::shared_ptr<SegmentStreamObserver> &observer) -> bool {
@@ -129,23 +129,16 @@ http::svr::ConnectionPolicy DashStreamServer::ProcessPlayListRequest(const std::
 		response->SetStatusCode(http::StatusCode::NotFound);
 		response->Response();
 
-		return http::svr::ConnectionPolicy::Closed;
+		return http::svr::ConnectionPolicy::KeepAlive;
 	}
 
-	if (response->GetStatusCode() != http::StatusCode::OK || play_list.IsEmpty())
+	if (response->GetStatusCode() != http::StatusCode::OK || (play_list == nullptr))
 	{
 		response->Response();
-		return http::svr::ConnectionPolicy::Closed;
+		return http::svr::ConnectionPolicy::KeepAlive;
 	}
 
-	// Set HTTP header
-	response->SetHeader("Content-Type", "application/dash+xml");
-//	response->SetHeader("Cache-Control", "no-cache, no-store, must-revalidate");
-//	response->SetHeader("Pragma", "no-cache");
-//	response->SetHeader("Expires", "0");
-	response->SetHeader("Cache-Control", "max-age=2");
-	response->AppendString(play_list);
-	auto sent_bytes = response->Response();
+	auto sent_bytes = SendCachedResponse(client, play_list);
 
 	auto metric = GetStreamMetric(client);
 	if (metric != nullptr)
@@ -153,7 +146,7 @@ http::svr::ConnectionPolicy DashStreamServer::ProcessPlayListRequest(const std::
 		metric->IncreaseBytesOut(GetPublisherType(), sent_bytes);
 	}
 
-	return http::svr::ConnectionPolicy::Closed;
+	return http::svr::ConnectionPolicy::KeepAlive;
 }
 
 http::svr::ConnectionPolicy DashStreamServer::ProcessSegmentRequest(const std::shared_ptr<http::svr::HttpConnection> &client,
@@ -175,14 +168,10 @@ http::svr::ConnectionPolicy DashStreamServer::ProcessSegmentRequest(const std::s
 		response->SetStatusCode(http::StatusCode::NotFound);
 		response->Response();
 
-		return http::svr::ConnectionPolicy::Closed;
+		return http::svr::ConnectionPolicy::KeepAlive;
 	}
 
-	// Set HTTP header
-	response->SetHeader("Content-Type", (segment->type == SegmentDataType::Video) ? "video/mp4" : "audio/mp4");
-	response->SetHeader("Cache-Control", "max-age=300");
-	response->AppendData(segment->data);
-	auto sent_bytes = response->Response();
+	auto sent_bytes = SendCachedResponse(client, segment->response);
 
 	auto metric = GetStreamMetric(client);
 	if (metric != nullptr)
@@ -190,5 +179,5 @@ http::svr::ConnectionPolicy DashStreamServer::ProcessSegmentRequest(const std::s
 		metric->IncreaseBytesOut(GetPublisherType(), sent_bytes);
 	}
 
-	return http::svr::ConnectionPolicy::Closed;
+	return http::svr::ConnectionPolicy::KeepAlive;
 }
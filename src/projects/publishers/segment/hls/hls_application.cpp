@@ -12,10 +12,12 @@
 #include "hls_private.h"
 #include "hls_publisher.h"
 #include "hls_stream_packetizer.h"
+#include "ll_hls_stream_packetizer.h"
 
-std::shared_ptr<HlsApplication> HlsApplication::Create(const std::shared_ptr<HlsPublisher> &publisher, const info::Application &application_info)
+std::shared_ptr<HlsApplication> HlsApplication::Create(const std::shared_ptr<HlsPublisher> &publisher, const info::Application &application_info,
+														 const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer)
 {
-	auto application = std::make_shared<HlsApplication>(publisher, application_info);
+	auto application = std::make_shared<HlsApplication>(publisher, application_info, chunked_transfer);
 
 	if (application->Start() == false)
 	{
@@ -25,9 +27,11 @@ std::shared_ptr<HlsApplication> HlsApplication::Create(const std::shared_ptr<Hls
 	return application;
 }
 
-HlsApplication::HlsApplication(const std::shared_ptr<HlsPublisher> &publisher, const info::Application &application_info)
+HlsApplication::HlsApplication(const std::shared_ptr<HlsPublisher> &publisher, const info::Application &application_info,
+							   const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer)
 	: Application(publisher->pub::Publisher::GetSharedPtrAs<pub::Publisher>(), application_info)
 {
+	_chunked_transfer = chunked_transfer;
 }
 
 HlsApplication::~HlsApplication()
@@ -42,15 +46,66 @@ bool HlsApplication::Start()
 	_segment_count = publisher_info->GetSegmentCount();
 	_segment_duration = publisher_info->GetSegmentDuration();
 
+	auto &ts_muxer = publisher_info->GetTsMuxer();
+
+	if (HlsTsWriter::ParseType(ts_muxer, &_ts_writer_type) == false)
+	{
+		logtw("Unknown TS muxer: %s, FFmpeg is used for %s", ts_muxer.CStr(), GetName().CStr());
+		_ts_writer_type = HlsTsWriter::Type::FFmpeg;
+	}
+	else if (_ts_writer_type != HlsTsWriter::Type::FFmpeg)
+	{
+		logti("%s TS muxer is used for %s", HlsTsWriter::StringFromType(_ts_writer_type), GetName().CStr());
+	}
+
+	auto &low_latency = publisher_info->GetLowLatency();
+
+	if (low_latency.IsParsed())
+	{
+		_low_latency = true;
+		_part_duration = low_latency.GetPartDuration();
+
+		logti("Low-Latency HLS is enabled for %s (part duration: %.3fs)", GetName().CStr(), _part_duration);
+	}
+
 	return Application::Start();
 }
 
+bool HlsApplication::IsLowLatencySupported(const std::shared_ptr<info::Stream> &info) const
+{
+	for (const auto &item : info->GetTracks())
+	{
+		auto &track = item.second;
+
+		// LlHlsPacketizer only packetizes H.264
+		if ((track->GetMediaType() == cmn::MediaType::Video) && (track->GetCodecId() != cmn::MediaCodecId::H264))
+		{
+			logtw("%s is not supported for LL-HLS, %s/%s is published as a regular HLS stream",
+				  ::StringFromMediaCodecId(track->GetCodecId()).CStr(), GetName().CStr(), info->GetName().CStr());
+			return false;
+		}
+	}
+
+	return true;
+}
+
 std::shared_ptr<pub::Stream> HlsApplication::CreateStream(const std::shared_ptr<info::Stream> &info, uint32_t thread_count)
 {
-	return SegmentStream::Create<HlsStreamPacketizer>(
+	if (_low_latency && IsLowLatencySupported(info))
+	{
+		return std::make_shared<SegmentStream>(
+			GetSharedPtrAs<pub::Application>(), *info.get(),
+			_segment_count, _segment_duration,
+			"", "",
+			std::make_shared<LlHlsPacketizerFactory>(_part_duration),
+			_chunked_transfer);
+	}
+
+	return std::make_shared<SegmentStream>(
 		GetSharedPtrAs<pub::Application>(), *info.get(),
 		_segment_count, _segment_duration,
-		thread_count,
+		"", "",
+		std::make_shared<HlsPacketizerFactory>(_ts_writer_type),
 		nullptr);
 }
 
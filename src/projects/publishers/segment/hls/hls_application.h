@@ -11,14 +11,19 @@
 #include <base/common_types.h>
 #include <base/publisher/application.h>
 
+#include "../segment_stream/packetizer/chunked_transfer_interface.h"
+#include "hls_ts_writer.h"
+
 class HlsPublisher;
 
 class HlsApplication : public pub::Application
 {
 public:
-	static std::shared_ptr<HlsApplication> Create(const std::shared_ptr<HlsPublisher> &publisher, const info::Application &application_info);
+	static std::shared_ptr<HlsApplication> Create(const std::shared_ptr<HlsPublisher> &publisher, const info::Application &application_info,
+												  const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer);
 
-	HlsApplication(const std::shared_ptr<HlsPublisher> &publisher, const info::Application &application_info);
+	HlsApplication(const std::shared_ptr<HlsPublisher> &publisher, const info::Application &application_info,
+				   const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer);
 	~HlsApplication() override;
 
 private:
@@ -29,6 +34,16 @@ private:
 	std::shared_ptr<pub::Stream> CreateStream(const std::shared_ptr<info::Stream> &info, uint32_t thread_count) override;
 	bool DeleteStream(const std::shared_ptr<info::Stream> &info) override;
 
+	// Returns false if a track of the stream cannot be packetized for LL-HLS
+	bool IsLowLatencySupported(const std::shared_ptr<info::Stream> &info) const;
+
 	int _segment_count;
 	int _segment_duration;
+	HlsTsWriter::Type _ts_writer_type = HlsTsWriter::Type::FFmpeg;
+
+	// Low-Latency HLS
+	bool _low_latency = false;
+	double _part_duration = 0.0;
+
+	std::shared_ptr<ChunkedTransferInterface> _chunked_transfer = nullptr;
 };
@@ -39,9 +39,10 @@ bool HlsInterceptor::IsInterceptorForRequest(const std::shared_ptr<const http::s
 		return false;
 	}
 
-	// ts/m3u8
+	// ts/m3u8, and m4s of LL-HLS
 	if ((request->GetRequestTarget().IndexOf(".ts") >= 0) ||
-		(request->GetRequestTarget().IndexOf(".m3u8") >= 0))
+		(request->GetRequestTarget().IndexOf(".m3u8") >= 0) ||
+		(request->GetRequestTarget().IndexOf(LLHLS_SEGMENT_FULL_SUFFIX) >= 0))
 	{
 		return true;
 	}
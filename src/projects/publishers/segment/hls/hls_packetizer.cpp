@@ -9,7 +9,6 @@
 #include "hls_packetizer.h"
 
 #include <base/ovlibrary/ovlibrary.h>
-#include <modules/segment_writer/writer.h>
 #include <publishers/segment/segment_stream/packetizer/packetizer_define.h>
 
 #include <algorithm>
@@ -37,17 +36,18 @@ static inline void DumpSegmentToFile(const std::shared_ptr<const SegmentItem> &s
 HlsPacketizer::HlsPacketizer(const ov::String &app_name, const ov::String &stream_name,
 							 uint32_t segment_count, uint32_t segment_duration,
 							 const std::shared_ptr<MediaTrack> &video_track, const std::shared_ptr<MediaTrack> &audio_track,
-							 const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer)
+							 const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer,
+							 HlsTsWriter::Type ts_writer_type)
 	: Packetizer(app_name, stream_name,
 				 segment_count, segment_count * 5, segment_duration,
 				 video_track, audio_track,
-				 chunked_transfer),
-
-	  _ts_writer(Writer::Type::MpegTs, Writer::MediaType::Both)
+				 chunked_transfer)
 {
 	_video_enable = false;
 	_audio_enable = false;
 
+	_ts_writer = HlsTsWriter::Create(ts_writer_type);
+
 	SetVideoTrack(video_track);
 	SetAudioTrack(audio_track);
 
@@ -78,7 +78,7 @@ void HlsPacketizer::SetVideoTrack(const std::shared_ptr<MediaTrack> &video_track
 			}
 			else
 			{
-				if (_ts_writer.AddTrack(video_track))
+				if (_ts_writer->AddTrack(video_track))
 				{
 					_ideal_duration_for_video = _segment_duration * _video_timescale;
 					_ideal_duration_for_video_in_ms = static_cast<int64_t>(_segment_duration * 1000);
@@ -120,7 +120,7 @@ void HlsPacketizer::SetAudioTrack(const std::shared_ptr<MediaTrack> &audio_track
 			}
 			else
 			{
-				if (_ts_writer.AddTrack(audio_track))
+				if (_ts_writer->AddTrack(audio_track))
 				{
 					_ideal_duration_for_audio = _segment_duration * _audio_timescale;
 					_ideal_duration_for_audio_in_ms = static_cast<int64_t>(_segment_duration * 1000);
@@ -140,7 +140,7 @@ void HlsPacketizer::SetAudioTrack(const std::shared_ptr<MediaTrack> &audio_track
 
 HlsPacketizer::~HlsPacketizer()
 {
-	_ts_writer.Finalize();
+	_ts_writer->Finalize();
 }
 
 bool HlsPacketizer::AppendVideoFrame(const std::shared_ptr<const MediaPacket> &media_packet)
@@ -172,7 +172,7 @@ bool HlsPacketizer::AppendVideoFrame(const std::shared_ptr<const MediaPacket> &m
 		_video_key_frame_received = true;
 	}
 
-	if (_ts_writer.PrepareIfNeeded() == false)
+	if (_ts_writer->PrepareIfNeeded() == false)
 	{
 		logte("Could not prepare ts writer");
 		return false;
@@ -182,10 +182,10 @@ bool HlsPacketizer::AppendVideoFrame(const std::shared_ptr<const MediaPacket> &m
 
 	if ((media_packet->GetFlag() == MediaPacketFlag::Key) && (_first_video_pts >= 0L))
 	{
-		auto first_pts = _ts_writer.GetFirstPts(media_packet->GetTrackId());
+		auto first_pts = _ts_writer->GetFirstPts(media_packet->GetTrackId());
 		auto duration = std::max(
 			media_packet->GetPts() - first_pts,
-			_ts_writer.GetDuration(media_packet->GetTrackId()));
+			_ts_writer->GetDuration(media_packet->GetTrackId()));
 
 		if (duration >= _ideal_duration_for_video)
 		{
@@ -193,7 +193,7 @@ bool HlsPacketizer::AppendVideoFrame(const std::shared_ptr<const MediaPacket> &m
 		}
 	}
 
-	result = result && _ts_writer.WritePacket(media_packet);
+	result = result && _ts_writer->WritePacket(media_packet);
 
 	if (result)
 	{
@@ -235,7 +235,7 @@ bool HlsPacketizer::AppendAudioFrame(const std::shared_ptr<const MediaPacket> &m
 		_audio_key_frame_received = true;
 	}
 
-	if (_ts_writer.PrepareIfNeeded() == false)
+	if (_ts_writer->PrepareIfNeeded() == false)
 	{
 		logte("Could not prepare ts writer");
 		return false;
@@ -245,10 +245,10 @@ bool HlsPacketizer::AppendAudioFrame(const std::shared_ptr<const MediaPacket> &m
 
 	if ((media_packet->GetFlag() == MediaPacketFlag::Key) && (_first_audio_pts >= 0L))
 	{
-		auto first_pts = _ts_writer.GetFirstPts(media_packet->GetTrackId());
+		auto first_pts = _ts_writer->GetFirstPts(media_packet->GetTrackId());
 		auto duration = std::max(
 			media_packet->GetPts() - first_pts,
-			_ts_writer.GetDuration(media_packet->GetTrackId()));
+			_ts_writer->GetDuration(media_packet->GetTrackId()));
 
 		if (duration >= _ideal_duration_for_audio)
 		{
@@ -260,7 +260,7 @@ bool HlsPacketizer::AppendAudioFrame(const std::shared_ptr<const MediaPacket> &m
 		}
 	}
 
-	result = result && _ts_writer.WritePacket(media_packet);
+	result = result && _ts_writer->WritePacket(media_packet);
 
 	if (result)
 	{
@@ -273,7 +273,7 @@ bool HlsPacketizer::AppendAudioFrame(const std::shared_ptr<const MediaPacket> &m
 
 bool HlsPacketizer::WriteSegment(int64_t timestamp, int64_t timestamp_in_ms, int64_t duration, int64_t duration_in_ms)
 {
-	auto data = _ts_writer.Finalize();
+	auto data = _ts_writer->Finalize();
 
 	if (data == nullptr)
 	{
@@ -292,7 +292,7 @@ bool HlsPacketizer::WriteSegment(int64_t timestamp, int64_t timestamp_in_ms, int
 
 	UpdatePlayList();
 
-	if (_ts_writer.Prepare() == false)
+	if (_ts_writer->Prepare() == false)
 	{
 		logae("Could not prepare ts writer");
 		return false;
@@ -336,14 +336,14 @@ bool HlsPacketizer::UpdatePlayList()
 
 	// logad("%p %d %s", this, IsReadyForStreaming(), play_list.CStr());
 
-	SetPlayList(play_list);
+	SetPlayList(play_list, HLS_PLAYLIST_CONTENT_TYPE, "max-age=2");
 
 	if (_stat_stop_watch.IsElapsed(5000) && _stat_stop_watch.Update())
 	{
 		if ((_video_track != nullptr) && (_audio_track != nullptr))
 		{
-			auto audio_pts_in_ms = static_cast<int64_t>(_ts_writer.GetFirstPts(cmn::MediaType::Audio) * _audio_timebase_expr_ms);
-			auto video_pts_in_ms = static_cast<int64_t>(_ts_writer.GetFirstPts(cmn::MediaType::Video) * _video_timebase_expr_ms);
+			auto audio_pts_in_ms = static_cast<int64_t>(_ts_writer->GetFirstPts(cmn::MediaType::Audio) * _audio_timebase_expr_ms);
+			auto video_pts_in_ms = static_cast<int64_t>(_ts_writer->GetFirstPts(cmn::MediaType::Video) * _video_timebase_expr_ms);
 			auto delta_in_ms = audio_pts_in_ms - video_pts_in_ms;
 
 			logas("A-V Sync: %lldms (A: %lldms, V: %lldms)", delta_in_ms, audio_pts_in_ms, video_pts_in_ms);
@@ -8,9 +8,8 @@
 //==============================================================================
 #pragma once
 
-#include <modules/segment_writer/writer.h>
-
 #include "../segment_stream/packetizer/packetizer.h"
+#include "hls_ts_writer.h"
 
 class HlsPacketizer : public Packetizer
 {
@@ -18,7 +17,8 @@ public:
 	HlsPacketizer(const ov::String &app_name, const ov::String &stream_name,
 				  uint32_t segment_count, uint32_t segment_duration,
 				  const std::shared_ptr<MediaTrack> &video_track, const std::shared_ptr<MediaTrack> &audio_track,
-				  const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer);
+				  const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer,
+				  HlsTsWriter::Type ts_writer_type = HlsTsWriter::Type::FFmpeg);
 
 	~HlsPacketizer() override;
 
@@ -105,7 +105,7 @@ protected:
 	bool _video_ready = false;
 	bool _audio_ready = false;
 
-	Writer _ts_writer;
+	std::shared_ptr<HlsTsWriter> _ts_writer;
 
 	ov::StopWatch _stat_stop_watch;
 };
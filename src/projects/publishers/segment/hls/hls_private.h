@@ -13,6 +13,22 @@
 #define HLS_SEGMENT_EXT 				"ts"
 #define HLS_PLAYLIST_EXT 				"m3u8"
 #define HLS_PLAYLIST_FILE_NAME 			"playlist.m3u8"
+#define HLS_PLAYLIST_CONTENT_TYPE 		"application/vnd.apple.mpegurl"
+
+// Low-Latency HLS (fMP4)
+//   - Media playlist: video_llhls.m3u8
+//   - Init: init_video_llhls.m4s
+//   - Segment: <msn>_video_llhls.m4s
+//   - Part: <msn>_<part>_video_llhls.m4s
+#define LLHLS_SUFFIX					"_llhls"
+#define LLHLS_SEGMENT_EXT				"m4s"
+#define LLHLS_INIT_FILE_PREFIX			"init_"
+#define LLHLS_VIDEO_NAME				"video" LLHLS_SUFFIX
+#define LLHLS_AUDIO_NAME				"audio" LLHLS_SUFFIX
+#define LLHLS_SEGMENT_FULL_SUFFIX		LLHLS_SUFFIX "." LLHLS_SEGMENT_EXT
+// Delta update of the media playlist: video_llhls.m3u8?_HLS_skip=YES
+// (Used only as an internal file name, since the query string is not a part of the requested file name)
+#define LLHLS_DELTA_PLAY_LIST_SUFFIX	"?_HLS_skip=YES"
 
 #define logad(format, ...)				logtd("[%s/%s] %s: " format, _app_name.CStr(), _stream_name.CStr(), GetPacketizerName(), ##__VA_ARGS__)
 #define logas(format, ...)				logts("[%s/%s] %s: " format, _app_name.CStr(), _stream_name.CStr(), GetPacketizerName(), ##__VA_ARGS__)
@@ -44,7 +44,7 @@ bool HlsPublisher::Start()
 	worker_count = is_parsed ? worker_count : HTTP_SERVER_USE_DEFAULT_COUNT;
 
 	return SegmentPublisher::Start(hls_config.GetPort(), hls_config.GetTlsPort(),
-								   std::make_shared<HlsStreamServer>(), worker_count);
+								   std::make_shared<HlsStreamServer>(), worker_count, hls_config.IsReusePortEnabled(), hls_config.GetKeepAliveTimeout(), hls_config.IsKernelTlsEnabled());
 }
 
 std::shared_ptr<pub::Application> HlsPublisher::OnCreatePublisherApplication(const info::Application &application_info)
@@ -54,7 +54,7 @@ std::shared_ptr<pub::Application> HlsPublisher::OnCreatePublisherApplication(con
 		return nullptr;
 	}
 
-	return HlsApplication::Create(pub::Publisher::GetSharedPtrAs<HlsPublisher>(), application_info);
+	return HlsApplication::Create(pub::Publisher::GetSharedPtrAs<HlsPublisher>(), application_info, std::static_pointer_cast<HlsStreamServer>(_stream_server));
 }
 
 bool HlsPublisher::OnDeletePublisherApplication(const std::shared_ptr<pub::Application> &application)
@@ -14,7 +14,8 @@ HlsStreamPacketizer::HlsStreamPacketizer(const ov::String &app_name, const ov::S
 										 int segment_count, int segment_duration,
 										 const ov::String &utc_timing_scheme, const ov::String &utc_timing_value,
 										 std::shared_ptr<MediaTrack> video_track, std::shared_ptr<MediaTrack> audio_track,
-										 const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer)
+										 const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer,
+										 HlsTsWriter::Type ts_writer_type)
 	: StreamPacketizer(app_name, stream_name,
 					   segment_count, segment_duration,
 					   utc_timing_scheme, utc_timing_value,
@@ -24,7 +25,8 @@ HlsStreamPacketizer::HlsStreamPacketizer(const ov::String &app_name, const ov::S
 	_packetizer = std::make_shared<HlsPacketizer>(app_name, stream_name,
 												  segment_count, segment_duration,
 												  video_track, audio_track,
-												  chunked_transfer);
+												  chunked_transfer,
+												  ts_writer_type);
 }
 
 bool HlsStreamPacketizer::AppendVideoData(const std::shared_ptr<MediaPacket> &media_packet)
@@ -37,7 +39,7 @@ bool HlsStreamPacketizer::AppendAudioData(const std::shared_ptr<MediaPacket> &me
 	return _packetizer->AppendAudioFrame(media_packet);
 }
 
-bool HlsStreamPacketizer::GetPlayList(ov::String &play_list)
+bool HlsStreamPacketizer::GetPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list)
 {
 	return _packetizer->GetPlayList(play_list);
 }
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <publishers/segment/segment_stream/segment_stream.h>
 #include <publishers/segment/segment_stream/stream_packetizer.h>
 
 #include "hls_packetizer.h"
@@ -20,7 +21,8 @@ public:
 						int segment_count, int segment_duration,
 						const ov::String &utc_timing_scheme, const ov::String &utc_timing_value,
 						std::shared_ptr<MediaTrack> video_track, std::shared_ptr<MediaTrack> audio_track,
-						const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer);
+						const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer,
+						HlsTsWriter::Type ts_writer_type = HlsTsWriter::Type::FFmpeg);
 
 public:
 	bool AppendVideoData(const std::shared_ptr<MediaPacket> &media_packet) override;
@@ -36,6 +38,35 @@ public:
 		return false;
 	}
 
-	bool GetPlayList(ov::String &play_list) override;
+	bool GetPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list) override;
 	std::shared_ptr<const SegmentItem> GetSegmentData(const ov::String &file_name) const override;
 };
+
+// PacketizerFactory<> cannot be used, because the TS writer type is needed to create the packetizer
+class HlsPacketizerFactory : public PacketizerFactoryInterface
+{
+public:
+	HlsPacketizerFactory(HlsTsWriter::Type ts_writer_type)
+		: _ts_writer_type(ts_writer_type)
+	{
+	}
+
+	std::shared_ptr<StreamPacketizer> Create(
+		const ov::String &app_name, const ov::String &stream_name,
+		uint32_t segment_count, uint32_t segment_duration,
+		const ov::String &utc_timing_scheme, const ov::String &utc_timing_value,
+		const std::shared_ptr<MediaTrack> &video_track, const std::shared_ptr<MediaTrack> &audio_track,
+		const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer) override
+	{
+		return std::make_shared<HlsStreamPacketizer>(
+			app_name, stream_name,
+			segment_count, segment_duration,
+			utc_timing_scheme, utc_timing_value,
+			video_track, audio_track,
+			chunked_transfer,
+			_ts_writer_type);
+	}
+
+protected:
+	HlsTsWriter::Type _ts_writer_type;
+};
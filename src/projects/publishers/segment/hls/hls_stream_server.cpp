@@ -10,6 +10,40 @@
 
 #include "../segment_publisher.h"
 #include "hls_private.h"
+#include "ll_hls_packetizer.h"
+
+// Interval to check the expired blocking requests
+#define LLHLS_BLOCKED_REQUEST_CHECK_INTERVAL 500
+// The state of the media playlist which is not updated for this duration is removed (Unit: ms)
+#define LLHLS_PLAY_LIST_STATE_TIMEOUT (60 * 1000)
+
+bool HlsStreamServer::PrepareInterceptors(
+	const std::shared_ptr<http::svr::HttpServer> &http_server,
+	const std::shared_ptr<http::svr::HttpsServer> &https_server,
+	int thread_count, const SegmentProcessHandler &process_handler)
+{
+	if (SegmentStreamServer::PrepareInterceptors(http_server, https_server, thread_count, process_handler) == false)
+	{
+		return false;
+	}
+
+	_blocked_request_timer.Push(std::bind(&HlsStreamServer::ExpireBlockedRequests, this, std::placeholders::_1), LLHLS_BLOCKED_REQUEST_CHECK_INTERVAL);
+
+	return _blocked_request_timer.Start();
+}
+
+bool HlsStreamServer::Stop()
+{
+	_blocked_request_timer.Stop();
+	_blocked_request_timer.Clear();
+
+	{
+		std::lock_guard<std::shared_mutex> lock(_play_list_state_map_mutex);
+		_play_list_state_map.clear();
+	}
+
+	return SegmentStreamServer::Stop();
+}
 
 http::svr::ConnectionPolicy HlsStreamServer::ProcessStreamRequest(const std::shared_ptr<http::svr::HttpConnection> &client,
 													 const SegmentStreamRequestInfo &request_info,
@@ -21,14 +55,64 @@ http::svr::ConnectionPolicy HlsStreamServer::ProcessStreamRequest(const std::sha
 	{
 		return ProcessPlayListRequest(client, request_info, PlayListType::M3u8);
 	}
+	else if (LlHlsPacketizer::IsMediaPlayListFileName(request_info.file_name))
+	{
+		int64_t msn = -1LL;
+		int64_t part = -1LL;
+		bool skip = false;
+
+		if (ParseBlockingReloadQuery(client, msn, part, skip) == false)
+		{
+			response->SetStatusCode(http::StatusCode::BadRequest);
+			response->Response();
+			return http::svr::ConnectionPolicy::KeepAlive;
+		}
+
+		http::svr::ConnectionPolicy policy;
+
+		if ((msn >= 0LL) && BlockRequestIfNeeded(client, request_info, request_info.file_name, msn, part, policy))
+		{
+			return policy;
+		}
+
+		if (skip)
+		{
+			// The delta update is served (and cached) as a separate playlist
+			SegmentStreamRequestInfo delta_request_info(request_info.vhost_app_name, request_info.host_name, request_info.stream_name,
+														LlHlsPacketizer::GetDeltaPlayListFileName(request_info.file_name));
+
+			return ProcessPlayListRequest(client, delta_request_info, PlayListType::M3u8);
+		}
+
+		return ProcessPlayListRequest(client, request_info, PlayListType::M3u8);
+	}
 	else if (file_ext == HLS_SEGMENT_EXT)
 	{
 		return ProcessSegmentRequest(client, request_info, SegmentType::MpegTs);
 	}
+	else if (file_ext == LLHLS_SEGMENT_EXT)
+	{
+		int64_t msn;
+		int64_t part;
+		ov::String play_list_file_name;
+
+		// The part of EXT-X-PRELOAD-HINT is requested before it is completed
+		if (LlHlsPacketizer::ParsePartFileName(request_info.file_name, msn, part, play_list_file_name))
+		{
+			http::svr::ConnectionPolicy policy;
+
+			if (BlockRequestIfNeeded(client, request_info, play_list_file_name, msn, part, policy))
+			{
+				return policy;
+			}
+		}
+
+		return ProcessSegmentRequest(client, request_info, SegmentType::M4S);
+	}
 
 	response->SetStatusCode(http::StatusCode::NotFound);
 	response->Response();
-	return http::svr::ConnectionPolicy::Closed;
+	return http::svr::ConnectionPolicy::KeepAlive;
 }
 
 http::svr::ConnectionPolicy HlsStreamServer::ProcessPlayListRequest(const std::shared_ptr<http::svr::HttpConnection> &client,
@@ -37,7 +121,7 @@ http::svr::ConnectionPolicy HlsStreamServer::ProcessPlayListRequest(const std::s
 {
 	auto response = client->GetResponse();
 
-	ov::String play_list;
+	std::shared_ptr<const http::svr::CachedResponse> play_list;
 
 	auto item = std::find_if(_observers.begin(), _observers.end(),
 							 [client, request_info, &play_list](std::shared_ptr<SegmentStreamObserver> &observer) -> bool {
@@ -50,25 +134,17 @@ http::svr::ConnectionPolicy HlsStreamServer::ProcessPlayListRequest(const std::s
 		response->SetStatusCode(http::StatusCode::NotFound);
 		response->Response();
 
-		return http::svr::ConnectionPolicy::Closed;
+		return http::svr::ConnectionPolicy::KeepAlive;
 	}
 
-	if (response->GetStatusCode() != http::StatusCode::OK || play_list.IsEmpty())
+	if (response->GetStatusCode() != http::StatusCode::OK || (play_list == nullptr))
 	{
 		logte("Could not find a %s playlist for [%s/%s], %s : %d", GetPublisherName(), request_info.vhost_app_name.CStr(), request_info.stream_name.CStr(), request_info.file_name.CStr(), response->GetStatusCode());
 		response->Response();
-		return http::svr::ConnectionPolicy::Closed;
+		return http::svr::ConnectionPolicy::KeepAlive;
 	}
 
-	// Set HTTP header
-	response->SetHeader("Content-Type", "application/vnd.apple.mpegurl");
-//	response->SetHeader("Cache-Control", "no-cache, no-store, must-revalidate");
-	response->SetHeader("Cache-Control", "max-age=2");
-//	response->SetHeader("Pragma", "no-cache");
-//	response->SetHeader("Expires", "0");
-
-	response->AppendString(play_list);
-	auto sent_bytes = response->Response();
+	auto sent_bytes = SendCachedResponse(client, play_list);
 
 	auto metric = GetStreamMetric(client);
 	if(metric != nullptr)
@@ -77,7 +153,7 @@ http::svr::ConnectionPolicy HlsStreamServer::ProcessPlayListRequest(const std::s
 	}
 
 
-	return http::svr::ConnectionPolicy::Closed;
+	return http::svr::ConnectionPolicy::KeepAlive;
 }
 
 http::svr::ConnectionPolicy HlsStreamServer::ProcessSegmentRequest(const std::shared_ptr<http::svr::HttpConnection> &client,
@@ -99,14 +175,10 @@ http::svr::ConnectionPolicy HlsStreamServer::ProcessSegmentRequest(const std::sh
 		response->SetStatusCode(http::StatusCode::NotFound);
 		response->Response();
 
-		return http::svr::ConnectionPolicy::Closed;
+		return http::svr::ConnectionPolicy::KeepAlive;
 	}
 
-	// Set HTTP header
-	response->SetHeader("Cache-Control", "max-age=300");
-	response->SetHeader("Content-Type", "video/MP2T");
-	response->AppendData(segment->data);
-	auto sent_bytes = response->Response();
+	auto sent_bytes = SendCachedResponse(client, segment->response);
 
 	auto metric = GetStreamMetric(client);
 	if(metric != nullptr)
@@ -114,5 +186,233 @@ http::svr::ConnectionPolicy HlsStreamServer::ProcessSegmentRequest(const std::sh
 		metric->IncreaseBytesOut(GetPublisherType(), sent_bytes);
 	}
 
-	return http::svr::ConnectionPolicy::Closed;
+	return http::svr::ConnectionPolicy::KeepAlive;
+}
+
+bool HlsStreamServer::ParseBlockingReloadQuery(const std::shared_ptr<http::svr::HttpConnection> &client, int64_t &msn, int64_t &part, bool &skip)
+{
+	auto url = ov::Url::Parse(client->GetRequest()->GetUri());
+
+	if (url == nullptr)
+	{
+		return false;
+	}
+
+	if (url->HasQueryKey("_HLS_msn"))
+	{
+		if (LlHlsPacketizer::ParseSequenceNumber(url->GetQueryValue("_HLS_msn"), msn) == false)
+		{
+			return false;
+		}
+	}
+
+	if (url->HasQueryKey("_HLS_part"))
+	{
+		// _HLS_part without _HLS_msn is not allowed
+		if ((msn < 0LL) || (LlHlsPacketizer::ParseSequenceNumber(url->GetQueryValue("_HLS_part"), part) == false))
+		{
+			return false;
+		}
+	}
+
+	if (url->HasQueryKey("_HLS_skip"))
+	{
+		auto value = url->GetQueryValue("_HLS_skip");
+
+		// v2 also skips EXT-X-DATERANGE tags, which are not used in the playlist
+		if ((value != "YES") && (value != "v2"))
+		{
+			return false;
+		}
+
+		skip = true;
+	}
+
+	return true;
+}
+
+bool HlsStreamServer::BlockRequestIfNeeded(const std::shared_ptr<http::svr::HttpConnection> &client,
+										   const SegmentStreamRequestInfo &request_info, const ov::String &play_list_file_name,
+										   int64_t msn, int64_t part,
+										   http::svr::ConnectionPolicy &policy)
+{
+	auto key = ov::String::FormatString("%s/%s/%s", request_info.vhost_app_name.CStr(), request_info.stream_name.CStr(), play_list_file_name.CStr());
+
+	// Keep the shared lock until the request is added, so the state is not removed by ExpireBlockedRequests()
+	std::shared_lock<std::shared_mutex> map_lock(_play_list_state_map_mutex);
+
+	auto item = _play_list_state_map.find(key);
+
+	if (item == _play_list_state_map.end())
+	{
+		// The stream is not started yet - respond the current playlist (or 404)
+		return false;
+	}
+
+	auto &state = item->second;
+	std::lock_guard<std::mutex> lock(state->mutex);
+
+	if (state->IsSatisfied(msn, part))
+	{
+		return false;
+	}
+
+	if (msn > (state->msn + 2LL))
+	{
+		// The server must respond "400 Bad Request" if _HLS_msn is greater than the last msn plus two
+		logtd("[%s] Invalid blocking request: msn: %" PRId64 ", part: %" PRId64 " (last msn: %" PRId64 ")",
+			  key.CStr(), msn, part, state->msn);
+
+		auto response = client->GetResponse();
+		response->SetStatusCode(http::StatusCode::BadRequest);
+		response->Response();
+
+		policy = http::svr::ConnectionPolicy::KeepAlive;
+		return true;
+	}
+
+	BlockedRequest blocked_request;
+
+	blocked_request.client = client;
+	blocked_request.msn = msn;
+	blocked_request.part = part;
+	// The server should respond "503 Service Unavailable" if the part is not available within three target durations
+	blocked_request.expire_time_msec = ov::Clock::NowMSec() + std::max(state->target_duration * 3 * 1000, 1000);
+
+	state->blocked_requests.push_back(blocked_request);
+
+	policy = http::svr::ConnectionPolicy::Deferred;
+	return true;
+}
+
+void HlsStreamServer::OnLlHlsPartCompleted(const ov::String &app_name, const ov::String &stream_name,
+										   const LlHlsPartInfo &part_info)
+{
+	auto key = ov::String::FormatString("%s/%s/%s", app_name.CStr(), stream_name.CStr(), part_info.play_list_file_name.CStr());
+
+	std::vector<std::shared_ptr<http::svr::HttpConnection>> client_list;
+
+	auto update_state = [&part_info, &client_list](PlayListState &state) {
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		state.msn = part_info.msn;
+		state.part = part_info.part;
+		state.is_last_part = part_info.is_last_part;
+		state.target_duration = part_info.target_duration;
+		state.update_time_msec = ov::Clock::NowMSec();
+
+		state.ReleaseBlockedRequests(
+			[&state](const BlockedRequest &request) -> bool {
+				return state.IsSatisfied(request.msn, request.part);
+			},
+			client_list);
+	};
+
+	{
+		std::shared_lock<std::shared_mutex> map_lock(_play_list_state_map_mutex);
+
+		auto item = _play_list_state_map.find(key);
+
+		if (item != _play_list_state_map.end())
+		{
+			update_state(*(item->second));
+		}
+		else
+		{
+			map_lock.unlock();
+
+			// The first part of the playlist
+			std::lock_guard<std::shared_mutex> exclusive_lock(_play_list_state_map_mutex);
+
+			auto &state = _play_list_state_map[key];
+
+			if (state == nullptr)
+			{
+				state = std::make_shared<PlayListState>();
+			}
+
+			update_state(*state);
+		}
+	}
+
+	// The requests are processed again by the workers of the interceptor
+	for (auto &client : client_list)
+	{
+		if (_interceptor->AddWork(client) == false)
+		{
+			RespondError(client, http::StatusCode::ServiceUnavailable);
+		}
+	}
+}
+
+void HlsStreamServer::RespondError(const std::shared_ptr<http::svr::HttpConnection> &client, http::StatusCode status_code)
+{
+	auto response = client->GetResponse();
+
+	response->SetStatusCode(status_code);
+	response->Response();
+
+	if (client->IsKeepAliveAvailable())
+	{
+		client->PrepareNextRequest();
+	}
+	else
+	{
+		response->Close();
+	}
+}
+
+ov::DelayQueueAction HlsStreamServer::ExpireBlockedRequests(void *parameter)
+{
+	auto current_msec = ov::Clock::NowMSec();
+
+	std::vector<std::shared_ptr<http::svr::HttpConnection>> client_list;
+	std::vector<ov::String> stale_key_list;
+
+	{
+		std::shared_lock<std::shared_mutex> map_lock(_play_list_state_map_mutex);
+
+		for (auto &item : _play_list_state_map)
+		{
+			auto &state = item.second;
+			std::lock_guard<std::mutex> lock(state->mutex);
+
+			state->ReleaseBlockedRequests(
+				[current_msec](const BlockedRequest &request) -> bool {
+					return current_msec >= request.expire_time_msec;
+				},
+				client_list);
+
+			// The stream may be deleted
+			if (state->blocked_requests.empty() && state->IsStale(current_msec, LLHLS_PLAY_LIST_STATE_TIMEOUT))
+			{
+				stale_key_list.push_back(item.first);
+			}
+		}
+	}
+
+	if (stale_key_list.empty() == false)
+	{
+		std::lock_guard<std::shared_mutex> exclusive_lock(_play_list_state_map_mutex);
+
+		for (auto &key : stale_key_list)
+		{
+			auto item = _play_list_state_map.find(key);
+
+			// Check again, because a part or a request may be added after the shared lock is released
+			if ((item != _play_list_state_map.end()) &&
+				item->second->blocked_requests.empty() && item->second->IsStale(current_msec, LLHLS_PLAY_LIST_STATE_TIMEOUT))
+			{
+				_play_list_state_map.erase(item);
+			}
+		}
+	}
+
+	for (auto &client : client_list)
+	{
+		logtd("The blocking request is expired: %s", client->GetRequest()->GetRequestTarget().CStr());
+		RespondError(client, http::StatusCode::ServiceUnavailable);
+	}
+
+	return ov::DelayQueueAction::Repeat;
 }
@@ -8,12 +8,20 @@
 //==============================================================================
 #pragma once
 
+#include <algorithm>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "../segment_stream/packetizer/chunked_transfer_interface.h"
 #include "../segment_stream/segment_stream_server.h"
 #include "hls_interceptor.h"
 
-class HlsStreamServer : public SegmentStreamServer
+// Also implements ChunkedTransferInterface to receive the parts of LL-HLS
+class HlsStreamServer : public SegmentStreamServer, public ChunkedTransferInterface
 {
 public:
+	bool Stop() override;
+
 	PublisherType GetPublisherType() const noexcept override
 	{
 		return PublisherType::Hls;
@@ -27,10 +35,83 @@ public:
 	std::shared_ptr<SegmentStreamInterceptor> CreateInterceptor() override
 	{
 		auto interceptor = std::make_shared<HlsInterceptor>();
+
+		// Used to process the blocked requests again
+		_interceptor = interceptor;
+
 		return std::static_pointer_cast<SegmentStreamInterceptor>(interceptor);
 	}
 
 protected:
+	// A request of LL-HLS which is blocked until the part is added to the media playlist
+	// (Blocking playlist reload, or the part of EXT-X-PRELOAD-HINT)
+	struct BlockedRequest
+	{
+		std::shared_ptr<http::svr::HttpConnection> client;
+
+		int64_t msn = 0LL;
+		// -1: Wait for the segment of msn to be completed
+		int64_t part = -1LL;
+
+		uint64_t expire_time_msec = 0ULL;
+	};
+
+	// The last part added to a media playlist of LL-HLS
+	struct PlayListState
+	{
+		int64_t msn = 0LL;
+		int64_t part = 0LL;
+		bool is_last_part = false;
+
+		// Unit: second
+		int target_duration = 0;
+		uint64_t update_time_msec = 0ULL;
+
+		// Protects the fields of this state, so the parts of the other playlists are not serialized
+		std::mutex mutex;
+		std::vector<BlockedRequest> blocked_requests;
+
+		bool IsSatisfied(int64_t request_msn, int64_t request_part) const
+		{
+			if (msn != request_msn)
+			{
+				return msn > request_msn;
+			}
+
+			return (request_part < 0LL) ? is_last_part : (part >= request_part);
+		}
+
+		bool IsStale(uint64_t current_msec, uint64_t timeout_msec) const
+		{
+			return (current_msec > update_time_msec) && ((current_msec - update_time_msec) > timeout_msec);
+		}
+
+		// Moves the clients of the requests which match the condition to client_list in one pass
+		template <typename Tcondition>
+		void ReleaseBlockedRequests(Tcondition condition, std::vector<std::shared_ptr<http::svr::HttpConnection>> &client_list)
+		{
+			auto released = std::partition(blocked_requests.begin(), blocked_requests.end(),
+										   [&condition](const BlockedRequest &request) -> bool {
+											   return condition(request) == false;
+										   });
+
+			for (auto request = released; request != blocked_requests.end(); ++request)
+			{
+				client_list.push_back(std::move(request->client));
+			}
+
+			blocked_requests.erase(released, blocked_requests.end());
+		}
+	};
+
+	//--------------------------------------------------------------------
+	// Overriding functions of SegmentStreamServer
+	//--------------------------------------------------------------------
+	bool PrepareInterceptors(
+		const std::shared_ptr<http::svr::HttpServer> &http_server,
+		const std::shared_ptr<http::svr::HttpsServer> &https_server,
+		int thread_count, const SegmentProcessHandler &process_handler) override;
+
 	//--------------------------------------------------------------------
 	// Implementation of SegmentStreamServer
 	//--------------------------------------------------------------------
@@ -45,4 +126,55 @@ protected:
 	http::svr::ConnectionPolicy ProcessSegmentRequest(const std::shared_ptr<http::svr::HttpConnection> &client,
 										 const SegmentStreamRequestInfo &request_info,
 										 SegmentType segment_type) override;
+
+	//--------------------------------------------------------------------
+	// Implementation of ChunkedTransferInterface
+	//--------------------------------------------------------------------
+	void OnCmafChunkDataPush(const ov::String &app_name, const ov::String &stream_name,
+							 const ov::String &file_name,
+							 const uint32_t sequence_number,
+							 const uint64_t duration_in_msec,
+							 bool is_video,
+							 std::shared_ptr<ov::Data> &chunk_data) override
+	{
+		// HLS doesn't use CMAF chunked transfer
+	}
+
+	void OnCmafChunkedComplete(const ov::String &app_name, const ov::String &stream_name,
+							   const ov::String &file_name,
+							   bool is_video) override
+	{
+		// HLS doesn't use CMAF chunked transfer
+	}
+
+	void OnLlHlsPartCompleted(const ov::String &app_name, const ov::String &stream_name,
+							  const LlHlsPartInfo &part_info) override;
+
+	// Parses _HLS_msn/_HLS_part/_HLS_skip of the media playlist request
+	//
+	// @return false if the query is invalid
+	bool ParseBlockingReloadQuery(const std::shared_ptr<http::svr::HttpConnection> &client, int64_t &msn, int64_t &part, bool &skip);
+
+	// Blocks the request if the part (or the segment) is not added to the media playlist yet
+	//
+	// @return true if the request is blocked, or the response is sent (policy is set)
+	bool BlockRequestIfNeeded(const std::shared_ptr<http::svr::HttpConnection> &client,
+							  const SegmentStreamRequestInfo &request_info, const ov::String &play_list_file_name,
+							  int64_t msn, int64_t part,
+							  http::svr::ConnectionPolicy &policy);
+
+	// Responds the error to the request which is completed without the normal response
+	void RespondError(const std::shared_ptr<http::svr::HttpConnection> &client, http::StatusCode status_code);
+
+	// Responds "503 Service Unavailable" to the expired requests, and removes the unused states
+	ov::DelayQueueAction ExpireBlockedRequests(void *parameter);
+
+	std::shared_ptr<SegmentStreamInterceptor> _interceptor;
+
+	// Key: [app name]/[stream name]/[playlist file name]
+	std::unordered_map<ov::String, std::shared_ptr<PlayListState>> _play_list_state_map;
+	// Exclusive only to add/remove a state - lock this before PlayListState::mutex
+	std::shared_mutex _play_list_state_map_mutex;
+
+	ov::DelayQueue _blocked_request_timer;
 };
@@ -0,0 +1,169 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "hls_ts_writer.h"
+
+#include <modules/mpegts/mpegts_packetizer.h>
+#include <modules/segment_writer/writer.h>
+
+#include "hls_private.h"
+
+namespace
+{
+	class FFmpegTsWriter : public HlsTsWriter
+	{
+	public:
+		Type GetType() const override
+		{
+			return Type::FFmpeg;
+		}
+
+		bool AddTrack(const std::shared_ptr<const MediaTrack> &media_track) override
+		{
+			return _writer.AddTrack(media_track);
+		}
+
+		bool Prepare() override
+		{
+			return _writer.Prepare();
+		}
+
+		bool PrepareIfNeeded() override
+		{
+			return _writer.PrepareIfNeeded();
+		}
+
+		bool WritePacket(const std::shared_ptr<const MediaPacket> &packet) override
+		{
+			return _writer.WritePacket(packet);
+		}
+
+		std::shared_ptr<const ov::Data> Finalize() override
+		{
+			return _writer.Finalize();
+		}
+
+		int64_t GetFirstPts(uint32_t track_id) const override
+		{
+			return _writer.GetFirstPts(track_id);
+		}
+
+		int64_t GetFirstPts(cmn::MediaType type) const override
+		{
+			return _writer.GetFirstPts(type);
+		}
+
+		int64_t GetDuration(uint32_t track_id) const override
+		{
+			return _writer.GetDuration(track_id);
+		}
+
+	protected:
+		Writer _writer{Writer::Type::MpegTs, Writer::MediaType::Both};
+	};
+
+	class NativeTsWriter : public HlsTsWriter
+	{
+	public:
+		Type GetType() const override
+		{
+			return Type::Native;
+		}
+
+		bool AddTrack(const std::shared_ptr<const MediaTrack> &media_track) override
+		{
+			return _packetizer.AddTrack(media_track);
+		}
+
+		// MpegTsPacketizer starts a segment by itself
+		bool Prepare() override
+		{
+			return true;
+		}
+
+		bool PrepareIfNeeded() override
+		{
+			return true;
+		}
+
+		bool WritePacket(const std::shared_ptr<const MediaPacket> &packet) override
+		{
+			return _packetizer.WritePacket(packet);
+		}
+
+		std::shared_ptr<const ov::Data> Finalize() override
+		{
+			return _packetizer.Finalize();
+		}
+
+		int64_t GetFirstPts(uint32_t track_id) const override
+		{
+			return _packetizer.GetFirstPts(track_id);
+		}
+
+		int64_t GetFirstPts(cmn::MediaType type) const override
+		{
+			return _packetizer.GetFirstPts(type);
+		}
+
+		int64_t GetDuration(uint32_t track_id) const override
+		{
+			return _packetizer.GetDuration(track_id);
+		}
+
+	protected:
+		mpegts::MpegTsPacketizer _packetizer;
+	};
+}  // namespace
+
+std::shared_ptr<HlsTsWriter> HlsTsWriter::Create(Type type)
+{
+	switch (type)
+	{
+		case Type::FFmpeg:
+			return std::make_shared<FFmpegTsWriter>();
+
+		case Type::Native:
+			return std::make_shared<NativeTsWriter>();
+	}
+
+	return nullptr;
+}
+
+bool HlsTsWriter::ParseType(const ov::String &name, Type *type)
+{
+	auto lower_name = name.LowerCaseString();
+
+	if (lower_name == "ffmpeg")
+	{
+		*type = Type::FFmpeg;
+		return true;
+	}
+
+	if (lower_name == "native")
+	{
+		*type = Type::Native;
+		return true;
+	}
+
+	return false;
+}
+
+const char *HlsTsWriter::StringFromType(Type type)
+{
+	switch (type)
+	{
+		case Type::FFmpeg:
+			return "FFmpeg";
+
+		case Type::Native:
+			return "Native";
+	}
+
+	return "Unknown";
+}
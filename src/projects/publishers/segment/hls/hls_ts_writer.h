@@ -0,0 +1,52 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/info/media_track.h>
+#include <base/mediarouter/media_buffer.h>
+
+// Creates the MPEG-TS segments of HLS
+//
+// - FFmpeg: Writer (libavformat)
+// - Native: mpegts::MpegTsPacketizer
+class HlsTsWriter
+{
+public:
+	enum class Type
+	{
+		FFmpeg,
+		Native
+	};
+
+	static std::shared_ptr<HlsTsWriter> Create(Type type);
+
+	// Returns false if the name is unknown (ex: "ffmpeg", "native")
+	static bool ParseType(const ov::String &name, Type *type);
+	static const char *StringFromType(Type type);
+
+	virtual ~HlsTsWriter() = default;
+
+	virtual Type GetType() const = 0;
+
+	virtual bool AddTrack(const std::shared_ptr<const MediaTrack> &media_track) = 0;
+
+	// Starts a new segment
+	virtual bool Prepare() = 0;
+	// Starts a new segment if it is not started yet
+	virtual bool PrepareIfNeeded() = 0;
+
+	virtual bool WritePacket(const std::shared_ptr<const MediaPacket> &packet) = 0;
+
+	// Returns the segment, and the values of the segment are kept until the next segment is started
+	virtual std::shared_ptr<const ov::Data> Finalize() = 0;
+
+	virtual int64_t GetFirstPts(uint32_t track_id) const = 0;
+	virtual int64_t GetFirstPts(cmn::MediaType type) const = 0;
+	virtual int64_t GetDuration(uint32_t track_id) const = 0;
+};
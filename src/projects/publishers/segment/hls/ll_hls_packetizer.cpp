@@ -0,0 +1,747 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "ll_hls_packetizer.h"
+
+#include <cmath>
+
+#include "hls_private.h"
+
+// The parts of the last N segments are listed in the media playlist
+// (Partial segments older than three target durations from the end of the playlist should be removed)
+#define LLHLS_PART_LISTED_SEGMENT_COUNT 2
+// CAN-SKIP-UNTIL of EXT-X-SERVER-CONTROL (Must be at least six times the target duration)
+#define LLHLS_SKIP_UNTIL_TARGET_DURATION_COUNT 6
+// Number of the video segment boundaries which are waiting for the audio
+#define LLHLS_MAX_PENDING_BOUNDARY_COUNT 10
+
+namespace
+{
+	enum class H264NalUnitType : uint8_t
+	{
+		IdrSlice = 5,
+		Sps = 7,
+		Pps = 8,
+	};
+
+	// Finds SPS/PPS, and returns the offset of the first slice (excluding the start code) in the Annex B frame
+	//
+	// Like LL-DASH, the data from the first slice is stored as a sample, so a frame is expected to have a slice
+	ssize_t ParseAnnexBFrame(const std::shared_ptr<const ov::Data> &data,
+							 std::shared_ptr<const ov::Data> *sps, std::shared_ptr<const ov::Data> *pps)
+	{
+		auto buffer = data->GetDataAs<uint8_t>();
+		auto length = data->GetLength();
+
+		// Offset of the NAL unit which is being parsed (excluding the start code)
+		ssize_t nal_offset = -1;
+		size_t offset = 0;
+
+		auto handle_nal_unit = [&](size_t nal_end) -> bool {
+			// Remove trailing_zero_8bits (or the first byte of the 4-bytes start code)
+			while ((nal_end > static_cast<size_t>(nal_offset)) && (buffer[nal_end - 1] == 0x00))
+			{
+				nal_end--;
+			}
+
+			if (nal_end <= static_cast<size_t>(nal_offset))
+			{
+				return false;
+			}
+
+			auto nal_unit_type = buffer[nal_offset] & 0x1F;
+
+			if ((nal_unit_type == static_cast<uint8_t>(H264NalUnitType::Sps)) && (sps != nullptr))
+			{
+				*sps = data->Subdata(nal_offset, nal_end - nal_offset);
+			}
+			else if ((nal_unit_type == static_cast<uint8_t>(H264NalUnitType::Pps)) && (pps != nullptr))
+			{
+				*pps = data->Subdata(nal_offset, nal_end - nal_offset);
+			}
+
+			// Coded slice (non-IDR ~ IDR)
+			return (nal_unit_type >= 1) && (nal_unit_type <= static_cast<uint8_t>(H264NalUnitType::IdrSlice));
+		};
+
+		while ((offset + 3) <= length)
+		{
+			if ((buffer[offset] != 0x00) || (buffer[offset + 1] != 0x00) || (buffer[offset + 2] != 0x01))
+			{
+				offset++;
+				continue;
+			}
+
+			if ((nal_offset >= 0) && handle_nal_unit(offset))
+			{
+				return nal_offset;
+			}
+
+			offset += 3;
+			nal_offset = offset;
+		}
+
+		if ((nal_offset >= 0) && handle_nal_unit(length))
+		{
+			return nal_offset;
+		}
+
+		return -1;
+	}
+}  // namespace
+
+LlHlsPacketizer::LlHlsPacketizer(const ov::String &app_name, const ov::String &stream_name,
+								 uint32_t segment_count, uint32_t segment_duration, double part_duration,
+								 const std::shared_ptr<MediaTrack> &video_track, const std::shared_ptr<MediaTrack> &audio_track,
+								 const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer)
+	: Packetizer(app_name, stream_name,
+				 segment_count, segment_count * 2, segment_duration,
+				 video_track, audio_track,
+				 chunked_transfer),
+
+	  _part_duration(part_duration)
+{
+	if (_part_duration <= 0.0)
+	{
+		_part_duration = 0.5;
+	}
+
+	if (video_track != nullptr)
+	{
+		if (video_track->GetCodecId() == cmn::MediaCodecId::H264)
+		{
+			_video = CreateTrack(cmn::MediaType::Video, video_track);
+		}
+		else
+		{
+			logaw("%s is not supported for LL-HLS, video track is ignored", ::StringFromMediaCodecId(video_track->GetCodecId()).CStr());
+		}
+	}
+
+	if (audio_track != nullptr)
+	{
+		_audio = CreateTrack(cmn::MediaType::Audio, audio_track);
+	}
+}
+
+std::shared_ptr<LlHlsPacketizer::Track> LlHlsPacketizer::CreateTrack(cmn::MediaType media_type, const std::shared_ptr<MediaTrack> &media_track)
+{
+	auto track = std::make_shared<Track>();
+	bool is_video = (media_type == cmn::MediaType::Video);
+
+	track->media_type = media_type;
+	track->m4s_media_type = is_video ? M4sMediaType::Video : M4sMediaType::Audio;
+	// Same as the track ID of M4sInitWriter
+	track->track_id = is_video ? 1U : 2U;
+	track->media_track = media_track;
+
+	track->name = is_video ? LLHLS_VIDEO_NAME : LLHLS_AUDIO_NAME;
+	track->play_list_file_name = ov::String::FormatString("%s.%s", track->name.CStr(), HLS_PLAYLIST_EXT);
+
+	track->timebase_expr = media_track->GetTimeBase().GetExpr();
+	track->ideal_segment_duration = static_cast<int64_t>(_segment_duration * media_track->GetTimeBase().GetTimescale());
+	track->part_target_duration = static_cast<int64_t>(_part_duration * media_track->GetTimeBase().GetTimescale());
+
+	track->segment_data = std::make_shared<ov::Data>();
+
+	return track;
+}
+
+bool LlHlsPacketizer::IsMediaPlayListFileName(const ov::String &file_name)
+{
+	return (file_name == LLHLS_VIDEO_NAME "." HLS_PLAYLIST_EXT) || (file_name == LLHLS_AUDIO_NAME "." HLS_PLAYLIST_EXT);
+}
+
+ov::String LlHlsPacketizer::GetDeltaPlayListFileName(const ov::String &play_list_file_name)
+{
+	return ov::String::FormatString("%s%s", play_list_file_name.CStr(), LLHLS_DELTA_PLAY_LIST_SUFFIX);
+}
+
+bool LlHlsPacketizer::ParseSequenceNumber(const ov::String &value, int64_t &number)
+{
+	if (value.IsEmpty() || (value.GetLength() > 18))
+	{
+		return false;
+	}
+
+	int64_t result = 0LL;
+
+	for (size_t index = 0; index < value.GetLength(); index++)
+	{
+		auto character = value[index];
+
+		if ((character < '0') || (character > '9'))
+		{
+			return false;
+		}
+
+		result = (result * 10) + (character - '0');
+	}
+
+	number = result;
+
+	return true;
+}
+
+bool LlHlsPacketizer::ParsePartFileName(const ov::String &file_name, int64_t &msn, int64_t &part, ov::String &play_list_file_name)
+{
+	ov::String prefix;
+
+	for (auto name : {LLHLS_VIDEO_NAME, LLHLS_AUDIO_NAME})
+	{
+		// _video_llhls.m4s
+		ov::String suffix = ov::String::FormatString("_%s.%s", name, LLHLS_SEGMENT_EXT);
+
+		if (file_name.HasSuffix(suffix))
+		{
+			prefix = file_name.Substring(0, file_name.GetLength() - suffix.GetLength());
+			play_list_file_name = ov::String::FormatString("%s.%s", name, HLS_PLAYLIST_EXT);
+			break;
+		}
+	}
+
+	// <msn>_<part>
+	auto tokens = prefix.Split("_");
+
+	if (tokens.size() != 2)
+	{
+		return false;
+	}
+
+	return ParseSequenceNumber(tokens[0], msn) && ParseSequenceNumber(tokens[1], part);
+}
+
+ov::String LlHlsPacketizer::GetPartFileName(const std::shared_ptr<Track> &track, int64_t msn, int64_t part) const
+{
+	return ov::String::FormatString("%" PRId64 "_%" PRId64 "_%s.%s", msn, part, track->name.CStr(), LLHLS_SEGMENT_EXT);
+}
+
+bool LlHlsPacketizer::WriteVideoInitIfNeeded(const std::shared_ptr<const PacketizerFrameData> &frame)
+{
+	if (_video->init_file != nullptr)
+	{
+		return true;
+	}
+
+	if (frame->type != PacketizerFrameType::VideoKeyFrame)
+	{
+		// Wait for the key frame which has SPS/PPS
+		return false;
+	}
+
+	std::shared_ptr<const ov::Data> sps;
+	std::shared_ptr<const ov::Data> pps;
+
+	ParseAnnexBFrame(frame->data, &sps, &pps);
+
+	if ((sps == nullptr) || (pps == nullptr))
+	{
+		logaw("Could not find SPS/PPS from the key frame (SPS: %zu, PPS: %zu bytes)",
+			  (sps != nullptr) ? sps->GetLength() : 0, (pps != nullptr) ? pps->GetLength() : 0);
+		return false;
+	}
+
+	// init.m4s does not have duration
+	M4sInitWriter writer(M4sMediaType::Video, 0, _video_track, _audio_track, sps, pps);
+	auto init_data = writer.CreateData();
+
+	if (init_data == nullptr)
+	{
+		logae("Could not write the init file for video");
+		return false;
+	}
+
+	_video->init_file = std::make_shared<SegmentItem>(SegmentDataType::Video, 0, ov::String::FormatString("%s%s.%s", LLHLS_INIT_FILE_PREFIX, _video->name.CStr(), LLHLS_SEGMENT_EXT), 0, 0, 0, 0, init_data);
+	AddFile(_video->init_file);
+
+	logad("Init file (%s) is written for video", _video->init_file->file_name.CStr());
+
+	return true;
+}
+
+bool LlHlsPacketizer::WriteAudioInitIfNeeded()
+{
+	if (_audio->init_file != nullptr)
+	{
+		return true;
+	}
+
+	// init.m4s does not have duration
+	M4sInitWriter writer(M4sMediaType::Audio, 0, _video_track, _audio_track, nullptr, nullptr);
+	auto init_data = writer.CreateData();
+
+	if (init_data == nullptr)
+	{
+		logae("Could not write the init file for audio");
+		return false;
+	}
+
+	_audio->init_file = std::make_shared<SegmentItem>(SegmentDataType::Audio, 0, ov::String::FormatString("%s%s.%s", LLHLS_INIT_FILE_PREFIX, _audio->name.CStr(), LLHLS_SEGMENT_EXT), 0, 0, 0, 0, init_data);
+	AddFile(_audio->init_file);
+
+	logad("Init file (%s) is written for audio", _audio->init_file->file_name.CStr());
+
+	return true;
+}
+
+bool LlHlsPacketizer::AppendVideoFrame(const std::shared_ptr<const PacketizerFrameData> &frame)
+{
+	if ((_video == nullptr) || (frame->pts < 0LL))
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(_append_mutex);
+
+	if (WriteVideoInitIfNeeded(frame) == false)
+	{
+		return false;
+	}
+
+	auto offset = ParseAnnexBFrame(frame->data, nullptr, nullptr);
+
+	if (offset < 0)
+	{
+		logaw("Could not find a slice from the video frame (%zu bytes)", frame->data->GetLength());
+		return false;
+	}
+
+	bool is_key_frame = (frame->type == PacketizerFrameType::VideoKeyFrame);
+	auto data = frame->data->Subdata(offset);
+
+	// Refer to the sample flags of CmafPacketizer
+	//   0x02000000: sample_depends_on == 2
+	//   0x01010000: sample_depends_on == 1, sample_is_non_sync_sample = 1
+	uint32_t flag = is_key_frame ? 0x02000000 : 0x01010000;
+
+	return AppendSample(_video, std::make_shared<SampleData>(frame->duration, flag, frame->pts, frame->dts, data), is_key_frame);
+}
+
+bool LlHlsPacketizer::AppendAudioFrame(const std::shared_ptr<const PacketizerFrameData> &frame)
+{
+	if ((_audio == nullptr) || (frame->pts < 0LL))
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(_append_mutex);
+
+	if (WriteAudioInitIfNeeded() == false)
+	{
+		return false;
+	}
+
+	auto data = frame->data;
+	auto buffer = data->GetDataAs<uint8_t>();
+
+	// Skip ADTS header (7 bytes, or 9 bytes if protection_absent == 0)
+	if ((data->GetLength() >= ADTS_HEADER_SIZE) && (buffer[0] == 0xFF) && ((buffer[1] & 0xF0) == 0xF0))
+	{
+		size_t header_size = (buffer[1] & 0x01) ? ADTS_HEADER_SIZE : (ADTS_HEADER_SIZE + 2);
+
+		if (data->GetLength() <= header_size)
+		{
+			return false;
+		}
+
+		data = data->Subdata(header_size);
+	}
+
+	return AppendSample(_audio, std::make_shared<SampleData>(frame->duration, frame->pts, frame->dts, data), true);
+}
+
+bool LlHlsPacketizer::IsSegmentBoundary(const std::shared_ptr<Track> &track, const std::shared_ptr<const SampleData> &sample, bool is_key_frame)
+{
+	if (track->media_type == cmn::MediaType::Video)
+	{
+		// A video segment starts with a key frame
+		return is_key_frame && (track->segment_duration >= track->ideal_segment_duration);
+	}
+
+	if (_video == nullptr)
+	{
+		// Audio only
+		return (track->segment_duration >= track->ideal_segment_duration);
+	}
+
+	// Cut the audio segment when the video segment is cut, to align the media sequence numbers of the renditions
+	if (_video_segment_boundaries.empty() == false)
+	{
+		if ((sample->dts * track->timebase_expr) >= _video_segment_boundaries.front())
+		{
+			_video_segment_boundaries.pop_front();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool LlHlsPacketizer::AppendSample(const std::shared_ptr<Track> &track, const std::shared_ptr<SampleData> &sample, bool is_key_frame)
+{
+	auto &pending_sample = track->pending_sample;
+
+	if (pending_sample != nullptr)
+	{
+		// Now, the duration of the pending sample is known
+		int64_t duration = sample->dts - pending_sample->dts;
+
+		if (duration <= 0LL)
+		{
+			duration = (pending_sample->duration > 0ULL) ? pending_sample->duration : track->last_sample_duration;
+		}
+
+		pending_sample->duration = duration;
+		track->last_sample_duration = duration;
+
+		if (track->part_samples.empty())
+		{
+			track->part_start_dts = pending_sample->dts;
+			track->is_part_independent = track->is_pending_key_frame;
+		}
+
+		track->part_samples.push_back(pending_sample);
+		track->part_duration += duration;
+		track->segment_duration += duration;
+
+		// Complete the part before the new sample if needed
+		if (IsSegmentBoundary(track, sample, is_key_frame))
+		{
+			CompletePart(track, true);
+		}
+		else if ((track->part_duration + track->last_sample_duration) > track->part_target_duration)
+		{
+			// The part must not be longer than PART-TARGET
+			CompletePart(track, false);
+		}
+	}
+
+	if (track->segment_start_dts < 0LL)
+	{
+		// A new segment is started with this sample
+		track->segment_start_dts = sample->dts;
+		track->part_lines.Format("#EXT-X-PROGRAM-DATE-TIME:%s\r\n", ov::Time::MakeUtcMillisecond().CStr());
+	}
+
+	pending_sample = sample;
+	track->is_pending_key_frame = is_key_frame;
+
+	return true;
+}
+
+void LlHlsPacketizer::CompletePart(const std::shared_ptr<Track> &track, bool is_last_part)
+{
+	M4sSegmentWriter writer(track->m4s_media_type, track->fragment_sequence_number++, track->track_id, track->part_start_dts);
+	auto part_data = writer.AppendSamples(track->part_samples);
+
+	auto file_name = GetPartFileName(track, track->msn, track->part_index);
+	auto duration = track->part_duration * track->timebase_expr;
+
+	auto part = std::make_shared<SegmentItem>((track->media_type == cmn::MediaType::Video) ? SegmentDataType::Video : SegmentDataType::Audio,
+											  track->msn, file_name,
+											  track->part_start_dts, static_cast<int64_t>(track->part_start_dts * track->timebase_expr * 1000.0),
+											  track->part_duration, static_cast<int64_t>(duration * 1000.0),
+											  part_data);
+	AddFile(part);
+
+	// The segment consists of the parts
+	track->segment_data->Append(part_data.get());
+
+	track->part_lines.AppendFormat("#EXT-X-PART:DURATION=%.5f,URI=\"%s\"%s\r\n",
+								   duration, file_name.CStr(), track->is_part_independent ? ",INDEPENDENT=YES" : "");
+	track->part_file_names.push_back(file_name);
+
+	LlHlsPartInfo part_info;
+	part_info.play_list_file_name = track->play_list_file_name;
+	part_info.msn = track->msn;
+	part_info.part = track->part_index;
+	part_info.is_last_part = is_last_part;
+
+	track->part_samples.clear();
+	track->part_duration = 0LL;
+	track->is_part_independent = false;
+	track->part_index++;
+
+	if (is_last_part)
+	{
+		CompleteSegment(track);
+	}
+
+	UpdateMediaPlayList(track);
+
+	if (_chunked_transfer != nullptr)
+	{
+		part_info.target_duration = GetTargetDuration(track);
+
+		// Wake up the requests which are blocked until this part is added to the playlist
+		_chunked_transfer->OnLlHlsPartCompleted(_app_name, _stream_name, part_info);
+	}
+}
+
+void LlHlsPacketizer::CompleteSegment(const std::shared_ptr<Track> &track)
+{
+	auto file_name = ov::String::FormatString("%" PRId64 "_%s.%s", track->msn, track->name.CStr(), LLHLS_SEGMENT_EXT);
+	auto duration = track->segment_duration * track->timebase_expr;
+
+	auto segment_item = std::make_shared<SegmentItem>((track->media_type == cmn::MediaType::Video) ? SegmentDataType::Video : SegmentDataType::Audio,
+													  track->msn, file_name,
+													  track->segment_start_dts, static_cast<int64_t>(track->segment_start_dts * track->timebase_expr * 1000.0),
+													  track->segment_duration, static_cast<int64_t>(duration * 1000.0),
+													  track->segment_data);
+	AddFile(segment_item);
+
+	auto segment = std::make_shared<Segment>();
+	auto segment_lines = ov::String::FormatString("#EXTINF:%.5f,\r\n%s\r\n", duration, file_name.CStr());
+
+	segment->msn = track->msn;
+	segment->duration = duration;
+
+	// The first line of part_lines is EXT-X-PROGRAM-DATE-TIME
+	auto program_date_time_length = track->part_lines.IndexOf("\r\n") + 2;
+	segment->lines = track->part_lines.Substring(0, program_date_time_length) + segment_lines;
+	segment->lines_with_parts = track->part_lines + segment_lines;
+
+	segment->file_names = std::move(track->part_file_names);
+	segment->file_names.push_back(file_name);
+
+	track->segment_list.push_back(segment);
+	track->max_segment_duration = std::max(track->max_segment_duration, duration);
+
+	while (track->segment_list.size() > _segment_save_count)
+	{
+		RemoveFiles(track->segment_list.front()->file_names);
+		track->segment_list.pop_front();
+	}
+
+	logad("Segment #%" PRId64 " is completed for %s, duration: %.3fs, parts: %" PRId64 ", size: %zu",
+		  track->msn, track->name.CStr(), duration, track->part_index, track->segment_data->GetLength());
+
+	if ((track->media_type == cmn::MediaType::Video) && (_audio != nullptr))
+	{
+		// The pending sample is the first sample of the next segment
+		_video_segment_boundaries.push_back(track->pending_sample->dts * track->timebase_expr);
+
+		while (_video_segment_boundaries.size() > LLHLS_MAX_PENDING_BOUNDARY_COUNT)
+		{
+			_video_segment_boundaries.pop_front();
+		}
+	}
+
+	// Start a new segment
+	track->msn++;
+	track->part_index = 0LL;
+	track->segment_start_dts = -1LL;
+	track->segment_duration = 0LL;
+	track->segment_data = std::make_shared<ov::Data>();
+	track->part_lines.Clear();
+	track->part_file_names.clear();
+
+	if ((IsReadyForStreaming() == false) &&
+		((_video == nullptr) || (_video->segment_list.empty() == false)) &&
+		((_audio == nullptr) || (_audio->segment_list.empty() == false)))
+	{
+		UpdateMultivariantPlayList();
+		SetReadyForStreaming();
+
+		logai("LL-HLS is ready to stream, segment duration: %.0fs, part duration: %.3fs, count: %u", _segment_duration, _part_duration, _segment_count);
+	}
+}
+
+int LlHlsPacketizer::GetTargetDuration(const std::shared_ptr<Track> &track) const
+{
+	// The duration of a segment (rounded to the nearest integer) must be less than or equal to the target duration
+	return std::max(static_cast<int>(_segment_duration), static_cast<int>(std::lround(track->max_segment_duration)));
+}
+
+void LlHlsPacketizer::UpdateMediaPlayList(const std::shared_ptr<Track> &track)
+{
+	auto &segment_list = track->segment_list;
+	size_t count = std::min(segment_list.size(), static_cast<size_t>(_segment_count));
+	auto first_segment = segment_list.end() - count;
+	auto target_duration = GetTargetDuration(track);
+	double skip_until = static_cast<double>(target_duration * LLHLS_SKIP_UNTIL_TARGET_DURATION_COUNT);
+
+	// Segments older than CAN-SKIP-UNTIL from the end of the playlist are replaced with EXT-X-SKIP in the delta update
+	double listed_duration = 0.0;
+	size_t skipped_count = 0;
+
+	for (auto segment = first_segment; segment != segment_list.end(); ++segment)
+	{
+		listed_duration += (*segment)->duration;
+	}
+
+	for (auto segment = first_segment; segment != segment_list.end(); ++segment)
+	{
+		listed_duration -= (*segment)->duration;
+
+		if ((listed_duration < skip_until) || ((segment_list.end() - segment) <= LLHLS_PART_LISTED_SEGMENT_COUNT))
+		{
+			break;
+		}
+
+		skipped_count++;
+	}
+
+	const char *header_format =
+		"#EXTM3U\r\n"
+		"#EXT-X-VERSION:%d\r\n"
+		"#EXT-X-TARGETDURATION:%d\r\n"
+		"#EXT-X-PART-INF:PART-TARGET=%.3f\r\n"
+		"#EXT-X-SERVER-CONTROL:CAN-BLOCK-RELOAD=YES,CAN-SKIP-UNTIL=%.1f,PART-HOLD-BACK=%.3f\r\n"
+		"#EXT-X-MEDIA-SEQUENCE:%" PRId64 "\r\n"
+		"#EXT-X-MAP:URI=\"%s\"\r\n";
+	int64_t media_sequence = (count > 0) ? (*first_segment)->msn : track->msn;
+
+	ov::String play_list;
+	ov::String delta_play_list;
+
+	// EXT-X-SKIP requires the version 9
+	play_list.Format(header_format, 6, target_duration, _part_duration, skip_until, _part_duration * 3.0,
+					 media_sequence, track->init_file->file_name.CStr());
+	delta_play_list.Format(header_format, 9, target_duration, _part_duration, skip_until, _part_duration * 3.0,
+						   media_sequence, track->init_file->file_name.CStr());
+	delta_play_list.AppendFormat("#EXT-X-SKIP:SKIPPED-SEGMENTS=%zu\r\n", skipped_count);
+
+	ov::String lines;
+
+	for (auto segment = first_segment; segment != segment_list.end(); ++segment)
+	{
+		bool list_parts = (segment_list.end() - segment) <= LLHLS_PART_LISTED_SEGMENT_COUNT;
+		auto &segment_lines = list_parts ? (*segment)->lines_with_parts : (*segment)->lines;
+
+		play_list.Append(segment_lines);
+
+		if (static_cast<size_t>(segment - first_segment) >= skipped_count)
+		{
+			lines.Append(segment_lines);
+		}
+	}
+
+	if (track->part_index > 0)
+	{
+		// Parts of the segment which is being created
+		lines.Append(track->part_lines);
+	}
+
+	lines.AppendFormat("#EXT-X-PRELOAD-HINT:TYPE=PART,URI=\"%s\"\r\n", GetPartFileName(track, track->msn, track->part_index).CStr());
+
+	play_list.Append(lines);
+	delta_play_list.Append(lines);
+
+	// The media playlists are updated for every part
+	auto play_list_response = http::svr::CachedResponse::Create(HLS_PLAYLIST_CONTENT_TYPE, "max-age=1", play_list.ToData(false));
+
+	std::atomic_store(&track->play_list, play_list_response);
+	// If nothing can be skipped yet, the delta update is the same as the full playlist
+	std::atomic_store(&track->delta_play_list, (skipped_count > 0) ? http::svr::CachedResponse::Create(HLS_PLAYLIST_CONTENT_TYPE, "max-age=1", delta_play_list.ToData(false)) : play_list_response);
+}
+
+void LlHlsPacketizer::UpdateMultivariantPlayList()
+{
+	ov::String play_list;
+	ov::String codecs;
+	int64_t bandwidth = 0LL;
+
+	play_list.Append(
+		"#EXTM3U\r\n"
+		"#EXT-X-VERSION:6\r\n"
+		"#EXT-X-INDEPENDENT-SEGMENTS\r\n");
+
+	if (_video != nullptr)
+	{
+		codecs = GetCodecString(_video_track);
+		bandwidth += _video_track->GetBitrate();
+	}
+
+	if (_audio != nullptr)
+	{
+		codecs.AppendFormat("%s%s", codecs.IsEmpty() ? "" : ",", GetCodecString(_audio_track).CStr());
+		bandwidth += _audio_track->GetBitrate();
+	}
+
+	if ((_video != nullptr) && (_audio != nullptr))
+	{
+		// The audio is provided as an alternative rendition of the video
+		play_list.AppendFormat(
+			"#EXT-X-MEDIA:TYPE=AUDIO,GROUP-ID=\"audio\",NAME=\"audio\",DEFAULT=YES,AUTOSELECT=YES,URI=\"%s\"\r\n",
+			_audio->play_list_file_name.CStr());
+	}
+
+	play_list.AppendFormat("#EXT-X-STREAM-INF:BANDWIDTH=%" PRId64 ",CODECS=\"%s\"", bandwidth, codecs.CStr());
+
+	if (_video != nullptr)
+	{
+		play_list.AppendFormat(",RESOLUTION=%dx%d", _video_track->GetWidth(), _video_track->GetHeight());
+
+		if (_audio != nullptr)
+		{
+			play_list.Append(",AUDIO=\"audio\"");
+		}
+	}
+
+	play_list.AppendFormat("\r\n%s\r\n", ((_video != nullptr) ? _video : _audio)->play_list_file_name.CStr());
+
+	SetPlayList(play_list, HLS_PLAYLIST_CONTENT_TYPE, "max-age=2");
+}
+
+bool LlHlsPacketizer::GetMediaPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list) const
+{
+	if (IsReadyForStreaming() == false)
+	{
+		logtd("Media playlist was requested before the stream began");
+		return false;
+	}
+
+	for (auto &track : {_video, _audio})
+	{
+		if (track == nullptr)
+		{
+			continue;
+		}
+
+		if (track->play_list_file_name == file_name)
+		{
+			play_list = std::atomic_load(&track->play_list);
+			return (play_list != nullptr);
+		}
+
+		if (GetDeltaPlayListFileName(track->play_list_file_name) == file_name)
+		{
+			play_list = std::atomic_load(&track->delta_play_list);
+			return (play_list != nullptr);
+		}
+	}
+
+	return false;
+}
+
+void LlHlsPacketizer::AddFile(const std::shared_ptr<SegmentItem> &file)
+{
+	std::lock_guard<std::mutex> lock(_file_map_mutex);
+
+	_file_map[file->file_name] = file;
+}
+
+void LlHlsPacketizer::RemoveFiles(const std::vector<ov::String> &file_names)
+{
+	std::lock_guard<std::mutex> lock(_file_map_mutex);
+
+	for (const auto &file_name : file_names)
+	{
+		_file_map.erase(file_name);
+	}
+}
+
+std::shared_ptr<const SegmentItem> LlHlsPacketizer::GetSegmentData(const ov::String &file_name) const
+{
+	std::lock_guard<std::mutex> lock(_file_map_mutex);
+
+	auto item = _file_map.find(file_name);
+
+	return (item != _file_map.end()) ? item->second : nullptr;
+}
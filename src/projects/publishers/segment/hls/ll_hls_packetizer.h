@@ -0,0 +1,188 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <publishers/segment/segment_stream/packetizer/m4s_init_writer.h>
+#include <publishers/segment/segment_stream/packetizer/m4s_segment_writer.h>
+
+#include <deque>
+#include <unordered_map>
+
+#include "../segment_stream/packetizer/packetizer.h"
+
+// Low-Latency HLS packetizer
+//
+// Each partial segment (part) is a fragment (moof + mdat) created by M4sSegmentWriter,
+// and the segment is the concatenation of its parts, so the data of a part is written only once.
+//
+// Video and audio are provided as separate renditions (media playlists) and their segments are aligned
+// by the media sequence number (an audio segment is cut when the video segment is cut).
+//
+// The media playlist is not rebuilt from the segment list - the lines of the segments and the parts are
+// formatted once when they are completed, and the playlist is assembled from them.
+class LlHlsPacketizer : public Packetizer
+{
+public:
+	LlHlsPacketizer(const ov::String &app_name, const ov::String &stream_name,
+					uint32_t segment_count, uint32_t segment_duration, double part_duration,
+					const std::shared_ptr<MediaTrack> &video_track, const std::shared_ptr<MediaTrack> &audio_track,
+					const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer);
+
+	const char *GetPacketizerName() const override
+	{
+		return "LLHLS";
+	}
+
+	static bool IsMediaPlayListFileName(const ov::String &file_name);
+
+	// Returns the internal name of the delta update (_HLS_skip=YES) of the media playlist
+	static ov::String GetDeltaPlayListFileName(const ov::String &play_list_file_name);
+
+	// Parses the name of the part (<msn>_<part>_video_llhls.m4s), and returns the media playlist which contains the part
+	static bool ParsePartFileName(const ov::String &file_name, int64_t &msn, int64_t &part, ov::String &play_list_file_name);
+
+	// Parses the non-negative decimal number (such as the value of _HLS_msn, _HLS_part)
+	static bool ParseSequenceNumber(const ov::String &value, int64_t &number);
+
+	//--------------------------------------------------------------------
+	// Override Packetizer
+	//--------------------------------------------------------------------
+	bool AppendVideoFrame(const std::shared_ptr<const MediaPacket> &media_packet) override
+	{
+		return false;
+	}
+
+	bool AppendAudioFrame(const std::shared_ptr<const MediaPacket> &media_packet) override
+	{
+		return false;
+	}
+
+	bool AppendVideoFrame(const std::shared_ptr<const PacketizerFrameData> &frame) override;
+	bool AppendAudioFrame(const std::shared_ptr<const PacketizerFrameData> &frame) override;
+
+	std::shared_ptr<const SegmentItem> GetSegmentData(const ov::String &file_name) const override;
+
+	// The multivariant playlist is provided by GetPlayList()
+	bool GetMediaPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list) const;
+
+protected:
+	// A completed segment
+	struct Segment
+	{
+		int64_t msn = 0LL;
+		// Unit: second
+		double duration = 0.0;
+
+		// EXT-X-PROGRAM-DATE-TIME, EXTINF and URI of the segment
+		ov::String lines;
+		// EXT-X-PROGRAM-DATE-TIME, EXT-X-PART of the parts, EXTINF and URI of the segment (Used while the parts are listed)
+		ov::String lines_with_parts;
+
+		// The segment and its parts
+		std::vector<ov::String> file_names;
+	};
+
+	struct Track
+	{
+		cmn::MediaType media_type = cmn::MediaType::Unknown;
+		M4sMediaType m4s_media_type = M4sMediaType::Data;
+		uint32_t track_id = 0U;
+		std::shared_ptr<MediaTrack> media_track;
+
+		// video_llhls, audio_llhls
+		ov::String name;
+		ov::String play_list_file_name;
+
+		// To convert from timebase to seconds, multiply by this value
+		double timebase_expr = 0.0;
+
+		// Unit: Timebase of the track
+		int64_t ideal_segment_duration = 0LL;
+		int64_t part_target_duration = 0LL;
+
+		std::shared_ptr<SegmentItem> init_file;
+
+		// The duration of a sample is known when the next sample is received
+		std::shared_ptr<SampleData> pending_sample;
+		bool is_pending_key_frame = false;
+		// Unit: Timebase of the track
+		int64_t last_sample_duration = 0LL;
+
+		// The part which is being created
+		std::vector<std::shared_ptr<const SampleData>> part_samples;
+		bool is_part_independent = false;
+		// Unit: Timebase of the track
+		int64_t part_start_dts = 0LL;
+		int64_t part_duration = 0LL;
+
+		// The segment which is being created
+		int64_t msn = 0LL;
+		// Index of the next part in the segment
+		int64_t part_index = 0LL;
+		// Unit: Timebase of the track
+		int64_t segment_start_dts = -1LL;
+		int64_t segment_duration = 0LL;
+		std::shared_ptr<ov::Data> segment_data;
+		// EXT-X-PROGRAM-DATE-TIME and EXT-X-PART of the completed parts in the segment
+		ov::String part_lines;
+		std::vector<ov::String> part_file_names;
+
+		// mfhd sequence number of the next fragment
+		uint32_t fragment_sequence_number = 1U;
+
+		// Completed segments (front: the oldest one)
+		std::deque<std::shared_ptr<const Segment>> segment_list;
+		// Unit: second
+		double max_segment_duration = 0.0;
+
+		// The response of the latest media playlist (Replaced atomically, so the requests can read it without locking)
+		std::shared_ptr<const http::svr::CachedResponse> play_list;
+		// The response of the latest delta update of the media playlist (EXT-X-SKIP)
+		std::shared_ptr<const http::svr::CachedResponse> delta_play_list;
+	};
+
+	std::shared_ptr<Track> CreateTrack(cmn::MediaType media_type, const std::shared_ptr<MediaTrack> &media_track);
+
+	bool WriteVideoInitIfNeeded(const std::shared_ptr<const PacketizerFrameData> &frame);
+	bool WriteAudioInitIfNeeded();
+
+	// Appends the sample, and completes the part (or the segment) before the sample if needed
+	bool AppendSample(const std::shared_ptr<Track> &track, const std::shared_ptr<SampleData> &sample, bool is_key_frame);
+	bool IsSegmentBoundary(const std::shared_ptr<Track> &track, const std::shared_ptr<const SampleData> &sample, bool is_key_frame);
+
+	void CompletePart(const std::shared_ptr<Track> &track, bool is_last_part);
+	void CompleteSegment(const std::shared_ptr<Track> &track);
+
+	void UpdateMediaPlayList(const std::shared_ptr<Track> &track);
+	void UpdateMultivariantPlayList();
+
+	int GetTargetDuration(const std::shared_ptr<Track> &track) const;
+
+	ov::String GetPartFileName(const std::shared_ptr<Track> &track, int64_t msn, int64_t part) const;
+
+	void AddFile(const std::shared_ptr<SegmentItem> &file);
+	void RemoveFiles(const std::vector<ov::String> &file_names);
+
+	// Unit: second
+	double _part_duration = 0.0;
+
+	std::shared_ptr<Track> _video;
+	std::shared_ptr<Track> _audio;
+
+	// Serializes AppendVideoFrame() and AppendAudioFrame()
+	std::mutex _append_mutex;
+
+	// The start times of the video segments which are not applied to the audio yet (Unit: second)
+	std::deque<double> _video_segment_boundaries;
+
+	// Init, segments and parts
+	// Key: file name
+	std::unordered_map<ov::String, std::shared_ptr<const SegmentItem>> _file_map;
+	mutable std::mutex _file_map_mutex;
+};
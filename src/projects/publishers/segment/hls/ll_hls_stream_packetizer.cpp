@@ -0,0 +1,53 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "ll_hls_stream_packetizer.h"
+
+#include "hls_private.h"
+
+LlHlsStreamPacketizer::LlHlsStreamPacketizer(const ov::String &app_name, const ov::String &stream_name,
+											 int segment_count, int segment_duration, double part_duration,
+											 std::shared_ptr<MediaTrack> video_track, std::shared_ptr<MediaTrack> audio_track,
+											 const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer)
+	: StreamPacketizer(app_name, stream_name,
+					   segment_count, segment_duration,
+					   "", "",
+					   video_track, audio_track,
+					   chunked_transfer)
+{
+	_ll_hls_packetizer = std::make_shared<LlHlsPacketizer>(app_name, stream_name,
+														   segment_count, segment_duration, part_duration,
+														   video_track, audio_track,
+														   chunked_transfer);
+	_packetizer = _ll_hls_packetizer;
+}
+
+bool LlHlsStreamPacketizer::AppendVideoFrame(const std::shared_ptr<const PacketizerFrameData> &frame)
+{
+	return _ll_hls_packetizer->AppendVideoFrame(frame);
+}
+
+bool LlHlsStreamPacketizer::AppendAudioFrame(const std::shared_ptr<const PacketizerFrameData> &frame)
+{
+	return _ll_hls_packetizer->AppendAudioFrame(frame);
+}
+
+bool LlHlsStreamPacketizer::GetPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list)
+{
+	if (file_name == HLS_PLAYLIST_FILE_NAME)
+	{
+		return _ll_hls_packetizer->GetPlayList(play_list);
+	}
+
+	return _ll_hls_packetizer->GetMediaPlayList(file_name, play_list);
+}
+
+std::shared_ptr<const SegmentItem> LlHlsStreamPacketizer::GetSegmentData(const ov::String &file_name) const
+{
+	return _ll_hls_packetizer->GetSegmentData(file_name);
+}
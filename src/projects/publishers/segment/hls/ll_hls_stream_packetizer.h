@@ -0,0 +1,62 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <publishers/segment/segment_stream/segment_stream.h>
+#include <publishers/segment/segment_stream/stream_packetizer.h>
+
+#include "ll_hls_packetizer.h"
+
+class LlHlsStreamPacketizer : public StreamPacketizer
+{
+public:
+	LlHlsStreamPacketizer(const ov::String &app_name, const ov::String &stream_name,
+						  int segment_count, int segment_duration, double part_duration,
+						  std::shared_ptr<MediaTrack> video_track, std::shared_ptr<MediaTrack> audio_track,
+						  const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer);
+
+public:
+	bool AppendVideoFrame(const std::shared_ptr<const PacketizerFrameData> &frame) override;
+	bool AppendAudioFrame(const std::shared_ptr<const PacketizerFrameData> &frame) override;
+
+	// playlist.m3u8: Multivariant playlist
+	// video_llhls.m3u8, audio_llhls.m3u8: Media playlist
+	bool GetPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list) override;
+	std::shared_ptr<const SegmentItem> GetSegmentData(const ov::String &file_name) const override;
+
+protected:
+	std::shared_ptr<LlHlsPacketizer> _ll_hls_packetizer;
+};
+
+// PacketizerFactory<> cannot be used, because the part duration is needed to create the packetizer
+class LlHlsPacketizerFactory : public PacketizerFactoryInterface
+{
+public:
+	LlHlsPacketizerFactory(double part_duration)
+		: _part_duration(part_duration)
+	{
+	}
+
+	std::shared_ptr<StreamPacketizer> Create(
+		const ov::String &app_name, const ov::String &stream_name,
+		uint32_t segment_count, uint32_t segment_duration,
+		const ov::String &utc_timing_scheme, const ov::String &utc_timing_value,
+		const std::shared_ptr<MediaTrack> &video_track, const std::shared_ptr<MediaTrack> &audio_track,
+		const std::shared_ptr<ChunkedTransferInterface> &chunked_transfer) override
+	{
+		return std::make_shared<LlHlsStreamPacketizer>(
+			app_name, stream_name,
+			segment_count, segment_duration, _part_duration,
+			video_track, audio_track,
+			chunked_transfer);
+	}
+
+protected:
+	double _part_duration;
+};
@@ -25,7 +25,7 @@ SegmentPublisher::~SegmentPublisher()
 	logtd("Publisher has been destroyed");
 }
 
-bool SegmentPublisher::Start(const cfg::cmn::SingularPort &port_config, const cfg::cmn::SingularPort &tls_port_config, const std::shared_ptr<SegmentStreamServer> &stream_server, int worker_count)
+bool SegmentPublisher::Start(const cfg::cmn::SingularPort &port_config, const cfg::cmn::SingularPort &tls_port_config, const std::shared_ptr<SegmentStreamServer> &stream_server, int worker_count, bool reuse_port, int keep_alive_timeout, bool kernel_tls)
 {
 	auto server_config = GetServerConfig();
 	auto ip = server_config.GetIp();
@@ -46,7 +46,7 @@ bool SegmentPublisher::Start(const cfg::cmn::SingularPort &port_config, const cf
 	//stream_server->SetCrossDomain(cross_domains);
 
 	if (stream_server->Start(has_port ? &address : nullptr, has_tls_port ? &tls_address : nullptr,
-							 DEFAULT_SEGMENT_WORKER_THREAD_COUNT, worker_count) == false)
+							 DEFAULT_SEGMENT_WORKER_THREAD_COUNT, worker_count, reuse_port, keep_alive_timeout, kernel_tls) == false)
 	{
 		logte("An error occurred while start %s Publisher", GetPublisherName());
 		return false;
@@ -79,7 +79,7 @@ bool SegmentPublisher::Stop()
 
 bool SegmentPublisher::OnPlayListRequest(const std::shared_ptr<http::svr::HttpConnection> &client,
 										 const SegmentStreamRequestInfo &request_info,
-										 ov::String &play_list)
+										 std::shared_ptr<const http::svr::CachedResponse> &play_list)
 {
 	auto request = client->GetRequest();
 	auto uri = request->GetUri();
@@ -138,7 +138,7 @@ bool SegmentPublisher::OnPlayListRequest(const std::shared_ptr<http::svr::HttpCo
 
 	request->SetExtra(std::static_pointer_cast<pub::Stream>(stream));
 
-	if (stream->GetPlayList(play_list) == false)
+	if (stream->GetPlayList(request_info.file_name, play_list) == false)
 	{
 		logtw("Could not get a playlist for %s [%p, %s/%s, %s]", GetPublisherName(), stream.get(), vhost_app_name.CStr(), stream_name.CStr(), request_info.file_name.CStr());
 		client->GetResponse()->SetStatusCode(http::StatusCode::Accepted);
@@ -220,7 +220,7 @@ protected:
 	SegmentPublisher(const cfg::Server &server_config, const std::shared_ptr<MediaRouteInterface> &router);
 	~SegmentPublisher() override;
 
-	bool Start(const cfg::cmn::SingularPort &port_config, const cfg::cmn::SingularPort &tls_port_config, const std::shared_ptr<SegmentStreamServer> &stream_server, int worker_count);
+	bool Start(const cfg::cmn::SingularPort &port_config, const cfg::cmn::SingularPort &tls_port_config, const std::shared_ptr<SegmentStreamServer> &stream_server, int worker_count, bool reuse_port = false, int keep_alive_timeout = HTTP_SERVER_DEFAULT_KEEP_ALIVE_TIMEOUT, bool kernel_tls = false);
 	virtual bool Start() = 0;
 
 	bool HandleSignedX(const info::VHostAppName &vhost_app_name, const ov::String &stream_name, 
@@ -232,7 +232,7 @@ protected:
 	//--------------------------------------------------------------------
 	bool OnPlayListRequest(const std::shared_ptr<http::svr::HttpConnection> &client,
 						   const SegmentStreamRequestInfo &request_info,
-						   ov::String &play_list) override;
+						   std::shared_ptr<const http::svr::CachedResponse> &play_list) override;
 
 	bool OnSegmentRequest(const std::shared_ptr<http::svr::HttpConnection> &client,
 						  const SegmentStreamRequestInfo &request_info,
@@ -10,6 +10,23 @@
 
 #include <base/ovlibrary/ovlibrary.h>
 
+// A partial segment of LL-HLS which is added to the media playlist
+struct LlHlsPartInfo
+{
+	// The media playlist which contains the part
+	ov::String play_list_file_name;
+
+	// Media sequence number of the segment which contains the part
+	int64_t msn = 0LL;
+	// Index of the part in the segment
+	int64_t part = 0LL;
+	// Whether the part is the last one of the segment (The segment of msn is completed)
+	bool is_last_part = false;
+
+	// EXT-X-TARGETDURATION of the media playlist (Unit: second)
+	int target_duration = 0;
+};
+
 class ChunkedTransferInterface
 {
 public:
@@ -26,4 +43,10 @@ public:
 	virtual void OnCmafChunkedComplete(const ov::String &app_name, const ov::String &stream_name,
 									   const ov::String &file_name,
 									   bool is_video) = 0;
+
+	// This callback will be called when a partial segment of LL-HLS is completed and the media playlist is updated
+	virtual void OnLlHlsPartCompleted(const ov::String &app_name, const ov::String &stream_name,
+									  const LlHlsPartInfo &part_info)
+	{
+	}
 };
\ No newline at end of file
@@ -48,11 +48,9 @@ uint64_t Packetizer::ConvertTimeScale(uint64_t time, const cmn::Timebase &from_t
 	return (uint64_t)((double)time * ratio);
 }
 
-void Packetizer::SetPlayList(const ov::String &play_list)
+void Packetizer::SetPlayList(const ov::String &play_list, const char *content_type, const char *cache_control)
 {
-	std::unique_lock<std::mutex> lock(_play_list_mutex);
-
-	_play_list = play_list;
+	std::atomic_store(&_play_list, http::svr::CachedResponse::Create(content_type, cache_control, play_list.ToData(false)));
 }
 
 bool Packetizer::IsReadyForStreaming() const noexcept
@@ -172,7 +170,7 @@ ov::String Packetizer::GetCodecString(const std::shared_ptr<const MediaTrack> &t
 	return codec_string;
 }
 
-bool Packetizer::GetPlayList(ov::String &play_list)
+bool Packetizer::GetPlayList(std::shared_ptr<const http::svr::CachedResponse> &play_list)
 {
 	if (IsReadyForStreaming() == false)
 	{
@@ -180,10 +178,9 @@ bool Packetizer::GetPlayList(ov::String &play_list)
 		return false;
 	}
 
-	std::unique_lock<std::mutex> lock(_play_list_mutex);
-	play_list = _play_list;
+	play_list = std::atomic_load(&_play_list);
 
-	return true;
+	return (play_list != nullptr);
 }
 
 bool Packetizer::GetVideoPlaySegments(std::vector<std::shared_ptr<SegmentItem>> &segment_datas)
@@ -50,10 +50,10 @@ public:
 	//   +--------+---------+--------+-----------+
 	static uint64_t ConvertTimeScale(uint64_t time, const cmn::Timebase &from_timebase, const cmn::Timebase &to_timebase);
 
-	void SetPlayList(const ov::String &play_list);
+	void SetPlayList(const ov::String &play_list, const char *content_type, const char *cache_control);
 
 	virtual bool IsReadyForStreaming() const noexcept;
-	virtual bool GetPlayList(ov::String &play_list);
+	virtual bool GetPlayList(std::shared_ptr<const http::svr::CachedResponse> &play_list);
 
 	bool GetVideoPlaySegments(std::vector<std::shared_ptr<SegmentItem>> &segment_datas);
 	bool GetAudioPlaySegments(std::vector<std::shared_ptr<SegmentItem>> &segment_datas);
@@ -84,12 +84,12 @@ protected:
 	uint32_t _current_video_index = 0U;
 	uint32_t _current_audio_index = 0U;
 
-	ov::String _play_list;
+	// The response of the latest playlist (Replaced atomically by SetPlayList(), so the requests can read it without locking)
+	std::shared_ptr<const http::svr::CachedResponse> _play_list;
 	std::vector<std::shared_ptr<SegmentItem>> _video_segments;
 	// HLS packetizer doesn't use _audio_segments
 	std::vector<std::shared_ptr<SegmentItem>> _audio_segments;
 
-	mutable std::mutex _play_list_mutex;
 	mutable std::mutex _video_segment_mutex;
 	mutable std::mutex _audio_segment_mutex;
 };
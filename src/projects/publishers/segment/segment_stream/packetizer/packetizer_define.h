@@ -10,6 +10,7 @@
 
 #include <base/mediarouter/media_type.h>
 #include <base/ovlibrary/ovlibrary.h>
+#include <modules/http/server/http_cached_response.h>
 #include <string.h>
 
 #include <deque>
@@ -63,8 +64,29 @@ public:
 		  timestamp_in_ms(timestamp_in_ms),
 		  duration(duration),
 		  duration_in_ms(duration_in_ms),
-		  data(data)
+		  data(data),
+		  response(http::svr::CachedResponse::Create(GetContentType(type), "max-age=300", data))
+	{
+	}
+
+	static const char *GetContentType(SegmentDataType type)
 	{
+		switch (type)
+		{
+			case SegmentDataType::Both:
+				// MPEG-TS (HLS)
+				return "video/MP2T";
+
+			case SegmentDataType::Audio:
+				return "audio/mp4";
+
+			case SegmentDataType::None:
+				[[fallthrough]];
+			case SegmentDataType::Video:
+				break;
+		}
+
+		return "video/mp4";
 	}
 
 public:
@@ -78,6 +100,9 @@ public:
 	int64_t duration = 0L;
 	int64_t duration_in_ms = 0L;
 	std::shared_ptr<const ov::Data> data;
+
+	// The response of the segment (created once with the data, and shared by all the requests)
+	std::shared_ptr<const http::svr::CachedResponse> response;
 };
 
 enum class PacketizerFrameType
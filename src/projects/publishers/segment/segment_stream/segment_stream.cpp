@@ -120,11 +120,11 @@ void SegmentStream::SendAudioFrame(const std::shared_ptr<MediaPacket> &media_pac
 	}
 }
 
-bool SegmentStream::GetPlayList(ov::String &play_list)
+bool SegmentStream::GetPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list)
 {
 	if (_stream_packetizer != nullptr)
 	{
-		return _stream_packetizer->GetPlayList(play_list);
+		return _stream_packetizer->GetPlayList(file_name, play_list);
 	}
 
 	return false;
@@ -95,7 +95,7 @@ public:
 	bool Start() override;
 	bool Stop() override;
 
-	bool GetPlayList(ov::String &play_list);
+	bool GetPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list);
 
 	std::shared_ptr<const SegmentItem> GetSegmentData(const ov::String &file_name) const;
 
@@ -64,6 +64,15 @@ http::svr::InterceptorResult SegmentStreamInterceptor::OnHttpData(const std::sha
 	return http::svr::InterceptorResult::Keep;
 }
 
+bool SegmentStreamInterceptor::AddWork(const std::shared_ptr<http::svr::HttpConnection> &client)
+{
+	auto request = client->GetRequest();
+
+	client->GetResponse()->SetStatusCode(http::StatusCode::OK);
+
+	return _worker_manager.AddWork(client, request->GetRequestTarget(), request->GetHeader("Origin"));
+}
+
 bool SegmentStreamInterceptor::IsInterceptorForRequest(const std::shared_ptr<const http::svr::HttpConnection> &client)
 {
 	auto request = client->GetRequest();
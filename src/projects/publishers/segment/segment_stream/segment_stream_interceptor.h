@@ -27,6 +27,9 @@ public:
 
 	bool IsInterceptorForRequest(const std::shared_ptr<const http::svr::HttpConnection> &client) override;
 
+	// Processes the request of the client again by the worker (ex: A parked request is woken up)
+	bool AddWork(const std::shared_ptr<http::svr::HttpConnection> &client);
+
 protected:
 	SegmentWorkerManager _worker_manager;
 };
@@ -35,7 +35,10 @@ std::shared_ptr<SegmentStreamInterceptor> SegmentStreamServer::CreateInterceptor
 bool SegmentStreamServer::Start(const ov::SocketAddress *address,
 								const ov::SocketAddress *tls_address,
 								int thread_count,
-								int worker_count)
+								int worker_count,
+								bool reuse_port,
+								int keep_alive_timeout,
+								bool kernel_tls)
 {
 	if ((_http_server != nullptr) || (_https_server != nullptr))
 	{
@@ -50,16 +53,28 @@ bool SegmentStreamServer::Start(const ov::SocketAddress *address,
 
 	auto manager = http::svr::HttpServerManager::GetInstance();
 
-	std::shared_ptr<http::svr::HttpServer> http_server = (address != nullptr) ? manager->CreateHttpServer("SegPub", *address, worker_count) : nullptr;
+	std::shared_ptr<http::svr::HttpServer> http_server = (address != nullptr) ? manager->CreateHttpServer("SegPub", *address, worker_count, reuse_port) : nullptr;
 	result = result && ((address != nullptr) ? (http_server != nullptr) : true);
 
-	std::shared_ptr<http::svr::HttpsServer> https_server = (tls_address != nullptr) ? manager->CreateHttpsServer("SegPub", *tls_address, vhost_list, worker_count) : nullptr;
+	std::shared_ptr<http::svr::HttpsServer> https_server = (tls_address != nullptr) ? manager->CreateHttpsServer("SegPub", *tls_address, vhost_list, worker_count, reuse_port) : nullptr;
 	result = result && ((tls_address != nullptr) ? (https_server != nullptr) : true);
 
 	result = result && PrepareInterceptors(http_server, https_server, thread_count, process_handler);
 
 	if (result)
 	{
+		// The servers may be shared with other publishers which use the same port
+		if (http_server != nullptr)
+		{
+			http_server->SetKeepAliveTimeout(keep_alive_timeout);
+		}
+
+		if (https_server != nullptr)
+		{
+			https_server->SetKeepAliveTimeout(keep_alive_timeout);
+			https_server->SetKernelTls(kernel_tls);
+		}
+
 		_http_server = http_server;
 		_https_server = https_server;
 	}
@@ -229,6 +244,9 @@ bool SegmentStreamServer::ProcessRequest(const std::shared_ptr<http::svr::HttpCo
 	auto request = client->GetRequest();
 	http::svr::ConnectionPolicy connetion = http::svr::ConnectionPolicy::Closed;
 
+	// Players request the playlist and the segments repeatedly, so reuse the connection if possible
+	bool keep_alive = client->IsKeepAliveAvailable();
+
 	do
 	{
 		ov::String app_name;
@@ -239,12 +257,15 @@ bool SegmentStreamServer::ProcessRequest(const std::shared_ptr<http::svr::HttpCo
 		// Set default headers
 		response->SetHeader("Server", "OvenMediaEngine");
 		response->SetHeader("Content-Type", "text/html");
+		response->SetHeader("Connection", keep_alive ? "keep-alive" : "close");
 
 		// Check crossdomains
 		if (request_target.IndexOf("crossdomain.xml") >= 0)
 		{
 			response->SetHeader("Content-Type", "text/x-cross-domain-policy");
 			response->AppendString(_cross_domain_xml);
+			response->Response();
+			connetion = http::svr::ConnectionPolicy::KeepAlive;
 			break;
 		}
 
@@ -253,6 +274,8 @@ bool SegmentStreamServer::ProcessRequest(const std::shared_ptr<http::svr::HttpCo
 		{
 			logtd("Failed to parse URL: %s", request_target.CStr());
 			response->SetStatusCode(http::StatusCode::NotFound);
+			response->Response();
+			connetion = http::svr::ConnectionPolicy::KeepAlive;
 			break;
 		}
 
@@ -277,6 +300,22 @@ bool SegmentStreamServer::ProcessRequest(const std::shared_ptr<http::svr::HttpCo
 			return response->Close();
 
 		case http::svr::ConnectionPolicy::KeepAlive:
+			if (response->IsChunkedTransfer())
+			{
+				// The response is still being sent (ex: CMAF chunked transfer)
+				return true;
+			}
+
+			if (keep_alive)
+			{
+				// The response is completed - wait for the next request
+				return client->PrepareNextRequest();
+			}
+
+			return response->Close();
+
+		case http::svr::ConnectionPolicy::Deferred:
+			// The request is parked, and it will be processed again later
 			return true;
 
 		default:
@@ -286,6 +325,17 @@ bool SegmentStreamServer::ProcessRequest(const std::shared_ptr<http::svr::HttpCo
 	}
 }
 
+uint32_t SegmentStreamServer::SendCachedResponse(const std::shared_ptr<http::svr::HttpConnection> &client, const std::shared_ptr<const http::svr::CachedResponse> &cached_response)
+{
+	auto request = client->GetRequest();
+	auto response = client->GetResponse();
+
+	auto if_none_match = request->GetHeader("IF-NONE-MATCH");
+	bool not_modified = (if_none_match.IsEmpty() == false) && cached_response->IsMatch(if_none_match);
+
+	return response->Response(cached_response, not_modified);
+}
+
 bool SegmentStreamServer::SetAllowOrigin(const ov::String &origin_url, const std::shared_ptr<http::svr::HttpResponse> &response)
 {
 	if (_cors_urls.empty())
@@ -10,12 +10,15 @@
 
 #include <base/publisher/publisher.h>
 #include <config/config_manager.h>
+#include <modules/http/server/http_cached_response.h>
 #include <modules/http/server/http_server.h>
 #include <modules/http/server/https_server.h>
 #include <modules/http/server/interceptors/http_request_interceptors.h>
 #include <monitoring/monitoring.h>
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "segment_stream_interceptor.h"
 #include "segment_stream_observer.h"
@@ -29,12 +32,18 @@ public:
 
 	// thread_count: A thread count of SegmentWorkerManager
 	// worker_count: A thread count of socket pool
+	// reuse_port: Bind a SO_REUSEPORT socket for each worker of socket pool
+	// keep_alive_timeout: Idle timeout of the persistent connections (0 = close the connection after each response)
+	// kernel_tls: Encrypt the HTTPS responses in the kernel (kTLS) if available
 	bool Start(
 		const ov::SocketAddress *address,
 		const ov::SocketAddress *tls_address,
 		int thread_count,
-		int worker_count);
-	bool Stop();
+		int worker_count,
+		bool reuse_port = false,
+		int keep_alive_timeout = HTTP_SERVER_DEFAULT_KEEP_ALIVE_TIMEOUT,
+		bool kernel_tls = false);
+	virtual bool Stop();
 
 	bool AddObserver(const std::shared_ptr<SegmentStreamObserver> &observer);
 	bool RemoveObserver(const std::shared_ptr<SegmentStreamObserver> &observer);
@@ -64,6 +73,12 @@ protected:
 
 	bool SetAllowOrigin(const ov::String &origin_url, const std::shared_ptr<http::svr::HttpResponse> &response);
 
+	// Sends the pre-serialized response, or "304 Not Modified" if If-None-Match of the request matches the ETag.
+	// The response is created by the packetizer when a segment (or a playlist) is published, and is shared by all the requests.
+	//
+	// @return The number of bytes sent
+	uint32_t SendCachedResponse(const std::shared_ptr<http::svr::HttpConnection> &client, const std::shared_ptr<const http::svr::CachedResponse> &cached_response);
+
 	// Interfaces
 	virtual http::svr::ConnectionPolicy ProcessStreamRequest(const std::shared_ptr<http::svr::HttpConnection> &client,
 															 const SegmentStreamRequestInfo &request_info,
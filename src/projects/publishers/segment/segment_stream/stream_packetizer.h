@@ -50,7 +50,8 @@ public:
 	virtual bool AppendVideoFrame(const std::shared_ptr<const PacketizerFrameData> &dEncodedFrameata) = 0;
 	virtual bool AppendAudioFrame(const std::shared_ptr<const PacketizerFrameData> &data) = 0;
 
-	virtual bool GetPlayList(ov::String &play_list) = 0;
+	// file_name: The name of the requested playlist (Some protocols provide multiple playlists for a stream, such as LL-HLS)
+	virtual bool GetPlayList(const ov::String &file_name, std::shared_ptr<const http::svr::CachedResponse> &play_list) = 0;
 	virtual std::shared_ptr<const SegmentItem> GetSegmentData(const ov::String &file_name) const = 0;
 
 protected:
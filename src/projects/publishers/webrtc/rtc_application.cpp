@@ -68,6 +68,30 @@ bool RtcApplication::DeleteStream(const std::shared_ptr<info::Stream> &info)
 	return true;
 }
 
+std::vector<std::shared_ptr<RtcStream>> RtcApplication::GetRenditionStreams(const std::shared_ptr<RtcStream> &stream)
+{
+	std::vector<std::shared_ptr<RtcStream>> renditions;
+
+	auto origin_stream_uuid = stream->GetOriginStreamUUID();
+	if(origin_stream_uuid.IsEmpty())
+	{
+		return renditions;
+	}
+
+	std::shared_lock<std::shared_mutex> lock(_stream_map_mutex);
+	for(const auto &item : _streams)
+	{
+		auto rendition = std::static_pointer_cast<RtcStream>(item.second);
+
+		if((rendition->GetState() == pub::Stream::State::STARTED) && (rendition->GetOriginStreamUUID() == origin_stream_uuid))
+		{
+			renditions.push_back(rendition);
+		}
+	}
+
+	return renditions;
+}
+
 bool RtcApplication::Start()
 {
 	if(_certificate == nullptr)
@@ -26,6 +26,9 @@ public:
 
 	std::shared_ptr<Certificate> GetCertificate();
 
+	// Streams which are made from the same input stream as the stream (ex: the outputs of the transcoder), including itself
+	std::vector<std::shared_ptr<RtcStream>> GetRenditionStreams(const std::shared_ptr<RtcStream> &stream);
+
 private:
 	bool Start() override;
 	bool Stop() override;
@@ -0,0 +1,635 @@
+#include "rtc_private.h"
+#include "rtc_rendition_switcher.h"
+#include "rtc_application.h"
+#include "rtc_stream.h"
+
+#include "modules/rtp_rtcp/rtx_rtp_packet.h"
+#include "base/ovlibrary/byte_io.h"
+
+#include <algorithm>
+
+// Timestamps of the renditions are on the same timeline if they differ less than this (in seconds of the clock rate),
+// since the packetizers of the renditions use the PTS of the same input
+#define RTC_ABR_SAME_TIMELINE_THRESHOLD		0.5
+// When the timelines differ, the timestamp continues after this interval (in seconds of the clock rate)
+#define RTC_ABR_TIMESTAMP_GAP				0.02
+
+static bool IsSamePayload(const std::shared_ptr<const MediaDescription> &media, const std::shared_ptr<const MediaDescription> &home_media, uint8_t id)
+{
+	auto payload = media->GetPayload(id);
+	auto home_payload = home_media->GetPayload(id);
+
+	if((payload == nullptr) || (home_payload == nullptr))
+	{
+		return false;
+	}
+
+	return (payload->GetCodec() == home_payload->GetCodec()) && (payload->GetCodecRate() == home_payload->GetCodecRate());
+}
+
+// Returns the size of the RTP header (including CSRCs and the header extension) of the packet in buffer, 0 if it is invalid
+static size_t GetRtpHeaderSize(const uint8_t *buffer, size_t length)
+{
+	if(length < FIXED_HEADER_SIZE)
+	{
+		return 0;
+	}
+
+	size_t header_size = FIXED_HEADER_SIZE + (buffer[0] & 0x0F) * 4;
+
+	if(buffer[0] & 0x10)
+	{
+		if(length < header_size + 4)
+		{
+			return 0;
+		}
+
+		header_size += 4 + ByteReader<uint16_t>::ReadBigEndian(&buffer[header_size + 2]) * 4;
+	}
+
+	return (header_size <= length) ? header_size : 0;
+}
+
+std::shared_ptr<RtcRenditionSwitcher> RtcRenditionSwitcher::Create(const std::shared_ptr<RtcApplication> &application,
+																   const std::shared_ptr<RtcStream> &home_stream,
+																   uint8_t video_payload_type, uint8_t red_block_pt, uint8_t audio_payload_type, bool rtx_enabled)
+{
+	auto switcher = std::make_shared<RtcRenditionSwitcher>(application, home_stream, video_payload_type, red_block_pt, audio_payload_type, rtx_enabled);
+	if(!switcher->Initialize())
+	{
+		return nullptr;
+	}
+
+	return switcher;
+}
+
+RtcRenditionSwitcher::RtcRenditionSwitcher(const std::shared_ptr<RtcApplication> &application,
+										   const std::shared_ptr<RtcStream> &home_stream,
+										   uint8_t video_payload_type, uint8_t red_block_pt, uint8_t audio_payload_type, bool rtx_enabled)
+{
+	_application = application;
+	_home.stream = home_stream;
+
+	_video_payload_type = video_payload_type;
+	_red_block_pt = red_block_pt;
+	_audio_payload_type = audio_payload_type;
+	_rtx_enabled = rtx_enabled;
+}
+
+bool RtcRenditionSwitcher::Initialize()
+{
+	auto session_description = _home.stream->GetSessionDescription();
+	if(session_description == nullptr)
+	{
+		return false;
+	}
+
+	for(const auto &media : session_description->GetMediaList())
+	{
+		if((media->GetMediaType() == MediaDescription::MediaType::Video) && (_home_video_media == nullptr))
+		{
+			_home_video_media = media;
+		}
+		else if((media->GetMediaType() == MediaDescription::MediaType::Audio) && (_home_audio_media == nullptr))
+		{
+			_home_audio_media = media;
+		}
+	}
+
+	if((_video_payload_type == 0) || (_home_video_media == nullptr) || (MakeRendition(_home.stream, _home) == false))
+	{
+		return false;
+	}
+
+	_serving = _home;
+
+	// The packets of the home stream are sent as they are until the first switch
+	Mapping video_mapping;
+	video_mapping.ssrc = _home.video_ssrc;
+	video_mapping.clock_rate = _home.video_clock_rate;
+	video_mapping.is_initialized = true;
+	_mappings[_home.video_ssrc] = video_mapping;
+
+	if(_home.video_rtx_ssrc != 0)
+	{
+		Mapping rtx_mapping = video_mapping;
+		rtx_mapping.ssrc = _home.video_rtx_ssrc;
+		rtx_mapping.is_rtx = true;
+		_mappings[_home.video_rtx_ssrc] = rtx_mapping;
+	}
+
+	if(_home.audio_ssrc != 0)
+	{
+		Mapping audio_mapping;
+		audio_mapping.ssrc = _home.audio_ssrc;
+		audio_mapping.clock_rate = _home.audio_clock_rate;
+		audio_mapping.is_initialized = true;
+		_mappings[_home.audio_ssrc] = audio_mapping;
+	}
+
+	_last_switch_time_ms = ov::Clock::NowMSec();
+
+	return true;
+}
+
+bool RtcRenditionSwitcher::MakeRendition(const std::shared_ptr<RtcStream> &stream, Rendition &rendition) const
+{
+	auto session_description = stream->GetSessionDescription();
+	if(session_description == nullptr)
+	{
+		return false;
+	}
+
+	rendition.stream = stream;
+
+	for(const auto &media : session_description->GetMediaList())
+	{
+		if((media->GetMediaType() == MediaDescription::MediaType::Video) && (rendition.video_ssrc == 0))
+		{
+			if(IsSamePayload(media, _home_video_media, _video_payload_type) == false)
+			{
+				return false;
+			}
+
+			if((_red_block_pt != 0) && (IsSamePayload(media, _home_video_media, _red_block_pt) == false))
+			{
+				return false;
+			}
+
+			if(_rtx_enabled)
+			{
+				// We always define the RTX payload as payload + 1
+				if((IsSamePayload(media, _home_video_media, _video_payload_type + 1) == false) || (media->GetRtxSsrc() == 0))
+				{
+					return false;
+				}
+
+				rendition.video_rtx_ssrc = media->GetRtxSsrc();
+			}
+
+			rendition.video_ssrc = media->GetSsrc();
+			rendition.video_clock_rate = media->GetPayload(_video_payload_type)->GetCodecRate();
+		}
+		else if((media->GetMediaType() == MediaDescription::MediaType::Audio) && (rendition.audio_ssrc == 0) && (_audio_payload_type != 0))
+		{
+			if((_home_audio_media == nullptr) || (IsSamePayload(media, _home_audio_media, _audio_payload_type) == false))
+			{
+				return false;
+			}
+
+			rendition.audio_ssrc = media->GetSsrc();
+			rendition.audio_clock_rate = media->GetPayload(_audio_payload_type)->GetCodecRate();
+		}
+	}
+
+	if((rendition.video_ssrc == 0) || ((_audio_payload_type != 0) && (rendition.audio_ssrc == 0)))
+	{
+		return false;
+	}
+
+	if(rendition.video_clock_rate == 0)
+	{
+		rendition.video_clock_rate = 90000;
+	}
+
+	for(const auto &item : stream->GetTracks())
+	{
+		const auto &track = item.second;
+
+		rendition.bitrate += std::max(track->GetBitrate(), 0);
+
+		if(track->GetMediaType() == cmn::MediaType::Video)
+		{
+			rendition.pixels = std::max<uint64_t>(rendition.pixels, static_cast<uint64_t>(std::max(track->GetWidth(), 0)) * std::max(track->GetHeight(), 0));
+		}
+	}
+
+	return true;
+}
+
+void RtcRenditionSwitcher::SetRenditions(std::vector<Rendition> renditions)
+{
+	std::sort(renditions.begin(), renditions.end(), [](const Rendition &a, const Rendition &b) -> bool {
+		return (a.bitrate != b.bitrate) ? (a.bitrate < b.bitrate) : (a.pixels < b.pixels);
+	});
+
+	_renditions = std::move(renditions);
+
+	// The bitrate of the serving rendition can be known later
+	auto index = FindRenditionIndex(_serving.stream);
+	if(index >= 0)
+	{
+		_serving.bitrate = _renditions[index].bitrate;
+		_serving.pixels = _renditions[index].pixels;
+	}
+}
+
+int RtcRenditionSwitcher::FindRenditionIndex(const std::shared_ptr<RtcStream> &stream) const
+{
+	for(size_t i = 0; i < _renditions.size(); i++)
+	{
+		if(_renditions[i].stream == stream)
+		{
+			return static_cast<int>(i);
+		}
+	}
+
+	return -1;
+}
+
+bool RtcRenditionSwitcher::OnOutgoingPacket(const std::shared_ptr<RtpPacket> &packet, std::shared_ptr<RtcStream> &stream_to_detach)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto ssrc = packet->Ssrc();
+
+	// The switch takes effect at the first packet of a keyframe, so the viewer can decode the new rendition from the packet
+	if(_has_pending && (ssrc == _pending.video_ssrc) && packet->IsKeyframeStart())
+	{
+		if(_serving.stream != _home.stream)
+		{
+			stream_to_detach = _serving.stream;
+		}
+
+		CommitPending(packet);
+	}
+
+	if((ssrc != _serving.video_ssrc) && (ssrc != _serving.audio_ssrc))
+	{
+		return false;
+	}
+
+	auto item = _mappings.find(ssrc);
+	if(item == _mappings.end())
+	{
+		return false;
+	}
+
+	auto &mapping = item->second;
+	if(mapping.is_initialized == false)
+	{
+		InitializeMapping(mapping, packet->SequenceNumber(), packet->Timestamp());
+	}
+
+	auto &state = _output_states[mapping.ssrc];
+	state.has_sent = true;
+	state.sequence_number = packet->SequenceNumber() + mapping.sequence_number_offset;
+	state.timestamp = packet->Timestamp() + mapping.timestamp_offset;
+	state.timestamp_offset = mapping.timestamp_offset;
+
+	return true;
+}
+
+void RtcRenditionSwitcher::CommitPending(const std::shared_ptr<RtpPacket> &packet)
+{
+	Mapping video_mapping;
+	video_mapping.ssrc = _home.video_ssrc;
+	video_mapping.clock_rate = _pending.video_clock_rate;
+	InitializeMapping(video_mapping, packet->SequenceNumber(), packet->Timestamp());
+	_mappings[_pending.video_ssrc] = video_mapping;
+
+	if((_pending.video_rtx_ssrc != 0) && (_home.video_rtx_ssrc != 0))
+	{
+		Mapping rtx_mapping = video_mapping;
+		rtx_mapping.ssrc = _home.video_rtx_ssrc;
+		rtx_mapping.is_rtx = true;
+		_mappings[_pending.video_rtx_ssrc] = rtx_mapping;
+	}
+
+	if(_pending.audio_ssrc != 0)
+	{
+		// Decided by the first audio packet of the rendition
+		Mapping audio_mapping;
+		audio_mapping.ssrc = _home.audio_ssrc;
+		audio_mapping.clock_rate = _pending.audio_clock_rate;
+		_mappings[_pending.audio_ssrc] = audio_mapping;
+	}
+
+	logti("Rendition of the session has been switched : %s -> %s (seq offset : %u, ts offset : %u)",
+		  _serving.stream->GetName().CStr(), _pending.stream->GetName().CStr(),
+		  video_mapping.sequence_number_offset, video_mapping.timestamp_offset);
+
+	_has_switched = true;
+	_serving_first_sequence_number = packet->SequenceNumber() + video_mapping.sequence_number_offset;
+
+	_serving = _pending;
+	_pending = Rendition();
+	_has_pending = false;
+
+	_last_switch_time_ms = ov::Clock::NowMSec();
+}
+
+void RtcRenditionSwitcher::InitializeMapping(Mapping &mapping, uint16_t sequence_number, uint32_t timestamp)
+{
+	mapping.is_initialized = true;
+
+	auto &state = _output_states[mapping.ssrc];
+	if(state.has_sent == false)
+	{
+		mapping.sequence_number_offset = 0;
+		mapping.timestamp_offset = 0;
+		return;
+	}
+
+	// The sequence number continues from the last packet which has been sent to the viewer
+	mapping.sequence_number_offset = static_cast<uint16_t>(state.sequence_number + 1 - sequence_number);
+
+	// Timestamp of the previous rendition (before rewriting) at the last packet
+	uint32_t previous_timestamp = state.timestamp - state.timestamp_offset;
+	auto difference = static_cast<int32_t>(timestamp - previous_timestamp);
+	auto clock_rate = (mapping.clock_rate != 0) ? mapping.clock_rate : 90000;
+
+	if(std::abs(static_cast<int64_t>(difference)) < static_cast<int64_t>(clock_rate * RTC_ABR_SAME_TIMELINE_THRESHOLD))
+	{
+		// The renditions are on the same timeline, so the viewer keeps the A/V sync with the same offset
+		mapping.timestamp_offset = state.timestamp_offset;
+	}
+	else
+	{
+		mapping.timestamp_offset = state.timestamp + static_cast<uint32_t>(clock_rate * RTC_ABR_TIMESTAMP_GAP) - timestamp;
+	}
+}
+
+uint32_t RtcRenditionSwitcher::Rewrite(const std::shared_ptr<RtpPacket> &packet, uint8_t *buffer, size_t length)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto item = _mappings.find(packet->Ssrc());
+	if(item == _mappings.end())
+	{
+		return 0;
+	}
+
+	const auto &mapping = item->second;
+	if((mapping.is_initialized == false) ||
+	   ((mapping.ssrc == packet->Ssrc()) && (mapping.sequence_number_offset == 0) && (mapping.timestamp_offset == 0)))
+	{
+		return 0;
+	}
+
+	auto header_size = GetRtpHeaderSize(buffer, length);
+	if(header_size == 0)
+	{
+		return 0;
+	}
+
+	ByteWriter<uint32_t>::WriteBigEndian(&buffer[4], packet->Timestamp() + mapping.timestamp_offset);
+	ByteWriter<uint32_t>::WriteBigEndian(&buffer[8], mapping.ssrc);
+
+	if(mapping.is_rtx)
+	{
+		// Original sequence number at the beginning of the payload
+		if(length >= header_size + RTX_HEADER_SIZE)
+		{
+			auto original_sequence_number = ByteReader<uint16_t>::ReadBigEndian(&buffer[header_size]);
+			ByteWriter<uint16_t>::WriteBigEndian(&buffer[header_size], original_sequence_number + mapping.sequence_number_offset);
+		}
+
+		return mapping.timestamp_offset;
+	}
+
+	ByteWriter<uint16_t>::WriteBigEndian(&buffer[2], packet->SequenceNumber() + mapping.sequence_number_offset);
+
+	if(packet->IsUlpfec())
+	{
+		// ULPFEC header follows the RED header
+		//  0                   1                   2                   3
+		// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+		// |E|L|P|X|  CC   |M| PT recovery |            SN base            |
+		// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+		// |                          TS recovery                          |
+		// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+		auto fec_header = &buffer[header_size + RED_HEADER_SIZE];
+		if(length >= header_size + RED_HEADER_SIZE + 8)
+		{
+			auto sn_base = ByteReader<uint16_t>::ReadBigEndian(&fec_header[2]);
+			ByteWriter<uint16_t>::WriteBigEndian(&fec_header[2], sn_base + mapping.sequence_number_offset);
+
+			// The protected packets of a frame have the same timestamp, so TS recovery is the timestamp or 0 (XOR of even number of them)
+			if(ByteReader<uint32_t>::ReadBigEndian(&fec_header[4]) == packet->Timestamp())
+			{
+				ByteWriter<uint32_t>::WriteBigEndian(&fec_header[4], packet->Timestamp() + mapping.timestamp_offset);
+			}
+		}
+	}
+
+	return mapping.timestamp_offset;
+}
+
+std::shared_ptr<RtcStream> RtcRenditionSwitcher::GetRetransmissionSource(uint16_t sequence_number, uint16_t &source_sequence_number)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	// The packets which have been sent before the switch are not in the history of the serving rendition
+	if(_has_switched && (static_cast<uint16_t>(sequence_number - _serving_first_sequence_number) >= 0x8000))
+	{
+		return nullptr;
+	}
+
+	auto item = _mappings.find(_serving.video_ssrc);
+	if((item == _mappings.end()) || (item->second.is_initialized == false))
+	{
+		return nullptr;
+	}
+
+	source_sequence_number = sequence_number - item->second.sequence_number_offset;
+
+	return _serving.stream;
+}
+
+void RtcRenditionSwitcher::OnNetworkCondition(double loss_rate, int64_t rtt_ms, uint32_t estimated_bitrate)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	// Smooth the loss rate since a report covers about a second only
+	_loss_rate = (_loss_rate + loss_rate) / 2.0;
+
+	if(rtt_ms >= 0)
+	{
+		_rtt_ms = rtt_ms;
+
+		if((_min_rtt_ms < 0) || (rtt_ms < _min_rtt_ms))
+		{
+			_min_rtt_ms = rtt_ms;
+		}
+	}
+
+	_estimated_bitrate = estimated_bitrate;
+}
+
+bool RtcRenditionSwitcher::IsCongested() const
+{
+	if(_loss_rate >= RTC_ABR_DOWNGRADE_LOSS_RATE)
+	{
+		return true;
+	}
+
+	if((_rtt_ms >= 0) && (_min_rtt_ms >= 0) &&
+	   (_rtt_ms > _min_rtt_ms * RTC_ABR_RTT_INFLATION_FACTOR) && (_rtt_ms > _min_rtt_ms + RTC_ABR_RTT_INFLATION_MARGIN_MS))
+	{
+		return true;
+	}
+
+	if((_estimated_bitrate != 0) && (_serving.bitrate != 0) && (_estimated_bitrate < _serving.bitrate))
+	{
+		return true;
+	}
+
+	return false;
+}
+
+void RtcRenditionSwitcher::Evaluate(std::shared_ptr<RtcStream> &stream_to_attach, std::shared_ptr<RtcStream> &stream_to_detach)
+{
+	auto now_ms = static_cast<int64_t>(ov::Clock::NowMSec());
+
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	if((now_ms - _last_evaluation_time_ms) < RTC_ABR_EVALUATION_INTERVAL_MS)
+	{
+		return;
+	}
+	_last_evaluation_time_ms = now_ms;
+
+	if((now_ms - _last_refresh_time_ms) >= RTC_ABR_RENDITION_REFRESH_INTERVAL_MS)
+	{
+		_last_refresh_time_ms = now_ms;
+
+		// The application locks its streams, so they are collected without the lock of the switcher
+		lock.unlock();
+
+		std::vector<Rendition> renditions;
+		for(const auto &stream : _application->GetRenditionStreams(_home.stream))
+		{
+			Rendition rendition;
+			if(MakeRendition(stream, rendition))
+			{
+				renditions.push_back(rendition);
+			}
+		}
+
+		lock.lock();
+		SetRenditions(std::move(renditions));
+	}
+
+	if(_has_pending)
+	{
+		if(((now_ms - _pending_time_ms) >= RTC_ABR_PENDING_TIMEOUT_MS) || (_pending.stream->GetState() != pub::Stream::State::STARTED))
+		{
+			logtw("Switching to %s has been canceled since no keyframe has been received", _pending.stream->GetName().CStr());
+
+			if(_pending.stream != _home.stream)
+			{
+				stream_to_detach = _pending.stream;
+			}
+
+			_pending = Rendition();
+			_has_pending = false;
+		}
+
+		return;
+	}
+
+	// The serving rendition has been deleted
+	if((_serving.stream != _home.stream) && (_serving.stream->GetState() != pub::Stream::State::STARTED))
+	{
+		SetPending(_home, now_ms, stream_to_attach, stream_to_detach);
+		return;
+	}
+
+	auto index = FindRenditionIndex(_serving.stream);
+	if((_renditions.size() < 2) || (index < 0))
+	{
+		return;
+	}
+
+	if(IsCongested())
+	{
+		if((index == 0) || ((now_ms - _last_switch_time_ms) < RTC_ABR_DOWNGRADE_HOLD_MS))
+		{
+			return;
+		}
+
+		auto target = index - 1;
+		if(_estimated_bitrate != 0)
+		{
+			while((target > 0) && (_renditions[target].bitrate > _estimated_bitrate * RTC_ABR_ESTIMATE_MARGIN))
+			{
+				target--;
+			}
+		}
+
+		// The previous upgrade has failed, so wait longer before the next upgrade
+		if((_last_upgrade_time_ms >= 0) && ((now_ms - _last_upgrade_time_ms) < _upgrade_hold_ms))
+		{
+			_upgrade_hold_ms = std::min<int64_t>(_upgrade_hold_ms * 2, RTC_ABR_MAX_UPGRADE_HOLD_MS);
+		}
+
+		SetPending(_renditions[target], now_ms, stream_to_attach, stream_to_detach);
+		return;
+	}
+
+	if((_loss_rate < RTC_ABR_UPGRADE_LOSS_RATE) && (static_cast<size_t>(index + 1) < _renditions.size()) &&
+	   ((now_ms - _last_switch_time_ms) >= _upgrade_hold_ms))
+	{
+		const auto &next = _renditions[index + 1];
+
+		// Without the estimate (transport-cc is not negotiated), the viewer tries the next rendition and the loss decides
+		if((_estimated_bitrate == 0) || (next.bitrate == 0) || (_estimated_bitrate * RTC_ABR_ESTIMATE_MARGIN >= next.bitrate))
+		{
+			_last_upgrade_time_ms = now_ms;
+			SetPending(next, now_ms, stream_to_attach, stream_to_detach);
+			return;
+		}
+	}
+
+	// The network has been stable for a long time
+	if((_upgrade_hold_ms > RTC_ABR_UPGRADE_HOLD_MS) && ((now_ms - _last_switch_time_ms) >= RTC_ABR_MAX_UPGRADE_HOLD_MS))
+	{
+		_upgrade_hold_ms = RTC_ABR_UPGRADE_HOLD_MS;
+	}
+}
+
+void RtcRenditionSwitcher::SetPending(const Rendition &rendition, int64_t now_ms, std::shared_ptr<RtcStream> &stream_to_attach, std::shared_ptr<RtcStream> &stream_to_detach)
+{
+	if(rendition.stream == _serving.stream)
+	{
+		return;
+	}
+
+	if(_has_pending && (_pending.stream != _home.stream) && (_pending.stream != rendition.stream))
+	{
+		stream_to_detach = _pending.stream;
+	}
+
+	logtd("The session is switching to %s (loss : %.3f, rtt : %lld ms, estimate : %u bps)",
+		  rendition.stream->GetName().CStr(), _loss_rate, static_cast<long long>(_rtt_ms), _estimated_bitrate);
+
+	_pending = rendition;
+	_has_pending = true;
+	_pending_time_ms = now_ms;
+
+	// The packets of the home stream are always delivered to the session
+	if(rendition.stream != _home.stream)
+	{
+		stream_to_attach = rendition.stream;
+	}
+}
+
+std::vector<std::shared_ptr<RtcStream>> RtcRenditionSwitcher::GetAttachedStreams()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	std::vector<std::shared_ptr<RtcStream>> streams;
+
+	if(_serving.stream != _home.stream)
+	{
+		streams.push_back(_serving.stream);
+	}
+
+	if(_has_pending && (_pending.stream != _home.stream))
+	{
+		streams.push_back(_pending.stream);
+	}
+
+	return streams;
+}
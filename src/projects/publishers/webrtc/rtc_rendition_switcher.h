@@ -0,0 +1,174 @@
+#pragma once
+
+#include "base/ovlibrary/ovlibrary.h"
+#include "modules/rtp_rtcp/rtp_packet.h"
+#include "modules/sdp/media_description.h"
+
+#include <mutex>
+#include <unordered_map>
+
+// Interval of deciding the rendition (The network condition is updated by RTCP RR about once a second)
+#define RTC_ABR_EVALUATION_INTERVAL_MS			1000
+// Interval of refreshing the renditions (The transcoder can create or delete them at any time)
+#define RTC_ABR_RENDITION_REFRESH_INTERVAL_MS	5000
+// A viewer does not switch down again right after the previous switch (The RR still reports the loss of the previous rendition)
+#define RTC_ABR_DOWNGRADE_HOLD_MS				2000
+// A viewer switches up only if the network has been stable for this time.
+// If the upgrade fails (switches down soon), the hold is doubled up to RTC_ABR_MAX_UPGRADE_HOLD_MS
+#define RTC_ABR_UPGRADE_HOLD_MS					10000
+#define RTC_ABR_MAX_UPGRADE_HOLD_MS				60000
+// If the target rendition does not send a keyframe in this time, the switch is canceled
+#define RTC_ABR_PENDING_TIMEOUT_MS				10000
+#define RTC_ABR_DOWNGRADE_LOSS_RATE				0.10
+#define RTC_ABR_UPGRADE_LOSS_RATE				0.02
+// RTT is inflated (queues are building up on the path) if it exceeds both of them
+#define RTC_ABR_RTT_INFLATION_FACTOR			2.0
+#define RTC_ABR_RTT_INFLATION_MARGIN_MS			100
+// Part of the estimated bandwidth which the video can use
+#define RTC_ABR_ESTIMATE_MARGIN					0.85
+
+class RtcApplication;
+class RtcStream;
+
+// Server-side ABR of a WebRTC session.
+//
+// The session stays in the stream it has requested (home), and receives the packets of another rendition of the same input
+// (a sibling RtcStream created by the transcoder) by being attached to it (pub::Stream::AttachSession).
+// The switch takes effect at the first packet of a keyframe of the target rendition, and the SSRC, sequence number and timestamp
+// of the packets are rewritten to those of the home stream, so the viewer receives the renditions as a single track.
+//
+// - OnOutgoingPacket() is called by the stream workers for every packet, and decides whether the packet is sent to the viewer
+// - Rewrite() is called with the copy of the packet which is sent to the viewer (after the pacer)
+// - OnNetworkCondition() and Evaluate() are called when RTCP is received, and decide the rendition
+//
+// The renditions must have the same payload types and codecs as the home stream (The viewer has negotiated them only).
+class RtcRenditionSwitcher
+{
+public:
+	// Returns nullptr if the home stream cannot be switched (ex: it has no video)
+	static std::shared_ptr<RtcRenditionSwitcher> Create(const std::shared_ptr<RtcApplication> &application,
+														const std::shared_ptr<RtcStream> &home_stream,
+														uint8_t video_payload_type, uint8_t red_block_pt, uint8_t audio_payload_type, bool rtx_enabled);
+
+	RtcRenditionSwitcher(const std::shared_ptr<RtcApplication> &application,
+						 const std::shared_ptr<RtcStream> &home_stream,
+						 uint8_t video_payload_type, uint8_t red_block_pt, uint8_t audio_payload_type, bool rtx_enabled);
+
+	// Returns true if the packet is sent to the viewer.
+	// stream_to_detach: The stream which the session does not need any more since the switch has been completed by this packet
+	bool OnOutgoingPacket(const std::shared_ptr<RtpPacket> &packet, std::shared_ptr<RtcStream> &stream_to_detach);
+
+	// Rewrites the copy of the packet (buffer) which is sent to the viewer,
+	// and returns the timestamp offset which has been applied (for RTCP SR)
+	uint32_t Rewrite(const std::shared_ptr<RtpPacket> &packet, uint8_t *buffer, size_t length);
+
+	// Finds the packet which the viewer has lost (sequence_number is of the home stream).
+	// Returns the stream which has sent the packet and its original sequence number
+	std::shared_ptr<RtcStream> GetRetransmissionSource(uint16_t sequence_number, uint16_t &source_sequence_number);
+
+	// loss_rate: 0.0 ~ 1.0, rtt_ms: -1 if unknown, estimated_bitrate: 0 if unknown
+	void OnNetworkCondition(double loss_rate, int64_t rtt_ms, uint32_t estimated_bitrate);
+
+	// Decides the rendition of the viewer.
+	// stream_to_attach: The session must be attached to this stream to receive its keyframe
+	// stream_to_detach: The session must be detached from this stream (The switch has been canceled)
+	void Evaluate(std::shared_ptr<RtcStream> &stream_to_attach, std::shared_ptr<RtcStream> &stream_to_detach);
+
+	// Streams (except the home stream) which the session is attached to
+	std::vector<std::shared_ptr<RtcStream>> GetAttachedStreams();
+
+private:
+	struct Rendition
+	{
+		std::shared_ptr<RtcStream> stream;
+
+		uint32_t video_ssrc = 0;
+		uint32_t video_rtx_ssrc = 0;
+		uint32_t video_clock_rate = 0;
+		uint32_t audio_ssrc = 0;
+		uint32_t audio_clock_rate = 0;
+
+		// Bitrate of the tracks (bps), 0 if unknown
+		uint64_t bitrate = 0;
+		uint64_t pixels = 0;
+	};
+
+	// How the packets of a source SSRC are rewritten
+	struct Mapping
+	{
+		uint32_t ssrc = 0;
+		uint16_t sequence_number_offset = 0;
+		uint32_t timestamp_offset = 0;
+		uint32_t clock_rate = 0;
+
+		// RTX: the original sequence number in the payload is rewritten instead of the sequence number
+		// (The session assigns the sequence number of RTX)
+		bool is_rtx = false;
+
+		// The offsets are decided by the first packet (ex: audio after the switch of video)
+		bool is_initialized = false;
+	};
+
+	// Last packet which has been sent to the viewer per output SSRC
+	struct OutputState
+	{
+		bool has_sent = false;
+		uint16_t sequence_number = 0;
+		uint32_t timestamp = 0;
+		uint32_t timestamp_offset = 0;
+	};
+
+	bool Initialize();
+
+	bool MakeRendition(const std::shared_ptr<RtcStream> &stream, Rendition &rendition) const;
+	void SetRenditions(std::vector<Rendition> renditions);
+	int FindRenditionIndex(const std::shared_ptr<RtcStream> &stream) const;
+
+	void SetPending(const Rendition &rendition, int64_t now_ms, std::shared_ptr<RtcStream> &stream_to_attach, std::shared_ptr<RtcStream> &stream_to_detach);
+	void CommitPending(const std::shared_ptr<RtpPacket> &packet);
+	void InitializeMapping(Mapping &mapping, uint16_t sequence_number, uint32_t timestamp);
+
+	bool IsCongested() const;
+
+	std::mutex _mutex;
+
+	std::shared_ptr<RtcApplication> _application;
+
+	uint8_t _video_payload_type = 0;
+	uint8_t _red_block_pt = 0;
+	uint8_t _audio_payload_type = 0;
+	bool _rtx_enabled = false;
+
+	std::shared_ptr<const MediaDescription> _home_video_media;
+	std::shared_ptr<const MediaDescription> _home_audio_media;
+
+	Rendition _home;
+	Rendition _serving;
+	Rendition _pending;
+	bool _has_pending = false;
+	int64_t _pending_time_ms = 0;
+
+	// The first sequence number (of the home stream) which has been sent from the serving rendition
+	bool _has_switched = false;
+	uint16_t _serving_first_sequence_number = 0;
+
+	// Sorted by bitrate (ascending)
+	std::vector<Rendition> _renditions;
+	int64_t _last_refresh_time_ms = 0;
+
+	// Key: source SSRC
+	std::unordered_map<uint32_t, Mapping> _mappings;
+	// Key: output SSRC
+	std::unordered_map<uint32_t, OutputState> _output_states;
+
+	// Network condition
+	double _loss_rate = 0.0;
+	int64_t _rtt_ms = -1;
+	int64_t _min_rtt_ms = -1;
+	uint32_t _estimated_bitrate = 0;
+
+	int64_t _last_evaluation_time_ms = 0;
+	int64_t _last_switch_time_ms = 0;
+	int64_t _last_upgrade_time_ms = -1;
+	int64_t _upgrade_hold_ms = RTC_ABR_UPGRADE_HOLD_MS;
+};
@@ -6,9 +6,23 @@
 #include "rtc_stream.h"
 
 #include "modules/rtp_rtcp/rtcp_info/nack.h"
+#include "modules/rtp_rtcp/rtcp_info/receiver_report.h"
+#include "modules/rtp_rtcp/rtcp_info/transport_cc.h"
+#include "base/ovlibrary/byte_io.h"
 
+#include <chrono>
 #include <utility>
 
+// The pacer sends the packets faster than the estimated bandwidth, so the bursts of the encoder (ex: keyframe) are drained quickly
+#define RTC_PACING_BITRATE_FACTOR			2.5
+// Interval of reporting the estimated bandwidth to the stream metrics
+#define RTC_BANDWIDTH_REPORT_INTERVAL_MS	1000
+
+static int64_t GetSteadyTimeUs()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 std::shared_ptr<RtcSession> RtcSession::Create(const std::shared_ptr<WebRtcPublisher> &publisher,
 											   const std::shared_ptr<pub::Application> &application,
                                                const std::shared_ptr<pub::Stream> &stream,
@@ -132,6 +146,31 @@ bool RtcSession::Start()
 			_video_ssrc = offer_media_desc->GetSsrc();
 			_rtp_rtcp->AddRtcpSRGenerator(_video_payload_type, _video_ssrc);
 		}
+
+		// Transport-wide sequence number is used only if both the offer and the answer have it
+		auto transport_cc_extension_id = peer_media_desc->GetExtmapId(TRANSPORT_CC_EXTENSION_URI);
+		if((transport_cc_extension_id != 0) && (offer_media_desc->GetExtmapId(TRANSPORT_CC_EXTENSION_URI) != 0))
+		{
+			_transport_cc_extension_id = transport_cc_extension_id;
+		}
+	}
+
+	if(_transport_cc_extension_id != 0)
+	{
+		_bandwidth_estimator = std::make_shared<BandwidthEstimator>();
+		_pacer = std::make_shared<RtpPacer>(_bandwidth_estimator->GetEstimatedBitrate() * RTC_PACING_BITRATE_FACTOR,
+			[this](const std::shared_ptr<RtpPacket> &packet, bool is_retransmission) -> bool {
+				return SendRtpPacketToPeer(packet, is_retransmission);
+			});
+
+		logtd("Transport-cc is enabled (extension id : %u)", _transport_cc_extension_id);
+	}
+
+	auto rtc_stream = GetRtcStream();
+
+	if(rtc_stream->GetApplicationInfo().GetConfig().GetPublishers().GetWebrtcPublisher().IsAbrEnabled())
+	{
+		_rendition_switcher = RtcRenditionSwitcher::Create(application, rtc_stream, _video_payload_type, _red_block_pt, _audio_payload_type, _rtx_enabled);
 	}
 
 	// Connect nodes
@@ -157,6 +196,15 @@ bool RtcSession::Start()
 
 bool RtcSession::Stop()
 {
+	// Detach from the other renditions before locking, since their workers may be waiting for the lock in SendOutgoingData()
+	if(_rendition_switcher != nullptr)
+	{
+		for(const auto &stream : _rendition_switcher->GetAttachedStreams())
+		{
+			stream->DetachSession(GetId());
+		}
+	}
+
 	// start and stop must be called independently.
 	std::lock_guard<std::shared_mutex> lock(_start_stop_lock);
 
@@ -167,6 +215,12 @@ bool RtcSession::Stop()
 		return true;
 	}
 
+	if(_pacer != nullptr)
+	{
+		// Waits for the thread which is sending the packets of this session
+		_pacer->Stop();
+	}
+
 	if(_rtp_rtcp != nullptr)
 	{
 		_rtp_rtcp->Stop();
@@ -182,6 +236,11 @@ bool RtcSession::Stop()
 		_srtp_transport->Stop();
 	}
 
+	if((_bandwidth_estimator != nullptr) && (_stream_metrics != nullptr))
+	{
+		_stream_metrics->RemoveEstimatedBandwidth(GetId());
+	}
+
 	// TODO(Getroot): Doesn't need this?
 	//_ws_client->Close();
 
@@ -210,6 +269,11 @@ const std::shared_ptr<http::svr::ws::Client>& RtcSession::GetWSClient()
 	return _ws_client;
 }
 
+uint32_t RtcSession::GetEstimatedBitrate() const
+{
+	return (_bandwidth_estimator != nullptr) ? _bandwidth_estimator->GetEstimatedBitrate() : 0;
+}
+
 void RtcSession::OnPacketReceived(const std::shared_ptr<info::Session> &session_info,
 								const std::shared_ptr<const ov::Data> &data)
 {
@@ -286,16 +350,100 @@ bool RtcSession::SendOutgoingData(const std::any &packet)
 		}
 	}
 
+	// Only the packets of the rendition which the viewer is switched to are sent
+	std::shared_ptr<RtcStream> stream_to_detach;
+	if((_rendition_switcher != nullptr) && (_rendition_switcher->OnOutgoingPacket(session_packet, stream_to_detach) == false))
+	{
+		return false;
+	}
+
+	bool result = true;
+
+	if(_pacer != nullptr)
+	{
+		// Audio is sent ahead of the queued video, so it is not delayed by the burst of a keyframe
+		_pacer->Enqueue(session_packet, rtp_payload_type == _audio_payload_type, false);
+	}
+	else
+	{
+		result = SendRtpPacketToPeer(session_packet, false);
+	}
+
+	if(stream_to_detach != nullptr)
+	{
+		// The worker of the previous rendition may be waiting for the lock to send a packet to this session
+		lock.unlock();
+		stream_to_detach->DetachSession(GetId());
+	}
+
+	return result;
+}
+
+void RtcSession::FlushOutgoingData()
+{
+	if(_pacer == nullptr)
+	{
+		return;
+	}
+
+	std::shared_lock<std::shared_mutex> lock(_start_stop_lock);
+
+	if(pub::Session::GetState() != SessionState::Started)
+	{
+		return;
+	}
+
+	// The packets which were waiting for the budget are sent by the worker of the stream
+	_pacer->Process();
+}
+
+bool RtcSession::SendRtpPacketToPeer(const std::shared_ptr<RtpPacket> &packet, bool is_retransmission)
+{
 	// RTP Session must be copied and sent because data is altered due to SRTP.
-	auto copy_packet = std::make_shared<RtpPacket>(*session_packet);
+	// The copy is made in a buffer of the worker's pool, and SRTP encrypts it in place.
+	bool is_allocated = false;
+	std::shared_ptr<ov::Data> copy_data;
+	uint16_t transport_sequence_number = 0;
+
+	if(_bandwidth_estimator != nullptr)
+	{
+		// The packets are sent by the pacer one at a time, so the transport-wide sequence number is assigned in the order of sending
+		transport_sequence_number = _transport_sequence_number++;
+		copy_data = RtpSendBufferPool::GetInstance().Copy(packet, _transport_cc_extension_id, transport_sequence_number, &is_allocated);
+	}
+	else
+	{
+		copy_data = RtpSendBufferPool::GetInstance().Copy(packet, &is_allocated);
+	}
+
+	// GetStream() is not changed while the session is alive, so the pointer is used without taking a reference per packet
+	static_cast<RtcStream *>(GetStream().get())->OnPacketCopiedForSession(is_allocated);
+
+	if(is_retransmission)
+	{
+		// Rewrite the sequence number of the copy (The packet in the history is shared by all sessions)
+		ByteWriter<uint16_t>::WriteBigEndian(copy_data->GetWritableDataAs<uint8_t>() + 2, _rtx_sequence_number++);
+	}
+
+	// The packets of the other renditions are rewritten as the packets of this stream
+	uint32_t timestamp_offset = 0;
+	if(_rendition_switcher != nullptr)
+	{
+		timestamp_offset = _rendition_switcher->Rewrite(packet, copy_data->GetWritableDataAs<uint8_t>(), copy_data->GetLength());
+	}
+
+	if(_bandwidth_estimator != nullptr)
+	{
+		_bandwidth_estimator->OnPacketSent(transport_sequence_number, copy_data->GetLength(), GetSteadyTimeUs());
+	}
 
 	if(_stream_metrics != nullptr)
 	{
-		_stream_metrics->IncreaseBytesOut(PublisherType::Webrtc, copy_packet->GetData()->GetLength());
+		_stream_metrics->IncreaseBytesOut(PublisherType::Webrtc, copy_data->GetLength());
 	}
 
 	// rtp_rtcp -> srtp -> dtls -> Edge Node(RtcSession)
-	return _rtp_rtcp->SendRtpPacket(copy_packet);
+	return _rtp_rtcp->SendRtpPacket(packet, copy_data, timestamp_offset);
 }
 
 void RtcSession::OnRtpFrameReceived(const std::vector<std::shared_ptr<RtpPacket>> &rtp_packets)
@@ -312,7 +460,7 @@ void RtcSession::OnRtcpReceived(const std::shared_ptr<RtcpInfo> &rtcp_info)
 
 	if(rtcp_info->GetPacketType() == RtcpPacketType::RR)
 	{
-		// Process
+		ProcessReceiverReport(rtcp_info);
 	}
 	else if(rtcp_info->GetPacketType() == RtcpPacketType::RTPFB)
 	{
@@ -321,12 +469,86 @@ void RtcSession::OnRtcpReceived(const std::shared_ptr<RtcpInfo> &rtcp_info)
 			// Process
 			ProcessNACK(rtcp_info);
 		}
+		else if(rtcp_info->GetCountOrFmt() == static_cast<uint8_t>(RTPFBFMT::TRANSPORT_CC))
+		{
+			ProcessTransportCc(rtcp_info);
+		}
+	}
+
+	if(_pacer != nullptr)
+	{
+		// If the stream stalls, the rest of the queue is sent whenever the viewer reports (at least every RTCP interval)
+		_pacer->Process();
 	}
 
 	//rtcp_info->DebugPrint();
 }
 
 
+bool RtcSession::ProcessReceiverReport(const std::shared_ptr<RtcpInfo> &rtcp_info)
+{
+	if(_rendition_switcher == nullptr)
+	{
+		return true;
+	}
+
+	auto receiver_report = std::dynamic_pointer_cast<ReceiverReport>(rtcp_info);
+	if(receiver_report == nullptr)
+	{
+		return false;
+	}
+
+	for(size_t i = 0; i < receiver_report->GetReportBlockCount(); i++)
+	{
+		auto report_block = receiver_report->GetReportBlock(i);
+		if((report_block == nullptr) || (report_block->GetSrcSsrc() != _video_ssrc))
+		{
+			continue;
+		}
+
+		// RTT = now - LSR - DLSR (in 1/65536 seconds, the middle 32 bits of NTP)
+		int64_t rtt_ms = -1;
+		if(report_block->GetLastSr() != 0)
+		{
+			uint32_t msw = 0;
+			uint32_t lsw = 0;
+			ov::Clock::GetNtpTime(msw, lsw);
+
+			uint32_t compact_ntp = (msw << 16) | (lsw >> 16);
+			uint32_t rtt = compact_ntp - report_block->GetLastSr() - report_block->GetDelaySinceLastSr();
+			if(rtt < 0x80000000)
+			{
+				rtt_ms = static_cast<int64_t>(rtt) * 1000 / 65536;
+			}
+		}
+
+		_rendition_switcher->OnNetworkCondition(report_block->GetFractionLost() / 256.0, rtt_ms, GetEstimatedBitrate());
+
+		std::shared_ptr<RtcStream> stream_to_attach;
+		std::shared_ptr<RtcStream> stream_to_detach;
+		_rendition_switcher->Evaluate(stream_to_attach, stream_to_detach);
+
+		if(stream_to_detach != nullptr)
+		{
+			stream_to_detach->DetachSession(GetId());
+		}
+
+		if((stream_to_attach != nullptr) && (stream_to_attach->AttachSession(pub::Session::GetSharedPtrAs<pub::Session>()) == false))
+		{
+			logtw("Could not attach the session(%u) to %s", GetId(), stream_to_attach->GetName().CStr());
+		}
+
+		break;
+	}
+
+	return true;
+}
+
+std::shared_ptr<RtcStream> RtcSession::GetRtcStream()
+{
+	return std::static_pointer_cast<RtcStream>(GetStream());
+}
+
 bool RtcSession::ProcessNACK(const std::shared_ptr<RtcpInfo> &rtcp_info)
 {
 	if(_rtx_enabled == false)
@@ -334,7 +556,7 @@ bool RtcSession::ProcessNACK(const std::shared_ptr<RtcpInfo> &rtcp_info)
 		return true;
 	}
 
-	auto stream = std::dynamic_pointer_cast<RtcStream>(GetStream());
+	auto stream = GetRtcStream();
 	if(stream == nullptr)
 	{
 		return false;
@@ -350,19 +572,67 @@ bool RtcSession::ProcessNACK(const std::shared_ptr<RtcpInfo> &rtcp_info)
 	for(size_t i=0; i<nack->GetLostIdCount(); i++)
 	{
 		auto seq_no = nack->GetLostId(i);
-		auto packet = stream->GetRtxRtpPacket(_video_payload_type, seq_no);
+		std::shared_ptr<RtxRtpPacket> packet;
+
+		if(_rendition_switcher != nullptr)
+		{
+			// The packet has been sent from the rendition which the viewer is switched to
+			uint16_t source_seq_no = 0;
+			auto source_stream = _rendition_switcher->GetRetransmissionSource(seq_no, source_seq_no);
+			packet = (source_stream != nullptr) ? source_stream->GetRtxRtpPacket(_video_payload_type, source_seq_no) : nullptr;
+		}
+		else
+		{
+			packet = stream->GetRtxRtpPacket(_video_payload_type, seq_no);
+		}
+
 		if(packet != nullptr)
 		{
 			logd("RTCP", "Send RTX packet : %u/%u", _video_payload_type, seq_no);
-			auto copy_packet = std::make_shared<RtpPacket>(*(std::dynamic_pointer_cast<RtpPacket>(packet)));
-			copy_packet->SetSequenceNumber(_rtx_sequence_number++);
-			return _rtp_rtcp->SendRtpPacket(copy_packet);
+
+			// Retransmit all the lost packets in the NACK, not only the first one
+			if(_pacer != nullptr)
+			{
+				_pacer->Enqueue(packet, true, true);
+			}
+			else
+			{
+				SendRtpPacketToPeer(packet, true);
+			}
 		}
 	}
 
 	return true;
 }
 
+bool RtcSession::ProcessTransportCc(const std::shared_ptr<RtcpInfo> &rtcp_info)
+{
+	if(_bandwidth_estimator == nullptr)
+	{
+		return true;
+	}
+
+	auto feedback = std::dynamic_pointer_cast<TransportCc>(rtcp_info);
+	if(feedback == nullptr)
+	{
+		return false;
+	}
+
+	if(_bandwidth_estimator->OnTransportFeedback(feedback, GetSteadyTimeUs()))
+	{
+		_pacer->SetPacingBitrate(_bandwidth_estimator->GetEstimatedBitrate() * RTC_PACING_BITRATE_FACTOR);
+	}
+
+	auto now_ms = static_cast<int64_t>(ov::Clock::NowMSec());
+	if((_stream_metrics != nullptr) && ((now_ms - _last_bandwidth_report_time_ms) >= RTC_BANDWIDTH_REPORT_INTERVAL_MS))
+	{
+		_stream_metrics->SetEstimatedBandwidth(GetId(), _bandwidth_estimator->GetEstimatedBitrate());
+		_last_bandwidth_report_time_ms = now_ms;
+	}
+
+	return true;
+}
+
 // ov::Node Interface
 // RtpRtcp -> SRTP -> DTLS -> Edge(this)
 bool RtcSession::OnDataReceivedFromPrevNode(NodeType from_node, const std::shared_ptr<ov::Data> &data)
@@ -373,7 +643,25 @@ bool RtcSession::OnDataReceivedFromPrevNode(NodeType from_node, const std::share
 		return false;
 	}
 
-	return _ice_port->Send(GetId(), data);
+	if (_is_ice_port_info_resolved.load(std::memory_order_acquire) == false)
+	{
+		std::lock_guard<std::mutex> lock_guard(_ice_port_info_lock);
+
+		if (_ice_port_info == nullptr)
+		{
+			_ice_port_info = _ice_port->GetIcePortInfo(GetId());
+
+			if (_ice_port_info == nullptr)
+			{
+				logtd("ClientSocket not found for session #%d", GetId());
+				return false;
+			}
+
+			_is_ice_port_info_resolved.store(true, std::memory_order_release);
+		}
+	}
+
+	return _ice_port->Send(_ice_port_info, data);
 }
 
 // RtcSession Node has not a lower node so it will not be called
@@ -6,8 +6,12 @@
 #include "modules/sdp/session_description.h"
 #include "modules/ice/ice_port.h"
 #include "modules/rtp_rtcp/rtp_rtcp.h"
+#include "modules/rtp_rtcp/rtp_send_buffer_pool.h"
 #include "modules/rtp_rtcp/rtp_packetizer_interface.h"
+#include "modules/rtp_rtcp/bandwidth_estimator.h"
+#include "modules/rtp_rtcp/rtp_pacer.h"
 #include "modules/dtls_srtp/dtls_transport.h"
+#include "rtc_rendition_switcher.h"
 #include <unordered_set>
 #include <monitoring/monitoring.h>
 
@@ -55,8 +59,12 @@ public:
 	const std::shared_ptr<const SessionDescription>& GetOfferSDP() const;
 	const std::shared_ptr<http::svr::ws::Client>& GetWSClient();
 
+	// Bandwidth of the viewer estimated by transport-cc (bps), 0 if transport-cc is not negotiated
+	uint32_t GetEstimatedBitrate() const;
+
 	// pub::Session Interface
 	bool SendOutgoingData(const std::any &packet) override;
+	void FlushOutgoingData() override;
 	void OnPacketReceived(const std::shared_ptr<info::Session> &session_info, const std::shared_ptr<const ov::Data> &data) override;
 	
 	// RtpRtcp Interface
@@ -68,7 +76,15 @@ public:
 	bool OnDataReceivedFromNextNode(NodeType from_node, const std::shared_ptr<const ov::Data> &data) override;
 
 private:
+	bool ProcessReceiverReport(const std::shared_ptr<RtcpInfo> &rtcp_info);
 	bool ProcessNACK(const std::shared_ptr<RtcpInfo> &rtcp_info);
+	bool ProcessTransportCc(const std::shared_ptr<RtcpInfo> &rtcp_info);
+
+	// Copies the packet for this session and sends it (called by the pacer if transport-cc is negotiated)
+	bool SendRtpPacketToPeer(const std::shared_ptr<RtpPacket> &packet, bool is_retransmission);
+
+	// The stream this session belongs to (pub::Session::GetStream()), not the rendition it is attached to
+	std::shared_ptr<RtcStream> GetRtcStream();
 
 	std::shared_ptr<WebRtcPublisher>	_publisher;
 
@@ -79,6 +95,10 @@ private:
 	std::shared_ptr<const SessionDescription> _offer_sdp;
 	std::shared_ptr<const SessionDescription> _peer_sdp;
 	std::shared_ptr<IcePort>            _ice_port;
+	// Resolved once after the STUN binding, so the packets are sent without looking up the tables of IcePort
+	std::mutex							_ice_port_info_lock;
+	std::shared_ptr<IcePort::IcePortInfo> _ice_port_info;
+	std::atomic<bool>					_is_ice_port_info_resolved{false};
 	std::shared_ptr<http::svr::ws::Client> 	_ws_client; // Signalling  
 
 	uint8_t 							_red_block_pt = 0;
@@ -93,6 +113,16 @@ private:
 
 	uint16_t							_rtx_sequence_number = 1;
 
+	// Transport-wide congestion control
+	uint8_t								_transport_cc_extension_id = 0;
+	uint16_t							_transport_sequence_number = 1;
+	std::shared_ptr<BandwidthEstimator>	_bandwidth_estimator;
+	std::shared_ptr<RtpPacer>			_pacer;
+	int64_t								_last_bandwidth_report_time_ms = 0;
+
+	// Server-side ABR (switches between the renditions of the same input)
+	std::shared_ptr<RtcRenditionSwitcher>	_rendition_switcher;
+
 	uint64_t							_session_expired_time = 0;
 
 	std::shared_mutex					_start_stop_lock;
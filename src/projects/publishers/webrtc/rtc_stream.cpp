@@ -7,6 +7,8 @@
 #include "rtc_private.h"
 #include "rtc_session.h"
 
+#include "modules/rtp_rtcp/rtcp_info/transport_cc.h"
+
 using namespace cmn;
 
 /***************************
@@ -102,6 +104,7 @@ bool RtcStream::Start()
 
 	_rtx_enabled = GetApplicationInfo().GetConfig().GetPublishers().GetWebrtcPublisher().IsRtxEnabled();
 	_ulpfec_enabled = GetApplicationInfo().GetConfig().GetPublishers().GetWebrtcPublisher().IsUlpfecEnalbed();
+	_transport_cc_enabled = GetApplicationInfo().GetConfig().GetPublishers().GetWebrtcPublisher().IsTransportCcEnabled();
 
 	_offer_sdp = std::make_shared<SessionDescription>();
 	_offer_sdp->SetOrigin("OvenMediaEngine", ov::Random::GenerateUInt32(), 2, "IN", 4, "127.0.0.1");
@@ -213,6 +216,11 @@ bool RtcStream::Start()
 					{
 						video_media_desc->SetRtxSsrc(ov::Random::GenerateUInt32());
 					}
+					// Transport-wide sequence number
+					if (_transport_cc_enabled == true)
+					{
+						video_media_desc->AddExtmap(RTC_TRANSPORT_CC_EXTENSION_ID, TRANSPORT_CC_EXTENSION_URI);
+					}
 					_offer_sdp->AddMedia(video_media_desc);
 					first_video_desc = false;
 				}
@@ -224,6 +232,11 @@ bool RtcStream::Start()
 					payload->EnableRtcpFb(PayloadAttr::RtcpFbType::Nack, true);
 				}
 
+				if (_transport_cc_enabled == true)
+				{
+					payload->EnableRtcpFb(PayloadAttr::RtcpFbType::TransportCc, true);
+				}
+
 				video_media_desc->AddPayload(payload);
 
 				// For RTX
@@ -284,6 +297,11 @@ bool RtcStream::Start()
 					audio_media_desc->SetCname(cname);
 					// Media SSRC
 					audio_media_desc->SetSsrc(ov::Random::GenerateUInt32());
+					// Transport-wide sequence number
+					if (_transport_cc_enabled == true)
+					{
+						audio_media_desc->AddExtmap(RTC_TRANSPORT_CC_EXTENSION_ID, TRANSPORT_CC_EXTENSION_URI);
+					}
 					_offer_sdp->AddMedia(audio_media_desc);
 					first_audio_desc = false;
 				}
@@ -291,6 +309,11 @@ bool RtcStream::Start()
 				payload->SetRtpmap(payload_type_num++, codec, static_cast<uint32_t>(track->GetSample().GetRateNum()),
 								   std::to_string(track->GetChannel().GetCounts()).c_str());
 
+				if (_transport_cc_enabled == true)
+				{
+					payload->EnableRtcpFb(PayloadAttr::RtcpFbType::TransportCc, true);
+				}
+
 				audio_media_desc->AddPayload(payload);
 				audio_media_desc->Update();
 
@@ -315,6 +338,10 @@ bool RtcStream::Start()
 		{
 			red_payload->EnableRtcpFb(PayloadAttr::RtcpFbType::Nack, true);
 		}
+		if (_transport_cc_enabled == true)
+		{
+			red_payload->EnableRtcpFb(PayloadAttr::RtcpFbType::TransportCc, true);
+		}
 		video_media_desc->AddPayload(red_payload);
 
 		// ULPFEC
@@ -355,6 +382,10 @@ bool RtcStream::Stop()
 
 	_offer_sdp->Release();
 
+	logti("RtcStream(%s/%s) packet stats: packetized: %" PRIu64 ", copied for sessions: %" PRIu64 ", allocated for sessions: %" PRIu64,
+		  GetApplicationName(), GetName().CStr(),
+		  GetPacketizedCount(), GetSessionPacketCopyCount(), GetSessionPacketAllocationCount());
+
 	std::lock_guard<std::shared_mutex> lock(_packetizers_lock);
 	_packetizers.clear();
 
@@ -373,6 +404,8 @@ std::shared_ptr<SessionDescription> RtcStream::GetSessionDescription()
 
 bool RtcStream::OnRtpPacketized(std::shared_ptr<RtpPacket> packet)
 {
+	_packetized_count++;
+
 	auto stream_packet = std::make_any<std::shared_ptr<RtpPacket>>(packet);
 	BroadcastPacket(stream_packet);
 
@@ -10,7 +10,8 @@
 #include <modules/rtp_rtcp/rtp_history.h>
 #include "rtc_session.h"
 
-
+// ID of the transport-wide sequence number extension in the offer (a=extmap)
+#define RTC_TRANSPORT_CC_EXTENSION_ID	1
 
 class RtcStream : public pub::Stream, public RtpPacketizerInterface
 {
@@ -39,6 +40,36 @@ public:
 	// RtpRtcpPacketizerInterface Implementation
 	bool OnRtpPacketized(std::shared_ptr<RtpPacket> packet) override;
 
+	// Called by RtcSession whenever a packet of this stream is copied for SRTP
+	// is_allocated: Whether the copy needed a memory allocation (RtpSendBufferPool is exhausted or growing)
+	void OnPacketCopiedForSession(bool is_allocated)
+	{
+		_session_packet_copy_count++;
+
+		if (is_allocated)
+		{
+			_session_packet_allocation_count++;
+		}
+	}
+
+	// The number of RTP packets created by the packetizers (one allocation per packet)
+	uint64_t GetPacketizedCount() const
+	{
+		return _packetized_count;
+	}
+
+	// The number of RTP packets copied for sessions
+	uint64_t GetSessionPacketCopyCount() const
+	{
+		return _session_packet_copy_count;
+	}
+
+	// The number of memory allocations while copying RTP packets for sessions
+	uint64_t GetSessionPacketAllocationCount() const
+	{
+		return _session_packet_allocation_count;
+	}
+
 private:
 	bool Start() override;
 	bool Stop() override;
@@ -62,5 +93,11 @@ private:
 
 	bool _rtx_enabled = true;
 	bool _ulpfec_enabled = true;
+	bool _transport_cc_enabled = true;
 	uint32_t _worker_count = 0;
+
+	// Allocation counters
+	std::atomic<uint64_t> _packetized_count{0};
+	std::atomic<uint64_t> _session_packet_copy_count{0};
+	std::atomic<uint64_t> _session_packet_allocation_count{0};
 };
\ No newline at end of file
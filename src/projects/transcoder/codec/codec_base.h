@@ -78,6 +78,8 @@ public:
 	}
 
 protected:
-	ov::Queue<std::shared_ptr<const InputType>> _input_buffer;
-	ov::Queue<std::shared_ptr<OutputType>> _output_buffer;
+	// Fed by the transcoder stream, consumed by the codec thread
+	ov::MpscQueue<std::shared_ptr<const InputType>> _input_buffer;
+	// Filled by the codec thread, consumed by the OnComplete handler
+	ov::SpscQueue<std::shared_ptr<OutputType>> _output_buffer;
 };
@@ -22,8 +22,33 @@ extern "C"
 class TranscoderUtilities
 {
 public:
+	// Makes a MediaFrame from the AVFrame.
+	//
+	// If the AVFrame is ref-counted and placed in the system memory, the MediaFrame holds a new reference of the AVFrame
+	// and its planes refer to the memory of the AVFrame without copying. Otherwise, the planes are copied.
 	static inline std::shared_ptr<MediaFrame> ConvertToMediaFrame(cmn::MediaType media_type, AVFrame* frame)
 	{
+		std::shared_ptr<AVFrame> native_frame;
+
+		if (IsReferenceable(media_type, frame))
+		{
+			native_frame = std::shared_ptr<AVFrame>(::av_frame_clone(frame), [](AVFrame* frame) {
+				::av_frame_free(&frame);
+			});
+		}
+
+		auto set_plane = [&native_frame](const std::shared_ptr<MediaFrame>& media_frame, const uint8_t* data, int32_t data_size, int32_t plane) {
+			if (native_frame != nullptr)
+			{
+				// The planes of the clone are the same as the original
+				media_frame->SetBufferReference(data, data_size, plane);
+			}
+			else
+			{
+				media_frame->SetBuffer(data, data_size, plane);
+			}
+		};
+
 		switch (media_type)
 		{
 			case cmn::MediaType::Video: {
@@ -47,20 +72,20 @@ public:
 
 				if (frame->format == AV_PIX_FMT_YUV444P)
 				{
-					video_frame->SetBuffer(frame->data[0], video_frame->GetStride(0) * video_frame->GetHeight(), 0);  // Y-Plane 4
-					video_frame->SetBuffer(frame->data[1], video_frame->GetStride(1) * video_frame->GetHeight(), 1);  // Cb Plane 4
-					video_frame->SetBuffer(frame->data[2], video_frame->GetStride(2) * video_frame->GetHeight(), 2);  // Cr Plane 4
+					set_plane(video_frame, frame->data[0], video_frame->GetStride(0) * video_frame->GetHeight(), 0);  // Y-Plane 4
+					set_plane(video_frame, frame->data[1], video_frame->GetStride(1) * video_frame->GetHeight(), 1);  // Cb Plane 4
+					set_plane(video_frame, frame->data[2], video_frame->GetStride(2) * video_frame->GetHeight(), 2);  // Cr Plane 4
 				}
 				else if (frame->format == AV_PIX_FMT_NV12 || frame->format == AV_PIX_FMT_NV21)
 				{
-					video_frame->SetBuffer(frame->data[0], video_frame->GetStride(0) * video_frame->GetHeight(), 0);	  // Y-Plane 4
-					video_frame->SetBuffer(frame->data[1], video_frame->GetStride(1) * video_frame->GetHeight() / 2, 1);  // uv Plane 2
+					set_plane(video_frame, frame->data[0], video_frame->GetStride(0) * video_frame->GetHeight(), 0);		// Y-Plane 4
+					set_plane(video_frame, frame->data[1], video_frame->GetStride(1) * video_frame->GetHeight() / 2, 1);  // uv Plane 2
 				}
 				else if (frame->format == AV_PIX_FMT_YUV420P)
 				{
-					video_frame->SetBuffer(frame->data[0], video_frame->GetStride(0) * video_frame->GetHeight(), 0);	  // Y-Plane 4
-					video_frame->SetBuffer(frame->data[1], video_frame->GetStride(1) * video_frame->GetHeight() / 2, 1);  // Cb Plane 2
-					video_frame->SetBuffer(frame->data[2], video_frame->GetStride(2) * video_frame->GetHeight() / 2, 2);  // Cr Plane 2
+					set_plane(video_frame, frame->data[0], video_frame->GetStride(0) * video_frame->GetHeight(), 0);		// Y-Plane 4
+					set_plane(video_frame, frame->data[1], video_frame->GetStride(1) * video_frame->GetHeight() / 2, 1);  // Cb Plane 2
+					set_plane(video_frame, frame->data[2], video_frame->GetStride(2) * video_frame->GetHeight() / 2, 2);  // Cr Plane 2
 				}
 				else if (frame->format == AV_PIX_FMT_CUDA)
 				{
@@ -68,17 +93,19 @@ public:
 					{
 						if (frame->linesize[i] > 0)
 						{
-							video_frame->SetBuffer(frame->data[i], video_frame->GetStride(i) * video_frame->GetHeight(), i);  // Y-Plane 4
+							set_plane(video_frame, frame->data[i], video_frame->GetStride(i) * video_frame->GetHeight(), i);  // Y-Plane 4
 						}
 					}
 				}
 				else
 				{
-					video_frame->SetBuffer(frame->data[0], video_frame->GetStride(0) * video_frame->GetHeight(), 0);	  // Y-Plane 4
-					video_frame->SetBuffer(frame->data[1], video_frame->GetStride(1) * video_frame->GetHeight() / 2, 1);  // Cb Plane 2
-					video_frame->SetBuffer(frame->data[2], video_frame->GetStride(2) * video_frame->GetHeight() / 2, 2);  // Cr Plane 2
+					set_plane(video_frame, frame->data[0], video_frame->GetStride(0) * video_frame->GetHeight(), 0);		// Y-Plane 4
+					set_plane(video_frame, frame->data[1], video_frame->GetStride(1) * video_frame->GetHeight() / 2, 1);  // Cb Plane 2
+					set_plane(video_frame, frame->data[2], video_frame->GetStride(2) * video_frame->GetHeight() / 2, 2);  // Cr Plane 2
 				}
 
+				video_frame->SetNativeFrame(std::move(native_frame));
+
 				return video_frame;
 			}
 			case cmn::MediaType::Audio: {
@@ -91,7 +118,7 @@ public:
 				audio_frame->SetSampleRate(frame->sample_rate);
 				audio_frame->SetFormat(frame->format);
 
-				auto data_length = static_cast<uint32_t>(audio_frame->GetBytesPerSample() * audio_frame->GetNbSamples());
+				auto data_length = static_cast<int32_t>(audio_frame->GetBytesPerSample() * audio_frame->GetNbSamples());
 
 				// Copy frame data into out_buf
 				if (IsPlanar(audio_frame->GetFormat<AVSampleFormat>()))
@@ -99,17 +126,17 @@ public:
 					// If the frame is planar, the data is stored separately in the "_frame->data" array.
 					for (int channel = 0; channel < frame->channels; channel++)
 					{
-						audio_frame->Resize(data_length, channel);
-						uint8_t* output = audio_frame->GetWritableBuffer(channel);
-						::memcpy(output, frame->data[channel], data_length);
+						set_plane(audio_frame, frame->data[channel], data_length, channel);
 					}
 				}
 				else
 				{
 					// If the frame is non-planar, it means interleaved data. So, just copy from "_frame->data[0]" into the output_frame
-					audio_frame->AppendBuffer(frame->data[0], data_length * frame->channels, 0);
+					set_plane(audio_frame, frame->data[0], data_length * frame->channels, 0);
 				}
 
+				audio_frame->SetNativeFrame(std::move(native_frame));
+
 				return audio_frame;
 			}
 			default:
@@ -120,6 +147,72 @@ public:
 		return nullptr;
 	}
 
+	// Makes the AVFrame refer to the planes of the MediaFrame without copying.
+	//
+	// Returns false if the MediaFrame is not backed by an AVFrame, or the AVFrame doesn't match the MediaFrame.
+	// In this case, the caller must allocate the AVFrame and copy the planes.
+	static inline bool ReferenceAVFrame(cmn::MediaType media_type, const MediaFrame* frame, AVFrame* output)
+	{
+		auto native_frame = frame->GetNativeFrame<AVFrame>();
+
+		if ((native_frame == nullptr) || (native_frame->format != frame->GetFormat()))
+		{
+			return false;
+		}
+
+		if (media_type == cmn::MediaType::Video)
+		{
+			if ((native_frame->width != frame->GetWidth()) || (native_frame->height != frame->GetHeight()))
+			{
+				return false;
+			}
+		}
+		else if ((native_frame->nb_samples != frame->GetNbSamples()) || (native_frame->channels != frame->GetChannels()))
+		{
+			return false;
+		}
+
+		if (::av_frame_ref(output, native_frame) < 0)
+		{
+			return false;
+		}
+
+		if (media_type == cmn::MediaType::Audio)
+		{
+			output->channel_layout = static_cast<uint64_t>(frame->GetChannelLayout());
+		}
+
+		// The timestamp of the MediaFrame may be changed after decoding
+		output->pts = frame->GetPts();
+		output->pkt_duration = frame->GetDuration();
+
+		// Do not pass the picture type of the input stream to the encoder (It forces a key frame)
+		output->pict_type = AV_PICTURE_TYPE_NONE;
+		output->key_frame = 0;
+
+		return true;
+	}
+
+	// Whether the planes of the AVFrame can be referenced by another module
+	static inline bool IsReferenceable(cmn::MediaType media_type, const AVFrame* frame)
+	{
+		if (frame->buf[0] == nullptr)
+		{
+			// The frame is not ref-counted
+			return false;
+		}
+
+		if (media_type == cmn::MediaType::Video)
+		{
+			auto descriptor = ::av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format));
+
+			// The planes of the hardware frame are not placed in the system memory
+			return (descriptor != nullptr) && ((descriptor->flags & AV_PIX_FMT_FLAG_HWACCEL) == 0);
+		}
+
+		return (media_type == cmn::MediaType::Audio);
+	}
+
 	static inline int64_t GetDurationPerFrame(cmn::MediaType media_type, std::shared_ptr<TranscodeContext>& context, AVFrame* frame = nullptr)
 	{
 		switch (media_type)
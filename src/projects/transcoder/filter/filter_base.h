@@ -71,8 +71,8 @@ public:
 	}
 
 protected:
-	ov::Queue<std::shared_ptr<MediaFrame>> _input_buffer;
-	ov::Queue<std::shared_ptr<MediaFrame>> _output_buffer;
+	ov::MpscQueue<std::shared_ptr<MediaFrame>> _input_buffer;
+	ov::SpscQueue<std::shared_ptr<MediaFrame>> _output_buffer;
 
 	AVFrame *_frame = nullptr;
 	AVFilterContext *_buffersink_ctx = nullptr;
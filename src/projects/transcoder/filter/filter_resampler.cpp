@@ -11,6 +11,7 @@
 
 #include <base/ovlibrary/ovlibrary.h>
 #include "../transcoder_private.h"
+#include "../codec/codec_utilities.h"
 
 MediaFilterResampler::MediaFilterResampler() 
 {
@@ -210,52 +211,58 @@ void MediaFilterResampler::ThreadFilter()
 		// logtd("format(%d), channels(%d), samples(%d)", frame->GetFormat(), frame->GetChannels(), frame->GetNbSamples());
 		///logtp("Dequeued data for resampling: %lld\n%s", frame->GetPts(), ov::Dump(frame->GetBuffer(0), frame->GetBufferSize(0), 32).CStr());
 
-		_frame->format = frame->GetFormat();
-		_frame->nb_samples = frame->GetNbSamples();
-		_frame->channel_layout = static_cast<uint64_t>(frame->GetChannelLayout());
-		_frame->channels = frame->GetChannels();
-		_frame->sample_rate = frame->GetSampleRate();
-		_frame->pts = frame->GetPts();
-		_frame->pkt_duration = frame->GetDuration();
+		int ret = 0;
 
-		int ret = ::av_frame_get_buffer(_frame, 0);
-		if (ret < 0)
+		// Refer to the planes of the decoded frame without copying if possible
+		if (TranscoderUtilities::ReferenceAVFrame(cmn::MediaType::Audio, frame.get(), _frame) == false)
 		{
-			logte("Could not allocate the audio frame data");
-
-			// *result = TranscodeResult::DataError;
-			// return nullptr;
-			break;
-		}
+			_frame->format = frame->GetFormat();
+			_frame->nb_samples = frame->GetNbSamples();
+			_frame->channel_layout = static_cast<uint64_t>(frame->GetChannelLayout());
+			_frame->channels = frame->GetChannels();
+			_frame->sample_rate = frame->GetSampleRate();
+			_frame->pts = frame->GetPts();
+			_frame->pkt_duration = frame->GetDuration();
+
+			ret = ::av_frame_get_buffer(_frame, 0);
+			if (ret < 0)
+			{
+				logte("Could not allocate the audio frame data");
 
-		ret = ::av_frame_make_writable(_frame);
-		if (ret < 0)
-		{
-			logte("Could not make writable frame");
+				// *result = TranscodeResult::DataError;
+				// return nullptr;
+				break;
+			}
 
-			// *result = TranscodeResult::DataError;
-			// return nullptr;
-			 break;
-		}
+			ret = ::av_frame_make_writable(_frame);
+			if (ret < 0)
+			{
+				logte("Could not make writable frame");
 
-		// Copy data into frame
-		if (IsPlanar(frame->GetFormat<AVSampleFormat>()))
-		{
-			// If the frame is planar, the data should stored separately in the "_frame->data" array.
-			_frame->linesize[0] = 0;
+				// *result = TranscodeResult::DataError;
+				// return nullptr;
+				 break;
+			}
 
-			for (int channel = 0; channel < _frame->channels; channel++)
+			// Copy data into frame
+			if (IsPlanar(frame->GetFormat<AVSampleFormat>()))
 			{
-				size_t data_length = frame->GetBufferSize(channel);
+				// If the frame is planar, the data should stored separately in the "_frame->data" array.
+				_frame->linesize[0] = 0;
+
+				for (int channel = 0; channel < _frame->channels; channel++)
+				{
+					size_t data_length = frame->GetBufferSize(channel);
 
-				::memcpy(_frame->data[channel], frame->GetBuffer(channel), data_length);
-				_frame->linesize[0] += data_length;
+					::memcpy(_frame->data[channel], frame->GetBuffer(channel), data_length);
+					_frame->linesize[0] += data_length;
+				}
+			}
+			else
+			{
+				// If the frame is non-planar, Just copy interleaved data to "_frame->data[0]"
+				::memcpy(_frame->data[0], frame->GetBuffer(0), frame->GetBufferSize(0));
 			}
-		}
-		else
-		{
-			// If the frame is non-planar, Just copy interleaved data to "_frame->data[0]"
-			::memcpy(_frame->data[0], frame->GetBuffer(0), frame->GetBufferSize(0));
 		}
 
 		ret = ::av_buffersrc_add_frame_flags(_buffersrc_ctx, _frame, AV_BUFFERSRC_FLAG_KEEP_REF);
@@ -201,37 +201,43 @@ void MediaFilterRescaler::ThreadFilter()
 
 		auto frame = std::move(obj.value());
 
-		_frame->format = frame->GetFormat();
-		_frame->width = frame->GetWidth();
-		_frame->height = frame->GetHeight();
-		_frame->pts = frame->GetPts();
-		_frame->pkt_duration = frame->GetDuration();
+		int ret = 0;
 
-		_frame->linesize[0] = frame->GetStride(0);
-		_frame->linesize[1] = frame->GetStride(1);
-		_frame->linesize[2] = frame->GetStride(2);
-
-		int ret = ::av_frame_get_buffer(_frame, 32);
-		if (ret < 0)
+		// Refer to the planes of the decoded frame without copying if possible
+		if (TranscoderUtilities::ReferenceAVFrame(cmn::MediaType::Video, frame.get(), _frame) == false)
 		{
-			logte("Could not allocate the video frame data\n");
-			break;
-		}
+			_frame->format = frame->GetFormat();
+			_frame->width = frame->GetWidth();
+			_frame->height = frame->GetHeight();
+			_frame->pts = frame->GetPts();
+			_frame->pkt_duration = frame->GetDuration();
+
+			_frame->linesize[0] = frame->GetStride(0);
+			_frame->linesize[1] = frame->GetStride(1);
+			_frame->linesize[2] = frame->GetStride(2);
+
+			ret = ::av_frame_get_buffer(_frame, 32);
+			if (ret < 0)
+			{
+				logte("Could not allocate the video frame data\n");
+				break;
+			}
 
-		ret = ::av_frame_make_writable(_frame);
-		if (ret < 0)
-		{
-			logte("Could not make writable frame. error(%d)", ret);
-			break;
-		}
+			ret = ::av_frame_make_writable(_frame);
+			if (ret < 0)
+			{
+				logte("Could not make writable frame. error(%d)", ret);
+				break;
+			}
 
-		// Copy data of MediaFrame to AVFrame
-		for (int plane = 0; plane < 3; plane++)
-		{
-			size_t buffer_size = frame->GetBufferSize(plane);
-			if (buffer_size > 0)
+			// Copy data of MediaFrame to AVFrame
+			for (int plane = 0; plane < 3; plane++)
 			{
-				::memcpy(_frame->data[plane], frame->GetBuffer(plane), frame->GetBufferSize(plane));
+				size_t buffer_size = frame->GetBufferSize(plane);
+				if (buffer_size > 0)
+				{
+					::memcpy(_frame->data[plane], frame->GetBuffer(plane), frame->GetBufferSize(plane));
+				}
 			}
 		}
 
@@ -105,18 +105,49 @@ bool TranscodeApplication::OnStreamPrepared(const std::shared_ptr<info::Stream>
 	return true;
 }
 
-bool TranscodeApplication::OnSendFrame(const std::shared_ptr<info::Stream> &stream_info, const std::shared_ptr<MediaPacket> &packet)
+std::shared_ptr<TranscoderStream> TranscodeApplication::GetStream(info::stream_id_t stream_id)
 {
 	std::unique_lock<std::mutex> lock(_mutex);
 
-	auto stream_bucket = _streams.find(stream_info->GetId());
+	auto stream_bucket = _streams.find(stream_id);
 
 	if (stream_bucket == _streams.end())
 	{
-		return false;
+		return nullptr;
 	}
 
-	auto stream = stream_bucket->second;
+	return stream_bucket->second;
+}
+
+bool TranscodeApplication::OnSendFrame(const std::shared_ptr<info::Stream> &stream_info, const std::shared_ptr<MediaPacket> &packet)
+{
+	auto stream = GetStream(stream_info->GetId());
+
+	if (stream == nullptr)
+	{
+		return false;
+	}
 
+	// Decoding is done without the lock, so other streams can be created/deleted meanwhile
 	return stream->Push(packet);
 }
+
+bool TranscodeApplication::OnSendFrames(const std::shared_ptr<info::Stream> &stream_info, const std::vector<std::shared_ptr<MediaPacket>> &packets)
+{
+	auto stream = GetStream(stream_info->GetId());
+
+	if (stream == nullptr)
+	{
+		return false;
+	}
+
+	// The whole batch is decoded without the lock
+	bool result = true;
+
+	for (const auto &packet : packets)
+	{
+		result = stream->Push(packet) && result;
+	}
+
+	return result;
+}
@@ -52,8 +52,12 @@ public:
 	bool OnStreamPrepared(const std::shared_ptr<info::Stream> &stream) override;
 
 	bool OnSendFrame(const std::shared_ptr<info::Stream> &stream, const std::shared_ptr<MediaPacket> &packet) override;
+	bool OnSendFrames(const std::shared_ptr<info::Stream> &stream, const std::vector<std::shared_ptr<MediaPacket>> &packets) override;
 
 private:
+	// Returns the stream under the lock (Frames are pushed to the stream after the lock is released)
+	std::shared_ptr<TranscoderStream> GetStream(info::stream_id_t stream_id);
+
 	const info::Application _application_info;
 
 private:
@@ -9,6 +9,8 @@
 
 #include "transcoder_stream.h"
 
+#include <algorithm>
+
 #include <config/config_manager.h>
 
 #include "transcoder_application.h"
@@ -111,6 +113,8 @@ bool TranscoderStream::Start()
 
 bool TranscoderStream::Stop()
 {
+	std::lock_guard<std::mutex> lock(_push_mutex);
+
 	_kill_flag = true;
 
 	logtd("Wait for terminated trancode stream thread. kill_flag(%s)", _kill_flag ? "true" : "false");
@@ -149,6 +153,13 @@ bool TranscoderStream::Stop()
 
 bool TranscoderStream::Push(std::shared_ptr<MediaPacket> packet)
 {
+	std::lock_guard<std::mutex> lock(_push_mutex);
+
+	if (_kill_flag)
+	{
+		return false;
+	}
+
 	int32_t track_id = packet->GetTrackId();
 
 	DecodePacket(track_id, std::move(packet));
@@ -508,12 +519,17 @@ int32_t TranscoderStream::CreateStageMapping()
 	// 2. Configure Track Mapping by Stage
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	// Flow 1(Transcode) : InputTrack -> Decoder -> Filter -> Encoder -> Output Tracks
+	// Flow 1(Transcode) : InputTrack -> Decoder -> Filter -> Encoders -> Output Tracks
 	// InputTrack = ID of Input Track
 	// Decoder = ID of Input Track
-	// Filter = ID of Generated by TranscodeTrackMapContext class
+	// Filter = ID of the first encoder that uses the filter
 	// Encoder = ID of Generated by TranscodeTrackMapContext class
 	// OutputTracks = ID of Output Tracks
+	//
+	// The nodes of the graph are shared to avoid duplicated work:
+	//  - An input track is decoded once
+	//  - A filter is shared by the encoders that need the same rescaled/resampled frames
+	//  - An encoder is shared by the output tracks that have the same encoding profile (See AppendTrackMap())
 
 	// Flow 2(Bypass) : Input Track -> Output Tracks
 	// InputTrack = ID of Input Track
@@ -522,6 +538,11 @@ int32_t TranscoderStream::CreateStageMapping()
 	ov::String temp_debug_msg = "\r\nTranscode Pipeline \n";
 	temp_debug_msg.AppendFormat(" - app(%s/%d), stream(%s/%d)\n", _application_info.GetName().CStr(), _application_info.GetId(), _input_stream->GetName().CStr(), _input_stream->GetId());
 
+	// [<DECODER_ID, FILTER_IDENTIFIER>, FILTER_ID]
+	std::map<std::pair<MediaTrackId, ov::String>, MediaTrackId> filter_nodes;
+
+	_merged_encoder_count = 0;
+
 	for (auto &iter : _track_map)
 	{
 		auto key_pair = iter.first;
@@ -529,15 +550,18 @@ int32_t TranscoderStream::CreateStageMapping()
 		auto encode_profile_name = key_pair.first;
 		auto encode_media_type = key_pair.second;
 
+		auto input_id = flow_context->_input_track->GetId();
+		auto decoder_id = flow_context->_input_track->GetId();
+		auto encoder_id = flow_context->_map_id;
+		MediaTrackId filter_id = -1;
+
+		int32_t encoded_track_count = 0;
+
 		for (auto &iter_output_tracks : flow_context->_output_tracks)
 		{
 			auto stream = iter_output_tracks.first;
 			auto track_info = iter_output_tracks.second;
 
-			auto input_id = flow_context->_input_track->GetId();
-			auto decoder_id = flow_context->_input_track->GetId();
-			auto filter_id = flow_context->_map_id;
-			auto encoder_id = flow_context->_map_id;
 			auto output_id = track_info->GetId();
 
 			if (track_info->IsBypass() == true)
@@ -549,38 +573,42 @@ int32_t TranscoderStream::CreateStageMapping()
 				// Map of InputTrack -> Decoder
 				_stage_input_to_decoder[input_id] = decoder_id;
 
-				// Map of Decoder -> Filters
-				if (_stage_decoder_to_filter.find(decoder_id) == _stage_decoder_to_filter.end())
+				// Map of Decoder -> Filter -> Encoder
+				// (All the output tracks of the context are encoded by the same encoder, so the filter is looked up once)
+				if (filter_id == -1)
 				{
-					_stage_decoder_to_filter[decoder_id].push_back(filter_id);
-				}
-				else
-				{
-					auto filter_ids = _stage_decoder_to_filter[decoder_id];
-					bool found = false;
+					auto filter_key = std::make_pair(decoder_id, GetIdentifiedForFilter(track_info));
+					auto filter_node = filter_nodes.find(filter_key);
 
-					for (auto it_filter_id : filter_ids)
+					if (filter_node == filter_nodes.end())
 					{
-						if (it_filter_id == filter_id)
-						{
-							found = true;
-						}
-					}
+						filter_id = encoder_id;
+						filter_nodes[filter_key] = filter_id;
 
-					if (found == false)
-					{
 						_stage_decoder_to_filter[decoder_id].push_back(filter_id);
 					}
-				}
+					else
+					{
+						// Another encoder already uses the same rescaled/resampled frames
+						filter_id = filter_node->second;
+					}
 
-				// Map of Filter -> Encoder
-				_stage_filter_to_encoder[filter_id] = encoder_id;
+					_stage_filter_to_encoder[filter_id].push_back(encoder_id);
+				}
 
 				// Map of Encoder -> OutputTrack
 				_stage_encoder_to_output[encoder_id].push_back(make_pair(stream, output_id));
+
+				encoded_track_count++;
 			}
 		}
 
+		if (encoded_track_count > 1)
+		{
+			// The encoded packets are fanned out to the output tracks
+			_merged_encoder_count += (encoded_track_count - 1);
+		}
+
 		// for debug log
 		ov::String temp_str = "";
 		for (auto &iter_output_tracks : flow_context->_output_tracks)
@@ -595,16 +623,22 @@ int32_t TranscoderStream::CreateStageMapping()
 		temp_debug_msg.AppendFormat(" - Encode Profile(%s:%s) / Flow InputTrack[%d] => Decoder[%d] => Filter[%d] => Encoder[%d] => OutputTraks%s\n",
 									encode_profile_name.CStr(),
 									(encode_media_type == cmn::MediaType::Video) ? "Video" : "Audio",
-									flow_context->_input_track->GetId(),
-									flow_context->_input_track->GetId(),
-									flow_context->_map_id,
-									flow_context->_map_id,
+									input_id,
+									decoder_id,
+									filter_id,
+									encoder_id,
 									temp_str.CStr());
 
 		created_stage_map++;
 	}
 	logtd(temp_debug_msg);
 
+	// The filters are counted when they are created (See CreateFilter()), because they can be split by the output format of the encoders
+	logti("[%s/%s(%u)] Rendition graph has been created: decoders: %zu, encoders: %zu (merged: %d)",
+		  _application_info.GetName().CStr(), _input_stream->GetName().CStr(), _input_stream->GetId(),
+		  _stage_input_to_decoder.size(),
+		  _stage_encoder_to_output.size(), _merged_encoder_count);
+
 	return created_stage_map;
 }
 
@@ -646,6 +680,23 @@ ov::String TranscoderStream::GetIdentifiedForAudioProfile(const cfg::vhost::app:
 									profile.GetChannel());
 }
 
+ov::String TranscoderStream::GetIdentifiedForFilter(const std::shared_ptr<MediaTrack> &output_track)
+{
+	if (output_track->GetMediaType() == cmn::MediaType::Video)
+	{
+		return ov::String::FormatString("V-%d-%d-%.02f-%s",
+										output_track->GetWidth(),
+										output_track->GetHeight(),
+										output_track->GetFrameRate(),
+										output_track->GetTimeBase().GetStringExpr().CStr());
+	}
+
+	return ov::String::FormatString("A-%d-%d-%s",
+									output_track->GetSampleRate(),
+									static_cast<int>(output_track->GetChannel().GetLayout()),
+									output_track->GetTimeBase().GetStringExpr().CStr());
+}
+
 // Store information that is actually used during encoder profiles.
 // This information is used to prevent encoder duplicate generation and map track IDs by stage.
 void TranscoderStream::AppendTrackMap(
@@ -1186,23 +1237,31 @@ TranscodeResult TranscoderStream::FilterFrame(int32_t track_id, std::shared_ptr<
 
 TranscodeResult TranscoderStream::EncodeFrame(int32_t filter_id, std::shared_ptr<const MediaFrame> frame)
 {
-	auto encoder_id = _stage_filter_to_encoder[filter_id];
-
-	auto encoder_item = _encoders.find(encoder_id);
-	if (encoder_item == _encoders.end())
+	auto stage_item = _stage_filter_to_encoder.find(filter_id);
+	if (stage_item == _stage_filter_to_encoder.end())
 	{
 		return TranscodeResult::NoData;
 	}
 
-	auto encoder = encoder_item->second.get();
+	// The filtered frame is shared by the encoders (The encoders don't modify the frame)
+	for (auto encoder_id : stage_item->second)
+	{
+		auto encoder_item = _encoders.find(encoder_id);
+		if (encoder_item == _encoders.end())
+		{
+			continue;
+		}
 
-	logtp("[#%3d] Encode In.  PTS: %lld, FLAGS: %d, SIZE: %d",
-		  encoder_id,
-		  (int64_t)(frame->GetPts() * encoder->GetTimebase().GetExpr() * 1000),
-		  frame->GetFlags(),
-		  frame->GetBufferSize());
+		auto encoder = encoder_item->second.get();
 
-	encoder->SendBuffer(std::move(frame));
+		logtp("[#%3d] Encode In.  PTS: %lld, FLAGS: %d, SIZE: %d",
+			  encoder_id,
+			  (int64_t)(frame->GetPts() * encoder->GetTimebase().GetExpr() * 1000),
+			  frame->GetFlags(),
+			  frame->GetBufferSize());
+
+		encoder->SendBuffer(frame);
+	}
 
 	return TranscodeResult::NoData;
 }
@@ -1319,19 +1378,7 @@ void TranscoderStream::CreateFilter(MediaFrame *buffer)
 	}
 	auto filter_id_list = filter_item->second;
 
-	for (auto &filter_id : filter_id_list)
-	{
-		auto encoder_id = _stage_filter_to_encoder[filter_id];
-
-		if (_encoders.find(encoder_id) == _encoders.end())
-		{
-			logte("%d track encoder is not allocated", encoder_id);
-
-			continue;
-		}
-
-		auto output_transcode_context = _encoders[encoder_id]->GetContext();
-
+	auto create_filter = [&](MediaTrackId filter_id, const std::shared_ptr<TranscodeContext> &output_transcode_context) {
 		auto transcode_filter = std::make_shared<TranscodeFilter>();
 
 		bool ret = transcode_filter->Configure(input_track, input_transcode_context, output_transcode_context);
@@ -1344,6 +1391,133 @@ void TranscoderStream::CreateFilter(MediaFrame *buffer)
 			// TODO(soulk) : Create exception processing code if filter creation fails
 			logte("Failed to create filter");
 		}
+	};
+
+	// The encoders split from a filter share a new filter if they need the same output
+	// (key: identifier of the output track + format of the encoder, value: ID of the split filter)
+	auto get_split_filter_key = [&](MediaTrackId encoder_id, const std::shared_ptr<TranscodeContext> &encoder_context) -> ov::String {
+		auto &output_list = _stage_encoder_to_output[encoder_id];
+		if (output_list.empty())
+		{
+			return "";
+		}
+
+		auto &output = output_list.front();
+		auto output_track = output.first->GetTrack(output.second);
+		if (output_track == nullptr)
+		{
+			return "";
+		}
+
+		auto format = (encoder_context->GetMediaType() == cmn::MediaType::Video)
+						  ? encoder_context->GetColorspace()
+						  : static_cast<int>(encoder_context->GetAudioSample().GetFormat());
+
+		return ov::String::FormatString("%s-%d", GetIdentifiedForFilter(output_track).CStr(), format);
+	};
+
+	for (auto &filter_id : filter_id_list)
+	{
+		auto encoder_id_list = _stage_filter_to_encoder[filter_id];
+		std::shared_ptr<TranscodeContext> output_transcode_context = nullptr;
+		std::map<ov::String, MediaTrackId> split_filters;
+
+		for (auto encoder_id : encoder_id_list)
+		{
+			auto encoder_item = _encoders.find(encoder_id);
+			if (encoder_item == _encoders.end())
+			{
+				logte("%d track encoder is not allocated", encoder_id);
+
+				continue;
+			}
+
+			auto encoder_context = encoder_item->second->GetContext();
+
+			if (output_transcode_context == nullptr)
+			{
+				output_transcode_context = encoder_context;
+			}
+			else if (IsFilterShareable(output_transcode_context, encoder_context) == false)
+			{
+				// The encoder needs another output (ex: a pixel format of the codec), so split the encoder from the filter
+				auto &shared_encoder_id_list = _stage_filter_to_encoder[filter_id];
+				shared_encoder_id_list.erase(std::remove(shared_encoder_id_list.begin(), shared_encoder_id_list.end(), encoder_id), shared_encoder_id_list.end());
+
+				auto split_filter_key = get_split_filter_key(encoder_id, encoder_context);
+				auto split_filter = split_filter_key.IsEmpty() ? split_filters.end() : split_filters.find(split_filter_key);
+
+				if (split_filter != split_filters.end())
+				{
+					// Another encoder split from this filter already needs the same output
+					logtd("Filter[%d] cannot be shared with Encoder[%d], Filter[%d] is shared instead", filter_id, encoder_id, split_filter->second);
+
+					_stage_filter_to_encoder[split_filter->second].push_back(encoder_id);
+					continue;
+				}
+
+				logtd("Filter[%d] cannot be shared with Encoder[%d], a new filter is created", filter_id, encoder_id);
+
+				if (split_filter_key.IsEmpty() == false)
+				{
+					split_filters[split_filter_key] = encoder_id;
+				}
+
+				_stage_filter_to_encoder[encoder_id].push_back(encoder_id);
+				filter_item->second.push_back(encoder_id);
+
+				create_filter(encoder_id, encoder_context);
+			}
+		}
+
+		if (output_transcode_context != nullptr)
+		{
+			create_filter(filter_id, output_transcode_context);
+		}
+	}
+
+	// Number of the encoders that share a filter with another encoder
+	size_t merged_filter_count = 0;
+
+	for (auto &filter_id : filter_item->second)
+	{
+		auto encoder_count = _stage_filter_to_encoder[filter_id].size();
+
+		if (encoder_count > 1)
+		{
+			merged_filter_count += (encoder_count - 1);
+		}
+	}
+
+	logti("[%s/%s(%u)] Filters of Decoder[%d] have been created: filters: %zu (merged: %zu)",
+		  _application_info.GetName().CStr(), _input_stream->GetName().CStr(), _input_stream->GetId(),
+		  track_id, filter_item->second.size(), merged_filter_count);
+}
+
+bool TranscoderStream::IsFilterShareable(const std::shared_ptr<TranscodeContext> &context, const std::shared_ptr<TranscodeContext> &other_context)
+{
+	if ((context->GetMediaType() != other_context->GetMediaType()) ||
+		(context->GetTimeBase().GetNum() != other_context->GetTimeBase().GetNum()) ||
+		(context->GetTimeBase().GetDen() != other_context->GetTimeBase().GetDen()))
+	{
+		return false;
+	}
+
+	switch (context->GetMediaType())
+	{
+		case cmn::MediaType::Video:
+			return (context->GetVideoWidth() == other_context->GetVideoWidth()) &&
+				   (context->GetVideoHeight() == other_context->GetVideoHeight()) &&
+				   (context->GetFrameRate() == other_context->GetFrameRate()) &&
+				   (context->GetColorspace() == other_context->GetColorspace());
+
+		case cmn::MediaType::Audio:
+			return (context->GetAudioSampleRate() == other_context->GetAudioSampleRate()) &&
+				   (context->GetAudioSample().GetFormat() == other_context->GetAudioSample().GetFormat()) &&
+				   (context->GetAudioChannel().GetLayout() == other_context->GetAudioChannel().GetLayout());
+
+		default:
+			return false;
 	}
 }
 
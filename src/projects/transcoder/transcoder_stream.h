@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <vector>
 
@@ -85,8 +86,9 @@ private:
 	// [DECODER_ID, FILTER_ID(trasncode_id)]
 	std::map<MediaTrackId, std::vector<MediaTrackId>> _stage_decoder_to_filter;
 
-	// [FILTER_ID(trasncode_id), ENCODER_ID(trasncode_id)]
-	std::map<MediaTrackId, MediaTrackId> _stage_filter_to_encoder;
+	// [FILTER_ID(trasncode_id), ENCODER_IDS(trasncode_id)]
+	// A filter is shared by the encoders that need the same rescaled/resampled frames
+	std::map<MediaTrackId, std::vector<MediaTrackId>> _stage_filter_to_encoder;
 
 	// [ENCODER_ID(trasncode_id), OUTPUT_TRACKS]
 	std::map<MediaTrackId, std::vector<std::pair<std::shared_ptr<info::Stream>, MediaTrackId>>> _stage_encoder_to_output;
@@ -106,8 +108,14 @@ private:
 	// last generated output track id.
 	uint8_t _last_track_index = 0;
 
+	// Number of the encoders that are merged into other nodes of the rendition graph
+	int32_t _merged_encoder_count = 0;
+
 	volatile bool _kill_flag;
 
+	// Push() is called without the lock of TranscodeApplication, so it is serialized with Stop() here
+	std::mutex _push_mutex;
+
 	TranscodeApplication *GetParent();
 	TranscodeApplication *_parent;
 
@@ -128,6 +136,8 @@ private:
 	bool CreateDecoder(int32_t input_track_id, int32_t decoder_track_id, std::shared_ptr<TranscodeContext> input_context);
 
 	void CreateFilter(MediaFrame *buffer);
+	// Whether the filter configured for the encoder context can be shared with another encoder context
+	bool IsFilterShareable(const std::shared_ptr<TranscodeContext> &context, const std::shared_ptr<TranscodeContext> &other_context);
 
 	int32_t CreateEncoders(MediaTrackId track_id);
 	bool CreateEncoder(int32_t encoder_track_id, std::shared_ptr<TranscodeContext> output_context);
@@ -162,6 +172,8 @@ public:
 
 	ov::String GetIdentifiedForVideoProfile(const cfg::vhost::app::oprf::VideoProfile &profile);
 	ov::String GetIdentifiedForAudioProfile(const cfg::vhost::app::oprf::AudioProfile &profile);
+	// Identifies the rescale/resample output of the track (The tracks that have the same identifier share a filter)
+	ov::String GetIdentifiedForFilter(const std::shared_ptr<MediaTrack> &output_track);
 	ov::String GetIdentifiedForImageProfile(const cfg::vhost::app::oprf::ImageProfile &profile);
 
 	const cmn::Timebase GetDefaultTimebaseByCodecId(cmn::MediaCodecId codec_id);